@@ -420,6 +420,23 @@
 #define OPENTHREAD_CONFIG_PLATFORM_FLASH_API_ENABLE 0
 #endif
 
+/**
+ * @def OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE
+ *
+ * The maximum number of settings records the in-RAM index of the otPlatFlash* based settings can hold.
+ *
+ * The index keeps the key and offset of every valid record of the active swap area, so that getting or deleting a
+ * setting reads the flash only for the records of that key instead of reading every record header. It is built
+ * when the settings are initialized and after every swap. Settings are read from the flash again while there are
+ * more valid records than the index can hold, until the next swap. Each entry uses 12 bytes of RAM.
+ *
+ * Applicable only when `OPENTHREAD_CONFIG_PLATFORM_FLASH_API_ENABLE` is set. Define to 0 to disable the index.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE
+#define OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE 0
+#endif
+
 /**
  * @def OPENTHREAD_CONFIG_FAILED_CHILD_TRANSMISSIONS
  *
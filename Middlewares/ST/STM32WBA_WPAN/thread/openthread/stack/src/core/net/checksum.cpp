@@ -33,6 +33,8 @@
 
 #include "checksum.hpp"
 
+#include <string.h>
+
 #include "common/code_utils.hpp"
 #include "common/log.hpp"
 #include "common/message.hpp"
@@ -74,10 +76,71 @@ void Checksum::AddUint16(uint16_t aUint16)
 
 void Checksum::AddData(const uint8_t *aBuffer, uint16_t aLength)
 {
-    for (uint16_t i = 0; i < aLength; i++)
+    // The data is summed as 32-bit words read in host byte order, and the carries are folded once at the end.
+    // The one's complement sum does not depend on the byte order (RFC 1071), so the folded sum only needs to
+    // be swapped to big-endian. A 16-bit length limits the sum to 48 bits, so it cannot overflow.
+
+    uint64_t sum = 0;
+    uint32_t word32;
+    uint16_t word16;
+
+    if (mAtOddIndex && (aLength > 0))
+    {
+        AddUint8(*aBuffer++);
+        aLength--;
+    }
+
+    for (; aLength >= 4 * sizeof(uint32_t); aLength -= 4 * sizeof(uint32_t), aBuffer += 4 * sizeof(uint32_t))
+    {
+        memcpy(&word32, aBuffer, sizeof(uint32_t));
+        sum += word32;
+        memcpy(&word32, aBuffer + sizeof(uint32_t), sizeof(uint32_t));
+        sum += word32;
+        memcpy(&word32, aBuffer + 2 * sizeof(uint32_t), sizeof(uint32_t));
+        sum += word32;
+        memcpy(&word32, aBuffer + 3 * sizeof(uint32_t), sizeof(uint32_t));
+        sum += word32;
+    }
+
+    for (; aLength >= sizeof(uint32_t); aLength -= sizeof(uint32_t), aBuffer += sizeof(uint32_t))
+    {
+        memcpy(&word32, aBuffer, sizeof(uint32_t));
+        sum += word32;
+    }
+
+    if (aLength >= sizeof(uint16_t))
+    {
+        memcpy(&word16, aBuffer, sizeof(uint16_t));
+        sum += word16;
+        aLength -= sizeof(uint16_t);
+        aBuffer += sizeof(uint16_t);
+    }
+
+    while ((sum >> 16) != 0)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+
+    AddFoldedSum(BigEndian::HostSwap16(static_cast<uint16_t>(sum)));
+
+    if (aLength > 0)
+    {
+        AddUint8(*aBuffer);
+    }
+}
+
+void Checksum::AddFoldedSum(uint16_t aSum)
+{
+    uint16_t newValue = static_cast<uint16_t>(mValue + aSum);
+
+    // Calculate one's complement sum.
+
+    if (newValue < mValue)
     {
-        AddUint8(aBuffer[i]);
+        newValue++;
     }
+
+    mValue = newValue;
 }
 
 void Checksum::WriteToMessage(uint16_t aOffset, Message &aMessage) const
@@ -120,6 +120,7 @@ private:
     void     AddUint8(uint8_t aUint8);
     void     AddUint16(uint16_t aUint16);
     void     AddData(const uint8_t *aBuffer, uint16_t aLength);
+    void     AddFoldedSum(uint16_t aSum);
     void     WriteToMessage(uint16_t aOffset, Message &aMessage) const;
     void     Calculate(const Ip6::Address &aSource,
                        const Ip6::Address &aDestination,
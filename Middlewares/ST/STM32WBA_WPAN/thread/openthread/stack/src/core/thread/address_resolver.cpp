@@ -60,6 +60,11 @@ AddressResolver::AddressResolver(Instance &aInstance)
 #endif
 {
 #if OPENTHREAD_FTD
+    for (uint16_t &bucket : mCacheHash)
+    {
+        bucket = kNoCacheEntryIndex;
+    }
+
     IgnoreError(Get<Ip6::Icmp>().RegisterHandler(mIcmpHandler));
 #endif
 }
@@ -208,20 +213,89 @@ AddressResolver::CacheEntry *AddressResolver::FindCacheEntry(const Ip6::Address
                                                              CacheEntryList    *&aList,
                                                              CacheEntry        *&aPrevEntry)
 {
-    CacheEntry     *entry   = nullptr;
-    CacheEntryList *lists[] = {&mCachedList, &mSnoopedList, &mQueryList, &mQueryRetryList};
+    CacheEntry *entry;
 
-    for (CacheEntryList *list : lists)
+    // Every entry in the cache lists is in the hash table, which
+    // also gives its list and previous entry for `PopAfter()`.
+
+    for (entry = GetCacheEntryAt(mCacheHash[GetCacheHashBucket(aEid)]); entry != nullptr;
+         entry = entry->GetNextInHash())
     {
-        aList = list;
-        entry = aList->FindMatching(aEid, aPrevEntry);
-        VerifyOrExit(entry == nullptr);
+        if (entry->Matches(aEid))
+        {
+            aList      = entry->GetList();
+            aPrevEntry = entry->GetPrev();
+            break;
+        }
     }
 
-exit:
     return entry;
 }
 
+uint16_t AddressResolver::GetCacheHashBucket(const Ip6::Address &aEid)
+{
+    uint32_t hash = 0;
+
+    for (uint32_t word : aEid.mFields.m32)
+    {
+        hash = (hash ^ word) * 0x01000193;
+    }
+
+    // Mix all the bits in the low ones, so that EIDs that only
+    // differ in their last byte do not end up in the same bucket.
+
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+
+    return static_cast<uint16_t>(hash % kCacheHashBuckets);
+}
+
+void AddressResolver::AddToCacheHash(CacheEntry &aEntry)
+{
+    uint16_t &bucket = mCacheHash[GetCacheHashBucket(aEntry.GetTarget())];
+
+    aEntry.SetNextInHash(GetCacheEntryAt(bucket));
+    bucket = GetCacheEntryIndex(&aEntry);
+}
+
+void AddressResolver::RemoveFromCacheHash(CacheEntry &aEntry)
+{
+    uint16_t   &bucket = mCacheHash[GetCacheHashBucket(aEntry.GetTarget())];
+    CacheEntry *prev   = nullptr;
+
+    for (CacheEntry *entry = GetCacheEntryAt(bucket); entry != nullptr; entry = entry->GetNextInHash())
+    {
+        if (entry == &aEntry)
+        {
+            if (prev == nullptr)
+            {
+                bucket = GetCacheEntryIndex(aEntry.GetNextInHash());
+            }
+            else
+            {
+                prev->SetNextInHash(aEntry.GetNextInHash());
+            }
+
+            break;
+        }
+
+        prev = entry;
+    }
+}
+
+AddressResolver::CacheEntry *AddressResolver::GetCacheEntryAt(uint16_t aIndex)
+{
+    return (aIndex == kNoCacheEntryIndex) ? nullptr : &mCacheEntryPool.GetEntryAt(aIndex);
+}
+
+uint16_t AddressResolver::GetCacheEntryIndex(const CacheEntry *aEntry) const
+{
+    return (aEntry == nullptr) ? kNoCacheEntryIndex : mCacheEntryPool.GetIndexOf(*aEntry);
+}
+
 void AddressResolver::RemoveEntryForAddress(const Ip6::Address &aEid) { Remove(aEid, kReasonRemovingEid); }
 
 void AddressResolver::Remove(const Ip6::Address &aEid, Reason aReason)
@@ -441,24 +515,11 @@ exit:
 
 void AddressResolver::RestartAddressQueries(void)
 {
-    CacheEntry *tail;
-
     // We move all entries from `mQueryRetryList` at the tail of
     // `mQueryList` and then (re)send Address Query for all entries in
     // the updated `mQueryList`.
 
-    tail = mQueryList.GetTail();
-
-    if (tail == nullptr)
-    {
-        mQueryList.SetHead(mQueryRetryList.GetHead());
-    }
-    else
-    {
-        tail->SetNext(mQueryRetryList.GetHead());
-    }
-
-    mQueryRetryList.Clear();
+    mQueryList.PushListAfterTail(mQueryRetryList);
 
     for (CacheEntry &entry : mQueryList)
     {
@@ -1128,7 +1189,10 @@ void AddressResolver::LogCacheEntryChange(EntryChange, Reason, const CacheEntry
 void AddressResolver::CacheEntry::Init(Instance &aInstance)
 {
     InstanceLocatorInit::Init(aInstance);
-    mNextIndex = kNoNextIndex;
+    mNextIndex     = kNoNextIndex;
+    mPrevIndex     = kNoCacheEntryIndex;
+    mNextHashIndex = kNoCacheEntryIndex;
+    mList          = nullptr;
 }
 
 AddressResolver::CacheEntry *AddressResolver::CacheEntry::GetNext(void)
@@ -1150,6 +1214,92 @@ exit:
     return;
 }
 
+AddressResolver::CacheEntry *AddressResolver::CacheEntry::GetPrev(void)
+{
+    return Get<AddressResolver>().GetCacheEntryAt(mPrevIndex);
+}
+
+void AddressResolver::CacheEntry::SetPrev(CacheEntry *aEntry)
+{
+    mPrevIndex = Get<AddressResolver>().GetCacheEntryIndex(aEntry);
+}
+
+AddressResolver::CacheEntry *AddressResolver::CacheEntry::GetNextInHash(void)
+{
+    return Get<AddressResolver>().GetCacheEntryAt(mNextHashIndex);
+}
+
+void AddressResolver::CacheEntry::SetNextInHash(CacheEntry *aEntry)
+{
+    mNextHashIndex = Get<AddressResolver>().GetCacheEntryIndex(aEntry);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// AddressResolver::CacheEntryList
+
+void AddressResolver::CacheEntryList::Push(CacheEntry &aEntry)
+{
+    if (GetHead() != nullptr)
+    {
+        GetHead()->SetPrev(&aEntry);
+    }
+
+    LinkedList<CacheEntry>::Push(aEntry);
+    aEntry.SetPrev(nullptr);
+    aEntry.SetList(this);
+    aEntry.Get<AddressResolver>().AddToCacheHash(aEntry);
+}
+
+AddressResolver::CacheEntry *AddressResolver::CacheEntryList::PopAfter(CacheEntry *aPrevEntry)
+{
+    CacheEntry *entry = LinkedList<CacheEntry>::PopAfter(aPrevEntry);
+
+    VerifyOrExit(entry != nullptr);
+
+    // The popped entry still points to the entry that followed it.
+
+    if (entry->GetNext() != nullptr)
+    {
+        entry->GetNext()->SetPrev(aPrevEntry);
+    }
+
+    entry->SetList(nullptr);
+    entry->Get<AddressResolver>().RemoveFromCacheHash(*entry);
+
+exit:
+    return entry;
+}
+
+void AddressResolver::CacheEntryList::PushListAfterTail(CacheEntryList &aList)
+{
+    // The entries stay in the hash table, only their list changes.
+
+    CacheEntry *tail = GetTail();
+
+    VerifyOrExit(!aList.IsEmpty());
+
+    if (tail == nullptr)
+    {
+        SetHead(aList.GetHead());
+    }
+    else
+    {
+        tail->SetNext(aList.GetHead());
+    }
+
+    aList.GetHead()->SetPrev(tail);
+
+    for (CacheEntry *entry = aList.GetHead(); entry != nullptr; entry = entry->GetNext())
+    {
+        entry->SetList(this);
+    }
+
+    aList.Clear();
+
+exit:
+    return;
+}
+
 #endif // OPENTHREAD_FTD
 
 } // namespace ot
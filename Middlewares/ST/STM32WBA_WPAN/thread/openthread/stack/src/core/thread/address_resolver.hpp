@@ -51,6 +51,8 @@
 
 namespace ot {
 
+class UnitTester;
+
 /**
  * @addtogroup core-arp
  *
@@ -68,6 +70,7 @@ class AddressResolver : public InstanceLocator, private NonCopyable
 {
     friend class TimeTicker;
     friend class Tmf::Agent;
+    friend class UnitTester;
 
     class CacheEntry;
     class CacheEntryList;
@@ -255,6 +258,10 @@ private:
     static constexpr uint16_t kAddressQueryMaxRetryDelay     = OPENTHREAD_CONFIG_TMF_ADDRESS_QUERY_MAX_RETRY_DELAY;
     static constexpr uint16_t kSnoopBlockEvictionTimeout     = OPENTHREAD_CONFIG_TMF_SNOOP_CACHE_ENTRY_TIMEOUT;
 
+    // Number of buckets of the hash table indexing the entries in the cache lists by EID.
+    static constexpr uint16_t kCacheHashBuckets  = kCacheEntries;
+    static constexpr uint16_t kNoCacheEntryIndex = 0xffff; // Index of no entry in `mCacheEntryPool`.
+
     class CacheEntry : public InstanceLocatorInit
     {
     public:
@@ -264,6 +271,15 @@ private:
         const CacheEntry *GetNext(void) const;
         void              SetNext(CacheEntry *aEntry);
 
+        CacheEntry *GetPrev(void);
+        void        SetPrev(CacheEntry *aEntry);
+
+        CacheEntry *GetNextInHash(void);
+        void        SetNextInHash(CacheEntry *aEntry);
+
+        CacheEntryList *GetList(void) const { return mList; }
+        void            SetList(CacheEntryList *aList) { mList = aList; }
+
         const Ip6::Address &GetTarget(void) const { return mTarget; }
         void                SetTarget(const Ip6::Address &aTarget) { mTarget = aTarget; }
 
@@ -301,6 +317,9 @@ private:
         Ip6::Address      mTarget;
         Mac::ShortAddress mRloc16;
         uint16_t          mNextIndex;
+        uint16_t          mPrevIndex;     // Index of the previous entry in `mList`, none for the head.
+        uint16_t          mNextHashIndex; // Index of the next entry in the same hash bucket.
+        CacheEntryList   *mList;          // The list the entry is in.
 
         union
         {
@@ -323,8 +342,15 @@ private:
 
     typedef Pool<CacheEntry, kCacheEntries> CacheEntryPool;
 
+    // The `LinkedList` operations used to move entries between the cache lists are wrapped to also track the list
+    // and the previous entry of each entry, and to index the entries in the lists by EID.
     class CacheEntryList : public LinkedList<CacheEntry>
     {
+    public:
+        void        Push(CacheEntry &aEntry);
+        CacheEntry *Pop(void) { return PopAfter(nullptr); }
+        CacheEntry *PopAfter(CacheEntry *aPrevEntry);
+        void        PushListAfterTail(CacheEntryList &aList);
     };
 
     enum EntryChange : uint8_t
@@ -347,11 +373,15 @@ private:
     };
 
     CacheEntryPool &GetCacheEntryPool(void) { return mCacheEntryPool; }
+    CacheEntry     *GetCacheEntryAt(uint16_t aIndex);
+    uint16_t        GetCacheEntryIndex(const CacheEntry *aEntry) const;
 
     Error       Resolve(const Ip6::Address &aEid, Mac::ShortAddress &aRloc16, bool aAllowAddressQuery);
     void        Remove(Mac::ShortAddress aRloc16, bool aMatchRouterId);
     void        Remove(const Ip6::Address &aEid, Reason aReason);
     CacheEntry *FindCacheEntry(const Ip6::Address &aEid, CacheEntryList *&aList, CacheEntry *&aPrevEntry);
+    void        AddToCacheHash(CacheEntry &aEntry);
+    void        RemoveFromCacheHash(CacheEntry &aEntry);
     CacheEntry *NewCacheEntry(bool aSnoopedEntry);
     void        RemoveCacheEntry(CacheEntry &aEntry, CacheEntryList &aList, CacheEntry *aPrevEntry, Reason aReason);
     Error       UpdateCacheEntry(const Ip6::Address &aEid, Mac::ShortAddress aRloc16);
@@ -384,12 +414,14 @@ private:
     const char *ListToString(const CacheEntryList *aList) const;
 
     static AddressResolver::CacheEntry *GetEntryAfter(CacheEntry *aPrev, CacheEntryList &aList);
+    static uint16_t                     GetCacheHashBucket(const Ip6::Address &aEid);
 
     CacheEntryPool     mCacheEntryPool;
     CacheEntryList     mCachedList;
     CacheEntryList     mSnoopedList;
     CacheEntryList     mQueryList;
     CacheEntryList     mQueryRetryList;
+    uint16_t           mCacheHash[kCacheHashBuckets];
     Ip6::Icmp::Handler mIcmpHandler;
 
 #endif // OPENTHREAD_FTD
@@ -34,7 +34,9 @@
 
 #include <openthread/platform/flash.h>
 
+#include "common/array.hpp"
 #include "common/code_utils.hpp"
+#include "common/num_utils.hpp"
 #include "instance/instance.hpp"
 
 namespace ot {
@@ -50,6 +52,10 @@ void Flash::Init(void)
 
     mSwapSize = otPlatFlashGetSwapSize(&GetInstance());
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    ClearIndex();
+#endif
+
     for (mSwapIndex = 0;; mSwapIndex++)
     {
         uint32_t swapMarker;
@@ -80,6 +86,13 @@ void Flash::Init(void)
         {
             break;
         }
+
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+        if (record.IsValid())
+        {
+            AddToIndex(record, mSwapUsed);
+        }
+#endif
     }
 
     SanitizeFreeSpace();
@@ -122,6 +135,48 @@ Error Flash::Get(uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLen
     uint32_t     offset;
     RecordHeader record;
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    if (mIndexValid)
+    {
+        const IndexEntry *match = nullptr;
+
+        // Same walk as below, over the valid records only and without reading the flash.
+        for (uint16_t i = 0; i < mIndexLength; i++)
+        {
+            const IndexEntry &entry = mIndex[i];
+
+            if (entry.mKey != aKey)
+            {
+                continue;
+            }
+
+            if (entry.mFirst)
+            {
+                index = 0;
+            }
+
+            if (index == aIndex)
+            {
+                match = &entry;
+            }
+
+            index++;
+        }
+
+        VerifyOrExit(match != nullptr);
+
+        if (aValue && aValueLength)
+        {
+            uint16_t readLength = Min(*aValueLength, match->mLength);
+
+            otPlatFlashRead(&GetInstance(), mSwapIndex, match->mOffset + sizeof(record), aValue, readLength);
+        }
+
+        valueLength = match->mLength;
+        ExitNow(error = kErrorNone);
+    }
+#endif
+
     for (offset = kSwapMarkerSize; offset < mSwapUsed; offset += record.GetSize())
     {
         otPlatFlashRead(&GetInstance(), mSwapIndex, offset, &record, sizeof(record));
@@ -157,6 +212,9 @@ Error Flash::Get(uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLen
         index++;
     }
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+exit:
+#endif
     if (aValueLength)
     {
         *aValueLength = valueLength;
@@ -198,6 +256,10 @@ Error Flash::Add(uint16_t aKey, bool aFirst, const uint8_t *aValue, uint16_t aVa
     record.SetAddCompleteFlag();
     otPlatFlashWrite(&GetInstance(), mSwapIndex, mSwapUsed, &record, sizeof(RecordHeader));
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    AddToIndex(record, mSwapUsed);
+#endif
+
     mSwapUsed += record.GetSize();
 
 exit:
@@ -231,6 +293,10 @@ void Flash::Swap(void)
 
     otPlatFlashErase(&GetInstance(), dstIndex);
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    ClearIndex();
+#endif
+
     for (uint32_t srcOffset = kSwapMarkerSize; srcOffset < mSwapUsed; srcOffset += record.GetSize())
     {
         otPlatFlashRead(&GetInstance(), mSwapIndex, srcOffset, &record, sizeof(RecordHeader));
@@ -244,6 +310,11 @@ void Flash::Swap(void)
 
         otPlatFlashRead(&GetInstance(), mSwapIndex, srcOffset, &record, record.GetSize());
         otPlatFlashWrite(&GetInstance(), dstIndex, dstOffset, &record, record.GetSize());
+
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+        AddToIndex(record, dstOffset);
+#endif
+
         dstOffset += record.GetSize();
     }
 
@@ -261,6 +332,13 @@ Error Flash::Delete(uint16_t aKey, int aIndex)
     int          index = 0; // This must be initialized to 0. See [Note] below.
     RecordHeader record;
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    if (mIndexValid)
+    {
+        ExitNow(error = DeleteIndexed(aKey, aIndex));
+    }
+#endif
+
     for (uint32_t offset = kSwapMarkerSize; offset < mSwapUsed; offset += record.GetSize())
     {
         otPlatFlashRead(&GetInstance(), mSwapIndex, offset, &record, sizeof(record));
@@ -295,6 +373,9 @@ Error Flash::Delete(uint16_t aKey, int aIndex)
         index++;
     }
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+exit:
+#endif
     return error;
 }
 
@@ -305,8 +386,91 @@ void Flash::Wipe(void)
 
     mSwapIndex = 0;
     mSwapUsed  = sizeof(sSwapActive);
+
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    ClearIndex();
+#endif
+}
+
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+
+void Flash::ClearIndex(void)
+{
+    mIndexLength = 0;
+    mIndexValid  = true;
+}
+
+void Flash::AddToIndex(const RecordHeader &aRecord, uint32_t aOffset)
+{
+    // Once a valid record is missing from the index, the settings are read from the flash until it is rebuilt.
+    VerifyOrExit(mIndexValid);
+    VerifyOrExit(mIndexLength < GetArrayLength(mIndex), mIndexValid = false);
+
+    mIndex[mIndexLength].mOffset = aOffset;
+    mIndex[mIndexLength].mKey    = aRecord.GetKey();
+    mIndex[mIndexLength].mLength = aRecord.GetLength();
+    mIndex[mIndexLength].mFirst  = aRecord.IsFirst();
+    mIndexLength++;
+
+exit:
+    return;
 }
 
+Error Flash::DeleteIndexed(uint16_t aKey, int aIndex)
+{
+    // Same as the walk of `Delete()` over the flash, see the [Note] there. The deleted records are removed from the
+    // index as it is walked.
+
+    Error        error  = kErrorNotFound;
+    int          index  = 0;
+    uint16_t     length = 0;
+    RecordHeader record;
+
+    for (uint16_t i = 0; i < mIndexLength; i++)
+    {
+        IndexEntry &entry   = mIndex[i];
+        bool        deleted = false;
+
+        if (entry.mKey == aKey)
+        {
+            if (entry.mFirst)
+            {
+                index = 0;
+            }
+
+            if ((aIndex == index) || (aIndex == -1))
+            {
+                otPlatFlashRead(&GetInstance(), mSwapIndex, entry.mOffset, &record, sizeof(record));
+                record.SetDeleted();
+                otPlatFlashWrite(&GetInstance(), mSwapIndex, entry.mOffset, &record, sizeof(record));
+                deleted = true;
+                error   = kErrorNone;
+            }
+
+            if ((index == 1) && (aIndex == 0))
+            {
+                otPlatFlashRead(&GetInstance(), mSwapIndex, entry.mOffset, &record, sizeof(record));
+                record.SetFirst();
+                otPlatFlashWrite(&GetInstance(), mSwapIndex, entry.mOffset, &record, sizeof(record));
+                entry.mFirst = true;
+            }
+
+            index++;
+        }
+
+        if (!deleted)
+        {
+            mIndex[length++] = entry;
+        }
+    }
+
+    mIndexLength = length;
+
+    return error;
+}
+
+#endif // OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+
 } // namespace ot
 
 #endif // OPENTHREAD_CONFIG_PLATFORM_FLASH_API_ENABLE
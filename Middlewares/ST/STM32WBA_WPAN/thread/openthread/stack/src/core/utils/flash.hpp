@@ -218,9 +218,30 @@ private:
     void  SanitizeFreeSpace(void);
     void  Swap(void);
 
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    struct IndexEntry
+    {
+        uint32_t mOffset; // Offset of the record in the active swap area.
+        uint16_t mKey;
+        uint16_t mLength;
+        bool     mFirst;
+    };
+
+    void  ClearIndex(void);
+    void  AddToIndex(const RecordHeader &aRecord, uint32_t aOffset);
+    Error DeleteIndexed(uint16_t aKey, int aIndex);
+#endif
+
     uint32_t mSwapSize;
     uint32_t mSwapUsed;
     uint8_t  mSwapIndex;
+
+#if OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE > 0
+    // Valid records of the active swap area in the order they were written, only used while `mIndexValid`.
+    IndexEntry mIndex[OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE];
+    uint16_t   mIndexLength;
+    bool       mIndexValid;
+#endif
 };
 
 } // namespace ot
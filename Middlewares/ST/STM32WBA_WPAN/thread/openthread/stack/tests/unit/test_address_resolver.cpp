@@ -0,0 +1,357 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "instance/instance.hpp"
+#include "thread/address_resolver.hpp"
+
+#define VerifyOrQuit(aCondition, aMessage)                                              \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(aCondition))                                                              \
+        {                                                                               \
+            fprintf(stderr, "FAIL: %s (%s:%d)\n", aMessage, __FUNCTION__, __LINE__); \
+            exit(EXIT_FAILURE);                                                         \
+        }                                                                               \
+    } while (false)
+
+namespace ot {
+
+// Only the `AddressResolver` of the instance is constructed.
+uint64_t gInstanceRaw[(sizeof(Instance) + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+
+void MeshForwarder::HandleResolved(const Ip6::Address &, Error) {}
+
+Error Ip6::Icmp::RegisterHandler(Handler &) { return kErrorNone; }
+
+// Referenced by the ICMP handler, which is never called.
+Error Message::Read(uint16_t, void *, uint16_t) const { return kErrorNotFound; }
+
+class UnitTester
+{
+public:
+    typedef AddressResolver::CacheEntry     CacheEntry;
+    typedef AddressResolver::CacheEntryList CacheEntryList;
+
+    static constexpr uint16_t kCacheEntries = AddressResolver::kCacheEntries;
+    static constexpr uint16_t kNumEids      = 2 * kCacheEntries;
+    static constexpr uint8_t  kNumRloc16s   = 4;
+
+    static AddressResolver &GetResolver(void)
+    {
+        return reinterpret_cast<Instance *>(&gInstanceRaw)->Get<AddressResolver>();
+    }
+
+    static Ip6::Address GetEid(uint16_t aIndex)
+    {
+        Ip6::Address eid;
+
+        // Mesh-local EIDs, with random IIDs except for the last two bytes.
+        eid.Clear();
+        eid.mFields.m8[0] = 0xfd;
+        srand(aIndex);
+
+        for (uint8_t i = 8; i < 14; i++)
+        {
+            eid.mFields.m8[i] = static_cast<uint8_t>(rand());
+        }
+
+        eid.mFields.m8[14] = static_cast<uint8_t>(aIndex >> 8);
+        eid.mFields.m8[15] = static_cast<uint8_t>(aIndex & 0xff);
+
+        return eid;
+    }
+
+    // Linear search through the lists, as `FindCacheEntry()` used to be implemented.
+    static CacheEntry *FindCacheEntryByScan(const Ip6::Address &aEid, CacheEntryList *&aList, CacheEntry *&aPrevEntry)
+    {
+        AddressResolver &resolver = GetResolver();
+        CacheEntry      *entry    = nullptr;
+        CacheEntryList  *lists[]  = {&resolver.mCachedList, &resolver.mSnoopedList, &resolver.mQueryList,
+                                     &resolver.mQueryRetryList};
+
+        for (CacheEntryList *list : lists)
+        {
+            aList = list;
+            entry = aList->FindMatching(aEid, aPrevEntry);
+
+            if (entry != nullptr)
+            {
+                break;
+            }
+        }
+
+        return entry;
+    }
+
+    static CacheEntryList &GetList(uint8_t aIndex)
+    {
+        AddressResolver &resolver = GetResolver();
+        CacheEntryList  *lists[]  = {&resolver.mCachedList, &resolver.mSnoopedList, &resolver.mQueryList,
+                                     &resolver.mQueryRetryList};
+
+        return *lists[aIndex];
+    }
+
+    static void CheckCache(void)
+    {
+        AddressResolver &resolver   = GetResolver();
+        uint16_t         numEntries = 0;
+        uint16_t         numHashed  = 0;
+
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            CacheEntryList &list = GetList(i);
+            CacheEntry     *prev = nullptr;
+
+            for (CacheEntry &entry : list)
+            {
+                CacheEntryList *foundList;
+                CacheEntry     *foundPrev;
+
+                VerifyOrQuit(resolver.FindCacheEntry(entry.GetTarget(), foundList, foundPrev) == &entry,
+                             "FindCacheEntry() did not find an entry");
+                VerifyOrQuit(foundList == &list, "FindCacheEntry() returned a wrong list");
+                VerifyOrQuit(foundPrev == prev, "FindCacheEntry() returned a wrong previous entry");
+
+                prev = &entry;
+                numEntries++;
+            }
+        }
+
+        for (uint16_t bucket : resolver.mCacheHash)
+        {
+            for (CacheEntry *entry = resolver.GetCacheEntryAt(bucket); entry != nullptr;
+                 entry             = entry->GetNextInHash())
+            {
+                numHashed++;
+            }
+        }
+
+        VerifyOrQuit(numHashed == numEntries, "entries in the hash table and in the lists differ");
+    }
+
+    static void CheckEid(const Ip6::Address &aEid)
+    {
+        CacheEntryList *list;
+        CacheEntry     *prev;
+
+        VerifyOrQuit(GetResolver().FindCacheEntry(aEid, list, prev) == FindCacheEntryByScan(aEid, list, prev),
+                     "FindCacheEntry() and a search through the lists differ");
+    }
+
+    static void TestRandomOperations(void)
+    {
+        AddressResolver &resolver = GetResolver();
+        uint32_t         seed     = 1;
+
+        new (&resolver) AddressResolver(*reinterpret_cast<Instance *>(&gInstanceRaw));
+
+        for (uint32_t iteration = 0; iteration < 50000; iteration++)
+        {
+            uint16_t          eidIndex;
+            Ip6::Address      eid;
+            Mac::ShortAddress rloc16;
+            CacheEntryList   *list;
+            CacheEntry       *prev;
+            CacheEntry       *entry;
+
+            // `GetEid()` seeds `rand()` with the EID index.
+            srand(seed++);
+            eidIndex = static_cast<uint16_t>(rand() % kNumEids);
+            rloc16   = static_cast<Mac::ShortAddress>(0x0400 * (1 + rand() % kNumRloc16s));
+
+            switch (rand() % 16)
+            {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+            case 4:
+            {
+                bool    snooped   = (rand() % 4 == 0);
+                bool    canEvict  = (rand() % 4 != 0);
+                uint8_t listIndex = static_cast<uint8_t>(rand() % 4);
+
+                eid = GetEid(eidIndex);
+                VerifyOrExit(FindCacheEntryByScan(eid, list, prev) == nullptr);
+
+                entry = resolver.NewCacheEntry(snooped);
+                VerifyOrExit(entry != nullptr);
+
+                entry->SetTarget(eid);
+                entry->SetRloc16(rloc16);
+                entry->SetCanEvict(canEvict);
+                GetList(listIndex).Push(*entry);
+                break;
+            }
+
+            case 5:
+            case 6:
+            case 7:
+                IgnoreError(resolver.UpdateCacheEntry(GetEid(eidIndex), rloc16));
+                break;
+
+            case 8:
+            case 9:
+                resolver.RemoveEntryForAddress(GetEid(eidIndex));
+                break;
+
+            case 10:
+                resolver.RemoveEntriesForRloc16(rloc16);
+                break;
+
+            case 11:
+            case 12:
+            case 13:
+                // Use of an entry, as done by `Resolve()`.
+                entry = resolver.FindCacheEntry(GetEid(eidIndex), list, prev);
+                VerifyOrExit(entry != nullptr);
+                list->PopAfter(prev);
+                resolver.mCachedList.Push(*entry);
+                break;
+
+            case 14:
+                resolver.mQueryList.PushListAfterTail(resolver.mQueryRetryList);
+                break;
+
+            case 15:
+                if (rand() % 64 == 0)
+                {
+                    resolver.Clear();
+                }
+                break;
+            }
+
+        exit:
+            CheckCache();
+            CheckEid(GetEid(eidIndex));
+        }
+
+        resolver.Clear();
+        CheckCache();
+
+        printf("TestRandomOperations() passed\n");
+    }
+
+    static uint64_t NowNs(void)
+    {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    static void BenchmarkLookup(void)
+    {
+        static constexpr uint32_t kNumLookups = 4000000;
+        static constexpr uint16_t kNumOrders  = 4096;
+
+        AddressResolver  &resolver = GetResolver();
+        Ip6::Address      eids[kNumEids];
+        uint16_t          order[kNumOrders];
+        volatile uint32_t found = 0;
+
+        resolver.Clear();
+
+        for (uint16_t i = 0; i < kNumEids; i++)
+        {
+            eids[i] = GetEid(i);
+        }
+
+        // A full cache, with the first half of the EIDs.
+        for (uint16_t i = 0; i < kCacheEntries; i++)
+        {
+            CacheEntry *entry = resolver.NewCacheEntry(/* aSnoopedEntry */ false);
+
+            VerifyOrQuit(entry != nullptr, "NewCacheEntry() failed");
+            entry->SetTarget(eids[i]);
+            entry->SetRloc16(0x0400);
+            resolver.mCachedList.Push(*entry);
+        }
+
+        srand(5);
+
+        for (uint16_t &index : order)
+        {
+            index = static_cast<uint16_t>(rand() % kCacheEntries);
+        }
+
+        printf("%u cache entries: %10s %10s\n", kCacheEntries, "scan", "hash");
+
+        for (uint8_t hits = 0; hits < 2; hits++)
+        {
+            uint64_t elapsed[2];
+
+            for (uint8_t useHash = 0; useHash < 2; useHash++)
+            {
+                uint64_t start = NowNs();
+
+                for (uint32_t i = 0; i < kNumLookups; i++)
+                {
+                    const Ip6::Address &eid = eids[(hits ? 0 : kCacheEntries) + order[i % kNumOrders]];
+                    CacheEntryList     *list;
+                    CacheEntry         *prev;
+                    CacheEntry         *entry;
+
+                    entry = useHash ? resolver.FindCacheEntry(eid, list, prev) : FindCacheEntryByScan(eid, list, prev);
+                    found = found + (entry != nullptr);
+                }
+
+                elapsed[useHash] = NowNs() - start;
+            }
+
+            printf("%19s %7.1f ns %7.1f ns  (per lookup, x%.1f)\n", hits ? "cached EIDs:" : "missing EIDs:",
+                   static_cast<double>(elapsed[0]) / kNumLookups, static_cast<double>(elapsed[1]) / kNumLookups,
+                   static_cast<double>(elapsed[0]) / static_cast<double>(elapsed[1]));
+        }
+
+        VerifyOrQuit(found == kNumLookups * 2, "lookups of cached EIDs failed");
+    }
+};
+
+} // namespace ot
+
+int main(int argc, char *argv[])
+{
+    ot::UnitTester::TestRandomOperations();
+
+    printf("All tests passed\n");
+
+    if ((argc > 1) && (strcmp(argv[1], "--bench") == 0))
+    {
+        ot::UnitTester::BenchmarkLookup();
+    }
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "net/checksum.hpp"
+
+#define VerifyOrQuit(aCondition, aMessage)                                              \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(aCondition))                                                              \
+        {                                                                               \
+            fprintf(stderr, "FAIL: %s (%s:%d)\n", aMessage, __FUNCTION__, __LINE__); \
+            exit(EXIT_FAILURE);                                                         \
+        }                                                                               \
+    } while (false)
+
+namespace ot {
+
+class ChecksumTester
+{
+public:
+    // Byte at a time, as `Checksum::AddData()` used to be implemented.
+    static void AddDataPerByte(Checksum &aChecksum, const uint8_t *aBuffer, uint16_t aLength)
+    {
+        for (uint16_t i = 0; i < aLength; i++)
+        {
+            aChecksum.AddUint8(aBuffer[i]);
+        }
+    }
+
+    // Sums `aBuffer` split in `aNumChunks` chunks at `aSplits`, after `aLead` leading bytes summed one by one.
+    static uint16_t Sum(const uint8_t  *aBuffer,
+                        uint16_t        aLength,
+                        uint16_t        aLead,
+                        const uint16_t *aSplits,
+                        uint8_t         aNumSplits,
+                        bool            aPerByte)
+    {
+        Checksum checksum;
+        uint16_t offset = 0;
+
+        for (; offset < aLead; offset++)
+        {
+            checksum.AddUint8(aBuffer[offset]);
+        }
+
+        for (uint8_t i = 0; i <= aNumSplits; i++)
+        {
+            uint16_t end = (i < aNumSplits) ? aSplits[i] : aLength;
+
+            if (aPerByte)
+            {
+                AddDataPerByte(checksum, aBuffer + offset, end - offset);
+            }
+            else
+            {
+                checksum.AddData(aBuffer + offset, end - offset);
+            }
+
+            offset = end;
+        }
+
+        return checksum.GetValue();
+    }
+
+    static void TestKnownValues(void)
+    {
+        // Example of RFC 1071, section 3.
+        static const uint8_t kRfc1071[] = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7};
+        static const uint8_t kZeros[64] = {0};
+        uint8_t              ones[64];
+        Checksum             checksum;
+
+        checksum.AddData(kRfc1071, sizeof(kRfc1071));
+        VerifyOrQuit(checksum.GetValue() == 0xddf2, "RFC 1071 example");
+
+        checksum.mValue = 0;
+        checksum.AddData(kZeros, sizeof(kZeros));
+        VerifyOrQuit(checksum.GetValue() == 0, "all zeros");
+
+        memset(ones, 0xff, sizeof(ones));
+        checksum.AddData(ones, sizeof(ones));
+        VerifyOrQuit(checksum.GetValue() == 0xffff, "all ones");
+
+        printf("TestKnownValues() passed\n");
+    }
+
+    static void TestOffsetsAndLengths(void)
+    {
+        static constexpr uint16_t kMaxLength = 300;
+        uint8_t                   buffer[kMaxLength + 8];
+
+        srand(1);
+
+        for (uint8_t &byte : buffer)
+        {
+            byte = static_cast<uint8_t>(rand());
+        }
+
+        // Unaligned starts, odd and even lengths, data added while at an odd and an even index.
+        for (uint16_t align = 0; align < 8; align++)
+        {
+            for (uint16_t length = 0; length <= kMaxLength; length++)
+            {
+                for (uint16_t lead = 0; lead < 2 && lead <= length; lead++)
+                {
+                    uint16_t expected = Sum(buffer + align, length, lead, nullptr, 0, /* aPerByte */ true);
+
+                    VerifyOrQuit(Sum(buffer + align, length, lead, nullptr, 0, false) == expected, "checksum mismatch");
+                }
+            }
+        }
+
+        printf("TestOffsetsAndLengths() passed\n");
+    }
+
+    static void TestChunkSplits(void)
+    {
+        static constexpr uint16_t kMaxLength = 1280;
+        static constexpr uint8_t  kMaxSplits = 6;
+        uint8_t                   buffer[kMaxLength];
+
+        srand(2);
+
+        for (uint32_t iteration = 0; iteration < 20000; iteration++)
+        {
+            uint16_t length    = static_cast<uint16_t>(rand() % (kMaxLength + 1));
+            uint8_t  numSplits = static_cast<uint8_t>(rand() % (kMaxSplits + 1));
+            uint16_t splits[kMaxSplits];
+            uint16_t lead = static_cast<uint16_t>((length > 0) ? rand() % 2 : 0);
+
+            for (uint16_t i = 0; i < length; i++)
+            {
+                // Bias towards 0xff and 0x00 to exercise the carries.
+                buffer[i] = static_cast<uint8_t>((rand() % 4 == 0) ? rand() : ((rand() % 2) ? 0xff : 0x00));
+            }
+
+            // Message buffer chains split the data at arbitrary (odd or even) offsets.
+            for (uint8_t i = 0; i < numSplits; i++)
+            {
+                splits[i] = static_cast<uint16_t>(lead + rand() % (length - lead + 1));
+            }
+
+            for (uint8_t i = 1; i < numSplits; i++)
+            {
+                for (uint8_t j = i; j > 0 && splits[j - 1] > splits[j]; j--)
+                {
+                    uint16_t tmp  = splits[j];
+                    splits[j]     = splits[j - 1];
+                    splits[j - 1] = tmp;
+                }
+            }
+
+            VerifyOrQuit(Sum(buffer, length, lead, splits, numSplits, false) ==
+                             Sum(buffer, length, lead, splits, numSplits, /* aPerByte */ true),
+                         "checksum mismatch");
+        }
+
+        printf("TestChunkSplits() passed\n");
+    }
+
+    static uint64_t NowNs(void)
+    {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    static void BenchmarkChecksum(void)
+    {
+        static constexpr uint16_t kLengths[]   = {16, 64, 127, 1280};
+        static constexpr uint32_t kTotalBytes  = 64 * 1024 * 1024;
+        uint8_t                   buffer[1280 + 1];
+        volatile uint16_t         sink = 0;
+
+        for (uint8_t &byte : buffer)
+        {
+            byte = static_cast<uint8_t>(rand());
+        }
+
+        printf("%6s %6s %12s %12s\n", "length", "offset", "per byte", "word");
+
+        for (uint16_t length : kLengths)
+        {
+            for (uint16_t offset = 0; offset < 2; offset++)
+            {
+                uint32_t iterations = kTotalBytes / length;
+                uint64_t elapsed[2];
+
+                for (uint8_t perByte = 0; perByte < 2; perByte++)
+                {
+                    uint64_t start = NowNs();
+
+                    for (uint32_t i = 0; i < iterations; i++)
+                    {
+                        sink = static_cast<uint16_t>(sink + Sum(buffer + offset, length, 0, nullptr, 0, perByte != 0));
+                    }
+
+                    elapsed[perByte] = NowNs() - start;
+                }
+
+                printf("%6u %6u %9.3f ns %9.3f ns  (ns per byte, x%.1f)\n", length, offset,
+                       static_cast<double>(elapsed[1]) / kTotalBytes, static_cast<double>(elapsed[0]) / kTotalBytes,
+                       static_cast<double>(elapsed[1]) / static_cast<double>(elapsed[0]));
+            }
+        }
+    }
+};
+
+} // namespace ot
+
+int main(int argc, char *argv[])
+{
+    ot::ChecksumTester::TestKnownValues();
+    ot::ChecksumTester::TestOffsetsAndLengths();
+    ot::ChecksumTester::TestChunkSplits();
+
+    printf("All tests passed\n");
+
+    if ((argc > 1) && (strcmp(argv[1], "--bench") == 0))
+    {
+        ot::ChecksumTester::BenchmarkChecksum();
+    }
+
+    return 0;
+}
@@ -0,0 +1,311 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openthread/platform/flash.h>
+
+#include "utils/flash.hpp"
+
+#define VerifyOrQuit(aCondition, aMessage)                                              \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(aCondition))                                                              \
+        {                                                                               \
+            fprintf(stderr, "FAIL: %s (%s:%d)\n", aMessage, __FUNCTION__, __LINE__); \
+            exit(EXIT_FAILURE);                                                         \
+        }                                                                               \
+    } while (false)
+
+namespace ot {
+
+// The flash driver only passes the instance on to the platform.
+uint64_t gInstanceRaw[1];
+
+} // namespace ot
+
+// Flash simulator: two swap areas of NOR flash, where writes can only clear bits.
+
+static constexpr uint32_t kSwapSize = 2048;
+
+static uint8_t  sFlash[2][kSwapSize];
+static uint32_t sReadCount;
+
+void otPlatFlashInit(otInstance *) {}
+
+uint32_t otPlatFlashGetSwapSize(otInstance *) { return kSwapSize; }
+
+void otPlatFlashErase(otInstance *, uint8_t aSwapIndex) { memset(sFlash[aSwapIndex], 0xff, kSwapSize); }
+
+void otPlatFlashRead(otInstance *, uint8_t aSwapIndex, uint32_t aOffset, void *aData, uint32_t aSize)
+{
+    VerifyOrQuit(aOffset + aSize <= kSwapSize, "read out of the swap area");
+    memcpy(aData, &sFlash[aSwapIndex][aOffset], aSize);
+    sReadCount++;
+}
+
+void otPlatFlashWrite(otInstance *, uint8_t aSwapIndex, uint32_t aOffset, const void *aData, uint32_t aSize)
+{
+    VerifyOrQuit(aOffset + aSize <= kSwapSize, "write out of the swap area");
+
+    for (uint32_t i = 0; i < aSize; i++)
+    {
+        sFlash[aSwapIndex][aOffset + i] &= static_cast<const uint8_t *>(aData)[i];
+    }
+}
+
+namespace ot {
+
+// Settings expected in the flash: up to `kMaxValues` values of up to `kMaxLength` bytes for each key.
+class Model
+{
+public:
+    static constexpr uint16_t kNumKeys   = 12;
+    static constexpr uint8_t  kMaxValues = 6;
+    static constexpr uint16_t kMaxLength = 40;
+
+    struct Value
+    {
+        uint8_t  mData[kMaxLength];
+        uint16_t mLength;
+    };
+
+    void Clear(void) { memset(mNumValues, 0, sizeof(mNumValues)); }
+
+    void Set(uint16_t aKey, const Value &aValue)
+    {
+        mValues[aKey][0]  = aValue;
+        mNumValues[aKey] = 1;
+    }
+
+    void Add(uint16_t aKey, const Value &aValue) { mValues[aKey][mNumValues[aKey]++] = aValue; }
+
+    void Delete(uint16_t aKey, int aIndex)
+    {
+        if (aIndex == -1)
+        {
+            mNumValues[aKey] = 0;
+            return;
+        }
+
+        for (uint8_t i = static_cast<uint8_t>(aIndex); i + 1 < mNumValues[aKey]; i++)
+        {
+            mValues[aKey][i] = mValues[aKey][i + 1];
+        }
+
+        mNumValues[aKey]--;
+    }
+
+    uint8_t      GetNumValues(uint16_t aKey) const { return mNumValues[aKey]; }
+    const Value &GetValue(uint16_t aKey, uint8_t aIndex) const { return mValues[aKey][aIndex]; }
+
+private:
+    Value   mValues[kNumKeys][kMaxValues];
+    uint8_t mNumValues[kNumKeys];
+};
+
+static Flash   *sFlashDriver;
+static Model    sModel;
+static uint32_t sMaxReadsPerGet;
+
+static Error Get(uint16_t aKey, uint8_t aIndex, uint8_t *aValue, uint16_t *aValueLength)
+{
+    uint32_t reads = sReadCount;
+    Error    error = sFlashDriver->Get(aKey, aIndex, aValue, aValueLength);
+
+    if (sReadCount - reads > sMaxReadsPerGet)
+    {
+        sMaxReadsPerGet = sReadCount - reads;
+    }
+
+    return error;
+}
+
+static Model::Value RandomValue(void)
+{
+    Model::Value value;
+
+    value.mLength = static_cast<uint16_t>(rand() % (Model::kMaxLength + 1));
+
+    for (uint16_t i = 0; i < value.mLength; i++)
+    {
+        value.mData[i] = static_cast<uint8_t>(rand());
+    }
+
+    return value;
+}
+
+// Checks every value of every key against the model, and returns the average number of flash reads per `Get()`.
+static double CheckAllSettings(void)
+{
+    uint32_t reads = sReadCount;
+    uint32_t gets  = 0;
+
+    for (uint16_t key = 0; key < Model::kNumKeys; key++)
+    {
+        for (uint8_t index = 0; index <= sModel.GetNumValues(key); index++)
+        {
+            uint8_t  data[Model::kMaxLength];
+            uint16_t length = sizeof(data);
+            Error    error  = Get(key, index, data, &length);
+
+            gets++;
+
+            if (index == sModel.GetNumValues(key))
+            {
+                VerifyOrQuit(error == kErrorNotFound, "Get() found a value past the last one");
+                VerifyOrQuit(length == 0, "Get() returned a length for a missing value");
+                continue;
+            }
+
+            const Model::Value &expected = sModel.GetValue(key, index);
+
+            VerifyOrQuit(error == kErrorNone, "Get() did not find a value");
+            VerifyOrQuit(length == expected.mLength, "Get() returned a wrong length");
+            VerifyOrQuit(memcmp(data, expected.mData, length) == 0, "Get() returned wrong data");
+
+            // A short buffer gets the beginning of the value and the full length.
+            length = 1;
+            data[0] = static_cast<uint8_t>(~expected.mData[0]);
+            VerifyOrQuit(Get(key, index, data, &length) == kErrorNone, "Get() failed");
+            VerifyOrQuit(length == expected.mLength, "Get() returned a wrong length");
+            VerifyOrQuit(expected.mLength == 0 || data[0] == expected.mData[0], "Get() returned wrong data");
+            gets++;
+        }
+    }
+
+    return static_cast<double>(sReadCount - reads) / gets;
+}
+
+static void TestRandomOperations(void)
+{
+    Flash  flash(*reinterpret_cast<Instance *>(&gInstanceRaw));
+    double readsPerGet = 0;
+    int    checks      = 0;
+
+    sFlashDriver = &flash;
+    otPlatFlashErase(nullptr, 0);
+    otPlatFlashErase(nullptr, 1);
+    flash.Init();
+    sModel.Clear();
+
+    srand(3);
+
+    for (uint32_t iteration = 0; iteration < 20000; iteration++)
+    {
+        uint16_t     key   = static_cast<uint16_t>(rand() % Model::kNumKeys);
+        uint8_t      count = sModel.GetNumValues(key);
+        Model::Value value = RandomValue();
+
+        switch (rand() % 8)
+        {
+        case 0:
+        case 1:
+            // `Set()` is used on single value keys only: the values added before are not deleted from the flash.
+            if (count > 1)
+            {
+                VerifyOrQuit(flash.Delete(key, -1) == kErrorNone, "Delete() failed");
+                sModel.Delete(key, -1);
+            }
+
+            VerifyOrQuit(flash.Set(key, value.mData, value.mLength) == kErrorNone, "Set() failed");
+            sModel.Set(key, value);
+            break;
+
+        case 2:
+        case 3:
+        case 4:
+            if (count < Model::kMaxValues)
+            {
+                VerifyOrQuit(flash.Add(key, value.mData, value.mLength) == kErrorNone, "Add() failed");
+                sModel.Add(key, value);
+            }
+            break;
+
+        case 5:
+        case 6:
+        {
+            int index = (rand() % (count + 2)) - 1;
+
+            if (index == count)
+            {
+                VerifyOrQuit(flash.Delete(key, index) == kErrorNotFound, "Delete() of a missing value succeeded");
+            }
+            else
+            {
+                VerifyOrQuit(flash.Delete(key, index) == ((count == 0) ? kErrorNotFound : kErrorNone), "Delete() failed");
+                sModel.Delete(key, index);
+            }
+            break;
+        }
+
+        case 7:
+            if (rand() % 50 == 0)
+            {
+                // Reboot: the settings are read back from the flash.
+                new (&flash) Flash(*reinterpret_cast<Instance *>(&gInstanceRaw));
+                flash.Init();
+            }
+            break;
+        }
+
+        if (iteration % 16 == 0)
+        {
+            readsPerGet += CheckAllSettings();
+            checks++;
+        }
+    }
+
+    CheckAllSettings();
+
+    printf("index size %d: %.2f flash reads per Get() on average, at most %u\n",
+           OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE, readsPerGet / checks, sMaxReadsPerGet);
+
+    if (OPENTHREAD_CONFIG_PLATFORM_FLASH_INDEX_SIZE >= Model::kNumKeys * Model::kMaxValues)
+    {
+        // All the valid records fit in the index: only the value is read from the flash.
+        VerifyOrQuit(sMaxReadsPerGet <= 1, "Get() read more than the value from the flash");
+    }
+
+    sFlashDriver = nullptr;
+
+    printf("TestRandomOperations() passed\n");
+}
+
+} // namespace ot
+
+int main(void)
+{
+    ot::TestRandomOperations();
+
+    printf("All tests passed\n");
+    return 0;
+}
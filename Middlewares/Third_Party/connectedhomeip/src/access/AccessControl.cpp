@@ -207,6 +207,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        InvalidateCompiledAcl(nullptr);
     }
 
     return retval;
@@ -218,6 +219,7 @@ void AccessControl::Finish()
     ChipLogProgress(DataManagement, "AccessControl: finishing");
     mDelegate->Finish();
     mDelegate = nullptr;
+    InvalidateCompiledAcl(nullptr);
 }
 
 CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t * index,
@@ -398,6 +400,44 @@ CHIP_ERROR AccessControl::CheckACL(const SubjectDescriptor & subjectDescriptor,
         return CHIP_NO_ERROR;
     }
 
+    bool allowed = false;
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    if (mDecisionCacheScopes == 0 || !FindCachedDecision(subjectDescriptor, requestPath, requestPrivilege, allowed))
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    {
+        CHIP_ERROR result = CheckCompiledACL(subjectDescriptor, requestPath, requestPrivilege, allowed);
+        if (result == CHIP_ERROR_NOT_FOUND)
+        {
+            result = CheckEntries(subjectDescriptor, requestPath, requestPrivilege, allowed);
+        }
+        ReturnErrorOnFailure(result);
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+        if (mDecisionCacheScopes > 0)
+        {
+            CacheDecision(subjectDescriptor, requestPath, requestPrivilege, allowed);
+        }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    }
+
+    if (allowed)
+    {
+        // An entry passed all checks: access is allowed.
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+        ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+
+        return CHIP_NO_ERROR;
+    }
+
+    // No entry was found which passed all checks: access is denied.
+    ChipLogProgress(DataManagement, "AccessControl: denied");
+    return CHIP_ERROR_ACCESS_DENIED;
+}
+
+CHIP_ERROR AccessControl::CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                       Privilege requestPrivilege, bool & allowed)
+{
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -499,19 +539,286 @@ CHIP_ERROR AccessControl::CheckACL(const SubjectDescriptor & subjectDescriptor,
             }
         }
         // Entry passed all checks: access is allowed.
-
-#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-        ChipLogProgress(DataManagement, "AccessControl: allowed");
-#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-
+        allowed = true;
         return CHIP_NO_ERROR;
     }
 
     // No entry was found which passed all checks: access is denied.
-    ChipLogProgress(DataManagement, "AccessControl: denied");
-    return CHIP_ERROR_ACCESS_DENIED;
+    allowed = false;
+    return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR AccessControl::CheckCompiledACL(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                           Privilege requestPrivilege, bool & allowed)
+{
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+    VerifyOrReturnError(subjectDescriptor.fabricIndex != kUndefinedFabricIndex, CHIP_ERROR_NOT_FOUND);
+
+    CompiledAcl * compiledAcl = nullptr;
+    CompiledAcl * emptyAcl    = nullptr;
+    for (auto & acl : mCompiledAcls)
+    {
+        if (acl.GetState() == CompiledAcl::State::kEmpty)
+        {
+            emptyAcl = (emptyAcl == nullptr) ? &acl : emptyAcl;
+        }
+        else if (acl.GetFabricIndex() == subjectDescriptor.fabricIndex)
+        {
+            compiledAcl = &acl;
+            break;
+        }
+    }
+
+    if (compiledAcl == nullptr)
+    {
+        if (emptyAcl != nullptr)
+        {
+            compiledAcl = emptyAcl;
+        }
+        else
+        {
+            compiledAcl      = &mCompiledAcls[mNextCompiledAcl];
+            mNextCompiledAcl = static_cast<uint8_t>((mNextCompiledAcl + 1) % CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS);
+        }
+
+        EntryIterator iterator;
+        if (Entries(iterator, &subjectDescriptor.fabricIndex) != CHIP_NO_ERROR)
+        {
+            compiledAcl->Clear();
+            return CHIP_ERROR_NOT_FOUND;
+        }
+        if (compiledAcl->Compile(subjectDescriptor.fabricIndex, iterator) != CHIP_NO_ERROR)
+        {
+            ChipLogDetail(DataManagement, "AccessControl: ACL of fabric %u not compiled", subjectDescriptor.fabricIndex);
+        }
+    }
+
+    VerifyOrReturnError(compiledAcl->GetState() == CompiledAcl::State::kCompiled, CHIP_ERROR_NOT_FOUND);
+
+    CompiledAcl::EntryMask candidates = compiledAcl->MatchSubject(subjectDescriptor, requestPrivilege);
+    allowed = (candidates != 0) && compiledAcl->MatchTarget(candidates, requestPath, *mDeviceTypeResolver);
+    return CHIP_NO_ERROR;
+#else
+    return CHIP_ERROR_NOT_FOUND;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+}
+
+void AccessControl::InvalidateCompiledAcl(const FabricIndex * fabricIndex)
+{
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+    for (auto & acl : mCompiledAcls)
+    {
+        if (fabricIndex == nullptr || acl.GetFabricIndex() == *fabricIndex)
+        {
+            acl.Clear();
+        }
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+    ClearDecisionCache();
+}
+
+void AccessControl::ClearDecisionCache()
+{
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    mCachedDecisionCount = 0;
+    mNextCachedDecision  = 0;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+}
+
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+
+CHIP_ERROR AccessControl::CompiledAcl::Compile(FabricIndex fabricIndex, EntryIterator & iterator)
+{
+    mState        = State::kNotCompilable;
+    mFabricIndex  = fabricIndex;
+    mEntryCount   = 0;
+    mSubjectCount = 0;
+    mCatCount     = 0;
+    mTargetCount  = 0;
+    mAnySubject   = 0;
+    mAnyTarget    = 0;
+
+    Entry entry;
+    while (iterator.Next(entry) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(AddEntry(entry));
+    }
+
+    mState = State::kCompiled;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControl::CompiledAcl::AddEntry(const Entry & entry)
+{
+    VerifyOrReturnError(mEntryCount < kMaxEntries, CHIP_ERROR_NO_MEMORY);
+
+    const uint8_t entryIndex = mEntryCount;
+    CompiledEntry & compiled = mEntries[entryIndex];
+
+    ReturnErrorOnFailure(entry.GetAuthMode(compiled.authMode));
+    // Operational PASE not supported for v1.0.
+    VerifyOrReturnError(compiled.authMode == AuthMode::kCase || compiled.authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(entry.GetPrivilege(compiled.privilege));
+
+    size_t subjectCount = 0;
+    ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+    for (size_t i = 0; i < subjectCount; ++i)
+    {
+        NodeId subject = kUndefinedNodeId;
+        ReturnErrorOnFailure(entry.GetSubject(i, subject));
+        if (IsCASEAuthTag(subject))
+        {
+            VerifyOrReturnError(compiled.authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+            VerifyOrReturnError(mCatCount < kMaxSubjects, CHIP_ERROR_NO_MEMORY);
+            mCats[mCatCount]       = subject;
+            mCatEntries[mCatCount] = entryIndex;
+            mCatCount++;
+        }
+        else
+        {
+            VerifyOrReturnError((IsOperationalNodeId(subject) && compiled.authMode == AuthMode::kCase) ||
+                                    (IsGroupId(subject) && compiled.authMode == AuthMode::kGroup),
+                                CHIP_ERROR_INCORRECT_STATE);
+            VerifyOrReturnError(mSubjectCount < kMaxSubjects, CHIP_ERROR_NO_MEMORY);
+            mSubjects[mSubjectCount]       = subject;
+            mSubjectEntries[mSubjectCount] = entryIndex;
+            mSubjectCount++;
+        }
+    }
+    if (subjectCount == 0)
+    {
+        mAnySubject |= Bit(entryIndex);
+    }
+
+    size_t targetCount = 0;
+    ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+    for (size_t i = 0; i < targetCount; ++i)
+    {
+        VerifyOrReturnError(mTargetCount < kMaxTargets, CHIP_ERROR_NO_MEMORY);
+        ReturnErrorOnFailure(entry.GetTarget(i, mTargets[mTargetCount]));
+        mTargetEntries[mTargetCount] = entryIndex;
+        mTargetCount++;
+    }
+    if (targetCount == 0)
+    {
+        mAnyTarget |= Bit(entryIndex);
+    }
+
+    mEntryCount++;
+    return CHIP_NO_ERROR;
+}
+
+AccessControl::CompiledAcl::EntryMask AccessControl::CompiledAcl::MatchSubject(const SubjectDescriptor & subjectDescriptor,
+                                                                               Privilege requestPrivilege) const
+{
+    EntryMask candidates = 0;
+    for (uint8_t i = 0; i < mEntryCount; ++i)
+    {
+        if (mEntries[i].authMode == subjectDescriptor.authMode &&
+            CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, mEntries[i].privilege))
+        {
+            candidates |= Bit(i);
+        }
+    }
+    VerifyOrReturnValue(candidates != 0, 0);
+
+    EntryMask matched = mAnySubject;
+    for (uint16_t i = 0; i < mSubjectCount; ++i)
+    {
+        if (mSubjects[i] == subjectDescriptor.subject)
+        {
+            matched |= Bit(mSubjectEntries[i]);
+        }
+    }
+    for (uint16_t i = 0; i < mCatCount; ++i)
+    {
+        if (subjectDescriptor.cats.CheckSubjectAgainstCATs(mCats[i]))
+        {
+            matched |= Bit(mCatEntries[i]);
+        }
+    }
+
+    return candidates & matched;
+}
+
+bool AccessControl::CompiledAcl::MatchTarget(EntryMask candidates, const RequestPath & requestPath,
+                                             DeviceTypeResolver & deviceTypeResolver) const
+{
+    VerifyOrReturnValue((candidates & mAnyTarget) == 0, true);
+
+    for (uint16_t i = 0; i < mTargetCount; ++i)
+    {
+        const Entry::Target & target = mTargets[i];
+        if ((candidates & Bit(mTargetEntries[i])) == 0)
+        {
+            continue;
+        }
+        if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
+        {
+            continue;
+        }
+        if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
+        {
+            continue;
+        }
+        if (target.flags & Entry::Target::kDeviceType &&
+            !deviceTypeResolver.IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
+        {
+            continue;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+#endif // CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
+bool AccessControl::FindCachedDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                       Privilege requestPrivilege, bool & allowed) const
+{
+    VerifyOrReturnValue(mCachedDecisionCount > 0, false);
+    VerifyOrReturnValue(mCachedSubject.fabricIndex == subjectDescriptor.fabricIndex &&
+                            mCachedSubject.authMode == subjectDescriptor.authMode &&
+                            mCachedSubject.subject == subjectDescriptor.subject && mCachedSubject.cats == subjectDescriptor.cats,
+                        false);
+
+    for (uint8_t i = 0; i < mCachedDecisionCount; ++i)
+    {
+        const CachedDecision & decision = mCachedDecisions[i];
+        if (decision.cluster == requestPath.cluster && decision.endpoint == requestPath.endpoint &&
+            decision.privilege == requestPrivilege)
+        {
+            allowed = decision.allowed;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AccessControl::CacheDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                  Privilege requestPrivilege, bool allowed)
+{
+    if (mCachedSubject.fabricIndex != subjectDescriptor.fabricIndex || mCachedSubject.authMode != subjectDescriptor.authMode ||
+        mCachedSubject.subject != subjectDescriptor.subject || !(mCachedSubject.cats == subjectDescriptor.cats))
+    {
+        ClearDecisionCache();
+        mCachedSubject = subjectDescriptor;
+    }
+
+    mCachedDecisions[mNextCachedDecision] = { requestPath.cluster, requestPath.endpoint, requestPrivilege, allowed };
+    mNextCachedDecision = static_cast<uint8_t>((mNextCachedDecision + 1) % CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE);
+    if (mCachedDecisionCount < CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE)
+    {
+        mCachedDecisionCount++;
+    }
+}
+
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
+
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
 CHIP_ERROR AccessControl::CheckARL(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
                                    Privilege requestPrivilege)
@@ -703,6 +1010,8 @@ exit:
 void AccessControl::NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
                                        const Entry * entry, EntryListener::ChangeType changeType)
 {
+    InvalidateCompiledAcl(&fabric);
+
     for (EntryListener * listener = mEntryListener; listener != nullptr; listener = listener->mNext)
     {
         listener->OnEntryChanged(subjectDescriptor, fabric, index, entry, changeType);
@@ -328,6 +328,35 @@ public:
         friend class AccessControl;
     };
 
+    /**
+     * Remembers access control decisions for as long as it is alive, e.g. for the duration of one interaction.
+     *
+     * While at least one scope is alive, ACL decisions are cached per (subject descriptor, endpoint, cluster,
+     * privilege), so that e.g. a wildcard read evaluates the access control list once per cluster instead of
+     * once per attribute. Any change to the access control list drops the cached decisions. Scopes may nest.
+     */
+    class DecisionCacheScope
+    {
+    public:
+        explicit DecisionCacheScope(AccessControl & accessControl) : mAccessControl(accessControl)
+        {
+            mAccessControl.mDecisionCacheScopes++;
+        }
+        ~DecisionCacheScope()
+        {
+            if (--mAccessControl.mDecisionCacheScopes == 0)
+            {
+                mAccessControl.ClearDecisionCache();
+            }
+        }
+
+        DecisionCacheScope(const DecisionCacheScope &)             = delete;
+        DecisionCacheScope & operator=(const DecisionCacheScope &) = delete;
+
+    private:
+        AccessControl & mAccessControl;
+    };
+
     class Delegate
     {
     public:
@@ -503,6 +532,8 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        // The fabric of the created entry is an output, so drop the compiled ACL of all fabrics.
+        InvalidateCompiledAcl(nullptr);
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -553,6 +584,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCompiledAcl(fabricIndex);
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -574,6 +606,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCompiledAcl(fabricIndex);
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -687,6 +720,138 @@ private:
      */
     CHIP_ERROR CheckARL(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege);
 
+    /**
+     * Check the ACL by iterating the entries of the subject's fabric.
+     */
+    CHIP_ERROR CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                            bool & allowed);
+
+    /**
+     * Check the compiled ACL of the subject's fabric, compiling it first if needed.
+     *
+     * @retval #CHIP_ERROR_NOT_FOUND if the ACL of the fabric cannot be compiled, in which case
+     *         the entries have to be iterated.
+     */
+    CHIP_ERROR CheckCompiledACL(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                Privilege requestPrivilege, bool & allowed);
+
+    /**
+     * Drop the compiled ACL of the given fabric (of all fabrics if null) and all cached decisions.
+     */
+    void InvalidateCompiledAcl(const FabricIndex * fabricIndex);
+
+    void ClearDecisionCache();
+
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+    /**
+     * Pre-decoded copy of the access control entries of one fabric.
+     *
+     * Subjects, CATs and targets of all entries are kept in flat arrays, each element tagged with the index of its
+     * entry. Matching yields bitmaps of entries, so that a check is a few scans over plain data instead of going
+     * through the entry iterator and the virtual getters of every entry.
+     *
+     * Only access control lists that CheckACL would evaluate without error are compiled. If an entry is malformed,
+     * or the entries do not fit, the fabric is marked as not compilable and checks iterate the entries instead.
+     */
+    class CompiledAcl
+    {
+    public:
+        using EntryMask = uint32_t;
+
+        enum class State : uint8_t
+        {
+            kEmpty,
+            kCompiled,
+            kNotCompilable,
+        };
+
+        static constexpr size_t kMaxEntries = (CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC < 32)
+            ? CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
+            : 32;
+        static constexpr size_t kMaxSubjects = kMaxEntries * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_SUBJECTS_PER_ENTRY;
+        static constexpr size_t kMaxTargets  = kMaxEntries * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_TARGETS_PER_ENTRY;
+
+        void Clear()
+        {
+            mState       = State::kEmpty;
+            mFabricIndex = kUndefinedFabricIndex;
+        }
+
+        /**
+         * Compile the entries returned by the iterator (which must be confined to the fabric).
+         *
+         * On failure, the fabric is marked as not compilable.
+         */
+        CHIP_ERROR Compile(FabricIndex fabricIndex, EntryIterator & iterator);
+
+        /**
+         * Return the entries granting the privilege to the subject, ignoring targets.
+         */
+        EntryMask MatchSubject(const SubjectDescriptor & subjectDescriptor, Privilege requestPrivilege) const;
+
+        /**
+         * Return whether any of the candidate entries has no target or a target matching the request path.
+         */
+        bool MatchTarget(EntryMask candidates, const RequestPath & requestPath, DeviceTypeResolver & deviceTypeResolver) const;
+
+        State GetState() const { return mState; }
+        FabricIndex GetFabricIndex() const { return mFabricIndex; }
+
+    private:
+        static constexpr EntryMask Bit(uint8_t entryIndex) { return static_cast<EntryMask>(1u << entryIndex); }
+
+        CHIP_ERROR AddEntry(const Entry & entry);
+
+        struct CompiledEntry
+        {
+            AuthMode authMode;
+            Privilege privilege;
+        };
+
+        State mState             = State::kEmpty;
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        uint8_t mEntryCount      = 0;
+        uint8_t mSubjectCount    = 0;
+        uint8_t mCatCount        = 0;
+        uint8_t mTargetCount     = 0;
+        EntryMask mAnySubject    = 0; // Entries without subjects
+        EntryMask mAnyTarget     = 0; // Entries without targets
+        CompiledEntry mEntries[kMaxEntries];
+        NodeId mSubjects[kMaxSubjects]; // Operational node ids and group node ids
+        uint8_t mSubjectEntries[kMaxSubjects];
+        NodeId mCats[kMaxSubjects]; // CASE Authenticated Tag node ids
+        uint8_t mCatEntries[kMaxSubjects];
+        Entry::Target mTargets[kMaxTargets];
+        uint8_t mTargetEntries[kMaxTargets];
+    };
+
+    CompiledAcl mCompiledAcls[CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS];
+    uint8_t mNextCompiledAcl = 0;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS > 0
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    struct CachedDecision
+    {
+        ClusterId cluster;
+        EndpointId endpoint;
+        Privilege privilege;
+        bool allowed;
+    };
+
+    bool FindCachedDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                            Privilege requestPrivilege, bool & allowed) const;
+    void CacheDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                       bool allowed);
+
+    // All cached decisions are for this subject.
+    SubjectDescriptor mCachedSubject;
+    CachedDecision mCachedDecisions[CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE];
+    uint8_t mCachedDecisionCount = 0;
+    uint8_t mNextCachedDecision  = 0;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
+    uint16_t mDecisionCacheScopes = 0;
+
 private:
     Delegate * mDelegate = nullptr;
 
@@ -1760,6 +1760,62 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+TEST_F(TestAccessControl, TestCheckWithDecisionCache)
+{
+    LoadAccessControl(accessControl, entryData1, entryData1Count);
+    AccessControl::DecisionCacheScope scope(accessControl);
+    // The second pass is answered from the cached decisions (for the last subjects) and must agree with the first one.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (const auto & checkData : checkData1)
+        {
+            CHIP_ERROR expectedResult = checkData.allow ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+            auto requestPath          = checkData.requestPath;
+#if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
+            requestPath.requestType = Access::RequestType::kAttributeReadRequest;
+#endif
+            EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, requestPath, checkData.privilege), expectedResult);
+            EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, requestPath, checkData.privilege), expectedResult);
+        }
+    }
+}
+
+TEST_F(TestAccessControl, TestCheckAfterEntryChange)
+{
+    for (const auto & checkData : checkData1)
+    {
+        if (!checkData.allow || checkData.subjectDescriptor.authMode == AuthMode::kPase)
+        {
+            continue;
+        }
+
+        auto requestPath = checkData.requestPath;
+#if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
+        requestPath.requestType = Access::RequestType::kAttributeReadRequest;
+#endif
+        const FabricIndex fabricIndex = checkData.subjectDescriptor.fabricIndex;
+
+        ASSERT_EQ(ClearAccessControl(accessControl), CHIP_NO_ERROR);
+        ASSERT_EQ(LoadAccessControl(accessControl, entryData1, entryData1Count), CHIP_NO_ERROR);
+
+        AccessControl::DecisionCacheScope scope(accessControl);
+        EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, requestPath, checkData.privilege), CHIP_NO_ERROR);
+
+        // Entries removed with notification: neither the compiled ACL nor the cached decision may be used anymore.
+        EXPECT_EQ(accessControl.DeleteAllEntriesForFabric(fabricIndex), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, requestPath, checkData.privilege), CHIP_ERROR_ACCESS_DENIED);
+
+        // Entries added back without notification.
+        ASSERT_EQ(ClearAccessControl(accessControl), CHIP_NO_ERROR);
+        ASSERT_EQ(LoadAccessControl(accessControl, entryData1, entryData1Count), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, requestPath, checkData.privilege), CHIP_NO_ERROR);
+
+        // Entries removed without notification.
+        ASSERT_EQ(ClearAccessControl(accessControl), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, requestPath, checkData.privilege), CHIP_ERROR_ACCESS_DENIED);
+    }
+}
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -68,6 +68,17 @@ public:
         return *this;
     }
 
+    /// True once the encoder handed out the subject of the read (its descriptor or its
+    /// accessing fabric index), meaning that the encoded value may differ from one reader
+    /// to another.  Not cleared by Reset(), which only concerns list chunking.
+    bool DependsOnSubject() const { return mDependsOnSubject; }
+
+    AttributeEncodeState & SetDependsOnSubject(bool depends)
+    {
+        mDependsOnSubject = depends;
+        return *this;
+    }
+
     void Reset()
     {
         mCurrentEncodingListIndex = kInvalidListIndex;
@@ -97,6 +108,8 @@ private:
      * TODO: There might be a better name for this variable.
      */
     bool mAllowPartialData = false;
+
+    bool mDependsOnSubject = false;
 };
 
 } // namespace app
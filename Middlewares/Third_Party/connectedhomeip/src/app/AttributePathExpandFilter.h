@@ -0,0 +1,48 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/ConcreteClusterPath.h>
+#include <lib/core/DataModelTypes.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Restricts the expansion of wildcard paths done by an AttributePathExpandIterator.
+ *
+ * When a filter is set on an iterator, a wildcard path does not emit any path of an endpoint (resp. cluster) that the
+ * filter rejects: the whole endpoint (resp. cluster) is skipped without going through its clusters (resp. attributes).
+ * Concrete paths are always emitted as-is.
+ *
+ * The filter is consulted when the expansion enters an endpoint or a cluster, never for a cluster the iterator is
+ * already in, so a path that the filter would now reject may still be emitted after the filter state changes.
+ */
+class AttributePathExpandFilter
+{
+public:
+    virtual ~AttributePathExpandFilter() = default;
+
+    /// Returns false if no path of the given endpoint is of interest.
+    virtual bool IsEndpointWanted(EndpointId aEndpointId) = 0;
+
+    /// Returns false if no path of the given cluster instance is of interest.
+    virtual bool IsClusterWanted(const ConcreteClusterPath & aClusterPath) = 0;
+};
+
+} // namespace app
+} // namespace chip
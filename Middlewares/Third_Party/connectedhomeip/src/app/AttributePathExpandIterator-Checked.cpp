@@ -62,6 +62,12 @@ void AttributePathExpandIteratorChecked::ResetTo(SingleLinkedListNode<AttributeP
     CheckOutputsIdentical("ResetTo");
 }
 
+void AttributePathExpandIteratorChecked::SetFilter(AttributePathExpandFilter * filter)
+{
+    mDataModelIterator.SetFilter(filter);
+    mEmberIterator.SetFilter(filter);
+}
+
 void AttributePathExpandIteratorChecked::CheckOutputsIdentical(const char * msg)
 {
     ConcreteAttributePath dmPath;
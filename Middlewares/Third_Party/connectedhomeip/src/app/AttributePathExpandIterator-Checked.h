@@ -32,6 +32,7 @@ public:
     bool Get(ConcreteAttributePath & aPath);
     void ResetCurrentCluster();
     void ResetTo(SingleLinkedListNode<AttributePathParams> * paths);
+    void SetFilter(AttributePathExpandFilter * filter);
 
 private:
     AttributePathExpandIteratorDataModel mDataModelIterator;
@@ -24,9 +24,9 @@ namespace chip {
 namespace app {
 
 AttributePathExpandIteratorDataModel::AttributePathExpandIteratorDataModel(
-    DataModel::Provider * provider, SingleLinkedListNode<AttributePathParams> * attributePath) :
+    DataModel::Provider * provider, SingleLinkedListNode<AttributePathParams> * attributePath, AttributePathExpandFilter * filter) :
     mDataModelProvider(provider),
-    mpAttributePath(attributePath), mOutputPath(kInvalidEndpointId, kInvalidClusterId, kInvalidAttributeId)
+    mpAttributePath(attributePath), mpFilter(filter), mOutputPath(kInvalidEndpointId, kInvalidClusterId, kInvalidAttributeId)
 
 {
     mOutputPath.mExpanded = true; // this is reset in 'next' if needed
@@ -198,6 +198,12 @@ bool AttributePathExpandIteratorDataModel::AdvanceOutputPath()
         if (mOutputPath.mEndpointId != kInvalidEndpointId)
         {
             std::optional<ClusterId> nextCluster = NextClusterId();
+            while (nextCluster.has_value() && !IsClusterWanted(*nextCluster))
+            {
+                // skip the whole cluster, NextClusterId continues after mOutputPath.mClusterId
+                mOutputPath.mClusterId = *nextCluster;
+                nextCluster            = NextClusterId();
+            }
             if (nextCluster.has_value())
             {
                 mOutputPath.mClusterId   = *nextCluster;
@@ -208,6 +214,12 @@ bool AttributePathExpandIteratorDataModel::AdvanceOutputPath()
 
         // no valid cluster, try advance the endpoint, see if a suitable on exists
         std::optional<EndpointId> nextEndpoint = NextEndpointId();
+        while (nextEndpoint.has_value() && !IsEndpointWanted(*nextEndpoint))
+        {
+            // skip the whole endpoint, NextEndpointId continues after mOutputPath.mEndpointId
+            mOutputPath.mEndpointId = *nextEndpoint;
+            nextEndpoint            = NextEndpointId();
+        }
         if (nextEndpoint.has_value())
         {
             mOutputPath.mEndpointId = *nextEndpoint;
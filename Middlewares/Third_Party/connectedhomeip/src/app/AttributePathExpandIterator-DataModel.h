@@ -16,6 +16,7 @@
  */
 #pragma once
 
+#include <app/AttributePathExpandFilter.h>
 #include <app/AttributePathParams.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/data-model-provider/Provider.h>
@@ -53,7 +54,8 @@ namespace app {
 class AttributePathExpandIteratorDataModel
 {
 public:
-    AttributePathExpandIteratorDataModel(DataModel::Provider * provider, SingleLinkedListNode<AttributePathParams> * attributePath);
+    AttributePathExpandIteratorDataModel(DataModel::Provider * provider, SingleLinkedListNode<AttributePathParams> * attributePath,
+                                         AttributePathExpandFilter * filter = nullptr);
 
     /**
      * Proceed the iterator to the next attribute path in the given cluster info.
@@ -81,15 +83,23 @@ public:
      */
     void ResetCurrentCluster();
 
+    /**
+     * Skip the endpoints and clusters rejected by the given filter when expanding wildcard paths, starting with the next call
+     * to Next().  The filter is kept by ResetTo(), and must outlive its use by the iterator; pass nullptr to expand paths in full
+     * again.
+     */
+    void SetFilter(AttributePathExpandFilter * filter) { mpFilter = filter; }
+
     /** Start iterating over the given `paths` */
     inline void ResetTo(SingleLinkedListNode<AttributePathParams> * paths)
     {
-        *this = AttributePathExpandIteratorDataModel(mDataModelProvider, paths);
+        *this = AttributePathExpandIteratorDataModel(mDataModelProvider, paths, mpFilter);
     }
 
 private:
     DataModel::Provider * mDataModelProvider;
     SingleLinkedListNode<AttributePathParams> * mpAttributePath;
+    AttributePathExpandFilter * mpFilter;
     ConcreteAttributePath mOutputPath;
 
     /// Move to the next endpoint/cluster/attribute triplet that is valid given
@@ -122,6 +132,13 @@ private:
     ///
     /// Meaning that it is known to the data model OR it is a always-there global attribute.
     bool IsValidAttributeId(AttributeId attributeId);
+
+    /// Checks that the filter, if any, does not reject the given endpoint (resp. cluster of mOutputPath(endpoint))
+    bool IsEndpointWanted(EndpointId endpointId) { return (mpFilter == nullptr) || mpFilter->IsEndpointWanted(endpointId); }
+    bool IsClusterWanted(ClusterId clusterId)
+    {
+        return (mpFilter == nullptr) || mpFilter->IsClusterWanted(ConcreteClusterPath(mOutputPath.mEndpointId, clusterId));
+    }
 };
 
 } // namespace app
@@ -54,8 +54,10 @@ namespace chip {
 namespace app {
 
 AttributePathExpandIteratorEmber::AttributePathExpandIteratorEmber(DataModel::Provider *,
-                                                                   SingleLinkedListNode<AttributePathParams> * aAttributePath) :
-    mpAttributePath(aAttributePath)
+                                                                   SingleLinkedListNode<AttributePathParams> * aAttributePath,
+                                                                   AttributePathExpandFilter * aFilter) :
+    mpAttributePath(aAttributePath),
+    mpFilter(aFilter)
 {
 
     // Reset iterator state
@@ -209,6 +211,11 @@ bool AttributePathExpandIteratorEmber::Next()
 
             if (mClusterIndex == UINT8_MAX)
             {
+                if (mpFilter != nullptr && !mpFilter->IsEndpointWanted(endpointId))
+                {
+                    // Nothing of interest on this endpoint; skip it.
+                    continue;
+                }
                 PrepareClusterIndexRange(mpAttributePath->mValue, endpointId);
                 mAttributeIndex       = UINT16_MAX;
                 mGlobalAttributeIndex = UINT8_MAX;
@@ -222,6 +229,11 @@ bool AttributePathExpandIteratorEmber::Next()
                 ClusterId clusterId = emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
                 if (mAttributeIndex == UINT16_MAX && mGlobalAttributeIndex == UINT8_MAX)
                 {
+                    if (mpFilter != nullptr && !mpFilter->IsClusterWanted(ConcreteClusterPath(endpointId, clusterId)))
+                    {
+                        // Nothing of interest in this cluster; skip it.
+                        continue;
+                    }
                     PrepareAttributeIndexRange(mpAttributePath->mValue, endpointId, clusterId);
                 }
 
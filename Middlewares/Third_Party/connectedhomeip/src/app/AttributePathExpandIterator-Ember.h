@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <app/AttributePathExpandFilter.h>
 #include <app/AttributePathParams.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
@@ -71,7 +72,8 @@ class AttributePathExpandIteratorEmber
 {
 public:
     AttributePathExpandIteratorEmber(DataModel::Provider *, // datamodel is NOT used by this class
-                                     SingleLinkedListNode<AttributePathParams> * aAttributePath);
+                                     SingleLinkedListNode<AttributePathParams> * aAttributePath,
+                                     AttributePathExpandFilter * aFilter = nullptr);
 
     /**
      * Proceed the iterator to the next attribute path in the given cluster info.
@@ -99,14 +101,22 @@ public:
      */
     void ResetCurrentCluster();
 
+    /**
+     * Skip the endpoints and clusters rejected by the given filter when expanding wildcard paths, starting with the next call
+     * to Next().  The filter is kept by ResetTo(), and must outlive its use by the iterator; pass nullptr to expand paths in full
+     * again.
+     */
+    void SetFilter(AttributePathExpandFilter * filter) { mpFilter = filter; }
+
     /** Start iterating over the given `paths` */
     inline void ResetTo(SingleLinkedListNode<AttributePathParams> * paths)
     {
-        *this = AttributePathExpandIteratorEmber(nullptr /* data model is not used */, paths);
+        *this = AttributePathExpandIteratorEmber(nullptr /* data model is not used */, paths, mpFilter);
     }
 
 private:
     SingleLinkedListNode<AttributePathParams> * mpAttributePath;
+    AttributePathExpandFilter * mpFilter;
 
     ConcreteAttributePath mOutputPath;
 
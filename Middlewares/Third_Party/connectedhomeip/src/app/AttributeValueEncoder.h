@@ -147,12 +147,20 @@ public:
 
     bool TriedEncode() const { return mTriedEncode; }
 
-    const Access::SubjectDescriptor & GetSubjectDescriptor() const { return mSubjectDescriptor; }
+    /**
+     * The subject of this read or subscribe interaction.  Asking for it (or for the accessing fabric index) marks the encoded
+     * value as specific to that subject, so that it is not shared with other readers.
+     */
+    const Access::SubjectDescriptor & GetSubjectDescriptor()
+    {
+        mEncodeState.SetDependsOnSubject(true);
+        return mSubjectDescriptor;
+    }
 
     /**
      * The accessing fabric index for this read or subscribe interaction.
      */
-    FabricIndex AccessingFabricIndex() const { return GetSubjectDescriptor().fabricIndex; }
+    FabricIndex AccessingFabricIndex() { return GetSubjectDescriptor().fabricIndex; }
 
     /**
      * AttributeValueEncoder is a short lived object, and the state is persisted by mEncodeState and restored by constructor.
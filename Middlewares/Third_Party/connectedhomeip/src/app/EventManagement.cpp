@@ -19,6 +19,7 @@
 #include <access/AccessControl.h>
 #include <access/RequestPath.h>
 #include <access/SubjectDescriptor.h>
+#include <algorithm>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
@@ -27,6 +28,7 @@
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <string.h>
 
 using namespace chip::TLV;
 
@@ -66,6 +68,7 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    EventNumber mEventNumber            = 0;
 };
 
 /**
@@ -126,7 +129,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mMonotonicStartupTime = aMonotonicStartupTime;
 }
 
-CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
+CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer, EventNumber aEventNumber)
 {
     CircularTLVWriter writer;
     CircularTLVReader reader;
@@ -154,6 +157,7 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
 
     err = writer.Finalize();
     SuccessOrExit(err);
+    nextBuffer->RecordEvent(aEventNumber, writer.GetLengthWritten());
 
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
 exit:
@@ -217,7 +221,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    err = CopyToNextBuffer(eventBuffer, ctx.mEventNumber);
                     SuccessOrExit(err);
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
@@ -264,28 +268,6 @@ exit:
     return err;
 }
 
-CHIP_ERROR EventManagement::CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions,
-                                               uint32_t & requiredSize)
-{
-    System::PacketBufferTLVWriter writer;
-    EventLoadOutContext ctxt       = EventLoadOutContext(writer, apOptions->mPriority, GetLastEventNumber());
-    System::PacketBufferHandle buf = System::PacketBufferHandle::New(kMaxEventSizeReserve);
-    if (buf.IsNull())
-    {
-        return CHIP_ERROR_NO_MEMORY;
-    }
-    writer.Init(std::move(buf));
-
-    ctxt.mCurrentEventNumber = mLastEventNumber;
-    ctxt.mCurrentTime        = mLastEventTimestamp;
-    CHIP_ERROR err           = ConstructEvent(&ctxt, apDelegate, apOptions);
-    if (err == CHIP_NO_ERROR)
-    {
-        requiredSize = writer.GetLengthWritten();
-    }
-    return err;
-}
-
 CHIP_ERROR EventManagement::ConstructEvent(EventLoadOutContext * apContext, EventLoggingDelegate * apDelegate,
                                            const EventOptions * apOptions)
 {
@@ -423,10 +405,11 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
 {
     CircularTLVWriter writer;
     CHIP_ERROR err               = CHIP_NO_ERROR;
-    uint32_t requestSize         = 0;
     aEventNumber                 = 0;
     CircularTLVWriter checkpoint = writer;
-    EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
+    TLVWriter stagingWriter;
+    EventLoadOutContext ctxt       = EventLoadOutContext(stagingWriter, aEventOptions.mPriority, mLastEventNumber);
+    System::PacketBufferHandle buf = System::PacketBufferHandle::New(kMaxEventSizeReserve);
     EventOptions opts;
 
     Timestamp timestamp;
@@ -458,16 +441,24 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     ctxt.mCurrentEventNumber = mLastEventNumber;
     ctxt.mCurrentTime.mValue = mLastEventTimestamp.mValue;
 
-    err = CalculateEventSize(apDelegate, &opts, requestSize);
+    // The event is encoded once, in a staging buffer: its size tells how much room to make in the in-memory logging
+    // queues, and the encoded event is then copied as-is into the circular buffer.
+    VerifyOrExit(!buf.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+    stagingWriter.Init(buf->Start(), std::min(buf->AvailableDataLength(), kMaxEventSizeReserve));
+
+    err = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
     // Ensure we have space in the in-memory logging queues
-    err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
+    err = EnsureSpaceInCircularBuffer(stagingWriter.GetLengthWritten(), aEventOptions.mPriority);
     SuccessOrExit(err);
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    err = writer.CopyContainer(AnonymousTag(), buf->Start(), static_cast<uint16_t>(stagingWriter.GetLengthWritten()));
+    SuccessOrExit(err);
+    err = writer.Finalize();
     SuccessOrExit(err);
 
+    mpEventBuffer->RecordEvent(mLastEventNumber, writer.GetLengthWritten());
     mBytesWritten += writer.GetLengthWritten();
 
 exit:
@@ -657,7 +648,7 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLi
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+    err                            = GetEventReaderSince(reader, aEventMin, &bufWrapper);
     SuccessOrExit(err);
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
@@ -753,6 +744,42 @@ CHIP_ERROR EventManagement::GetEventReader(TLVReader & aReader, PriorityLevel aP
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR EventManagement::GetEventReaderSince(TLVReader & aReader, EventNumber aEventMin,
+                                                CircularEventBufferWrapper * apBufWrapper)
+{
+    CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical);
+    VerifyOrReturnError(buffer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Event numbers only grow from one buffer to the previous one: skip the buffers holding older events only, but always
+    // go through the last non-empty buffer so that the caller still reads the most recent event.
+    CircularEventBuffer * lastNonEmpty = buffer;
+    for (auto * current = buffer; current != nullptr; current = current->GetPreviousCircularEventBuffer())
+    {
+        if (current->DataLength() != 0)
+        {
+            lastNonEmpty = current;
+        }
+    }
+
+    size_t skippedBytes = 0;
+    while (buffer != lastNonEmpty && (buffer->DataLength() == 0 || buffer->GetLastEventNumber() < aEventMin))
+    {
+        skippedBytes += buffer->DataLength();
+        buffer = buffer->GetPreviousCircularEventBuffer();
+    }
+
+    size_t skippedInBuffer    = 0;
+    apBufWrapper->mpCurrent   = buffer;
+    apBufWrapper->mpReadStart = buffer->FindEventsSince(aEventMin, skippedInBuffer);
+    mSkippedEventBytes += skippedBytes + skippedInBuffer;
+
+    CircularEventReader reader;
+    reader.Init(apBufWrapper);
+    aReader.Init(reader);
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR EventManagement::FetchEventParameters(const TLVReader & aReader, size_t, void * apContext)
 {
     EventEnvelopeContext * const envelope = static_cast<EventEnvelopeContext *>(apContext);
@@ -846,6 +873,7 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     // event is not getting dropped. Note how much space it requires, and return.
     ctx->mSpaceNeededForMovedEvent = aReader.GetLengthRead();
+    ctx->mEventNumber              = context.mEventNumber;
     return CHIP_END_OF_TLV;
 }
 
@@ -865,9 +893,70 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
                                CircularEventBuffer * apNext, PriorityLevel aPriorityLevel)
 {
     TLVCircularBuffer::Init(apBuffer, aBufferLength);
-    mpPrev    = apPrev;
-    mpNext    = apNext;
-    mPriority = aPriorityLevel;
+    mpPrev           = apPrev;
+    mpNext           = apNext;
+    mPriority        = aPriorityLevel;
+    mIndexCount      = 0;
+    mBytesWritten    = 0;
+    mLastEventNumber = 0;
+}
+
+void CircularEventBuffer::RecordEvent(EventNumber aEventNumber, uint32_t aLength)
+{
+    const uint64_t position = mBytesWritten;
+    mBytesWritten += aLength;
+    mLastEventNumber = aEventNumber;
+    DropEvictedIndexEntries();
+
+    // Keep the indexed events at least 1/CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES of the buffer apart, so that the entries
+    // cover the whole buffer.
+    const uint64_t spacing = GetTotalDataLength() / CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES;
+    if (mIndexCount != 0 && position - mIndex[mIndexCount - 1].mPosition < spacing)
+    {
+        return;
+    }
+
+    if (mIndexCount == CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES)
+    {
+        memmove(&mIndex[0], &mIndex[1], sizeof(mIndex[0]) * (mIndexCount - 1));
+        mIndexCount--;
+    }
+    mIndex[mIndexCount].mEventNumber = aEventNumber;
+    mIndex[mIndexCount].mPosition    = position;
+    mIndexCount++;
+}
+
+void CircularEventBuffer::DropEvictedIndexEntries()
+{
+    const uint64_t evicted = mBytesWritten - DataLength();
+    size_t dropped         = 0;
+    while (dropped < mIndexCount && mIndex[dropped].mPosition < evicted)
+    {
+        dropped++;
+    }
+    if (dropped != 0)
+    {
+        memmove(&mIndex[0], &mIndex[dropped], sizeof(mIndex[0]) * (mIndexCount - dropped));
+        mIndexCount -= dropped;
+    }
+}
+
+const uint8_t * CircularEventBuffer::FindEventsSince(EventNumber aEventNumber, size_t & aSkippedBytes)
+{
+    aSkippedBytes = 0;
+    DropEvictedIndexEntries();
+
+    // Events that are not vended a number of their own share it with the next event: only the events before an event
+    // numbered strictly below aEventNumber can be skipped.
+    const IndexEntry * start = nullptr;
+    for (size_t i = 0; i < mIndexCount && mIndex[i].mEventNumber < aEventNumber; i++)
+    {
+        start = &mIndex[i];
+    }
+    VerifyOrReturnValue(start != nullptr, nullptr);
+
+    aSkippedBytes = static_cast<size_t>(start->mPosition - (mBytesWritten - DataLength()));
+    return GetQueue() + (start->mPosition % GetTotalDataLength());
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -910,6 +999,20 @@ CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const
     mpCurrent->GetNextBuffer(aReader, aBufStart, aBufLen);
     SuccessOrExit(err);
 
+    if (mpReadStart != nullptr)
+    {
+        // The first event to read is either in the data up to the end of the storage, or in the data wrapped around to
+        // its start.
+        if (mpReadStart < aBufStart || mpReadStart >= aBufStart + aBufLen)
+        {
+            aBufStart = mpCurrent->GetQueue() + mpCurrent->GetTotalDataLength();
+            mpCurrent->GetNextBuffer(aReader, aBufStart, aBufLen);
+        }
+        aBufLen -= static_cast<uint32_t>(mpReadStart - aBufStart);
+        aBufStart   = mpReadStart;
+        mpReadStart = nullptr;
+    }
+
     if ((aBufLen == 0) && (mpCurrent->GetPreviousCircularEventBuffer() != nullptr))
     {
         mpCurrent = mpCurrent->GetPreviousCircularEventBuffer();
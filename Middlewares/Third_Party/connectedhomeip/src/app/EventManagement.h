@@ -129,9 +129,44 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   Record that an event of aLength bytes was appended to the buffer.  Every event written to the buffer must be
+     *   recorded for the index to stay accurate.
+     */
+    void RecordEvent(EventNumber aEventNumber, uint32_t aLength);
+
+    /// Event number of the most recent event in the buffer, only meaningful when the buffer is not empty.
+    EventNumber GetLastEventNumber() const { return mLastEventNumber; }
+
+    /**
+     * @brief
+     *   Find where to start reading the buffer to go through all of its events numbered aEventNumber or more.
+     *
+     * @param[in]  aEventNumber   The first event number of interest.
+     * @param[out] aSkippedBytes  Set to the number of bytes before the returned read point.
+     *
+     * @return A read point within the buffer storage, or nullptr to read from the head of the buffer.
+     */
+    const uint8_t * FindEventsSince(EventNumber aEventNumber, size_t & aSkippedBytes);
+
     ~CircularEventBuffer() override = default;
 
 private:
+    struct IndexEntry
+    {
+        EventNumber mEventNumber = 0;
+        uint64_t mPosition       = 0; ///< Number of bytes written to the buffer before the event
+    };
+
+    /// Drop the index entries of events that were evicted from the buffer.
+    void DropEvictedIndexEntries();
+
+    IndexEntry mIndex[CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES]; ///< Oldest entry first
+    size_t mIndexCount           = 0;
+    uint64_t mBytesWritten       = 0; ///< Since Init, including the DataLength() bytes still in the buffer
+    EventNumber mLastEventNumber = 0;
+
     CircularEventBuffer * mpPrev = nullptr; ///< A pointer CircularEventBuffer storing events less important events
     CircularEventBuffer * mpNext = nullptr; ///< A pointer CircularEventBuffer storing events more important events
 
@@ -156,6 +191,7 @@ class CircularEventBufferWrapper : public TLV::TLVCircularBuffer
 public:
     CircularEventBufferWrapper() : TLVCircularBuffer(nullptr, 0), mpCurrent(nullptr){};
     CircularEventBuffer * mpCurrent;
+    const uint8_t * mpReadStart = nullptr; ///< Where to start reading mpCurrent, nullptr to read it from its head
 
 private:
     CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
@@ -377,6 +413,12 @@ public:
      */
     EventNumber GetLastEventNumber() const { return mLastEventNumber; }
 
+    /**
+     * @brief
+     *   Number of bytes of events that fetching events did not have to read, thanks to the event index of the buffers.
+     */
+    uint64_t GetSkippedEventBytes() const { return mSkippedEventBytes; }
+
     /**
      * @brief
      *   IsValid returns whether the EventManagement instance is valid
@@ -417,7 +459,6 @@ private:
     };
 
     void VendEventNumber();
-    CHIP_ERROR CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, uint32_t & requiredSize);
     /**
      * @brief Helper function for writing event header and data according to event
      *   logging protocol.
@@ -441,9 +482,10 @@ private:
      * @brief copy the event outright to next buffer with higher priority
      *
      * @param[in] apEventBuffer  CircularEventBuffer
+     * @param[in] aEventNumber   The number of the event at the head of apEventBuffer
      *
      */
-    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer);
+    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer, EventNumber aEventNumber);
 
     /**
      * @brief Ensure that:
@@ -550,6 +592,13 @@ private:
      */
     CircularEventBuffer * GetPriorityBuffer(PriorityLevel aPriority) const;
 
+    /**
+     * @brief
+     *   Like GetEventReader for the Critical priority, but the reader skips the events that are known to be numbered
+     *   below aEventMin. The most recent event is always read.
+     */
+    CHIP_ERROR GetEventReaderSince(TLV::TLVReader & aReader, EventNumber aEventMin, CircularEventBufferWrapper * apBufWrapper);
+
     // EventBuffer for debug level,
     CircularEventBuffer * mpEventBuffer        = nullptr;
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
@@ -563,6 +612,8 @@ private:
     Timestamp mLastEventTimestamp;    ///< The timestamp of the last event in this buffer
 
     System::Clock::Milliseconds64 mMonotonicStartupTime;
+
+    uint64_t mSkippedEventBytes = 0; ///< Bytes of events the event index saved reading
 };
 
 } // namespace app
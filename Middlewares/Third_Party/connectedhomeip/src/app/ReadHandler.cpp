@@ -133,6 +133,8 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
     // Notify the observer that a subscription has been resumed
     mObserver->OnSubscriptionEstablished(this);
 
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RegisterInterestPaths(*this);
+
     MoveToState(HandlerState::CanStartReporting);
 
     SingleLinkedListNode<AttributePathParams> * attributePath = mpAttributePathList;
@@ -159,6 +161,7 @@ ReadHandler::~ReadHandler()
     {
         mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
     }
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().UnregisterInterestPaths(*this);
     mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
@@ -510,6 +513,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     if (CHIP_END_OF_TLV == err)
     {
         mManagementCallback.GetInteractionModelEngine()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
+        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RegisterInterestPaths(*this);
         mAttributePathExpandIterator.ResetTo(mpAttributePathList);
         err = CHIP_NO_ERROR;
     }
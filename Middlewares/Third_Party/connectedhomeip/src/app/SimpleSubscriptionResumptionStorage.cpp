@@ -67,12 +67,17 @@ bool SimpleSubscriptionResumptionStorage::SimpleSubscriptionInfoIterator::Next(S
         CHIP_ERROR err = mStorage.Load(mNextIndex, output);
         if (err == CHIP_NO_ERROR)
         {
+            mStorage.SetSlotIndexEntry(mNextIndex, output);
             // increment index for the next call
             mNextIndex++;
             return true;
         }
 
-        if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            mStorage.ClearSlotIndexEntry(mNextIndex);
+        }
+        else
         {
             ChipLogError(DataManagement, "Failed to load subscription at index %u error %" CHIP_ERROR_FORMAT,
                          static_cast<unsigned>(mNextIndex), err.Format());
@@ -112,9 +117,87 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Init(PersistentStorageDelegate *
     ReturnErrorOnFailure(mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionMaxCount().KeyName(),
                                                    &countMaxToSave, sizeof(uint16_t)));
 
+    // Build the slot index: this is the only time every slot is read
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        SlotIndexEntry & entry = mSlotIndex[subscriptionIndex];
+        err                    = LoadSlotIndexEntry(subscriptionIndex, entry);
+        if (err == CHIP_NO_ERROR)
+        {
+            entry.mState = SlotState::kValid;
+        }
+        else
+        {
+            entry        = SlotIndexEntry();
+            entry.mState = (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) ? SlotState::kEmpty : SlotState::kUnreadable;
+        }
+    }
+
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR SimpleSubscriptionResumptionStorage::LoadSlotIndexEntry(uint16_t subscriptionIndex, SlotIndexEntry & entry)
+{
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxSubscriptionSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+
+    uint16_t len = static_cast<uint16_t>(MaxSubscriptionSize());
+    ReturnErrorOnFailure(mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName(),
+                                                   backingBuffer.Get(), len));
+
+    TLV::ScopedBufferTLVReader reader(std::move(backingBuffer), len);
+
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+
+    TLV::TLVType subscriptionContainerType;
+    ReturnErrorOnFailure(reader.EnterContainer(subscriptionContainerType));
+
+    // Only the identity at the start of the structure is decoded, the paths are left alone
+    ReturnErrorOnFailure(reader.Next(kPeerNodeIdTag));
+    ReturnErrorOnFailure(reader.Get(entry.mNodeId));
+
+    ReturnErrorOnFailure(reader.Next(kFabricIndexTag));
+    ReturnErrorOnFailure(reader.Get(entry.mFabricIndex));
+
+    ReturnErrorOnFailure(reader.Next(kSubscriptionIdTag));
+    ReturnErrorOnFailure(reader.Get(entry.mSubscriptionId));
+
+    return CHIP_NO_ERROR;
+}
+
+void SimpleSubscriptionResumptionStorage::SetSlotIndexEntry(uint16_t subscriptionIndex, const SubscriptionInfo & subscriptionInfo)
+{
+    VerifyOrReturn(subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+
+    SlotIndexEntry & entry = mSlotIndex[subscriptionIndex];
+    entry.mNodeId          = subscriptionInfo.mNodeId;
+    entry.mFabricIndex     = subscriptionInfo.mFabricIndex;
+    entry.mSubscriptionId  = subscriptionInfo.mSubscriptionId;
+    entry.mState           = SlotState::kValid;
+}
+
+void SimpleSubscriptionResumptionStorage::ClearSlotIndexEntry(uint16_t subscriptionIndex)
+{
+    VerifyOrReturn(subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+
+    mSlotIndex[subscriptionIndex] = SlotIndexEntry();
+}
+
+uint16_t SimpleSubscriptionResumptionStorage::ValidSlotCount() const
+{
+    uint16_t count = 0;
+    for (const auto & entry : mSlotIndex)
+    {
+        if (entry.mState == SlotState::kValid)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
 SubscriptionResumptionStorage::SubscriptionInfoIterator * SimpleSubscriptionResumptionStorage::IterateSubscriptions()
 {
     return mSubscriptionInfoIterators.CreateObject(*this);
@@ -136,7 +219,13 @@ uint16_t SimpleSubscriptionResumptionStorage::Count()
 
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Delete(uint16_t subscriptionIndex)
 {
-    return mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName());
+    CHIP_ERROR err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName());
+    if ((err == CHIP_NO_ERROR) || (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
+    {
+        ClearSlotIndexEntry(subscriptionIndex);
+    }
+
+    return err;
 }
 
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Load(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo)
@@ -331,34 +420,23 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(TLV::TLVWriter & writer, Su
 
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(SubscriptionInfo & subscriptionInfo)
 {
-    // Find empty index or duplicate if exists
+    // Overwrite the slot of the same subscription if it exists, otherwise use the first empty one
     uint16_t subscriptionIndex;
     uint16_t firstEmptySubscriptionIndex = CHIP_IM_MAX_NUM_SUBSCRIPTIONS; // initialize to out of bounds as "not set"
     for (subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
     {
-        SubscriptionInfo currentSubscriptionInfo;
-        CHIP_ERROR err = Load(subscriptionIndex, currentSubscriptionInfo);
+        const SlotIndexEntry & entry = mSlotIndex[subscriptionIndex];
 
-        // if empty and firstEmptySubscriptionIndex isn't set yet, then mark empty spot
-        if ((firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS) && (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
+        if ((entry.mState == SlotState::kValid) && (subscriptionInfo.mNodeId == entry.mNodeId) &&
+            (subscriptionInfo.mFabricIndex == entry.mFabricIndex) && (subscriptionInfo.mSubscriptionId == entry.mSubscriptionId))
         {
             firstEmptySubscriptionIndex = subscriptionIndex;
+            break;
         }
 
-        // delete duplicate
-        if (err == CHIP_NO_ERROR)
+        if ((firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS) && (entry.mState == SlotState::kEmpty))
         {
-            if ((subscriptionInfo.mNodeId == currentSubscriptionInfo.mNodeId) &&
-                (subscriptionInfo.mFabricIndex == currentSubscriptionInfo.mFabricIndex) &&
-                (subscriptionInfo.mSubscriptionId == currentSubscriptionInfo.mSubscriptionId))
-            {
-                Delete(subscriptionIndex);
-                // if duplicate is the first empty spot, then also set it
-                if (firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS)
-                {
-                    firstEmptySubscriptionIndex = subscriptionIndex;
-                }
-            }
+            firstEmptySubscriptionIndex = subscriptionIndex;
         }
     }
 
@@ -385,6 +463,7 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(SubscriptionInfo & subscrip
     ReturnErrorOnFailure(
         mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(firstEmptySubscriptionIndex).KeyName(),
                                   backingBuffer.Get(), static_cast<uint16_t>(len)));
+    SetSlotIndexEntry(firstEmptySubscriptionIndex, subscriptionInfo);
 
     return CHIP_NO_ERROR;
 }
@@ -394,34 +473,25 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Delete(NodeId nodeId, FabricInde
     bool subscriptionFound   = false;
     CHIP_ERROR lastDeleteErr = CHIP_NO_ERROR;
 
-    uint16_t remainingSubscriptionsCount = 0;
     for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
     {
-        SubscriptionInfo subscriptionInfo;
-        CHIP_ERROR err = Load(subscriptionIndex, subscriptionInfo);
+        const SlotIndexEntry & entry = mSlotIndex[subscriptionIndex];
 
         // delete match
-        if (err == CHIP_NO_ERROR)
+        if ((entry.mState == SlotState::kValid) && (nodeId == entry.mNodeId) && (fabricIndex == entry.mFabricIndex) &&
+            (subscriptionId == entry.mSubscriptionId))
         {
-            if ((nodeId == subscriptionInfo.mNodeId) && (fabricIndex == subscriptionInfo.mFabricIndex) &&
-                (subscriptionId == subscriptionInfo.mSubscriptionId))
-            {
-                subscriptionFound    = true;
-                CHIP_ERROR deleteErr = Delete(subscriptionIndex);
-                if (deleteErr != CHIP_NO_ERROR)
-                {
-                    lastDeleteErr = deleteErr;
-                }
-            }
-            else
+            subscriptionFound    = true;
+            CHIP_ERROR deleteErr = Delete(subscriptionIndex);
+            if (deleteErr != CHIP_NO_ERROR)
             {
-                remainingSubscriptionsCount++;
+                lastDeleteErr = deleteErr;
             }
         }
     }
 
     // if there are no persisted subscriptions, the MaxCount can also be deleted
-    if (remainingSubscriptionsCount == 0)
+    if (ValidSlotCount() == 0)
     {
         DeleteMaxCount();
     }
@@ -443,31 +513,22 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::DeleteAll(FabricIndex fabricInde
 {
     CHIP_ERROR deleteErr = CHIP_NO_ERROR;
 
-    uint16_t count = 0;
     for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
     {
-        SubscriptionInfo subscriptionInfo;
-        CHIP_ERROR err = Load(subscriptionIndex, subscriptionInfo);
+        const SlotIndexEntry & entry = mSlotIndex[subscriptionIndex];
 
-        if (err == CHIP_NO_ERROR)
+        if ((entry.mState == SlotState::kValid) && (fabricIndex == entry.mFabricIndex))
         {
-            if (fabricIndex == subscriptionInfo.mFabricIndex)
-            {
-                err = Delete(subscriptionIndex);
-                if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
-                {
-                    deleteErr = err;
-                }
-            }
-            else
+            CHIP_ERROR err = Delete(subscriptionIndex);
+            if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
             {
-                count++;
+                deleteErr = err;
             }
         }
     }
 
     // if there are no persisted subscriptions, the MaxCount can also be deleted
-    if (count == 0)
+    if (ValidSlotCount() == 0)
     {
         CHIP_ERROR err = DeleteMaxCount();
 
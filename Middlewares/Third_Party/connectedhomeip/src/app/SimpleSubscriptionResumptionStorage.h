@@ -57,6 +57,28 @@ protected:
     uint16_t Count();
     CHIP_ERROR DeleteMaxCount();
 
+    // In-RAM copy of the identity of the subscription persisted in each slot. It is read once by Init() and kept up to date by
+    // Save() and Delete(), so that they find the slot to write or to delete without loading every subscription from storage.
+    enum class SlotState : uint8_t
+    {
+        kEmpty,
+        kValid,
+        kUnreadable, // present in storage, but its identity could not be decoded
+    };
+
+    struct SlotIndexEntry
+    {
+        NodeId mNodeId                 = kUndefinedNodeId;
+        SubscriptionId mSubscriptionId = 0;
+        FabricIndex mFabricIndex       = kUndefinedFabricIndex;
+        SlotState mState               = SlotState::kEmpty;
+    };
+
+    CHIP_ERROR LoadSlotIndexEntry(uint16_t subscriptionIndex, SlotIndexEntry & entry);
+    void SetSlotIndexEntry(uint16_t subscriptionIndex, const SubscriptionInfo & subscriptionInfo);
+    void ClearSlotIndexEntry(uint16_t subscriptionIndex);
+    uint16_t ValidSlotCount() const;
+
     class SimpleSubscriptionInfoIterator : public SubscriptionInfoIterator
     {
     public:
@@ -135,6 +157,7 @@ protected:
     static constexpr TLV::Tag kResumptionRetriesTag  = TLV::ContextTag(17);
 
     PersistentStorageDelegate * mStorage;
+    SlotIndexEntry mSlotIndex[CHIP_IM_MAX_NUM_SUBSCRIPTIONS];
     ObjectPool<SimpleSubscriptionInfoIterator, kIteratorsMax> mSubscriptionInfoIterators;
 };
 } // namespace app
@@ -0,0 +1,238 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @brief Index of the (endpoint, cluster) pairs each read handler is interested in.
+ *
+ * Without this index, every attribute change walks every read handler and the whole attribute path list of each
+ * of them. The index maps a concrete (endpoint, cluster) pair to the handlers that have at least one attribute
+ * path on it, so that a change only visits the handlers that can possibly match. Handlers with a path that has a
+ * wildcard endpoint or cluster are kept in a separate wildcard bucket and are visited for every change.
+ *
+ * A handler is either in the wildcard bucket or in the buckets of its concrete pairs (once per pair), so that a
+ * lookup never yields the same handler twice. The candidates still need to be checked against the full path
+ * list of the handler (attribute ids, list indices).
+ *
+ * The index is sized for one entry per attribute path the interaction model engine can hold. If it runs out of
+ * entries anyway it becomes invalid until it is cleared, and callers are expected to fall back to walking all
+ * handlers (and to rebuild the index) in that case.
+ */
+template <typename Handler, size_t kMaxEntries>
+class AttributeInterestIndex
+{
+public:
+    static_assert(kMaxEntries > 0 && kMaxEntries < UINT16_MAX, "Index entries are addressed with 16-bit indices");
+
+    AttributeInterestIndex() { Clear(); }
+
+    /**
+     * @brief Drop all entries and mark the index valid.
+     */
+    void Clear()
+    {
+        for (auto & bucket : mBuckets)
+        {
+            bucket = kInvalidEntry;
+        }
+        mWildcardBucket = kInvalidEntry;
+        for (size_t i = 0; i < kMaxEntries; i++)
+        {
+            mEntries[i].handler = nullptr;
+            mEntries[i].next    = static_cast<uint16_t>(i + 1 < kMaxEntries ? i + 1 : kInvalidEntry);
+        }
+        mFreeList   = 0;
+        mEntryCount = 0;
+        mOverflow   = false;
+    }
+
+    /**
+     * @brief Record that the handler is interested in attributes of the given concrete endpoint and cluster.
+     *
+     * Does nothing if the handler is already in the wildcard bucket or already interested in that cluster.
+     */
+    void Insert(Handler * handler, EndpointId endpointId, ClusterId clusterId)
+    {
+        if (Contains(mWildcardBucket, handler, kInvalidEndpointId, kInvalidClusterId))
+        {
+            return;
+        }
+
+        uint16_t & bucket = mBuckets[Hash(endpointId, clusterId) & kBucketMask];
+        if (!Contains(bucket, handler, endpointId, clusterId))
+        {
+            Push(bucket, handler, endpointId, clusterId);
+        }
+    }
+
+    /**
+     * @brief Record that the handler is interested in attributes of any endpoint or cluster.
+     *
+     * The concrete entries of the handler are dropped, since it is going to be visited for every change anyway.
+     */
+    void InsertWildcard(Handler * handler)
+    {
+        if (Contains(mWildcardBucket, handler, kInvalidEndpointId, kInvalidClusterId))
+        {
+            return;
+        }
+
+        for (auto & bucket : mBuckets)
+        {
+            RemoveFrom(bucket, handler);
+        }
+        Push(mWildcardBucket, handler, kInvalidEndpointId, kInvalidClusterId);
+    }
+
+    /**
+     * @brief Drop all entries of the handler.
+     */
+    void Remove(Handler * handler)
+    {
+        RemoveFrom(mWildcardBucket, handler);
+        for (auto & bucket : mBuckets)
+        {
+            RemoveFrom(bucket, handler);
+        }
+    }
+
+    /**
+     * @brief Call `function` once for every handler that may be interested in the given concrete cluster.
+     *
+     * `function` must not modify the index.
+     */
+    template <typename Function>
+    void ForEachCandidate(EndpointId endpointId, ClusterId clusterId, Function && function) const
+    {
+        for (uint16_t i = mWildcardBucket; i != kInvalidEntry; i = mEntries[i].next)
+        {
+            function(mEntries[i].handler);
+        }
+        for (uint16_t i = mBuckets[Hash(endpointId, clusterId) & kBucketMask]; i != kInvalidEntry; i = mEntries[i].next)
+        {
+            if (mEntries[i].endpointId == endpointId && mEntries[i].clusterId == clusterId)
+            {
+                function(mEntries[i].handler);
+            }
+        }
+    }
+
+    bool IsValid() const { return !mOverflow; }
+    size_t EntryCount() const { return mEntryCount; }
+    static constexpr size_t Capacity() { return kMaxEntries; }
+
+private:
+    struct Entry
+    {
+        Handler * handler;
+        ClusterId clusterId;
+        EndpointId endpointId;
+        uint16_t next;
+    };
+
+    static constexpr size_t RoundUpToPowerOfTwo(size_t value, size_t result = 1)
+    {
+        return (result >= value) ? result : RoundUpToPowerOfTwo(value, result << 1);
+    }
+
+    static constexpr size_t kBucketCount    = RoundUpToPowerOfTwo(kMaxEntries);
+    static constexpr size_t kBucketMask     = kBucketCount - 1;
+    static constexpr uint16_t kInvalidEntry = UINT16_MAX;
+
+    static uint32_t Hash(EndpointId endpointId, ClusterId clusterId)
+    {
+        uint32_t hash = (clusterId * 0x9E3779B1u) ^ (endpointId * 0xC2B2AE35u);
+        hash ^= hash >> 15;
+        hash *= 0x2C1B3C6Du;
+        hash ^= hash >> 13;
+        return hash;
+    }
+
+    bool Contains(uint16_t bucket, const Handler * handler, EndpointId endpointId, ClusterId clusterId) const
+    {
+        for (uint16_t i = bucket; i != kInvalidEntry; i = mEntries[i].next)
+        {
+            if (mEntries[i].handler == handler && mEntries[i].endpointId == endpointId && mEntries[i].clusterId == clusterId)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Push(uint16_t & bucket, Handler * handler, EndpointId endpointId, ClusterId clusterId)
+    {
+        if (mFreeList == kInvalidEntry)
+        {
+            mOverflow = true;
+            return;
+        }
+
+        uint16_t index   = mFreeList;
+        Entry & entry    = mEntries[index];
+        mFreeList        = entry.next;
+        entry.handler    = handler;
+        entry.endpointId = endpointId;
+        entry.clusterId  = clusterId;
+        entry.next       = bucket;
+        bucket           = index;
+        mEntryCount++;
+    }
+
+    void RemoveFrom(uint16_t & bucket, const Handler * handler)
+    {
+        for (uint16_t * link = &bucket; *link != kInvalidEntry;)
+        {
+            Entry & entry = mEntries[*link];
+            if (entry.handler != handler)
+            {
+                link = &entry.next;
+                continue;
+            }
+
+            uint16_t index = *link;
+            *link          = entry.next;
+            entry.handler  = nullptr;
+            entry.next     = mFreeList;
+            mFreeList      = index;
+            mEntryCount--;
+        }
+    }
+
+    Entry mEntries[kMaxEntries];
+    uint16_t mBuckets[kBucketCount];
+    uint16_t mWildcardBucket;
+    uint16_t mFreeList;
+    size_t mEntryCount;
+    bool mOverflow;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,441 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/AttributePathExpandFilter.h>
+#include <app/AttributePathParams.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @brief Set of dirty attribute paths, kept sorted by (endpoint, cluster, attribute, list index).
+ *
+ * Wildcard ids are the largest values of their type, so the wildcard paths of an endpoint (resp. cluster)
+ * sort right after all the concrete paths of that endpoint (resp. cluster), and all the paths with a wildcard
+ * endpoint sort last. This makes lookups of a superset of a path a handful of binary searches, and the paths
+ * that a new path can absorb a contiguous range in the common case of a concrete endpoint.
+ *
+ * A path that is already covered by an entry only refreshes the generation of that entry, and a path that
+ * covers existing entries replaces all of them. When the set is full, entries are coarsened step by step,
+ * stopping as soon as there is room for the new path:
+ *
+ *   1. attribute paths of the same cluster instance are merged into a wildcard attribute path,
+ *   2. paths of the same endpoint are merged into a wildcard cluster path,
+ *   3. paths of the same cluster on different endpoints are merged into a wildcard endpoint path,
+ *   4. if no two paths share an endpoint or a cluster, the set is replaced by a single wildcard path.
+ *
+ * Each of the first three steps is a linear pass over the (sorted) entries. The number of inserts that
+ * needed coarsening, and the number of those that had to fall back to a full wildcard, are counted.
+ */
+template <size_t kCapacity>
+class DirtyPathSet
+{
+public:
+    static_assert(kCapacity > 0, "The dirty set must be able to hold at least the wildcard path");
+
+    struct Entry : public AttributePathParams
+    {
+        Entry() {}
+        Entry(const AttributePathParams & aPath, uint64_t aGeneration) : AttributePathParams(aPath), mGeneration(aGeneration) {}
+        uint64_t mGeneration = 0;
+    };
+
+    /**
+     * @brief Mark the given path dirty at the given generation.
+     */
+    CHIP_ERROR Insert(const AttributePathParams & aPath, uint64_t aGeneration)
+    {
+        bool degraded = false;
+
+        while (true)
+        {
+            Entry * superset = FindSupersetOf(aPath);
+            if (superset != nullptr)
+            {
+                superset->mGeneration = aGeneration;
+                return CHIP_NO_ERROR;
+            }
+
+            if (RemoveSubsetsOf(aPath) || mCount < kCapacity)
+            {
+                InsertSorted(Entry(aPath, aGeneration));
+                return CHIP_NO_ERROR;
+            }
+
+            if (!degraded)
+            {
+                degraded = true;
+                mDegradeCount++;
+            }
+
+            if (MergeUnderSameCluster() || MergeUnderSameEndpoint() || MergeSameClusterAcrossEndpoints(aPath))
+            {
+                continue;
+            }
+
+            ChipLogDetail(DataManagement, "Global dirty set pool exhausted, merge all paths.");
+            mGlobalWildcardCount++;
+            uint64_t generation = aGeneration;
+            for (size_t i = 0; i < mCount; i++)
+            {
+                generation = std::max(generation, mEntries[i].mGeneration);
+            }
+            mCount = 0;
+            InsertSorted(Entry(AttributePathParams(), generation));
+        }
+    }
+
+    void Clear() { mCount = 0; }
+
+    size_t Size() const { return mCount; }
+    bool Exhausted() const { return mCount == kCapacity; }
+    static constexpr size_t Capacity() { return kCapacity; }
+
+    /// Number of inserts that found the set full and had to coarsen existing entries.
+    uint32_t GetDegradeCount() const { return mDegradeCount; }
+
+    /// Number of inserts that had to replace the whole set with a single wildcard path.
+    uint32_t GetGlobalWildcardCount() const { return mGlobalWildcardCount; }
+
+    /**
+     * @brief Call `function` for every entry, in order, until it returns Loop::Break.
+     *
+     * `function` may update the generation of the entry, but must not modify the set.
+     *
+     * @return Loop::Break if `function` returned Loop::Break, Loop::Finish otherwise.
+     */
+    template <typename Function>
+    Loop ForEach(Function && function)
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            if (function(&mEntries[i]) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+        }
+        return Loop::Finish;
+    }
+
+    /**
+     * @brief Whether any path covered by the given path was marked dirty at a generation newer than the given one.
+     *
+     * Meant for wildcard paths (a whole endpoint or cluster), for which a single pass over the entries is cheaper
+     * than looking up every attribute path they expand to.
+     */
+    bool HasDirtyPathSince(const AttributePathParams & aPath, uint64_t aGeneration) const
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            if (mEntries[i].mGeneration > aGeneration && mEntries[i].Intersects(aPath))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static bool Less(const AttributePathParams & a, const AttributePathParams & b)
+    {
+        if (a.mEndpointId != b.mEndpointId)
+        {
+            return a.mEndpointId < b.mEndpointId;
+        }
+        if (a.mClusterId != b.mClusterId)
+        {
+            return a.mClusterId < b.mClusterId;
+        }
+        if (a.mAttributeId != b.mAttributeId)
+        {
+            return a.mAttributeId < b.mAttributeId;
+        }
+        return a.mListIndex < b.mListIndex;
+    }
+
+    // Index of the first entry that does not sort before the given path.
+    size_t LowerBound(const AttributePathParams & aPath) const
+    {
+        auto less = [](const Entry & entry, const AttributePathParams & path) { return Less(entry, path); };
+        return static_cast<size_t>(std::lower_bound(mEntries, mEntries + mCount, aPath, less) - mEntries);
+    }
+
+    // Index of the first entry that sorts after the given path.
+    size_t UpperBound(const AttributePathParams & aPath) const
+    {
+        auto less = [](const AttributePathParams & path, const Entry & entry) { return Less(path, entry); };
+        return static_cast<size_t>(std::upper_bound(mEntries, mEntries + mCount, aPath, less) - mEntries);
+    }
+
+    Entry * Find(const AttributePathParams & aPath)
+    {
+        size_t i = LowerBound(aPath);
+        return (i < mCount && static_cast<const AttributePathParams &>(mEntries[i]) == aPath) ? &mEntries[i] : nullptr;
+    }
+
+    /**
+     * A superset of a path has, for every id, either the same id or a wildcard, so there are at most 16
+     * candidate keys (fewer when the path itself has wildcards), each of which is a binary search.
+     */
+    Entry * FindSupersetOf(const AttributePathParams & aPath)
+    {
+        const EndpointId endpoints[]   = { aPath.mEndpointId, kInvalidEndpointId };
+        const ClusterId clusters[]     = { aPath.mClusterId, kInvalidClusterId };
+        const AttributeId attributes[] = { aPath.mAttributeId, kInvalidAttributeId };
+        const ListIndex listIndices[]  = { aPath.mListIndex, kInvalidListIndex };
+
+        for (size_t e = aPath.HasWildcardEndpointId() ? 1 : 0; e < 2; e++)
+        {
+            for (size_t c = aPath.HasWildcardClusterId() ? 1 : 0; c < 2; c++)
+            {
+                for (size_t a = aPath.HasWildcardAttributeId() ? 1 : 0; a < 2; a++)
+                {
+                    for (size_t l = aPath.HasWildcardListIndex() ? 1 : 0; l < 2; l++)
+                    {
+                        Entry * entry = Find(AttributePathParams(endpoints[e], clusters[c], attributes[a], listIndices[l]));
+                        if (entry != nullptr)
+                        {
+                            return entry;
+                        }
+                    }
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Remove the entries covered by the given path, which is not covered by any entry.  The entries of a concrete
+     * endpoint are a contiguous range, so only paths with a wildcard endpoint need a full pass.
+     *
+     * @return true if any entry was removed.
+     */
+    bool RemoveSubsetsOf(const AttributePathParams & aPath)
+    {
+        size_t begin = 0;
+        size_t end   = mCount;
+        if (!aPath.HasWildcardEndpointId())
+        {
+            // Only the entries of the same endpoint (and cluster, if concrete) can be covered.
+            ClusterId firstCluster = aPath.HasWildcardClusterId() ? 0 : aPath.mClusterId;
+            begin                  = LowerBound(AttributePathParams(aPath.mEndpointId, firstCluster, 0, 0));
+            end = UpperBound(AttributePathParams(aPath.mEndpointId, aPath.mClusterId, kInvalidAttributeId, kInvalidListIndex));
+        }
+
+        size_t kept = begin;
+        for (size_t i = begin; i < end; i++)
+        {
+            if (!aPath.IsAttributePathSupersetOf(mEntries[i]))
+            {
+                mEntries[kept++] = mEntries[i];
+            }
+        }
+        if (kept == end)
+        {
+            return false;
+        }
+        std::copy(mEntries + end, mEntries + mCount, mEntries + kept);
+        mCount -= end - kept;
+        return true;
+    }
+
+    void InsertSorted(const Entry & aEntry)
+    {
+        VerifyOrDie(mCount < kCapacity);
+        size_t i = LowerBound(aEntry);
+        std::copy_backward(mEntries + i, mEntries + mCount, mEntries + mCount + 1);
+        mEntries[i] = aEntry;
+        mCount++;
+    }
+
+    /**
+     * Replace every run of at least two entries for which `sameGroup` holds between the first entry of the run
+     * and every other entry with a single entry built by `widen` from the first one.  The widened entry must sort
+     * after every entry of the run and before any entry following it.
+     *
+     * @return true if any entry was merged.
+     */
+    template <typename SameGroup, typename Widen>
+    bool MergeRuns(SameGroup && sameGroup, Widen && widen)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < mCount;)
+        {
+            size_t runEnd = i + 1;
+            Entry merged  = mEntries[i];
+            while (runEnd < mCount && sameGroup(mEntries[i], mEntries[runEnd]))
+            {
+                merged.mGeneration = std::max(merged.mGeneration, mEntries[runEnd].mGeneration);
+                runEnd++;
+            }
+            if (runEnd - i > 1)
+            {
+                widen(merged);
+            }
+            mEntries[kept++] = merged;
+            i                = runEnd;
+        }
+
+        bool anyMerged = (kept != mCount);
+        mCount         = kept;
+        return anyMerged;
+    }
+
+    bool MergeUnderSameCluster()
+    {
+        return MergeRuns(
+            [](const Entry & first, const Entry & other) {
+                return !first.HasWildcardClusterId() && first.mEndpointId == other.mEndpointId &&
+                    first.mClusterId == other.mClusterId;
+            },
+            [](Entry & merged) { merged.SetWildcardAttributeId(); });
+    }
+
+    bool MergeUnderSameEndpoint()
+    {
+        return MergeRuns(
+            [](const Entry & first, const Entry & other) {
+                return !first.HasWildcardEndpointId() && first.mEndpointId == other.mEndpointId;
+            },
+            [](Entry & merged) {
+                merged.SetWildcardClusterId();
+                merged.SetWildcardAttributeId();
+            });
+    }
+
+    /**
+     * Find a cluster that at least two entries (or an entry and the new path) have in common, preferring the
+     * cluster of the new path, and merge all its entries into a wildcard endpoint path.
+     *
+     * @return true if any entry was merged.
+     */
+    bool MergeSameClusterAcrossEndpoints(const AttributePathParams & aPath)
+    {
+        ClusterId clusters[kCapacity];
+        size_t clusterCount = 0;
+        for (size_t i = 0; i < mCount; i++)
+        {
+            if (!mEntries[i].HasWildcardClusterId())
+            {
+                clusters[clusterCount++] = mEntries[i].mClusterId;
+            }
+        }
+        std::sort(clusters, clusters + clusterCount);
+
+        ClusterId target = kInvalidClusterId;
+        if (!aPath.HasWildcardClusterId() && std::binary_search(clusters, clusters + clusterCount, aPath.mClusterId))
+        {
+            target = aPath.mClusterId;
+        }
+        for (size_t i = 1; i < clusterCount && target == kInvalidClusterId; i++)
+        {
+            if (clusters[i] == clusters[i - 1])
+            {
+                target = clusters[i];
+            }
+        }
+        VerifyOrReturnValue(target != kInvalidClusterId, false);
+
+        // Keep the attribute if all the merged paths agree on it.
+        Entry merged(AttributePathParams(kInvalidEndpointId, target, kInvalidAttributeId, kInvalidListIndex), 0);
+        bool first         = true;
+        bool sameAttribute = true;
+        if (aPath.mClusterId == target)
+        {
+            merged.mAttributeId = aPath.mAttributeId;
+            merged.mListIndex   = aPath.mListIndex;
+            first               = false;
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < mCount; i++)
+        {
+            const Entry & entry = mEntries[i];
+            if (entry.mClusterId != target)
+            {
+                mEntries[kept++] = entry;
+                continue;
+            }
+            if (first)
+            {
+                merged.mAttributeId = entry.mAttributeId;
+                merged.mListIndex   = entry.mListIndex;
+                first               = false;
+            }
+            sameAttribute = sameAttribute && entry.mAttributeId == merged.mAttributeId && entry.mListIndex == merged.mListIndex;
+            merged.mGeneration = std::max(merged.mGeneration, entry.mGeneration);
+        }
+        if (!sameAttribute)
+        {
+            merged.SetWildcardAttributeId();
+        }
+
+        mCount = kept;
+        InsertSorted(merged);
+        return true;
+    }
+
+    Entry mEntries[kCapacity];
+    size_t mCount                 = 0;
+    uint32_t mDegradeCount        = 0;
+    uint32_t mGlobalWildcardCount = 0;
+};
+
+/**
+ * @brief Expansion filter keeping only the endpoints and clusters with a path marked dirty after a given generation.
+ *
+ * Set on the path iterator of a read handler building a non-priming report, with the generation at which its
+ * previous report began, so that the endpoints and clusters with no change to report are skipped as a whole.
+ */
+template <size_t kCapacity>
+class DirtyPathFilter : public AttributePathExpandFilter
+{
+public:
+    DirtyPathFilter(const DirtyPathSet<kCapacity> & aDirtySet, uint64_t aGeneration) :
+        mDirtySet(aDirtySet), mGeneration(aGeneration)
+    {}
+
+    bool IsEndpointWanted(EndpointId aEndpointId) override
+    {
+        return mDirtySet.HasDirtyPathSince(AttributePathParams(aEndpointId), mGeneration);
+    }
+
+    bool IsClusterWanted(const ConcreteClusterPath & aClusterPath) override
+    {
+        return mDirtySet.HasDirtyPathSince(AttributePathParams(aClusterPath.mEndpointId, aClusterPath.mClusterId), mGeneration);
+    }
+
+private:
+    const DirtyPathSet<kCapacity> & mDirtySet;
+    const uint64_t mGeneration;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
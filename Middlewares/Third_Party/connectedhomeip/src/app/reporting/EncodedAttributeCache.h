@@ -0,0 +1,213 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/AttributeReportIB.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @brief Encoded attribute values shared by the read handlers the reporting engine reports a change to.
+ *
+ * An entry holds an AttributeReportIBs array with the single AttributeReportIB encoded for an attribute path,
+ * together with the data version found in it, so that the other read handlers interested in the same change copy
+ * the encoded AttributeReportIB into their report (a single memcpy) instead of reading and encoding the attribute
+ * again. An entry may instead mark the path as
+ * private: its value depends on the subject of the read (e.g. fabric-scoped lists), or does not fit in an entry,
+ * so every read handler has to read it.
+ *
+ * The cache does not check access: the engine has to check that the subject of each read handler is allowed to
+ * read the path before copying an entry. It only holds values read since the last time an attribute was marked
+ * dirty, and entries are replaced in insertion order when full.
+ */
+template <size_t kEntryCount, size_t kMaxEncodedSize>
+class EncodedAttributeCache
+{
+public:
+    static_assert(kEntryCount > 0, "Disable the cache instead of giving it no entries");
+    static_assert(kMaxEncodedSize <= UINT16_MAX, "Encoded lengths are stored on 16 bits");
+
+    struct Entry
+    {
+        ConcreteAttributePath mPath;
+        DataVersion mDataVersion = 0;
+        uint16_t mReportOffset   = 0; // contents of the AttributeReportIB structure, end of container included
+        uint16_t mReportLength   = 0; // 0 for a private path
+        bool mInUse              = false;
+        uint8_t mData[kMaxEncodedSize];
+
+        bool IsShared() const { return mReportLength != 0; }
+    };
+
+    Entry * Find(const ConcreteAttributePath & aPath)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (entry.mInUse && entry.mPath == aPath)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Get an entry for the path, reusing its current entry if any, and otherwise an unused or the oldest
+     * entry. The entry is private until Share() is called on it, its data buffer may be used to encode the value.
+     */
+    Entry & Allocate(const ConcreteAttributePath & aPath)
+    {
+        Entry * entry = Find(aPath);
+        if (entry == nullptr)
+        {
+            for (auto & candidate : mEntries)
+            {
+                if (!candidate.mInUse)
+                {
+                    entry = &candidate;
+                    break;
+                }
+            }
+        }
+        if (entry == nullptr)
+        {
+            entry       = &mEntries[mNextVictim];
+            mNextVictim = (mNextVictim + 1) % kEntryCount;
+        }
+
+        entry->mPath        = aPath;
+        entry->mDataVersion  = 0;
+        entry->mReportLength = 0;
+        entry->mInUse        = true;
+        return *entry;
+    }
+
+    /**
+     * @brief Share the AttributeReportIBs array of aLength bytes encoded in the data buffer of the entry.
+     *
+     * @retval CHIP_ERROR_INCORRECT_STATE if the array does not hold exactly one AttributeReportIB with attribute data
+     *                                    for the path of the entry; the entry is left private.
+     */
+    CHIP_ERROR Share(Entry & aEntry, size_t aLength)
+    {
+        VerifyOrReturnError(aLength > 0 && aLength <= kMaxEncodedSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+        TLV::TLVReader reader;
+        TLV::TLVType outerType;
+        reader.Init(aEntry.mData, aLength);
+        ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+        ReturnErrorOnFailure(reader.EnterContainer(outerType));
+        VerifyOrReturnError(reader.Next() == CHIP_NO_ERROR, CHIP_ERROR_INCORRECT_STATE);
+
+        AttributeReportIB::Parser report;
+        AttributeDataIB::Parser data;
+        AttributePathIB::Parser path;
+        ConcreteDataAttributePath encodedPath;
+        DataVersion version = 0;
+        ReturnErrorOnFailure(report.Init(reader));
+        VerifyOrReturnError(report.GetAttributeData(&data) == CHIP_NO_ERROR, CHIP_ERROR_INCORRECT_STATE);
+        ReturnErrorOnFailure(data.GetDataVersion(&version));
+        ReturnErrorOnFailure(data.GetPath(&path));
+        ReturnErrorOnFailure(path.GetConcreteAttributePath(encodedPath));
+        VerifyOrReturnError(encodedPath == aEntry.mPath && !encodedPath.IsListItemOperation(), CHIP_ERROR_INCORRECT_STATE);
+
+        TLV::TLVReader contents;
+        TLV::TLVType reportType;
+        contents.Init(reader);
+        ReturnErrorOnFailure(contents.EnterContainer(reportType));
+        const uint8_t * contentsStart = contents.GetReadPoint();
+        ReturnErrorOnFailure(contents.ExitContainer(reportType));
+        VerifyOrReturnError(reader.Next() == CHIP_END_OF_TLV, CHIP_ERROR_INCORRECT_STATE);
+
+        aEntry.mDataVersion  = version;
+        aEntry.mReportOffset = static_cast<uint16_t>(contentsStart - aEntry.mData);
+        aEntry.mReportLength = static_cast<uint16_t>(contents.GetReadPoint() - contentsStart);
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * @brief Append the AttributeReportIB of a shared entry to a report.
+     */
+    static CHIP_ERROR CopySharedAttributeReport(const Entry & aEntry, TLV::TLVWriter & aWriter)
+    {
+        VerifyOrReturnError(aEntry.IsShared(), CHIP_ERROR_INCORRECT_STATE);
+        return aWriter.PutPreEncodedContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, &aEntry.mData[aEntry.mReportOffset],
+                                              aEntry.mReportLength);
+    }
+
+    /**
+     * @brief Forget the entry. Its data buffer is left untouched until the entry is allocated again.
+     */
+    void Release(Entry & aEntry) { aEntry.mInUse = false; }
+
+    /**
+     * @brief Copy the AttributeReportIB(s) of an AttributeReportIBs array encoded by the engine into a report, element
+     * by element.
+     */
+    static CHIP_ERROR CopyAttributeReports(const uint8_t * aData, size_t aLength, TLV::TLVWriter & aWriter)
+    {
+        TLV::TLVReader reader;
+        TLV::TLVType outerType;
+        reader.Init(aData, aLength);
+        ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+        ReturnErrorOnFailure(reader.EnterContainer(outerType));
+
+        CHIP_ERROR err;
+        while ((err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            ReturnErrorOnFailure(aWriter.CopyElement(reader));
+        }
+        return err == CHIP_END_OF_TLV ? CHIP_NO_ERROR : err;
+    }
+
+    void Clear()
+    {
+        for (auto & entry : mEntries)
+        {
+            entry.mInUse = false;
+        }
+        mNextVictim = 0;
+    }
+
+    void CountHit() { mHitCount++; }
+    void CountMiss() { mMissCount++; }
+
+    uint32_t GetHitCount() const { return mHitCount; }
+    uint32_t GetMissCount() const { return mMissCount; }
+
+private:
+    Entry mEntries[kEntryCount];
+    size_t mNextVictim  = 0;
+    uint32_t mHitCount  = 0;
+    uint32_t mMissCount = 0;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -78,7 +78,10 @@ void Engine::Shutdown()
 
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
-    mGlobalDirtySet.ReleaseAll();
+    mGlobalDirtySet.Clear();
+#if CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+    mEncodedAttributeCache.Clear();
+#endif
 }
 
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
@@ -108,6 +111,99 @@ static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
     return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
 }
 
+DataModel::ActionReturnStatus Engine::RetrieveClusterData(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aReportBuilder,
+                                                          const ConcreteReadAttributePath & aPath,
+                                                          AttributeEncodeState * apEncoderState)
+{
+    DataModel::Provider * dataModel                   = mpImEngine->GetDataModelProvider();
+    const Access::SubjectDescriptor subjectDescriptor = apReadHandler->GetSubjectDescriptor();
+
+#if CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+    // Priming reports read every path once per read handler, so only reports of dirty paths are worth sharing, and a list
+    // being chunked resumes from a position that is specific to the read handler.
+    if (!apReadHandler->IsPriming() && apEncoderState->CurrentEncodingListIndex() == kInvalidListIndex)
+    {
+        auto * entry = mEncodedAttributeCache.Find(aPath);
+        if (entry != nullptr && !entry->IsShared())
+        {
+            // Already known to be specific to each reader this generation.
+            mEncodedAttributeCache.CountMiss();
+            return Impl::RetrieveClusterData(dataModel, subjectDescriptor, apReadHandler->IsFabricFiltered(), aReportBuilder, aPath,
+                                             apEncoderState);
+        }
+
+        if (entry != nullptr && Impl::IsClusterDataVersionEqualTo(dataModel, aPath, entry->mDataVersion))
+        {
+            // The value was encoded for another subject: this one must be allowed to read it as well.  When it is not, the
+            // regular read below generates the status (or the absence of report) the subject should get.
+            Access::RequestPath requestPath{ .cluster     = aPath.mClusterId,
+                                             .endpoint    = aPath.mEndpointId,
+                                             .requestType = Access::RequestType::kAttributeReadRequest,
+                                             .entityId    = aPath.mAttributeId };
+            if (Access::GetAccessControl().Check(subjectDescriptor, requestPath, RequiredPrivilege::ForReadAttribute(aPath)) !=
+                CHIP_NO_ERROR)
+            {
+                mEncodedAttributeCache.CountMiss();
+                return Impl::RetrieveClusterData(dataModel, subjectDescriptor, apReadHandler->IsFabricFiltered(), aReportBuilder,
+                                                 aPath, apEncoderState);
+            }
+
+            mEncodedAttributeCache.CountHit();
+            return mEncodedAttributeCache.CopySharedAttributeReport(*entry, *aReportBuilder.GetWriter());
+        }
+
+        // Encode the value in a cache entry, then copy it into the report.
+        mEncodedAttributeCache.CountMiss();
+        auto & newEntry = mEncodedAttributeCache.Allocate(aPath);
+        TLV::TLVWriter entryWriter;
+        AttributeReportIBs::Builder entryBuilder;
+        AttributeEncodeState entryState;
+        entryWriter.Init(newEntry.mData, sizeof(newEntry.mData));
+
+        DataModel::ActionReturnStatus status = entryBuilder.Init(&entryWriter);
+        if (status.IsSuccess())
+        {
+            status = Impl::RetrieveClusterData(dataModel, subjectDescriptor, apReadHandler->IsFabricFiltered(), entryBuilder, aPath,
+                                               &entryState);
+        }
+        if (status.IsSuccess())
+        {
+            status = entryBuilder.EndOfAttributeReportIBs();
+        }
+        if (status.IsSuccess())
+        {
+            status = entryWriter.Finalize();
+        }
+
+        if (status.IsSuccess())
+        {
+            // Values that depend on the subject stay private to this generation.  Reads that did not produce exactly one
+            // attribute data IB (e.g. the subject was denied access to an expanded path) are not kept at all.
+            if (!entryState.DependsOnSubject() &&
+                mEncodedAttributeCache.Share(newEntry, entryWriter.GetLengthWritten()) != CHIP_NO_ERROR)
+            {
+                mEncodedAttributeCache.Release(newEntry);
+            }
+            return mEncodedAttributeCache.CopyAttributeReports(newEntry.mData, entryWriter.GetLengthWritten(),
+                                                               *aReportBuilder.GetWriter());
+        }
+
+        if (!status.IsOutOfSpaceEncodingResponse())
+        {
+            // Errors are not cached: the caller encodes them as a status, like for a regular read.  No partial data was
+            // written into the report.
+            mEncodedAttributeCache.Release(newEntry);
+            return status;
+        }
+
+        // Too large for an entry: read it straight into the report, for every read handler this generation.
+    }
+#endif // CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+
+    return Impl::RetrieveClusterData(dataModel, subjectDescriptor, apReadHandler->IsFabricFiltered(), aReportBuilder, aPath,
+                                     apEncoderState);
+}
+
 CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder,
                                                            ReadHandler * apReadHandler, bool * apHasMoreChunks,
                                                            bool * apHasEncodedData)
@@ -144,6 +240,12 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
                       ChipLogValueX64(apReadHandler->mPreviousReportsBeginGeneration),
                       ChipLogValueX64(apReadHandler->mDirtyGeneration));
 
+        // Only the endpoints and clusters with a change to report are worth expanding; the dirty check below still
+        // decides for every attribute path that the iterator emits.
+        DirtyPathFilter<CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> dirtyFilter(mGlobalDirtySet,
+                                                                      apReadHandler->mPreviousReportsBeginGeneration);
+        apReadHandler->GetAttributePathExpandIterator()->SetFilter(apReadHandler->IsPriming() ? nullptr : &dirtyFilter);
+
         // This ReadHandler is not generating reports, so we reset the iterator for a clean start.
         if (!apReadHandler->IsReporting())
         {
@@ -161,8 +263,7 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             if (!apReadHandler->IsPriming())
             {
                 bool concretePathDirty = false;
-                // TODO: Optimize this implementation by making the iterator only emit intersected paths.
-                mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
+                mGlobalDirtySet.ForEach([&](auto * dirtyPath) {
                     if (dirtyPath->IsAttributePathSupersetOf(readPath))
                     {
                         // We don't need to worry about paths that were already marked dirty before the last time this read handler
@@ -206,8 +307,7 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
             DataModel::ActionReturnStatus status =
-                Impl::RetrieveClusterData(mpImEngine->GetDataModelProvider(), apReadHandler->GetSubjectDescriptor(),
-                                          apReadHandler->IsFabricFiltered(), attributeReportIBs, pathForRetrieval, &encodeState);
+                RetrieveClusterData(apReadHandler, attributeReportIBs, pathForRetrieval, &encodeState);
             if (status.IsError())
             {
                 // Operation error set, since this will affect early return or override on status encoding
@@ -273,6 +373,9 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         hasMoreChunks = false;
     }
 exit:
+    // The filter only lives for this chunk.
+    apReadHandler->GetAttributePathExpandIterator()->SetFilter(nullptr);
+
     if (attributeReportIBs.GetWriter()->GetLengthWritten() != emptyReportDataLength)
     {
         // We may encounter BUFFER_TOO_SMALL with nothing actually written for the case of list chunking, so we check if we have
@@ -528,6 +631,10 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     // Reserved size for an empty EventReportIBs, so we can at least check if there are any events need to be reported.
     const uint32_t kReservedSizeForEventReportIBs = 3; // type, tag, end of container
 
+    // Every access check made while building this report is for the subject of the read handler, so let access control
+    // remember its decisions instead of evaluating the ACL again for every attribute of a cluster.
+    Access::AccessControl::DecisionCacheScope accessDecisionCacheScope(Access::GetAccessControl());
+
     VerifyOrExit(apReadHandler != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(apReadHandler->GetSession() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
@@ -739,151 +846,25 @@ void Engine::Run()
     {
         ChipLogDetail(DataManagement, "All ReadHandler-s are clean, clear GlobalDirtySet");
 
-        mGlobalDirtySet.ReleaseAll();
+        mGlobalDirtySet.Clear();
     }
 }
 
-bool Engine::MergeOverlappedAttributePath(const AttributePathParams & aAttributePath)
-{
-    return Loop::Break == mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
-        if (path->IsAttributePathSupersetOf(aAttributePath))
-        {
-            path->mGeneration = GetDirtySetGeneration();
-            return Loop::Break;
-        }
-        if (aAttributePath.IsAttributePathSupersetOf(*path))
-        {
-            // TODO: the wildcard input path may be superset of next paths in globalDirtySet, it is fine at this moment, since
-            // when building report, it would use the first path of globalDirtySet to compare against interested paths read clients
-            // want.
-            // It is better to eliminate the duplicate wildcard paths in follow-up
-            path->mGeneration  = GetDirtySetGeneration();
-            path->mEndpointId  = aAttributePath.mEndpointId;
-            path->mClusterId   = aAttributePath.mClusterId;
-            path->mListIndex   = aAttributePath.mListIndex;
-            path->mAttributeId = aAttributePath.mAttributeId;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
-}
-
-bool Engine::ClearTombPaths()
-{
-    bool pathReleased = false;
-    mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
-        if (path->mGeneration == 0)
-        {
-            mGlobalDirtySet.ReleaseObject(path);
-            pathReleased = true;
-        }
-        return Loop::Continue;
-    });
-    return pathReleased;
-}
-
-bool Engine::MergeDirtyPathsUnderSameCluster()
-{
-    mGlobalDirtySet.ForEachActiveObject([&](auto * outerPath) {
-        if (outerPath->HasWildcardClusterId() || outerPath->mGeneration == 0)
-        {
-            return Loop::Continue;
-        }
-        mGlobalDirtySet.ForEachActiveObject([&](auto * innerPath) {
-            if (innerPath == outerPath)
-            {
-                return Loop::Continue;
-            }
-            // We don't support paths with a wildcard endpoint + a concrete cluster in global dirty set, so we do a simple == check
-            // here.
-            if (innerPath->mEndpointId != outerPath->mEndpointId || innerPath->mClusterId != outerPath->mClusterId)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mGeneration > outerPath->mGeneration)
-            {
-                outerPath->mGeneration = innerPath->mGeneration;
-            }
-            outerPath->SetWildcardAttributeId();
-
-            // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
-            // generation to 0 and then clear it later.
-            innerPath->mGeneration = 0;
-            return Loop::Continue;
-        });
-        return Loop::Continue;
-    });
-
-    return ClearTombPaths();
-}
-
-bool Engine::MergeDirtyPathsUnderSameEndpoint()
-{
-    mGlobalDirtySet.ForEachActiveObject([&](auto * outerPath) {
-        if (outerPath->HasWildcardEndpointId() || outerPath->mGeneration == 0)
-        {
-            return Loop::Continue;
-        }
-        mGlobalDirtySet.ForEachActiveObject([&](auto * innerPath) {
-            if (innerPath == outerPath)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mEndpointId != outerPath->mEndpointId)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mGeneration > outerPath->mGeneration)
-            {
-                outerPath->mGeneration = innerPath->mGeneration;
-            }
-            outerPath->SetWildcardClusterId();
-            outerPath->SetWildcardAttributeId();
-
-            // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
-            // generation to 0 and then clear it later.
-            innerPath->mGeneration = 0;
-            return Loop::Continue;
-        });
-        return Loop::Continue;
-    });
-    return ClearTombPaths();
-}
-
 CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttributePath)
 {
-    ReturnErrorCodeIf(MergeOverlappedAttributePath(aAttributePath), CHIP_NO_ERROR);
-
-    if (mGlobalDirtySet.Exhausted() && !MergeDirtyPathsUnderSameCluster() && !MergeDirtyPathsUnderSameEndpoint())
-    {
-        ChipLogDetail(DataManagement, "Global dirty set pool exhausted, merge all paths.");
-        mGlobalDirtySet.ReleaseAll();
-        auto object         = mGlobalDirtySet.CreateObject();
-        object->mGeneration = GetDirtySetGeneration();
-    }
-
-    ReturnErrorCodeIf(MergeOverlappedAttributePath(aAttributePath), CHIP_NO_ERROR);
-    ChipLogDetail(DataManagement, "Cannot merge the new path into any existing path, create one.");
-
-    auto object = mGlobalDirtySet.CreateObject();
-    if (object == nullptr)
-    {
-        // This should not happen, this path should be merged into the wildcard endpoint at least.
-        ChipLogError(DataManagement, "mGlobalDirtySet pool full, cannot handle more entries!");
-        return CHIP_ERROR_NO_MEMORY;
-    }
-    *object             = aAttributePath;
-    object->mGeneration = GetDirtySetGeneration();
-
-    return CHIP_NO_ERROR;
+    return mGlobalDirtySet.Insert(aAttributePath, GetDirtySetGeneration());
 }
 
 CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
+#if CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+    // Values encoded before this change must not be shared with the read handlers that report it.
+    mEncodedAttributeCache.Clear();
+#endif
 
     bool intersectsInterestPath = false;
-    mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
+    auto markDirtyIfIntersects  = [&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
         // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
         // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
         // waiting for a response to the last message chunk for read interactions.
@@ -899,9 +880,20 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
                 }
             }
         }
+    };
 
-        return Loop::Continue;
-    });
+    if (aAttributePath.HasWildcardEndpointId() || aAttributePath.HasWildcardClusterId() || !mInterestIndex.IsValid())
+    {
+        mpImEngine->mReadHandlers.ForEachActiveObject([&markDirtyIfIntersects](ReadHandler * handler) {
+            markDirtyIfIntersects(handler);
+            return Loop::Continue;
+        });
+    }
+    else
+    {
+        // Only the handlers interested in the changed cluster (or in wildcard clusters) can match.
+        mInterestIndex.ForEachCandidate(aAttributePath.mEndpointId, aAttributePath.mClusterId, markDirtyIfIntersects);
+    }
 
     if (!intersectsInterestPath)
     {
@@ -912,6 +904,44 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
     return CHIP_NO_ERROR;
 }
 
+void Engine::RegisterInterestPaths(ReadHandler & aReadHandler)
+{
+    mInterestIndex.Remove(&aReadHandler);
+
+    for (auto object = aReadHandler.GetAttributePathList(); object != nullptr; object = object->mpNext)
+    {
+        if (object->mValue.HasWildcardEndpointId() || object->mValue.HasWildcardClusterId())
+        {
+            // The handler will be visited for every change anyway.
+            mInterestIndex.InsertWildcard(&aReadHandler);
+            return;
+        }
+        mInterestIndex.Insert(&aReadHandler, object->mValue.mEndpointId, object->mValue.mClusterId);
+    }
+}
+
+void Engine::UnregisterInterestPaths(ReadHandler & aReadHandler)
+{
+    mInterestIndex.Remove(&aReadHandler);
+
+    if (!mInterestIndex.IsValid())
+    {
+        RebuildInterestIndex(&aReadHandler);
+    }
+}
+
+void Engine::RebuildInterestIndex(const ReadHandler * apExcludedHandler)
+{
+    mInterestIndex.Clear();
+    mpImEngine->mReadHandlers.ForEachActiveObject([this, apExcludedHandler](ReadHandler * handler) {
+        if (handler != apExcludedHandler)
+        {
+            RegisterInterestPaths(*handler);
+        }
+        return Loop::Continue;
+    });
+}
+
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -27,7 +27,11 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/data-model-provider/ActionReturnStatus.h>
 #include <app/data-model-provider/ProviderChangeListener.h>
+#include <app/reporting/AttributeInterestIndex.h>
+#include <app/reporting/DirtyPathSet.h>
+#include <app/reporting/EncodedAttributeCache.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -96,6 +100,17 @@ public:
      */
     CHIP_ERROR SetDirty(const AttributePathParams & aAttributePathParams);
 
+    /**
+     * Record the clusters the attribute paths of the read handler refer to, so that SetDirty visits the handler
+     * when one of them changes.  Must be called whenever the attribute path list of the handler has been built.
+     */
+    void RegisterInterestPaths(ReadHandler & aReadHandler);
+
+    /**
+     * Forget the clusters recorded by RegisterInterestPaths.  Must be called before the read handler is destroyed.
+     */
+    void UnregisterInterestPaths(ReadHandler & aReadHandler);
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -138,7 +153,24 @@ public:
     void ScheduleUrgentEventDeliverySync(Optional<FabricIndex> fabricIndex = NullOptional);
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
-    size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
+    size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Size(); }
+#endif
+
+    /**
+     * Number of times a path was marked dirty while the global dirty set was full, so that existing paths had to be
+     * coarsened to make room, and how many of those had to replace the whole set with a wildcard path (which
+     * forces a full report to every subscriber).
+     */
+    uint32_t GetDirtySetDegradeCount() const { return mGlobalDirtySet.GetDegradeCount(); }
+    uint32_t GetDirtySetGlobalWildcardCount() const { return mGlobalDirtySet.GetGlobalWildcardCount(); }
+
+#if CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+    /**
+     * Number of attribute values copied from the encoded attribute cache into a report, and number of values that had to
+     * be read and encoded because the cache could not provide them.
+     */
+    uint32_t GetEncodedAttributeCacheHitCount() const { return mEncodedAttributeCache.GetHitCount(); }
+    uint32_t GetEncodedAttributeCacheMissCount() const { return mEncodedAttributeCache.GetMissCount(); }
 #endif
 
     /* ProviderChangeListener implementation */
@@ -155,13 +187,6 @@ private:
 
     bool IsRunScheduled() const { return mRunScheduled; }
 
-    struct AttributePathParamsWithGeneration : public AttributePathParams
-    {
-        AttributePathParamsWithGeneration() {}
-        AttributePathParamsWithGeneration(const AttributePathParams aPath) : AttributePathParams(aPath) {}
-        uint64_t mGeneration = 0;
-    };
-
     /**
      * Build Single Report Data including attribute changes and event data stream, and send out
      *
@@ -174,6 +199,14 @@ private:
                                                  bool aBufferIsUsed, bool * apHasMoreChunks, bool * apHasEncodedData);
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
+    /**
+     * Read and encode one attribute path for the read handler.  Reports driven by dirty paths go through the encoded
+     * attribute cache, so that a value changed once is only read and encoded once for all the subscriptions reporting it.
+     */
+    DataModel::ActionReturnStatus RetrieveClusterData(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aReportBuilder,
+                                                      const ConcreteReadAttributePath & aPath,
+                                                      AttributeEncodeState * apEncoderState);
+
     // If version match, it means don't send, if version mismatch, it means send.
     // If client sends the same path with multiple data versions, client will get the data back per the spec, because at least one
     // of those will fail to match.  This function should return false if either nothing in the list matches the given
@@ -198,39 +231,17 @@ private:
     void GetMinEventLogPosition(uint32_t & aMinLogPosition);
 
     /**
-     * If the provided path is a superset of our of our existing paths, update that existing path to match the
-     * provided path.
-     *
-     * Return whether one of our paths is now a superset of the provided path.
-     */
-    bool MergeOverlappedAttributePath(const AttributePathParams & aAttributePath);
-
-    /**
-     * If we are running out of ObjectPool for the global dirty set, we will try to merge the existing items by clusters.
-     *
-     * Returns whether we have released any paths.
+     * Mark the path dirty in the global dirty set at the current generation.  When the set is full, existing
+     * paths are coarsened (see DirtyPathSet) rather than dropped.
      */
-    bool MergeDirtyPathsUnderSameCluster();
+    CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
-    /**
-     * If we are running out of ObjectPool for the global dirty set and we cannot find a slot after merging the existing items by
-     * clusters, we will try to merge the existing items by endpoints.
-     *
-     * Returns whether we have released any paths.
-     */
-    bool MergeDirtyPathsUnderSameEndpoint();
+    inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
     /**
-     * During the iterating of the paths, releasing the object in the inner loop will cause undefined behavior of the ObjectPool, so
-     * we replace the items to be cleared by a tomb first, then clear all the tombs after the iteration.
-     *
-     * Returns whether we have released any paths.
+     * Rebuild the interest index from all the active read handlers but apExcludedHandler, after it ran out of entries.
      */
-    bool ClearTombPaths();
-
-    CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
-
-    inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
+    void RebuildInterestIndex(const ReadHandler * apExcludedHandler);
 
     /**
      * Boolean to indicate if ScheduleRun is pending. This flag is used to prevent calling ScheduleRun multiple times
@@ -260,12 +271,7 @@ private:
      *  mGlobalDirtySet is used to track the set of attribute/event paths marked dirty for reporting purposes.
      *
      */
-#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
-    // For unit tests, always use inline allocation for code coverage.
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, ObjectPoolMem::kInline> mGlobalDirtySet;
-#else
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
-#endif
+    DirtyPathSet<CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
 
     /**
      * A generation counter for the dirty attrbute set.
@@ -281,6 +287,23 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+#if CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+    /**
+     * Attribute values encoded since the dirty generation last changed, shared by the read handlers reporting them.
+     * Cleared by SetDirty.
+     */
+    EncodedAttributeCache<CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES, CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_MAX_SIZE>
+        mEncodedAttributeCache;
+#endif
+
+    /**
+     * Index of the clusters each read handler is interested in, so that SetDirty only visits the handlers
+     * that can match the changed path.  Every attribute path of every read handler takes at most one entry.
+     */
+    AttributeInterestIndex<ReadHandler,
+                           CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+        mInterestIndex;
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
@@ -155,6 +155,12 @@ ActionReturnStatus RetrieveClusterData(DataModel::Provider * dataModel, const Ac
         }
     }
 
+    // The report holds the DM data, so the engine must not share it if the DM read asked for the subject.
+    if (statusDm.IsSuccess() && encoderState != nullptr && stateDm.DependsOnSubject())
+    {
+        encoderState->SetDependsOnSubject(true);
+    }
+
     DataModelCallbacks::GetInstance()->AttributeOperation(DataModelCallbacks::OperationType::Read,
                                                           DataModelCallbacks::OperationOrder::Post, path);
 
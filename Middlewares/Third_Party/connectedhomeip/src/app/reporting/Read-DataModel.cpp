@@ -69,6 +69,12 @@ DataModel::ActionReturnStatus RetrieveClusterData(DataModel::Provider * dataMode
 
     if (status.IsSuccess())
     {
+        // Lets the reporting engine know whether the value may be shared with other readers.
+        if (encoderState != nullptr)
+        {
+            encoderState->SetDependsOnSubject(attributeValueEncoder.GetState().DependsOnSubject());
+        }
+
         // Odd ifdef is to only do this if the `Read-Check` does not do it already.
 #if !CHIP_CONFIG_USE_EMBER_DATA_MODEL
         // TODO: this callback being only executed on success is awkward. The Write callback is always done
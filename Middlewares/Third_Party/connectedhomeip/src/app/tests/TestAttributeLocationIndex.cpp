@@ -0,0 +1,431 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/util/attribute-location-index.h>
+#include <app/util/endpoint-config-defines.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+#include <string.h>
+
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr uint16_t kFixedEndpointCount   = 4;
+constexpr uint16_t kDynamicEndpointCount = 60;
+constexpr uint16_t kEndpointCount        = kFixedEndpointCount + kDynamicEndpointCount;
+constexpr uint8_t kClustersPerEndpoint   = 8;
+
+// Attributes of clusters on fixed endpoints: mostly internally stored, with a few
+// external and singleton attributes interleaved so that they are skipped when
+// computing storage offsets.
+const EmberAfAttributeMetadata kFixedAttributes[] = {
+    { ZAP_EMPTY_DEFAULT(), 0x0000, 1, ZAP_TYPE(BOOLEAN), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0x0001, 2, ZAP_TYPE(INT16U), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0x0002, 4, ZAP_TYPE(INT32U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0003, 1, ZAP_TYPE(INT8U), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0x0004, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(SINGLETON) },
+    { ZAP_EMPTY_DEFAULT(), 0x0005, 4, ZAP_TYPE(INT32U), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0x0010, 1, ZAP_TYPE(INT8U), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0x0011, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x4000, 1, ZAP_TYPE(BOOLEAN), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0x4001, 2, ZAP_TYPE(INT16U), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0xFFFC, 4, ZAP_TYPE(BITMAP32), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0xFFFD, 2, ZAP_TYPE(INT16U), 0 },
+};
+
+// Attributes of clusters on dynamic endpoints, which are always externally stored.
+const EmberAfAttributeMetadata kDynamicAttributes[] = {
+    { ZAP_EMPTY_DEFAULT(), 0x0000, 1, ZAP_TYPE(BOOLEAN), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0001, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0002, 4, ZAP_TYPE(INT32U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0003, 1, ZAP_TYPE(INT8U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0004, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0005, 4, ZAP_TYPE(INT32U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0010, 1, ZAP_TYPE(INT8U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x0011, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x4000, 1, ZAP_TYPE(BOOLEAN), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0x4001, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0xFFFC, 4, ZAP_TYPE(BITMAP32), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+    { ZAP_EMPTY_DEFAULT(), 0xFFFD, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) },
+};
+
+constexpr uint16_t kAttributesPerCluster = static_cast<uint16_t>(ArraySize(kFixedAttributes));
+
+using TestIndex = AttributeLocationIndex<kEndpointCount * kClustersPerEndpoint * kAttributesPerCluster>;
+
+// Describes a synthetic bridge-like composition: a few fixed endpoints with internally
+// stored attributes, followed by many dynamic endpoints.
+struct TestComposition
+{
+    EmberAfCluster fixedClusters[kClustersPerEndpoint];
+    EmberAfCluster dynamicClusters[kClustersPerEndpoint];
+    EmberAfEndpointType fixedType;
+    EmberAfEndpointType dynamicType;
+    EmberAfDefinedEndpoint endpoints[kEndpointCount];
+
+    TestComposition()
+    {
+        uint16_t clusterSize = 0;
+        for (const auto & am : kFixedAttributes)
+        {
+            if (!am.IsExternal() && !am.IsSingleton())
+            {
+                clusterSize = static_cast<uint16_t>(clusterSize + am.size);
+            }
+        }
+
+        for (uint8_t c = 0; c < kClustersPerEndpoint; c++)
+        {
+            // Every fourth cluster is a client cluster, which must never be indexed.
+            EmberAfClusterMask clusterMask = (c % 4 == 1) ? ZAP_CLUSTER_MASK(CLIENT) : ZAP_CLUSTER_MASK(SERVER);
+            ClusterId clusterId            = static_cast<ClusterId>(0x0006 + c);
+
+            fixedClusters[c]   = { clusterId, kFixedAttributes, kAttributesPerCluster, clusterSize, clusterMask };
+            dynamicClusters[c] = { clusterId, kDynamicAttributes, kAttributesPerCluster, 0, clusterMask };
+        }
+
+        fixedType   = { fixedClusters, kClustersPerEndpoint, static_cast<uint16_t>(clusterSize * kClustersPerEndpoint) };
+        dynamicType = { dynamicClusters, kClustersPerEndpoint, 0 };
+
+        for (uint16_t ep = 0; ep < kEndpointCount; ep++)
+        {
+            endpoints[ep].endpoint     = static_cast<EndpointId>(ep + 1);
+            endpoints[ep].endpointType = (ep < kFixedEndpointCount) ? &fixedType : &dynamicType;
+            endpoints[ep].bitmask.Set(EmberAfEndpointOptions::isEnabled);
+        }
+    }
+};
+
+using Protocols::InteractionModel::Status;
+
+// Composition with the duplicate ids the linear lookup resolves in its own way:
+//  - a disabled fixed endpoint followed by an enabled one with the same id, whose storage offset then skips the
+//    disabled one;
+//  - an endpoint with two server clusters with the same id;
+//  - a disabled dynamic endpoint followed by an enabled one with the same id;
+//  - a dynamic endpoint with the id of an enabled fixed endpoint, which is never reached.
+struct DuplicateComposition
+{
+    static constexpr uint16_t kFixedEndpointCount = 4;
+    static constexpr uint16_t kEndpointCount      = 7;
+    static constexpr uint16_t kShortClusterSize   = 4;
+
+    EmberAfCluster duplicateClusters[2];
+    EmberAfCluster otherCluster;
+    EmberAfEndpointType duplicateClustersType;
+    EmberAfEndpointType otherClusterType;
+    EmberAfDefinedEndpoint endpoints[kEndpointCount];
+    TestComposition base;
+
+    DuplicateComposition()
+    {
+        const EmberAfCluster & fixedCluster = base.fixedClusters[0];
+
+        // The first 4 attributes hold a BOOLEAN, an INT16U and an INT8U, the INT32U is external.
+        duplicateClusters[0]  = { fixedCluster.clusterId, kFixedAttributes, 4, kShortClusterSize, ZAP_CLUSTER_MASK(SERVER) };
+        duplicateClusters[1]  = fixedCluster;
+        otherCluster          = { 0x0100, kDynamicAttributes, kAttributesPerCluster, 0, ZAP_CLUSTER_MASK(SERVER) };
+        duplicateClustersType = { duplicateClusters, 2, static_cast<uint16_t>(kShortClusterSize + fixedCluster.clusterSize) };
+        otherClusterType      = { &otherCluster, 1, 0 };
+
+        const struct
+        {
+            EndpointId id;
+            const EmberAfEndpointType * type;
+            bool enabled;
+        } layout[kEndpointCount] = {
+            { 1, &base.fixedType, true },
+            { 2, &base.fixedType, false },
+            { 2, &base.fixedType, true },
+            { 3, &duplicateClustersType, true },
+            { 10, &base.dynamicType, false },
+            { 10, &base.dynamicType, true },
+            { 1, &otherClusterType, true },
+        };
+
+        for (uint16_t ep = 0; ep < kEndpointCount; ep++)
+        {
+            endpoints[ep].endpoint     = layout[ep].id;
+            endpoints[ep].endpointType = layout[ep].type;
+            endpoints[ep].bitmask.Set(EmberAfEndpointOptions::isEnabled, layout[ep].enabled);
+        }
+    }
+};
+
+// Every lookup through the index resolves to the same status and location as the linear scan.
+template <typename Index>
+void ExpectIndexMatchesScan(const Index & index, const EmberAfDefinedEndpoint * endpoints, uint16_t endpointCount,
+                            uint16_t fixedEndpointCount, EndpointId maxEndpointId)
+{
+    // Include IDs outside of each range, so that misses are covered as well.
+    AttributeId attributeIds[kAttributesPerCluster + 1];
+    for (uint16_t i = 0; i < kAttributesPerCluster; i++)
+    {
+        attributeIds[i] = kFixedAttributes[i].attributeId;
+    }
+    attributeIds[kAttributesPerCluster] = 0x0006;
+
+    ClusterId clusterIds[kClustersPerEndpoint + 2];
+    for (uint8_t c = 0; c <= kClustersPerEndpoint; c++)
+    {
+        clusterIds[c] = static_cast<ClusterId>(0x0006 + c);
+    }
+    clusterIds[kClustersPerEndpoint + 1] = 0x0100;
+
+    for (EndpointId endpointId = 0; endpointId <= maxEndpointId; endpointId++)
+    {
+        for (ClusterId clusterId : clusterIds)
+        {
+            for (AttributeId attributeId : attributeIds)
+            {
+                AttributeLocation expected;
+                Status expectedStatus = ScanAttributeLocation(endpoints, endpointCount, fixedEndpointCount, endpointId, clusterId,
+                                                              attributeId, expected);
+
+                // An index that is not valid finds nothing, and every lookup goes through the scan.
+                const typename Index::Entry * entry = index.Find(endpointId, clusterId, attributeId);
+                ASSERT_EQ(entry != nullptr, index.IsValid() && expectedStatus == Status::Success);
+
+                AttributeLocation location;
+                ASSERT_EQ(index.Locate(endpoints, endpointCount, fixedEndpointCount, endpointId, clusterId, attributeId, location),
+                          expectedStatus);
+                if (expectedStatus != Status::Success)
+                {
+                    continue;
+                }
+
+                EXPECT_EQ(location.metadata, expected.metadata);
+                EXPECT_EQ(location.isDynamicEndpoint, expected.isDynamicEndpoint);
+                const bool stored =
+                    !expected.metadata->IsExternal() && !expected.metadata->IsSingleton() && !expected.isDynamicEndpoint;
+                if (stored)
+                {
+                    EXPECT_EQ(location.storageOffset, expected.storageOffset);
+                }
+                if (entry == nullptr)
+                {
+                    continue;
+                }
+
+                EXPECT_EQ(entry->metadata, expected.metadata);
+                EXPECT_EQ(entry->IsDynamicEndpoint(), expected.isDynamicEndpoint);
+                EXPECT_EQ(entry->IsExternal(), expected.metadata->IsExternal());
+                EXPECT_EQ(entry->IsSingleton(), expected.metadata->IsSingleton());
+                if (stored)
+                {
+                    EXPECT_EQ(entry->storageOffset, expected.storageOffset);
+                }
+            }
+        }
+    }
+}
+
+void ExpectIndexMatchesScan(const TestIndex & index, const TestComposition & composition)
+{
+    ExpectIndexMatchesScan(index, composition.endpoints, kEndpointCount, kFixedEndpointCount, kEndpointCount + 1);
+}
+
+// Locates every internally stored attribute of the enabled fixed endpoints the way emAfReadOrWriteAttribute does, checks
+// that the scan alone (used once the index no longer fits the composition) gives the same location, then writes a
+// distinct value at each location and reads them all back: overlapping locations corrupt at least one of them.
+template <typename Index>
+void ExpectStorageRoundTrip(const Index & index, const EmberAfDefinedEndpoint * endpoints, uint16_t endpointCount,
+                            uint16_t fixedEndpointCount)
+{
+    struct StoredAttribute
+    {
+        uint16_t offset;
+        uint16_t size;
+    };
+    StoredAttribute stored[255];
+    size_t storedCount = 0;
+    uint8_t storage[1024];
+    size_t storageSize = 0;
+
+    for (uint16_t ep = 0; ep < fixedEndpointCount; ep++)
+    {
+        storageSize += endpoints[ep].endpointType->endpointSize;
+    }
+    ASSERT_LE(storageSize, sizeof(storage));
+
+    for (uint16_t ep = 0; ep < fixedEndpointCount; ep++)
+    {
+        if (!endpoints[ep].bitmask.Has(EmberAfEndpointOptions::isEnabled))
+        {
+            continue;
+        }
+        const EmberAfEndpointType * endpointType = endpoints[ep].endpointType;
+        for (uint8_t c = 0; c < endpointType->clusterCount; c++)
+        {
+            const EmberAfCluster & cluster = endpointType->cluster[c];
+            for (uint16_t a = 0; a < cluster.attributeCount; a++)
+            {
+                AttributeLocation location;
+                AttributeLocation scanned;
+                Status status = index.Locate(endpoints, endpointCount, fixedEndpointCount, endpoints[ep].endpoint,
+                                             cluster.clusterId, cluster.attributes[a].attributeId, location);
+                ASSERT_EQ(status,
+                          ScanAttributeLocation(endpoints, endpointCount, fixedEndpointCount, endpoints[ep].endpoint,
+                                                cluster.clusterId, cluster.attributes[a].attributeId, scanned));
+                if (status != Status::Success || location.metadata->IsExternal() || location.metadata->IsSingleton())
+                {
+                    continue;
+                }
+                ASSERT_EQ(location.metadata, scanned.metadata);
+                ASSERT_EQ(location.storageOffset, scanned.storageOffset);
+                ASSERT_LE(location.storageOffset + location.metadata->size, storageSize);
+
+                // Attributes shadowed by an earlier duplicate resolve to the location of that duplicate.
+                bool known = false;
+                for (size_t i = 0; i < storedCount; i++)
+                {
+                    known = known || (stored[i].offset == location.storageOffset);
+                }
+                if (!known)
+                {
+                    ASSERT_LT(storedCount, ArraySize(stored));
+                    stored[storedCount++] = { location.storageOffset, location.metadata->size };
+                }
+            }
+        }
+    }
+    EXPECT_GT(storedCount, 0u);
+
+    for (size_t i = 0; i < storedCount; i++)
+    {
+        memset(&storage[stored[i].offset], static_cast<int>(i + 1), stored[i].size);
+    }
+    for (size_t i = 0; i < storedCount; i++)
+    {
+        for (uint16_t b = 0; b < stored[i].size; b++)
+        {
+            EXPECT_EQ(storage[stored[i].offset + b], static_cast<uint8_t>(i + 1));
+        }
+    }
+}
+
+TEST(TestAttributeLocationIndex, TestMatchesLinearScan)
+{
+    static TestComposition composition;
+    static TestIndex index;
+
+    EXPECT_FALSE(index.IsValid());
+    EXPECT_EQ(index.Find(1, 0x0006, 0x0000), nullptr);
+
+    ASSERT_EQ(index.Build(composition.endpoints, kEndpointCount, kFixedEndpointCount), CHIP_NO_ERROR);
+    EXPECT_TRUE(index.IsValid());
+
+    // Client clusters are not indexed.
+    EXPECT_EQ(index.EntryCount(), kEndpointCount * (kClustersPerEndpoint - kClustersPerEndpoint / 4) * kAttributesPerCluster);
+
+    ExpectIndexMatchesScan(index, composition);
+    ExpectStorageRoundTrip(index, composition.endpoints, kEndpointCount, kFixedEndpointCount);
+}
+
+TEST(TestAttributeLocationIndex, TestRebuildOnEnableDisable)
+{
+    static TestComposition composition;
+    static TestIndex index;
+
+    ASSERT_EQ(index.Build(composition.endpoints, kEndpointCount, kFixedEndpointCount), CHIP_NO_ERROR);
+    EXPECT_NE(index.Find(2, 0x0006, 0), nullptr);
+    EXPECT_NE(index.Find(kFixedEndpointCount + 5, 0x0006, 0), nullptr);
+
+    // Disabling a fixed endpoint must not shift the storage offsets of the endpoints after it.
+    composition.endpoints[1].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
+    composition.endpoints[kFixedEndpointCount + 4].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
+    ASSERT_EQ(index.Build(composition.endpoints, kEndpointCount, kFixedEndpointCount), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Find(2, 0x0006, 0), nullptr);
+    EXPECT_EQ(index.Find(kFixedEndpointCount + 5, 0x0006, 0), nullptr);
+    ExpectIndexMatchesScan(index, composition);
+    ExpectStorageRoundTrip(index, composition.endpoints, kEndpointCount, kFixedEndpointCount);
+
+    composition.endpoints[1].bitmask.Set(EmberAfEndpointOptions::isEnabled);
+    composition.endpoints[kFixedEndpointCount + 4].bitmask.Set(EmberAfEndpointOptions::isEnabled);
+    ASSERT_EQ(index.Build(composition.endpoints, kEndpointCount, kFixedEndpointCount), CHIP_NO_ERROR);
+    EXPECT_NE(index.Find(2, 0x0006, 0), nullptr);
+    EXPECT_NE(index.Find(kFixedEndpointCount + 5, 0x0006, 0), nullptr);
+    ExpectIndexMatchesScan(index, composition);
+}
+
+TEST(TestAttributeLocationIndex, TestDuplicateIds)
+{
+    static DuplicateComposition composition;
+    static TestIndex index;
+    constexpr uint16_t kEndpointCount      = DuplicateComposition::kEndpointCount;
+    constexpr uint16_t kFixedEndpointCount = DuplicateComposition::kFixedEndpointCount;
+    const ClusterId clusterId              = composition.base.fixedClusters[0].clusterId;
+
+    ASSERT_EQ(index.Build(composition.endpoints, kEndpointCount, kFixedEndpointCount), CHIP_NO_ERROR);
+    ExpectIndexMatchesScan(index, composition.endpoints, kEndpointCount, kFixedEndpointCount, 11);
+    ExpectStorageRoundTrip(index, composition.endpoints, kEndpointCount, kFixedEndpointCount);
+
+    // The enabled endpoint 2 does not count the storage of the disabled endpoint 2 before it.
+    AttributeLocation location;
+    ASSERT_EQ(index.Locate(composition.endpoints, kEndpointCount, kFixedEndpointCount, 2, clusterId, 0x0000, location),
+              Status::Success);
+    EXPECT_EQ(location.storageOffset, composition.base.fixedType.endpointSize);
+
+    // Only the first server cluster with a given id is searched.
+    EXPECT_EQ(index.Locate(composition.endpoints, kEndpointCount, kFixedEndpointCount, 3, clusterId, 0x0005, location),
+              Status::UnsupportedAttribute);
+    ASSERT_EQ(index.Locate(composition.endpoints, kEndpointCount, kFixedEndpointCount, 3, clusterId, 0x0003, location),
+              Status::Success);
+    EXPECT_EQ(location.storageOffset, 3 * composition.base.fixedType.endpointSize + 3);
+
+    // The dynamic endpoint 10 is found past its disabled duplicate.
+    ASSERT_EQ(index.Locate(composition.endpoints, kEndpointCount, kFixedEndpointCount, 10, clusterId, 0x0000, location),
+              Status::Success);
+    EXPECT_TRUE(location.isDynamicEndpoint);
+
+    // The dynamic endpoint 1 is shadowed by the enabled fixed endpoint 1.
+    EXPECT_EQ(index.Find(1, 0x0100, 0x0000), nullptr);
+    EXPECT_EQ(index.Locate(composition.endpoints, kEndpointCount, kFixedEndpointCount, 1, 0x0100, 0x0000, location),
+              Status::UnsupportedCluster);
+
+    EXPECT_EQ(index.Locate(composition.endpoints, kEndpointCount, kFixedEndpointCount, 4, clusterId, 0x0000, location),
+              Status::UnsupportedEndpoint);
+}
+
+TEST(TestAttributeLocationIndex, TestCapacityExhausted)
+{
+    static TestComposition composition;
+    AttributeLocationIndex<16> index;
+
+    EXPECT_EQ(index.Build(composition.endpoints, kEndpointCount, kFixedEndpointCount), CHIP_ERROR_NO_MEMORY);
+    EXPECT_FALSE(index.IsValid());
+    EXPECT_EQ(index.Find(1, 0x0006, 0x0000), nullptr);
+
+    // Lookups go through the scan while the index is not valid.
+    ExpectIndexMatchesScan(index, composition.endpoints, kEndpointCount, kFixedEndpointCount, kEndpointCount + 1);
+
+    // The index becomes usable again once the composition fits.
+    EXPECT_EQ(index.Build(composition.endpoints, 1, kFixedEndpointCount), CHIP_ERROR_NO_MEMORY);
+    composition.fixedType.clusterCount = 1;
+    EXPECT_EQ(index.Build(composition.endpoints, 1, kFixedEndpointCount), CHIP_NO_ERROR);
+    EXPECT_TRUE(index.IsValid());
+    EXPECT_EQ(index.EntryCount(), kAttributesPerCluster);
+}
+
+} // namespace
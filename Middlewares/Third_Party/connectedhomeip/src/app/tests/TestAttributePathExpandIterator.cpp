@@ -21,7 +21,10 @@
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
 #include <app/codegen-data-model-provider/Instance.h>
+#include <app/reporting/DirtyPathSet.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
@@ -365,4 +368,128 @@ TEST(TestAttributePathExpandIterator, TestMultipleClusInfo)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
+TEST(TestAttributePathExpandIterator, TestDirtyPathFilter)
+{
+    SingleLinkedListNode<app::AttributePathParams> clusInfo;
+    SingleLinkedListNode<app::AttributePathParams> clusInfo1;
+
+    // A concrete path is emitted as-is, even if it is not dirty.
+    clusInfo.mValue  = app::AttributePathParams(kMockEndpoint2, MockClusterId(3), MockAttributeId(3));
+    clusInfo.mpNext  = &clusInfo1;
+    clusInfo1.mValue = app::AttributePathParams();
+
+    reporting::DirtyPathSet<4> dirtySet;
+    EXPECT_EQ(dirtySet.Insert(app::AttributePathParams(kMockEndpoint3, MockClusterId(4), MockAttributeId(1)), 1), CHIP_NO_ERROR);
+    EXPECT_EQ(dirtySet.Insert(app::AttributePathParams(kMockEndpoint1, MockClusterId(2)), 2), CHIP_NO_ERROR);
+
+    P paths[] = {
+        { kMockEndpoint2, MockClusterId(3), MockAttributeId(3) },
+        { kMockEndpoint1, MockClusterId(2), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint1, MockClusterId(2), Clusters::Globals::Attributes::FeatureMap::Id },
+        { kMockEndpoint1, MockClusterId(2), MockAttributeId(1) },
+        { kMockEndpoint1, MockClusterId(2), Clusters::Globals::Attributes::GeneratedCommandList::Id },
+        { kMockEndpoint1, MockClusterId(2), Clusters::Globals::Attributes::AcceptedCommandList::Id },
+        { kMockEndpoint1, MockClusterId(2), Clusters::Globals::Attributes::AttributeList::Id },
+    };
+
+    // Only the paths marked dirty after generation 1 are of interest.
+    reporting::DirtyPathFilter<4> filter(dirtySet, 1);
+    app::AttributePathExpandIterator iter(CodegenDataModelProviderInstance(), &clusInfo);
+    iter.SetFilter(&filter);
+
+    app::ConcreteAttributePath path;
+    size_t index = 0;
+    for (; iter.Get(path); iter.Next())
+    {
+        EXPECT_LT(index, ArraySize(paths));
+        EXPECT_EQ(paths[index], path);
+        index++;
+    }
+    EXPECT_EQ(index, ArraySize(paths));
+
+    // Nothing was marked dirty after generation 2.
+    reporting::DirtyPathFilter<4> noChangeFilter(dirtySet, 2);
+    iter.SetFilter(&noChangeFilter);
+    iter.ResetTo(&clusInfo1);
+    EXPECT_FALSE(iter.Get(path));
+
+    // Without a filter, every path is emitted again.
+    iter.SetFilter(nullptr);
+    iter.ResetTo(&clusInfo1);
+    index = 0;
+    for (; iter.Get(path); iter.Next())
+    {
+        index++;
+    }
+    EXPECT_EQ(index, 56u);
+}
+
+// 16 endpoints with 8 clusters of 5 attributes each (8 paths per cluster, with the global attributes not in metadata).
+#define LARGE_CLUSTER(id)                                                                                                          \
+    MockClusterConfig(MockClusterId(id),                                                                                           \
+                      { Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id,         \
+                        MockAttributeId(1), MockAttributeId(2), MockAttributeId(3) })
+#define LARGE_ENDPOINT(id)                                                                                                         \
+    MockEndpointConfig(id,                                                                                                         \
+                       { LARGE_CLUSTER(1), LARGE_CLUSTER(2), LARGE_CLUSTER(3), LARGE_CLUSTER(4), LARGE_CLUSTER(5),                 \
+                         LARGE_CLUSTER(6), LARGE_CLUSTER(7), LARGE_CLUSTER(8) })
+
+TEST(TestAttributePathExpandIterator, TestDirtyPathFilterLargeComposition)
+{
+    static const MockNodeConfig largeConfig({
+        LARGE_ENDPOINT(1), LARGE_ENDPOINT(2), LARGE_ENDPOINT(3), LARGE_ENDPOINT(4), LARGE_ENDPOINT(5), LARGE_ENDPOINT(6),
+        LARGE_ENDPOINT(7), LARGE_ENDPOINT(8), LARGE_ENDPOINT(9), LARGE_ENDPOINT(10), LARGE_ENDPOINT(11), LARGE_ENDPOINT(12),
+        LARGE_ENDPOINT(13), LARGE_ENDPOINT(14), LARGE_ENDPOINT(15), LARGE_ENDPOINT(16),
+    });
+    SetMockNodeConfig(largeConfig);
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo;
+    clusInfo.mValue = app::AttributePathParams();
+
+    // One attribute changed since the last report, as in the typical subscription report.
+    const app::ConcreteAttributePath changed(12, MockClusterId(5), MockAttributeId(2));
+    reporting::DirtyPathSet<8> dirtySet;
+    EXPECT_EQ(dirtySet.Insert(app::AttributePathParams(changed.mEndpointId, changed.mClusterId, changed.mAttributeId), 2),
+              CHIP_NO_ERROR);
+    reporting::DirtyPathFilter<8> filter(dirtySet, 1);
+
+    // Count the paths emitted and the dirty ones among them, the way the reporting engine visits them.
+    auto visit = [&](app::AttributePathExpandFilter * aFilter, size_t & emitted, size_t & dirty) {
+        app::AttributePathExpandIterator iter(CodegenDataModelProviderInstance(), nullptr);
+        iter.SetFilter(aFilter);
+        iter.ResetTo(&clusInfo);
+        app::ConcreteAttributePath path;
+        for (; iter.Get(path); iter.Next())
+        {
+            emitted++;
+            dirtySet.ForEach([&](auto * dirtyPath) {
+                if (dirtyPath->IsAttributePathSupersetOf(path) && dirtyPath->mGeneration > 1)
+                {
+                    dirty++;
+                    return Loop::Break;
+                }
+                return Loop::Continue;
+            });
+        }
+    };
+
+    size_t emitted = 0;
+    size_t dirty   = 0;
+    visit(nullptr, emitted, dirty);
+    EXPECT_EQ(emitted, 16u * 8u * 8u);
+    EXPECT_EQ(dirty, 1u);
+
+    // Only the changed cluster is expanded, and the changed attribute is still reported.
+    emitted = 0;
+    dirty   = 0;
+    visit(&filter, emitted, dirty);
+    EXPECT_EQ(emitted, 8u);
+    EXPECT_EQ(dirty, 1u);
+
+    ResetMockNodeConfig();
+}
+
+#undef LARGE_ENDPOINT
+#undef LARGE_CLUSTER
+
 } // namespace
@@ -26,6 +26,7 @@
 #include <app/EventLoggingTypes.h>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
+#include <app/MessageDef/EventReportIB.h>
 #include <app/tests/AppTestContext.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
@@ -35,12 +36,17 @@
 #include <lib/support/CHIPCounter.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/EnforceFormat.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/logging/Constants.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 #include <lib/core/StringBuilderAdapters.h>
 #include <pw_unit_test/framework.h>
 
@@ -96,6 +102,18 @@ public:
     }
 };
 
+class CountingEventGenerator : public TestEventGenerator
+{
+public:
+    CHIP_ERROR WriteEvent(chip::TLV::TLVWriter & aWriter)
+    {
+        mWriteCount++;
+        return TestEventGenerator::WriteEvent(aWriter);
+    }
+
+    uint32_t mWriteCount = 0;
+};
+
 TEST_F(TestEventOverflow, TestCheckLogEventOverFlow)
 {
     chip::EventNumber oldEid = 0;
@@ -157,4 +175,121 @@ TEST_F(TestEventOverflow, TestCheckLogEventOverFlow)
     }
 }
 
+// Fetches the events numbered aEventMin or more, and collects their numbers into aEventNumbers.
+static void FetchEventNumbers(chip::EventNumber & aEventMin, std::vector<chip::EventNumber> & aEventNumbers)
+{
+    chip::SingleLinkedListNode<chip::app::EventPathParams> path;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> backingStore;
+    chip::TLV::TLVWriter writer;
+    chip::TLV::TLVReader reader;
+    size_t eventCount = 0;
+
+    VerifyOrDie(backingStore.Alloc(8192));
+    writer.Init(backingStore.Get(), 8192);
+    EXPECT_EQ(chip::app::EventManagement::GetInstance().FetchEventsSince(writer, &path, aEventMin, eventCount,
+                                                                        chip::Access::SubjectDescriptor{}),
+              CHIP_NO_ERROR);
+
+    aEventNumbers.clear();
+    reader.Init(backingStore.Get(), writer.GetLengthWritten());
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        chip::app::EventReportIB::Parser report;
+        chip::app::EventDataIB::Parser data;
+        chip::EventNumber number = 0;
+        EXPECT_EQ(report.Init(reader), CHIP_NO_ERROR);
+        EXPECT_EQ(report.GetEventData(&data), CHIP_NO_ERROR);
+        EXPECT_EQ(data.GetEventNumber(&number), CHIP_NO_ERROR);
+        aEventNumbers.push_back(number);
+    }
+    EXPECT_EQ(aEventNumbers.size(), eventCount);
+}
+
+TEST_F(TestEventOverflow, TestLogEventEncodesOnce)
+{
+    constexpr uint32_t kEventCount = 200;
+    chip::EventNumber firstEid     = 0;
+    chip::EventNumber eid          = 0;
+    chip::app::EventOptions options;
+    CountingEventGenerator testEventGenerator;
+
+    options.mPath = { 1, 0x00000006, 1 };
+
+    // The buffers are full after a few dozen events, so most of the events below evict older ones, some of which are
+    // moved to the next buffer first.
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    for (uint32_t i = 0; i < kEventCount; i++)
+    {
+        chip::EventNumber previousEid = eid;
+        options.mPriority             = (i % 4 == 0) ? chip::app::PriorityLevel::Critical : chip::app::PriorityLevel::Debug;
+        EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eid), CHIP_NO_ERROR);
+        if (i == 0)
+        {
+            firstEid = eid;
+        }
+        else
+        {
+            EXPECT_EQ(eid, previousEid + 1);
+        }
+    }
+
+    // Each event is encoded once, however many times it is moved between buffers.
+    EXPECT_EQ(testEventGenerator.mWriteCount, kEventCount);
+
+    // The oldest events were evicted, the events left read back in order, up to the last one.
+    std::vector<chip::EventNumber> events;
+    chip::EventNumber eventMin = 0;
+    FetchEventNumbers(eventMin, events);
+    ASSERT_FALSE(events.empty());
+    EXPECT_GT(events.front(), firstEid);
+    EXPECT_EQ(events.back(), eid);
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end()));
+    EXPECT_EQ(std::adjacent_find(events.begin(), events.end()), events.end());
+}
+
+TEST_F(TestEventOverflow, TestFetchEventsSinceSkipsOldEvents)
+{
+    chip::EventNumber eid = 0;
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+
+    options.mPath = { 1, 0x00000006, 1 };
+
+    // Fill the buffers several times, so that the events wrap around the buffer storages and are moved between buffers.
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        options.mPriority = (i % 4 == 0) ? chip::app::PriorityLevel::Critical : chip::app::PriorityLevel::Debug;
+        EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eid), CHIP_NO_ERROR);
+    }
+
+    // Reading from the oldest event does not skip anything.
+    std::vector<chip::EventNumber> allEvents;
+    chip::EventNumber nextEventMin = 0;
+    uint64_t skippedBytes          = logMgmt.GetSkippedEventBytes();
+    FetchEventNumbers(nextEventMin, allEvents);
+    ASSERT_GT(allEvents.size(), 20u);
+    EXPECT_EQ(allEvents.back(), eid);
+    EXPECT_EQ(nextEventMin, eid + 1);
+    EXPECT_EQ(logMgmt.GetSkippedEventBytes(), skippedBytes);
+
+    // Other reads only go through the events they need, and fetch the same events as a full scan. Debug events are
+    // dropped when evicted, so some of the event numbers below are not in the buffers anymore.
+    for (chip::EventNumber since : { allEvents[1], allEvents[allEvents.size() / 2], eid - 100, eid - 10, eid, eid + 1 })
+    {
+        std::vector<chip::EventNumber> expected;
+        std::vector<chip::EventNumber> events;
+        chip::EventNumber next = since;
+
+        std::copy_if(allEvents.begin(), allEvents.end(), std::back_inserter(expected),
+                     [since](chip::EventNumber number) { return number >= since; });
+        FetchEventNumbers(next, events);
+        EXPECT_EQ(events, expected);
+        EXPECT_EQ(next, eid + 1);
+    }
+    EXPECT_GT(logMgmt.GetSkippedEventBytes(), skippedBytes);
+    ChipLogProgress(EventLogging, "%u events in the buffers, the event index saved reading %u bytes",
+                    static_cast<unsigned>(allEvents.size()), static_cast<unsigned>(logMgmt.GetSkippedEventBytes() - skippedBytes));
+}
+
 } // namespace
@@ -22,10 +22,13 @@
  *
  */
 
+#include <algorithm>
 #include <cinttypes>
 
 #include <pw_unit_test/framework.h>
 
+#include <access/examples/PermissiveAccessControlDelegate.h>
+#include <app/AttributeValueEncoder.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/InteractionModelEngine.h>
 #include <app/codegen-data-model-provider/Instance.h>
@@ -98,6 +101,9 @@ public:
     void TestBuildAndSendSingleReportData();
     void TestMergeOverlappedAttributePath();
     void TestMergeAttributePathWhenDirtySetPoolExhausted();
+    void TestSetDirtyInterestIndex();
+    void TestEncodedAttributeCache();
+    void TestEncodedAttributeCacheRetrieveClusterData();
 
 private:
     chip::app::DataModel::Provider * mOldProvider = nullptr;
@@ -131,13 +137,75 @@ public:
     }
 };
 
+#if CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+// Denies every request of the subjects of one fabric.
+class DenyFabricAccessControlDelegate : public AccessControl::Delegate
+{
+public:
+    CHIP_ERROR Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                     Privilege requestPrivilege) override
+    {
+        return (subjectDescriptor.fabricIndex == mDeniedFabricIndex) ? CHIP_ERROR_ACCESS_DENIED : CHIP_NO_ERROR;
+    }
+
+    FabricIndex mDeniedFabricIndex = kUndefinedFabricIndex;
+} gDenyFabricAccessControlDelegate;
+
+class TestDeviceTypeResolver : public AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+} gDeviceTypeResolver;
+
+// Serves kTestFieldId1 as a value shared by all readers and kTestFieldId2 as the accessing fabric index, checking the access
+// of the subject like the codegen data model does.
+class EncodedAttributeCacheDataModel : public TestImCustomDataModel
+{
+public:
+    std::optional<DataModel::ClusterInfo> GetClusterInfo(const ConcreteClusterPath & path) override
+    {
+        std::optional<DataModel::ClusterInfo> info = TestImCustomDataModel::GetClusterInfo(path);
+        if (info.has_value())
+        {
+            info->dataVersion = mDataVersion;
+        }
+        return info;
+    }
+
+    DataModel::ActionReturnStatus ReadAttribute(const DataModel::ReadAttributeRequest & request,
+                                                AttributeValueEncoder & encoder) override
+    {
+        RequestPath requestPath{ .cluster     = request.path.mClusterId,
+                                 .endpoint    = request.path.mEndpointId,
+                                 .requestType = RequestType::kAttributeReadRequest,
+                                 .entityId    = request.path.mAttributeId };
+        if (GetAccessControl().Check(request.subjectDescriptor.value_or(SubjectDescriptor()), requestPath, Privilege::kView) !=
+            CHIP_NO_ERROR)
+        {
+            return Protocols::InteractionModel::Status::UnsupportedAccess;
+        }
+
+        mReadCount++;
+        if (request.path.mAttributeId == kTestFieldId2)
+        {
+            return encoder.Encode(encoder.AccessingFabricIndex());
+        }
+        return encoder.Encode(mValue);
+    }
+
+    DataVersion mDataVersion = Test::kTestDataVersion1;
+    uint8_t mValue           = 1;
+    unsigned mReadCount      = 0;
+};
+#endif // CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+
 template <typename... Args>
 bool TestReportingEngine::VerifyDirtySetContent(const Args &... args)
 {
     const int size                        = sizeof...(args);
     ExpectedDirtySetContent content[size] = { ExpectedDirtySetContent(args)... };
 
-    if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
+    if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEach([&](auto * path) {
             for (int i = 0; i < size; i++)
             {
                 if (static_cast<AttributePathParams>(content[i]) == static_cast<AttributePathParams>(*path))
@@ -169,11 +237,11 @@ bool TestReportingEngine::VerifyDirtySetContent(const Args &... args)
 
 bool TestReportingEngine::InsertToDirtySet(const AttributePathParams & aPath)
 {
-    auto path = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    VerifyOrReturnError(path != nullptr, false);
-    *path             = aPath;
-    path->mGeneration = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
-    return true;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    size_t size     = engine.GetGlobalDirtySetSize();
+    VerifyOrReturnError(engine.InsertPathIntoDirtySet(aPath) == CHIP_NO_ERROR, false);
+    // The path must have been added as-is, without merging.
+    return engine.GetGlobalDirtySetSize() == size + 1;
 }
 
 TEST_F_FROM_FIXTURE(TestReportingEngine, TestBuildAndSendSingleReportData)
@@ -224,53 +292,40 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeOverlappedAttributePath)
                                                           app::reporting::GetDefaultReportScheduler()),
               CHIP_NO_ERROR);
 
-    AttributePathParams * clusterInfo = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    clusterInfo->mEndpointId          = 1;
-    clusterInfo->mClusterId           = 1;
-    clusterInfo->mAttributeId         = 1;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.mGlobalDirtySet.Clear();
 
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = 1;
-        testClusterInfo.mClusterId   = 1;
-        testClusterInfo.mAttributeId = 3;
-        EXPECT_FALSE(InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-    }
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = 1;
-        testClusterInfo.mClusterId   = 1;
-        testClusterInfo.mAttributeId = 1;
-        testClusterInfo.mListIndex   = 2;
-        EXPECT_TRUE(InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-    }
+    EXPECT_TRUE(InsertToDirtySet(AttributePathParams(1, 1, 1)));
 
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = 1;
-        testClusterInfo.mClusterId   = 1;
-        testClusterInfo.mAttributeId = kInvalidAttributeId;
-        EXPECT_TRUE(InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-    }
+    // A path covered by an existing path only refreshes the generation of that path.
+    engine.BumpDirtySetGeneration();
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams(1, 1, 1, 2)), CHIP_NO_ERROR);
+    EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(1, 1, 1)));
+    engine.mGlobalDirtySet.ForEach([&](auto * path) {
+        EXPECT_EQ(path->mGeneration, engine.GetDirtySetGeneration());
+        return Loop::Continue;
+    });
 
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mClusterId   = kInvalidClusterId;
-        testClusterInfo.mAttributeId = kInvalidAttributeId;
-        EXPECT_TRUE(InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        EXPECT_TRUE(clusterInfo->mClusterId == kInvalidClusterId && clusterInfo->mAttributeId == kInvalidAttributeId);
-    }
+    // A path that does not overlap is added.
+    EXPECT_TRUE(InsertToDirtySet(AttributePathParams(1, 1, 3)));
+    EXPECT_TRUE(InsertToDirtySet(AttributePathParams(2, 1, 1)));
+    EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(1, 1, 1), AttributePathParams(1, 1, 3), AttributePathParams(2, 1, 1)));
 
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = kInvalidEndpointId;
-        testClusterInfo.mClusterId   = kInvalidClusterId;
-        testClusterInfo.mAttributeId = kInvalidAttributeId;
-        EXPECT_TRUE(InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        EXPECT_TRUE(clusterInfo->mEndpointId == kInvalidEndpointId && clusterInfo->mClusterId == kInvalidClusterId &&
-                    clusterInfo->mAttributeId == kInvalidAttributeId);
-    }
-    InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
+    // A path covering existing paths replaces all of them.
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams(EndpointId(1), ClusterId(1))), CHIP_NO_ERROR);
+    EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(EndpointId(1), ClusterId(1)), AttributePathParams(2, 1, 1)));
+
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams(1)), CHIP_NO_ERROR);
+    EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(1), AttributePathParams(2, 1, 1)));
+
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams(ClusterId(1), kInvalidAttributeId)), CHIP_NO_ERROR);
+    EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(1), AttributePathParams(ClusterId(1), kInvalidAttributeId)));
+
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams()), CHIP_NO_ERROR);
+    EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams()));
+
+    EXPECT_EQ(engine.GetDirtySetDegradeCount(), 0u);
+    engine.Shutdown();
 }
 
 TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolExhausted)
@@ -279,8 +334,9 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
                                                           app::reporting::GetDefaultReportScheduler()),
               CHIP_NO_ERROR);
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
     InteractionModelEngine::GetInstance()->GetReportingEngine().BumpDirtySetGeneration();
+    uint32_t degradeCount = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetDegradeCount();
 
     // Case 1: All dirty paths including the new one are under the same cluster.
     // -> Expected behavior: The dirty set is replaced by a wildcard attribute path under the same cluster.
@@ -293,7 +349,7 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
                   AttributePathParams(kTestEndpointId, kTestClusterId, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1)));
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 2: All dirty paths including the new one are under the same endpoint.
     // -> Expected behavior: The dirty set is replaced by a wildcard cluster path under the same endpoint.
@@ -306,10 +362,11 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
                   AttributePathParams(kTestEndpointId, ClusterId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1)));
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
-    // Case 3: All dirty paths including the new one are under the different endpoints.
-    // -> Expected behavior: The dirty set is replaced by a wildcard endpoint.
+    // Case 3: All dirty paths including the new one are under different endpoints, but the new one shares its cluster with
+    // an existing one.
+    // -> Expected behavior: The paths of that cluster are merged into a wildcard endpoint path, the others are kept.
     for (EndpointId i = 1; i <= CHIP_IM_SERVER_MAX_NUM_DIRTY_SET; i++)
     {
         EXPECT_TRUE(InsertToDirtySet(AttributePathParams(EndpointId(i), i, i)));
@@ -317,9 +374,30 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     EXPECT_EQ(CHIP_NO_ERROR,
               InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
                   AttributePathParams(EndpointId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1, 1)));
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetReportingEngine().GetGlobalDirtySetSize(),
+              size_t(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET));
+    EXPECT_TRUE(InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEach([](auto * path) {
+        bool untouched = path->mEndpointId != 1 && path->mEndpointId == path->mClusterId && path->mClusterId == path->mAttributeId;
+        return (untouched || *path == AttributePathParams(ClusterId(1), AttributeId(1))) ? Loop::Continue : Loop::Break;
+    }) == Loop::Finish);
+
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
+
+    // Case 3b: All dirty paths including the new one are under different endpoints and different clusters.
+    // -> Expected behavior: The dirty set is replaced by a wildcard endpoint.
+    for (EndpointId i = 1; i <= CHIP_IM_SERVER_MAX_NUM_DIRTY_SET; i++)
+    {
+        EXPECT_TRUE(InsertToDirtySet(AttributePathParams(EndpointId(i), i, i)));
+    }
+    uint32_t globalWildcardCount = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGlobalWildcardCount();
+    EXPECT_EQ(CHIP_NO_ERROR,
+              InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(AttributePathParams(
+                  EndpointId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1, 1)));
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams()));
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGlobalWildcardCount(),
+              globalWildcardCount + 1);
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 4: All existing dirty paths are under the same cluster, the new path comes from another cluster.
     // -> Expected behavior: The existing paths are merged into one single wildcard attribute path. New path is inserted
@@ -334,7 +412,7 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId),
                                       AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 5: All existing dirty paths are under the same endpoint, the new path comes from another endpoint.
     // -> Expected behavior: The existing paths are merged into one single wildcard cluster path. New path is inserted as-is.
@@ -348,9 +426,336 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId),
                                       AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
+    // Every case had to coarsen the full set once.
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetDegradeCount(), degradeCount + 6);
+
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestSetDirtyInterestIndex)
+{
+    // One exchange is left for the test context itself.
+    constexpr size_t kHandlerCount =
+        std::min<size_t>(CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS - 1);
+    constexpr size_t kClustersPerHandler = 3;
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    ReadHandler * handlers[kHandlerCount];
+
+    // Handler i is interested in a few clusters of endpoint i, except for the last one which subscribes to a
+    // wildcard endpoint.
+    for (size_t i = 0; i < kHandlerCount; i++)
+    {
+        handlers[i] = InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+            dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Subscribe,
+            app::reporting::GetDefaultReportScheduler(), CodegenDataModelProviderInstance());
+        ASSERT_NE(handlers[i], nullptr);
+
+        for (size_t c = 0; c < kClustersPerHandler; c++)
+        {
+            AttributePathParams path(static_cast<EndpointId>(i), static_cast<ClusterId>(kTestClusterId + c), kTestFieldId1);
+            if (i == kHandlerCount - 1 && c == 0)
+            {
+                path.SetWildcardEndpointId();
+            }
+            EXPECT_EQ(InteractionModelEngine::GetInstance()->PushFrontAttributePathList(handlers[i]->mpAttributePathList, path),
+                      CHIP_NO_ERROR);
+        }
+        engine.RegisterInterestPaths(*handlers[i]);
+    }
+
+    EXPECT_TRUE(engine.mInterestIndex.IsValid());
+    EXPECT_EQ(engine.mInterestIndex.EntryCount(), (kHandlerCount - 1) * kClustersPerHandler + 1);
+
+    // A change on endpoint 0 can only match handler 0 and the wildcard handler.
+    size_t candidates = 0;
+    engine.mInterestIndex.ForEachCandidate(0, kTestClusterId, [&](ReadHandler * handler) {
+        EXPECT_TRUE(handler == handlers[0] || handler == handlers[kHandlerCount - 1]);
+        candidates++;
+    });
+    EXPECT_EQ(candidates, 2u);
+
+    // A change on (e, kTestClusterId + 1) only intersects the paths of handler e: the candidates of the index hold that
+    // handler, and no other candidate is interested in the change.
+    for (size_t e = 0; e < kHandlerCount; e++)
+    {
+        AttributePathParams changed(static_cast<EndpointId>(e), kTestClusterId + 1, kTestFieldId1);
+        bool handlerFound = false;
+        engine.mInterestIndex.ForEachCandidate(changed.mEndpointId, changed.mClusterId, [&](ReadHandler * handler) {
+            EXPECT_TRUE(handler == handlers[e] || handler == handlers[kHandlerCount - 1]);
+            if (handler == handlers[e])
+            {
+                handlerFound = true;
+                return;
+            }
+            for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+            {
+                EXPECT_FALSE(object->mValue.Intersects(changed));
+            }
+        });
+        EXPECT_TRUE(handlerFound);
+        EXPECT_EQ(engine.SetDirty(changed), CHIP_NO_ERROR);
+    }
+
+    for (auto * handler : handlers)
+    {
+        InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(handler);
+    }
+    EXPECT_EQ(engine.mInterestIndex.EntryCount(), 0u);
+
+    DrainAndServiceIO();
+    engine.Shutdown();
+}
+
+#if CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestEncodedAttributeCache)
+{
+    using Cache = EncodedAttributeCache<2, 64>;
+    constexpr DataVersion kVersion = 5;
+
+    const ConcreteAttributePath path1(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    const ConcreteAttributePath path2(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    const ConcreteAttributePath path3(kTestEndpointId, kTestClusterId + 1, kTestFieldId1);
+    const CharSpan kValue = "a value shared by all"_span;
+
+    // Encodes an AttributeReportIBs array the way the engine does, with either a plain value or the accessing fabric index.
+    auto encode = [&](uint8_t * buffer, size_t size, const ConcreteAttributePath & path, bool useSubject,
+                      AttributeEncodeState & state, size_t & length) -> CHIP_ERROR {
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        Access::SubjectDescriptor subject;
+        subject.fabricIndex = 1;
+        writer.Init(buffer, size);
+        ReturnErrorOnFailure(builder.Init(&writer));
+        AttributeValueEncoder encoder(builder, subject, path, kVersion, /* aIsFabricFiltered = */ true, state);
+        ReturnErrorOnFailure(useSubject ? encoder.Encode(encoder.AccessingFabricIndex()) : encoder.Encode(kValue));
+        state = encoder.GetState();
+        ReturnErrorOnFailure(builder.EndOfAttributeReportIBs());
+        ReturnErrorOnFailure(writer.Finalize());
+        length = writer.GetLengthWritten();
+        return CHIP_NO_ERROR;
+    };
+
+    Cache cache;
+    AttributeEncodeState state;
+    size_t length = 0;
+
+    // A plain value is shared, with the data version it was encoded with.
+    Cache::Entry & entry1 = cache.Allocate(path1);
+    EXPECT_EQ(encode(entry1.mData, sizeof(entry1.mData), path1, false, state, length), CHIP_NO_ERROR);
+    EXPECT_FALSE(state.DependsOnSubject());
+    EXPECT_EQ(cache.Share(entry1, length), CHIP_NO_ERROR);
+    ASSERT_EQ(cache.Find(path1), &entry1);
+    EXPECT_TRUE(entry1.IsShared());
+    EXPECT_EQ(entry1.mDataVersion, kVersion);
+
+    // Copying the entry into a report produces the bytes a regular read would.
+    uint8_t expected[64];
+    size_t expectedLength = 0;
+    AttributeEncodeState expectedState;
+    EXPECT_EQ(encode(expected, sizeof(expected), path1, false, expectedState, expectedLength), CHIP_NO_ERROR);
+
+    uint8_t report[64];
+    TLV::TLVWriter reportWriter;
+    AttributeReportIBs::Builder reportBuilder;
+    reportWriter.Init(report, sizeof(report));
+    EXPECT_EQ(reportBuilder.Init(&reportWriter), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.CopySharedAttributeReport(entry1, *reportBuilder.GetWriter()), CHIP_NO_ERROR);
+    EXPECT_EQ(reportBuilder.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+    EXPECT_EQ(reportWriter.Finalize(), CHIP_NO_ERROR);
+    ASSERT_EQ(reportWriter.GetLengthWritten(), expectedLength);
+    EXPECT_EQ(memcmp(report, expected, expectedLength), 0);
+
+    // So does copying the encoded array element by element.
+    reportWriter.Init(report, sizeof(report));
+    EXPECT_EQ(reportBuilder.Init(&reportWriter), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.CopyAttributeReports(expected, expectedLength, *reportBuilder.GetWriter()), CHIP_NO_ERROR);
+    EXPECT_EQ(reportBuilder.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+    EXPECT_EQ(reportWriter.Finalize(), CHIP_NO_ERROR);
+    ASSERT_EQ(reportWriter.GetLengthWritten(), expectedLength);
+    EXPECT_EQ(memcmp(report, expected, expectedLength), 0);
+
+    // A copy that does not fit fails, so that the engine rolls it back like any out of space encoding.
+    uint8_t smallReport[8];
+    reportWriter.Init(smallReport, sizeof(smallReport));
+    EXPECT_EQ(reportBuilder.Init(&reportWriter), CHIP_NO_ERROR);
+    EXPECT_NE(cache.CopySharedAttributeReport(entry1, *reportBuilder.GetWriter()), CHIP_NO_ERROR);
+
+    // Asking the encoder for the subject marks the value as specific to it.
+    AttributeEncodeState subjectState;
+    Cache::Entry & entry2 = cache.Allocate(path2);
+    EXPECT_EQ(encode(entry2.mData, sizeof(entry2.mData), path2, true, subjectState, length), CHIP_NO_ERROR);
+    EXPECT_TRUE(subjectState.DependsOnSubject());
+    subjectState.Reset();
+    EXPECT_TRUE(subjectState.DependsOnSubject());
+
+    // An array without attribute data (e.g. the subject was denied an expanded path) is not shared.
+    TLV::TLVWriter emptyWriter;
+    AttributeReportIBs::Builder emptyBuilder;
+    emptyWriter.Init(entry2.mData, sizeof(entry2.mData));
+    EXPECT_EQ(emptyBuilder.Init(&emptyWriter), CHIP_NO_ERROR);
+    EXPECT_EQ(emptyBuilder.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+    EXPECT_EQ(emptyWriter.Finalize(), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.Share(entry2, emptyWriter.GetLengthWritten()), CHIP_ERROR_INCORRECT_STATE);
+    ASSERT_EQ(cache.Find(path2), &entry2);
+    EXPECT_FALSE(entry2.IsShared());
+
+    // An entry holding the value of another path is not shared either.
+    EXPECT_EQ(encode(entry2.mData, sizeof(entry2.mData), path1, false, state, length), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.Share(entry2, length), CHIP_ERROR_INCORRECT_STATE);
+
+    // The oldest entry is replaced when the cache is full.
+    cache.Allocate(path3);
+    EXPECT_EQ(cache.Find(path1), nullptr);
+    EXPECT_NE(cache.Find(path2), nullptr);
+    EXPECT_NE(cache.Find(path3), nullptr);
+    cache.Clear();
+    EXPECT_EQ(cache.Find(path2), nullptr);
+    EXPECT_EQ(cache.Find(path3), nullptr);
+
+    // Marking any attribute dirty empties the cache of the engine.
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.mEncodedAttributeCache.Allocate(path1);
+    EXPECT_NE(engine.mEncodedAttributeCache.Find(path1), nullptr);
+    EXPECT_EQ(engine.SetDirty(AttributePathParams(kTestEndpointId, kTestClusterId + 1, kTestFieldId2)), CHIP_NO_ERROR);
+    EXPECT_EQ(engine.mEncodedAttributeCache.Find(path1), nullptr);
+
+    engine.Shutdown();
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestEncodedAttributeCacheRetrieveClusterData)
+{
+    struct Report
+    {
+        uint8_t mData[128];
+        size_t mLength = 0;
+
+        bool operator==(const Report & other) const
+        {
+            return mLength == other.mLength && memcmp(mData, other.mData, mLength) == 0;
+        }
+    };
+
+    EncodedAttributeCacheDataModel model;
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    InteractionModelEngine::GetInstance()->SetDataModelProvider(&model);
+    GetAccessControl().Finish();
+    EXPECT_EQ(GetAccessControl().Init(&gDenyFabricAccessControlDelegate, gDeviceTypeResolver), CHIP_NO_ERROR);
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+
+    // Two subscriptions past their priming reports, from subjects of different fabrics.
+    ReadHandler * handlers[2] = {
+        InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+            dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Subscribe,
+            app::reporting::GetDefaultReportScheduler(), &model),
+        InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+            dummy, NewExchangeToBob(&delegate), ReadHandler::InteractionType::Subscribe,
+            app::reporting::GetDefaultReportScheduler(), &model),
+    };
+    for (auto * handler : handlers)
+    {
+        ASSERT_NE(handler, nullptr);
+        handler->mFlags.Clear(ReadHandler::ReadHandlerFlags::PrimingReports);
+    }
+    ASSERT_NE(handlers[0]->GetSubjectDescriptor().fabricIndex, handlers[1]->GetSubjectDescriptor().fabricIndex);
+
+    // Reads a path for a handler the way a report does, into an AttributeReportIBs array.
+    auto retrieve = [&](ReadHandler * handler, const ConcreteAttributePath & path, Report & report) {
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        AttributeEncodeState state;
+        writer.Init(report.mData, sizeof(report.mData));
+        EXPECT_EQ(builder.Init(&writer), CHIP_NO_ERROR);
+        DataModel::ActionReturnStatus status =
+            engine.RetrieveClusterData(handler, builder, ConcreteReadAttributePath(path), &state);
+        EXPECT_EQ(builder.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+        report.mLength = writer.GetLengthWritten();
+        return status;
+    };
+
+    const ConcreteAttributePath sharedPath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    const ConcreteAttributePath subjectPath(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    uint32_t hits   = engine.GetEncodedAttributeCacheHitCount();
+    uint32_t misses = engine.GetEncodedAttributeCacheMissCount();
+    Report first;
+    Report second;
+
+    // The first handler encodes the value, the second one gets a copy of the same bytes without reading it again.
+    EXPECT_TRUE(retrieve(handlers[0], sharedPath, first).IsSuccess());
+    EXPECT_EQ(engine.GetEncodedAttributeCacheMissCount(), ++misses);
+    EXPECT_EQ(model.mReadCount, 1u);
+    EXPECT_TRUE(retrieve(handlers[1], sharedPath, second).IsSuccess());
+    EXPECT_EQ(engine.GetEncodedAttributeCacheHitCount(), ++hits);
+    EXPECT_EQ(model.mReadCount, 1u);
+    EXPECT_TRUE(first == second);
+
+    // Once the data version changed, the cached bytes are stale: the value is read and encoded again.
+    model.mDataVersion++;
+    model.mValue++;
+    EXPECT_TRUE(retrieve(handlers[1], sharedPath, second).IsSuccess());
+    EXPECT_EQ(engine.GetEncodedAttributeCacheMissCount(), ++misses);
+    EXPECT_EQ(model.mReadCount, 2u);
+    EXPECT_FALSE(first == second);
+    EXPECT_TRUE(retrieve(handlers[0], sharedPath, first).IsSuccess());
+    EXPECT_EQ(engine.GetEncodedAttributeCacheHitCount(), ++hits);
+    EXPECT_TRUE(first == second);
+
+    // A subject denied access to the cached value gets the status of a regular read, and no data.
+    Report empty;
+    {
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        writer.Init(empty.mData, sizeof(empty.mData));
+        EXPECT_EQ(builder.Init(&writer), CHIP_NO_ERROR);
+        EXPECT_EQ(builder.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+        empty.mLength = writer.GetLengthWritten();
+    }
+    gDenyFabricAccessControlDelegate.mDeniedFabricIndex = handlers[1]->GetSubjectDescriptor().fabricIndex;
+    EXPECT_TRUE(retrieve(handlers[1], sharedPath, second) == Protocols::InteractionModel::Status::UnsupportedAccess);
+    EXPECT_EQ(engine.GetEncodedAttributeCacheHitCount(), hits);
+    EXPECT_EQ(engine.GetEncodedAttributeCacheMissCount(), ++misses);
+    EXPECT_TRUE(second == empty);
+    gDenyFabricAccessControlDelegate.mDeniedFabricIndex = kUndefinedFabricIndex;
+
+    // A value that depends on the subject is read for every handler, and each one gets its own.
+    EXPECT_TRUE(retrieve(handlers[0], subjectPath, first).IsSuccess());
+    EXPECT_TRUE(retrieve(handlers[1], subjectPath, second).IsSuccess());
+    EXPECT_EQ(engine.GetEncodedAttributeCacheHitCount(), hits);
+    EXPECT_EQ(engine.GetEncodedAttributeCacheMissCount(), misses + 2);
+    EXPECT_EQ(model.mReadCount, 4u);
+    EXPECT_FALSE(first == second);
+
+    for (auto * handler : handlers)
+    {
+        InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(handler);
+    }
+
+    GetAccessControl().Finish();
+    EXPECT_EQ(GetAccessControl().Init(Access::Examples::GetPermissiveAccessControlDelegate(), gDeviceTypeResolver), CHIP_NO_ERROR);
+    InteractionModelEngine::GetInstance()->SetDataModelProvider(&TestImCustomDataModel::Instance());
+
+    DrainAndServiceIO();
+    engine.Shutdown();
+}
+#endif // CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES > 0
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
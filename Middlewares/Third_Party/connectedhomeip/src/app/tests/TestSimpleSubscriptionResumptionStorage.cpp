@@ -119,6 +119,92 @@ TEST_F(TestSimpleSubscriptionResumptionStorage, TestSubscriptionCount)
     EXPECT_EQ(count, 0u);
 }
 
+class CountingPersistentStorageDelegate : public chip::TestPersistentStorageDelegate
+{
+public:
+    size_t mReads   = 0;
+    size_t mWrites  = 0;
+    size_t mDeletes = 0;
+
+protected:
+    CHIP_ERROR SyncGetKeyValueInternal(const char * key, void * buffer, uint16_t & size) override
+    {
+        mReads++;
+        return TestPersistentStorageDelegate::SyncGetKeyValueInternal(key, buffer, size);
+    }
+
+    CHIP_ERROR SyncSetKeyValueInternal(const char * key, const void * value, uint16_t size) override
+    {
+        mWrites++;
+        return TestPersistentStorageDelegate::SyncSetKeyValueInternal(key, value, size);
+    }
+
+    CHIP_ERROR SyncDeleteKeyValueInternal(const char * key) override
+    {
+        mDeletes++;
+        return TestPersistentStorageDelegate::SyncDeleteKeyValueInternal(key);
+    }
+};
+
+TEST_F(TestSimpleSubscriptionResumptionStorage, TestSubscriptionSaveDeleteTouchOneSlot)
+{
+    CountingPersistentStorageDelegate storage;
+    chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo = { .mNodeId = 7777, .mFabricIndex = 47 };
+
+    {
+        SimpleSubscriptionResumptionStorageTest subscriptionStorage;
+        subscriptionStorage.Init(&storage);
+        for (size_t i = 0; i < (CHIP_IM_MAX_NUM_SUBSCRIPTIONS / 2); i++)
+        {
+            subscriptionInfo.mSubscriptionId = static_cast<chip::SubscriptionId>(i);
+            EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+        }
+    }
+
+    // A new instance finds the subscriptions saved by the previous one, as after a reboot
+    SimpleSubscriptionResumptionStorageTest subscriptionStorage;
+    subscriptionStorage.Init(&storage);
+
+    // Saving a new subscription, then the same one again, writes a single slot without reading any
+    storage.mReads = storage.mWrites = storage.mDeletes = 0;
+    subscriptionInfo.mSubscriptionId                     = CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+    EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+    subscriptionInfo.mMaxInterval = 60;
+    EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.mReads, 0u);
+    EXPECT_EQ(storage.mWrites, 2u);
+    EXPECT_EQ(storage.mDeletes, 0u);
+
+    // Deleting a subscription deletes a single slot without reading any
+    storage.mReads = storage.mWrites = storage.mDeletes = 0;
+    EXPECT_EQ(subscriptionStorage.Delete(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(subscriptionStorage.Delete(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex, 0),
+              CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_EQ(storage.mReads, 0u);
+    EXPECT_EQ(storage.mWrites, 0u);
+    EXPECT_EQ(storage.mDeletes, 1u);
+
+    // The updated subscription was saved once, in place of its previous version
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    EXPECT_EQ(iterator->Count(), std::make_unsigned_t<int>(CHIP_IM_MAX_NUM_SUBSCRIPTIONS / 2));
+    size_t updatedCount = 0;
+    TestSubscriptionInfo loadedSubscriptionInfo;
+    while (iterator->Next(loadedSubscriptionInfo))
+    {
+        EXPECT_NE(loadedSubscriptionInfo.mSubscriptionId, 0u);
+        if (loadedSubscriptionInfo.mSubscriptionId == subscriptionInfo.mSubscriptionId)
+        {
+            EXPECT_EQ(loadedSubscriptionInfo.mMaxInterval, 60u);
+            updatedCount++;
+        }
+    }
+    iterator->Release();
+    EXPECT_EQ(updatedCount, 1u);
+
+    EXPECT_EQ(subscriptionStorage.DeleteAll(subscriptionInfo.mFabricIndex), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.GetNumKeys(), 0u);
+}
+
 TEST_F(TestSimpleSubscriptionResumptionStorage, TestSubscriptionMaxCount)
 {
     // Force large MacCount value and check that Init resets it properly, and deletes extra subs:
@@ -0,0 +1,405 @@
+/**
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/util/af-types.h>
+#include <app/util/attribute-metadata.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/BitFlags.h>
+#include <lib/support/CodeUtils.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * @brief Location of an attribute in ember storage.
+ */
+struct AttributeLocation
+{
+    const EmberAfAttributeMetadata * metadata = nullptr;
+    // Offset of the attribute value in the attribute storage buffer. Only meaningful for attributes that are neither
+    // external, nor singletons, nor on a dynamic endpoint.
+    uint16_t storageOffset = 0;
+    bool isDynamicEndpoint = false;
+};
+
+/**
+ * @brief Locate an attribute by walking the endpoint table, as emAfReadOrWriteAttribute does without an index.
+ *
+ * The first enabled endpoint with the given id is searched, and within it the first server cluster with the given
+ * id. Every fixed endpoint before it contributes its endpointSize to the storage offset, except for disabled ones
+ * that have the same id.
+ *
+ * @return Status::Success with `location` filled in, or the status reported for a missing endpoint, cluster or
+ *         attribute.
+ */
+inline Protocols::InteractionModel::Status ScanAttributeLocation(const EmberAfDefinedEndpoint * endpoints, uint16_t endpointCount,
+                                                                 uint16_t fixedEndpointCount, EndpointId endpointId,
+                                                                 ClusterId clusterId, AttributeId attributeId,
+                                                                 AttributeLocation & location)
+{
+    using Protocols::InteractionModel::Status;
+
+    uint16_t attributeOffsetIndex = 0;
+
+    for (uint16_t ep = 0; ep < endpointCount; ep++)
+    {
+        // Is this a dynamic endpoint?
+        bool isDynamicEndpoint = (ep >= fixedEndpointCount);
+
+        if (endpoints[ep].endpoint == endpointId)
+        {
+            const EmberAfEndpointType * endpointType = endpoints[ep].endpointType;
+            if (!endpoints[ep].bitmask.Has(EmberAfEndpointOptions::isEnabled))
+            {
+                continue;
+            }
+            for (uint8_t clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+            {
+                const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+                if (cluster->clusterId == clusterId && cluster->IsServer())
+                { // Got the cluster
+                    for (uint16_t attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+                    {
+                        const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+                        if (am->attributeId == attributeId)
+                        { // Got the attribute
+                            location.metadata          = am;
+                            location.storageOffset     = attributeOffsetIndex;
+                            location.isDynamicEndpoint = isDynamicEndpoint;
+                            return Status::Success;
+                        }
+
+                        // Not the attribute we are looking for
+                        // Increase the index if attribute is not externally stored
+                        if (!am->IsExternal() && !am->IsSingleton())
+                        {
+                            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + am->size);
+                        }
+                    }
+
+                    // Attribute is not in the cluster.
+                    return Status::UnsupportedAttribute;
+                }
+
+                // Not the cluster we are looking for
+                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
+            }
+
+            // Cluster is not in the endpoint.
+            return Status::UnsupportedCluster;
+        }
+
+        // Not the endpoint we are looking for
+        // Dynamic endpoints are external and don't factor into storage size
+        if (!isDynamicEndpoint)
+        {
+            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + endpoints[ep].endpointType->endpointSize);
+        }
+    }
+    return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+}
+
+/**
+ * @brief Index mapping <endpoint, cluster, attribute> to the location of an attribute in ember storage.
+ *
+ * Without this index, every ember attribute access walks all endpoints, all clusters on the matching
+ * endpoint and all attributes on the matching cluster, summing attribute sizes along the way to find
+ * the offset of the attribute in the global attribute storage buffer.
+ *
+ * The index is built once from the defined endpoint table (enabled endpoints only) and has to be
+ * rebuilt every time the endpoint table changes (endpoint configured, enabled, disabled or replaced).
+ * Lookups are a single hash probe sequence over a fixed-size open addressing table.
+ *
+ * Only server clusters are indexed, since there are no client attributes. Entries resolve to the same
+ * location as ScanAttributeLocation(), including for endpoints or clusters with duplicate ids. A failed
+ * lookup does not mean the attribute does not exist if the index is not valid (e.g. it ran out of
+ * capacity), so callers use Locate(), which falls back to the linear scan.
+ */
+template <size_t kMaxEntries>
+class AttributeLocationIndex
+{
+public:
+    static_assert(kMaxEntries > 0 && kMaxEntries < UINT16_MAX, "Index entries are addressed with 16-bit indices");
+
+    enum class EntryFlags : uint8_t
+    {
+        kDynamicEndpoint = 0x01, // Attribute lives on a dynamic endpoint
+        kExternalStorage = 0x02, // Attribute value is not stored by ember
+        kSingleton       = 0x04, // Attribute value is stored in singleton storage, not at storageOffset
+    };
+
+    struct Entry
+    {
+        const EmberAfAttributeMetadata * metadata = nullptr;
+        ClusterId clusterId                       = kInvalidClusterId;
+        EndpointId endpointId                     = kInvalidEndpointId;
+        // Offset of the attribute value in the attribute storage buffer. Only meaningful for attributes that
+        // are neither external, nor singletons, nor on a dynamic endpoint.
+        uint16_t storageOffset = 0;
+        BitFlags<EntryFlags> flags;
+
+        bool IsDynamicEndpoint() const { return flags.Has(EntryFlags::kDynamicEndpoint); }
+        bool IsExternal() const { return flags.Has(EntryFlags::kExternalStorage); }
+        bool IsSingleton() const { return flags.Has(EntryFlags::kSingleton); }
+    };
+
+    AttributeLocationIndex() { Clear(); }
+
+    /**
+     * @brief Drop all entries and mark the index invalid.
+     */
+    void Clear()
+    {
+        for (auto & bucket : mBuckets)
+        {
+            bucket = kEmptyBucket;
+        }
+        mEntryCount = 0;
+        mValid      = false;
+    }
+
+    /**
+     * @brief Rebuild the index from the given endpoint table.
+     *
+     * Storage offsets are computed exactly as ScanAttributeLocation() does: every fixed endpoint (enabled or not,
+     * except disabled ones with the same id) contributes its endpointSize, every cluster preceding the matching one
+     * contributes its clusterSize and every internally stored, non-singleton attribute preceding the matching one
+     * contributes its size.
+     *
+     * @param endpoints          - Array of defined endpoints.
+     * @param endpointCount      - Number of valid entries in `endpoints`.
+     * @param fixedEndpointCount - Number of leading entries in `endpoints` that are fixed endpoints.
+     *
+     * @return CHIP_ERROR_NO_MEMORY if more than kMaxEntries attributes are enabled; the index is left
+     *         invalid in that case.
+     */
+    CHIP_ERROR Build(const EmberAfDefinedEndpoint * endpoints, uint16_t endpointCount, uint16_t fixedEndpointCount)
+    {
+        Clear();
+
+        uint16_t endpointOffset = 0;
+        for (uint16_t ep = 0; ep < endpointCount; ep++)
+        {
+            const EmberAfDefinedEndpoint & definedEndpoint = endpoints[ep];
+            const bool isDynamicEndpoint                   = (ep >= fixedEndpointCount);
+
+            if (definedEndpoint.endpointType != nullptr && definedEndpoint.bitmask.Has(EmberAfEndpointOptions::isEnabled))
+            {
+                // The linear lookup stops at the first enabled endpoint with a given id, and does not count the storage of
+                // the disabled fixed endpoints with that id before it.
+                uint16_t offset = endpointOffset;
+                bool shadowed   = false;
+                for (uint16_t previous = 0; previous < ep && !shadowed; previous++)
+                {
+                    if (endpoints[previous].endpoint != definedEndpoint.endpoint)
+                    {
+                        continue;
+                    }
+                    shadowed = endpoints[previous].bitmask.Has(EmberAfEndpointOptions::isEnabled);
+                    if (!shadowed && previous < fixedEndpointCount)
+                    {
+                        offset = static_cast<uint16_t>(offset - endpoints[previous].endpointType->endpointSize);
+                    }
+                }
+
+                if (!shadowed)
+                {
+                    ReturnErrorOnFailure(AddEndpoint(definedEndpoint, offset, isDynamicEndpoint));
+                }
+            }
+
+            // Dynamic endpoints are external and don't factor into storage size
+            if (!isDynamicEndpoint && definedEndpoint.endpointType != nullptr)
+            {
+                endpointOffset = static_cast<uint16_t>(endpointOffset + definedEndpoint.endpointType->endpointSize);
+            }
+        }
+
+        mValid = true;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * @brief Find the location of the given attribute.
+     *
+     * @return the matching entry, or nullptr if the attribute is not indexed.
+     */
+    const Entry * Find(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId) const
+    {
+        if (!mValid)
+        {
+            return nullptr;
+        }
+
+        for (size_t bucket = Hash(endpointId, clusterId, attributeId) & kBucketMask;; bucket = (bucket + 1) & kBucketMask)
+        {
+            uint16_t slot = mBuckets[bucket];
+            if (slot == kEmptyBucket)
+            {
+                return nullptr;
+            }
+            const Entry & entry = mEntries[slot];
+            if (entry.endpointId == endpointId && entry.clusterId == clusterId && entry.metadata->attributeId == attributeId)
+            {
+                return &entry;
+            }
+        }
+    }
+
+    /**
+     * @brief Locate the given attribute through the index, falling back to ScanAttributeLocation() on a miss.
+     *
+     * The arguments describing the endpoint table must be the ones the index was last built from.
+     */
+    Protocols::InteractionModel::Status Locate(const EmberAfDefinedEndpoint * endpoints, uint16_t endpointCount,
+                                               uint16_t fixedEndpointCount, EndpointId endpointId, ClusterId clusterId,
+                                               AttributeId attributeId, AttributeLocation & location) const
+    {
+        // A miss in a valid index means the attribute does not exist, but the scan reports the precise status.
+        const Entry * entry = Find(endpointId, clusterId, attributeId);
+        if (entry == nullptr)
+        {
+            return ScanAttributeLocation(endpoints, endpointCount, fixedEndpointCount, endpointId, clusterId, attributeId,
+                                         location);
+        }
+
+        location.metadata          = entry->metadata;
+        location.storageOffset     = entry->storageOffset;
+        location.isDynamicEndpoint = entry->IsDynamicEndpoint();
+        return Protocols::InteractionModel::Status::Success;
+    }
+
+    bool IsValid() const { return mValid; }
+    size_t EntryCount() const { return mEntryCount; }
+    static constexpr size_t Capacity() { return kMaxEntries; }
+
+private:
+    static constexpr size_t RoundUpToPowerOfTwo(size_t value, size_t result = 1)
+    {
+        return (result >= value) ? result : RoundUpToPowerOfTwo(value, result << 1);
+    }
+
+    // Keep the load factor at or below 50% so that probe sequences stay short.
+    static constexpr size_t kBucketCount   = RoundUpToPowerOfTwo(2 * kMaxEntries);
+    static constexpr size_t kBucketMask    = kBucketCount - 1;
+    static constexpr uint16_t kEmptyBucket = UINT16_MAX;
+
+    static uint32_t Hash(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId)
+    {
+        uint32_t hash = (clusterId * 0x9E3779B1u) ^ (attributeId * 0x85EBCA6Bu) ^ (endpointId * 0xC2B2AE35u);
+        hash ^= hash >> 15;
+        hash *= 0x2C1B3C6Du;
+        hash ^= hash >> 13;
+        return hash;
+    }
+
+    CHIP_ERROR AddEndpoint(const EmberAfDefinedEndpoint & definedEndpoint, uint16_t endpointOffset, bool isDynamicEndpoint)
+    {
+        const EmberAfEndpointType * endpointType = definedEndpoint.endpointType;
+        uint16_t clusterOffset                   = endpointOffset;
+
+        for (uint8_t clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+        {
+            const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+            if (cluster->IsServer() && !HasEarlierServerCluster(*endpointType, clusterIndex))
+            {
+                ReturnErrorOnFailure(AddCluster(definedEndpoint.endpoint, *cluster, clusterOffset, isDynamicEndpoint));
+            }
+            clusterOffset = static_cast<uint16_t>(clusterOffset + cluster->clusterSize);
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    // The linear lookup stops at the first server cluster with a given id.
+    static bool HasEarlierServerCluster(const EmberAfEndpointType & endpointType, uint8_t clusterIndex)
+    {
+        for (uint8_t previous = 0; previous < clusterIndex; previous++)
+        {
+            if (endpointType.cluster[previous].clusterId == endpointType.cluster[clusterIndex].clusterId &&
+                endpointType.cluster[previous].IsServer())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    CHIP_ERROR AddCluster(EndpointId endpointId, const EmberAfCluster & cluster, uint16_t clusterOffset, bool isDynamicEndpoint)
+    {
+        uint16_t attributeOffset = clusterOffset;
+
+        for (uint16_t attrIndex = 0; attrIndex < cluster.attributeCount; attrIndex++)
+        {
+            const EmberAfAttributeMetadata * am = &(cluster.attributes[attrIndex]);
+
+            Entry entry;
+            entry.metadata      = am;
+            entry.clusterId     = cluster.clusterId;
+            entry.endpointId    = endpointId;
+            entry.storageOffset = attributeOffset;
+            entry.flags.Set(EntryFlags::kDynamicEndpoint, isDynamicEndpoint)
+                .Set(EntryFlags::kExternalStorage, am->IsExternal())
+                .Set(EntryFlags::kSingleton, am->IsSingleton());
+            ReturnErrorOnFailure(Insert(entry));
+
+            if (!am->IsExternal() && !am->IsSingleton())
+            {
+                attributeOffset = static_cast<uint16_t>(attributeOffset + am->size);
+            }
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR Insert(const Entry & entry)
+    {
+        size_t bucket = Hash(entry.endpointId, entry.clusterId, entry.metadata->attributeId) & kBucketMask;
+        while (mBuckets[bucket] != kEmptyBucket)
+        {
+            const Entry & existing = mEntries[mBuckets[bucket]];
+            if (existing.endpointId == entry.endpointId && existing.clusterId == entry.clusterId &&
+                existing.metadata->attributeId == entry.metadata->attributeId)
+            {
+                // The linear lookup always resolves to the first match, so keep the existing entry.
+                return CHIP_NO_ERROR;
+            }
+            bucket = (bucket + 1) & kBucketMask;
+        }
+
+        VerifyOrReturnError(mEntryCount < kMaxEntries, CHIP_ERROR_NO_MEMORY);
+
+        mEntries[mEntryCount] = entry;
+        mBuckets[bucket]      = static_cast<uint16_t>(mEntryCount);
+        mEntryCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    Entry mEntries[kMaxEntries];
+    uint16_t mBuckets[kBucketCount];
+    size_t mEntryCount = 0;
+    bool mValid        = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -19,6 +19,8 @@
 
 #include <app/util/attribute-storage-detail.h>
 
+#include <app/util/attribute-location-index.h>
+
 #include <app/AttributeAccessInterfaceRegistry.h>
 #include <app/AttributePersistenceProvider.h>
 #include <app/CommandHandlerInterfaceRegistry.h>
@@ -141,6 +143,24 @@ constexpr const EmberAfDeviceType fixedDeviceTypeList[]             = FIXED_DEVI
 DataVersion fixedEndpointDataVersions[ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT];
 #endif // FIXED_ENDPOINT_COUNT > 0
 
+#if CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE > 0
+AttributeLocationIndex<CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE> attributeLocationIndex;
+#endif
+
+// Must be called every time an endpoint is configured, enabled or disabled,
+// before any attribute on the changed endpoint is accessed.
+void rebuildAttributeLocationIndex()
+{
+#if CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE > 0
+    CHIP_ERROR err = attributeLocationIndex.Build(emAfEndpoints, emberAfEndpointCount(), emberAfFixedEndpointCount());
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Attribute location index needs more than %u entries, using linear lookup",
+                     static_cast<unsigned>(attributeLocationIndex.Capacity()));
+    }
+#endif // CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE > 0
+}
+
 bool emberAfIsThisDataTypeAListType(EmberAfAttributeType dataType)
 {
     return dataType == ZCL_ARRAY_ATTRIBUTE_TYPE;
@@ -236,6 +256,8 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    rebuildAttributeLocationIndex();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
@@ -291,6 +313,9 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
         }
     }
 
+    // The slot may be overwritten while still enabled; if so, drop its old attributes from the index.
+    bool wasEnabled = emberAfEndpointIndexIsEnabled(index);
+
     emAfEndpoints[index].endpoint       = id;
     emAfEndpoints[index].deviceTypeList = deviceTypeList;
     emAfEndpoints[index].endpointType   = ep;
@@ -301,6 +326,11 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
 
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
+    if (wasEnabled)
+    {
+        rebuildAttributeLocationIndex();
+    }
+
     // Initialize the data versions.
     size_t dataSize = sizeof(DataVersion) * serverClusterCount;
     if (dataSize != 0)
@@ -555,6 +585,63 @@ bool emAfMatchAttribute(const EmberAfCluster * cluster, const EmberAfAttributeMe
     return (am->attributeId == attRecord->attributeId);
 }
 
+// Performs the actual read or write once the attribute has been located.  See
+// emAfReadOrWriteAttribute for the semantics of the arguments.
+static Status readOrWriteLocatedAttribute(const EmberAfAttributeSearchRecord * attRecord, const EmberAfAttributeMetadata * am,
+                                          uint16_t attributeOffsetIndex, bool isDynamicEndpoint,
+                                          const EmberAfAttributeMetadata ** metadata, uint8_t * buffer, uint16_t readLength,
+                                          bool write)
+{
+    // If passed metadata location is not null, populate
+    if (metadata != nullptr)
+    {
+        *metadata = am;
+    }
+
+    uint8_t * attributeLocation =
+        (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am) : attributeData + attributeOffsetIndex);
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = attributeLocation;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return Status::UnsupportedAccess;
+        }
+    }
+    else
+    {
+        if (buffer == nullptr)
+        {
+            return Status::Success;
+        }
+
+        src = attributeLocation;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return Status::UnsupportedAccess;
+        }
+    }
+
+    // Is the attribute externally stored?
+    if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+    {
+        return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am, buffer)
+                      : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
+                                                             emberAfAttributeSize(am)));
+    }
+
+    // Internal storage is only supported for fixed endpoints
+    if (!isDynamicEndpoint)
+    {
+        return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+    }
+
+    return Status::Failure;
+}
+
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -573,117 +660,18 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
-    uint16_t attributeOffsetIndex = 0;
-
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
-    {
-        // Is this a dynamic endpoint?
-        bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
-
-        if (emAfEndpoints[ep].endpoint == attRecord->endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t clusterIndex;
-            if (!emberAfEndpointIndexIsEnabled(ep))
-            {
-                continue;
-            }
-            for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
-            {
-                const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
-                if (emAfMatchCluster(cluster, attRecord))
-                { // Got the cluster
-                    uint16_t attrIndex;
-                    for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
-                    {
-                        const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
-                        if (emAfMatchAttribute(cluster, am, attRecord))
-                        { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
-
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == nullptr)
-                                    {
-                                        return Status::Success;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                          am, buffer)
-                                                  : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                         am, buffer, emberAfAttributeSize(am)));
-                                }
-
-                                // Internal storage is only supported for fixed endpoints
-                                if (!isDynamicEndpoint)
-                                {
-                                    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                }
-
-                                return Status::Failure;
-                            }
-                        }
-                        else
-                        { // Not the attribute we are looking for
-                            // Increase the index if attribute is not externally stored
-                            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
-                            {
-                                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
-                            }
-                        }
-                    }
-
-                    // Attribute is not in the cluster.
-                    return Status::UnsupportedAttribute;
-                }
-
-                // Not the cluster we are looking for
-                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
-            }
-
-            // Cluster is not in the endpoint.
-            return Status::UnsupportedCluster;
-        }
+    AttributeLocation location;
+#if CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE > 0
+    Status status = attributeLocationIndex.Locate(emAfEndpoints, emberAfEndpointCount(), emberAfFixedEndpointCount(),
+                                                  attRecord->endpoint, attRecord->clusterId, attRecord->attributeId, location);
+#else
+    Status status = ScanAttributeLocation(emAfEndpoints, emberAfEndpointCount(), emberAfFixedEndpointCount(), attRecord->endpoint,
+                                          attRecord->clusterId, attRecord->attributeId, location);
+#endif // CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE > 0
+    VerifyOrReturnValue(status == Status::Success, status);
 
-        // Not the endpoint we are looking for
-        // Dynamic endpoints are external and don't factor into storage size
-        if (!isDynamicEndpoint)
-        {
-            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emAfEndpoints[ep].endpointType->endpointSize);
-        }
-    }
-    return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+    return readOrWriteLocatedAttribute(attRecord, location.metadata, location.storageOffset, location.isDynamicEndpoint, metadata,
+                                       buffer, readLength, write);
 }
 
 const EmberAfEndpointType * emberAfFindEndpointType(EndpointId endpointId)
@@ -917,6 +905,8 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
     {
         if (enable)
         {
+            // Cluster init callbacks may already access attributes on this endpoint.
+            rebuildAttributeLocationIndex();
             initializeEndpoint(&(emAfEndpoints[index]));
             emberAfEndpointChanged(endpoint, emberAfGlobalInteractionModelAttributesChangedListener());
         }
@@ -924,6 +914,7 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
         {
             shutdownEndpoint(&(emAfEndpoints[index]));
             emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
+            rebuildAttributeLocationIndex();
         }
 
         EndpointId parentEndpointId = emberAfParentEndpointFromIndex(index);
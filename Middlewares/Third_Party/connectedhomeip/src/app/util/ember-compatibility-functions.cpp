@@ -206,6 +206,12 @@ CHIP_ERROR ReadViaAccessInterface(const SubjectDescriptor & subjectDescriptor, b
         return err;
     }
 
+    // On success only the subject dependency of the value matters to the caller: list encoding state has been reset.
+    if (aEncoderState != nullptr)
+    {
+        aEncoderState->SetDependsOnSubject(valueEncoder.GetState().DependsOnSubject());
+    }
+
     *aTriedEncode = valueEncoder.TriedEncode();
     return CHIP_NO_ERROR;
 }
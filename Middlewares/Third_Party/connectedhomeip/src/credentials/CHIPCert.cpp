@@ -138,6 +138,11 @@ CHIP_ERROR ChipCertificateSet::LoadCert(TLVReader & reader, BitFlags<CertDecodeF
     ChipCertificateData cert;
     ReturnErrorOnFailure(DecodeChipCert(reader, cert, decodeFlags));
 
+    return LoadCert(cert);
+}
+
+CHIP_ERROR ChipCertificateSet::LoadCert(const ChipCertificateData & cert)
+{
     // Verify the cert has both the Subject Key Id and Authority Key Id extensions present.
     // Only certs with both these extensions are supported for the purposes of certificate validation.
     VerifyOrReturnError(cert.mCertFlags.HasAll(CertFlags::kExtPresent_SubjectKeyId, CertFlags::kExtPresent_AuthKeyId),
@@ -409,6 +414,12 @@ CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, Va
         ExitNow(err = CHIP_ERROR_CA_CERT_NOT_FOUND);
     }
 
+    // The signature of a certificate issued by the trust anchor may already have been verified when it was loaded.
+    if (cert->mCertFlags.Has(CertFlags::kSignatureVerified) && caCert->mCertFlags.Has(CertFlags::kIsTrustAnchor))
+    {
+        ExitNow(err = CHIP_NO_ERROR);
+    }
+
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
     // succeeds, the current certificate is valid.
     err = VerifyCertSignature(*cert, *caCert);
@@ -164,6 +164,8 @@ enum class CertFlags : uint16_t
     kIsCA                        = 0x0080, /**< Indicates that certificate is a CA certificate. */
     kIsTrustAnchor               = 0x0100, /**< Indicates that certificate is a trust anchor. */
     kTBSHashPresent              = 0x0200, /**< Indicates that TBS hash of the certificate was generated and stored. */
+    kSignatureVerified           = 0x0400, /**< Indicates that the certificate signature was already verified against the trust
+                                              anchor of its certificate set. Never set when decoding a certificate. */
 };
 
 /** CHIP Certificate Decode Flags
@@ -187,6 +187,18 @@ public:
      **/
     CHIP_ERROR LoadCert(chip::TLV::TLVReader & reader, BitFlags<CertDecodeFlags> decodeFlags, ByteSpan chipCert = ByteSpan());
 
+    /**
+     * @brief Load already decoded CHIP certificate into set.
+     *        It is required that the CHIP certificate the data was decoded from stays valid while
+     *        the certificate data in the set is used.
+     *        In case of an error the certificate set is left in the same state as prior to this call.
+     *
+     * @param certData  Data decoded from the CHIP certificate.
+     *
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR LoadCert(const ChipCertificateData & certData);
+
     CHIP_ERROR ReleaseLastCert();
 
     /**
@@ -25,10 +25,12 @@
 #include <lib/support/BufferWriter.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CHIPMemString.h>
+#include <lib/support/Defer.h>
 #include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/ScopedBuffer.h>
 #include <platform/LockTracker.h>
+#include <system/SystemMutex.h>
 #include <tracing/macros.h>
 
 namespace chip {
@@ -109,6 +111,169 @@ exit:
     return err;
 }
 
+#if CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+
+/**
+ * Issuer certificates (RCAC and optional ICAC) of the chains validated by FabricTable::VerifyCredentials().
+ *
+ * All the nodes of a fabric share the same RCAC and ICAC. An entry keeps a copy of them, keyed by their SHA-256 hash, with
+ * their decoded data, and records that the ICAC signature was verified with the RCAC public key. Validating another NOC
+ * issued by them loads the decoded data as is, and only verifies the NOC signature: the validity window, key usages and
+ * validity policy of the cached certificates are still checked against each validation context.
+ *
+ * Validations run on the CHIP thread and on a background thread for CASE Sigma3, so the entries are protected by a mutex.
+ * An entry is pinned while a validation uses its data, and only unpinned entries are replaced.
+ */
+class VerifiedCertChainCache
+{
+public:
+    struct Entry
+    {
+        ChipCertificateData mRcacData;
+        ChipCertificateData mIcacData;
+        uint8_t mKey[kSHA256_Hash_Length];
+        uint8_t mRcac[kMaxCHIPCertLength];
+        uint8_t mIcac[kMaxCHIPCertLength];
+        uint16_t mRcacLength = 0;
+        uint16_t mIcacLength = 0;
+        uint32_t mLastUsed   = 0;
+        uint8_t mPinCount    = 0;
+        bool mIsValid        = false;
+
+        bool HasIcac() const { return mIcacLength != 0; }
+    };
+
+    CHIP_ERROR Init()
+    {
+        ReturnErrorCodeIf(mIsInitialized, CHIP_NO_ERROR);
+        ReturnErrorOnFailure(System::Mutex::Init(mMutex));
+        mIsInitialized = true;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Returns the pinned entry of the given issuer certificates, adding it if needed. Must be released with Release().
+     *
+     * Returns nullptr, for the caller to validate the chain without the cache, if the cache is not initialized, if
+     * every entry is in use, or if the certificates cannot be cached: they do not decode, or the ICAC was not issued by
+     * the RCAC.
+     */
+    const Entry * Acquire(const ByteSpan & rcac, const ByteSpan & icac)
+    {
+        uint8_t key[kSHA256_Hash_Length];
+
+        VerifyOrReturnValue(mIsInitialized, nullptr);
+        VerifyOrReturnValue(rcac.size() <= kMaxCHIPCertLength && icac.size() <= kMaxCHIPCertLength, nullptr);
+        VerifyOrReturnValue(ComputeKey(rcac, icac, key) == CHIP_NO_ERROR, nullptr);
+
+        Entry * entry = nullptr;
+
+        mMutex.Lock();
+        for (auto & candidate : mEntries)
+        {
+            if (candidate.mIsValid && candidate.mRcacLength == rcac.size() && candidate.mIcacLength == icac.size() &&
+                memcmp(candidate.mKey, key, sizeof(key)) == 0)
+            {
+                candidate.mLastUsed = ++mUseCount;
+                candidate.mPinCount++;
+                mHitCount++;
+                mMutex.Unlock();
+                return &candidate;
+            }
+        }
+
+        // Replace the least recently used entry nobody is reading. It is pinned and invalid while it is filled.
+        for (auto & candidate : mEntries)
+        {
+            if (candidate.mPinCount == 0 && (entry == nullptr || candidate.mLastUsed < entry->mLastUsed))
+            {
+                entry = &candidate;
+            }
+        }
+        if (entry != nullptr)
+        {
+            entry->mIsValid  = false;
+            entry->mLastUsed = ++mUseCount;
+            entry->mPinCount = 1;
+        }
+        mMutex.Unlock();
+        VerifyOrReturnValue(entry != nullptr, nullptr);
+
+        bool isValid = (Fill(*entry, rcac, icac) == CHIP_NO_ERROR);
+        memcpy(entry->mKey, key, sizeof(key));
+
+        mMutex.Lock();
+        entry->mIsValid = isValid;
+        mMissCount++;
+        if (!isValid)
+        {
+            entry->mPinCount = 0;
+            entry->mLastUsed = 0;
+            entry            = nullptr;
+        }
+        mMutex.Unlock();
+        return entry;
+    }
+
+    void Release(const Entry * entry)
+    {
+        mMutex.Lock();
+        mEntries[entry - mEntries].mPinCount--;
+        mMutex.Unlock();
+    }
+
+    uint32_t GetHitCount() const { return mHitCount; }
+    uint32_t GetMissCount() const { return mMissCount; }
+
+private:
+    static CHIP_ERROR ComputeKey(const ByteSpan & rcac, const ByteSpan & icac, uint8_t (&key)[kSHA256_Hash_Length])
+    {
+        Hash_SHA256_stream hash;
+        MutableByteSpan keySpan{ key };
+
+        ReturnErrorOnFailure(hash.Begin());
+        ReturnErrorOnFailure(hash.AddData(rcac));
+        ReturnErrorOnFailure(hash.AddData(icac));
+        return hash.Finish(keySpan);
+    }
+
+    static CHIP_ERROR Fill(Entry & entry, const ByteSpan & rcac, const ByteSpan & icac)
+    {
+        memcpy(entry.mRcac, rcac.data(), rcac.size());
+        entry.mRcacLength = static_cast<uint16_t>(rcac.size());
+        ReturnErrorOnFailure(DecodeChipCert(ByteSpan(entry.mRcac, entry.mRcacLength), entry.mRcacData,
+                                            BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor)));
+
+        entry.mIcacLength = static_cast<uint16_t>(icac.size());
+        if (!icac.empty())
+        {
+            memcpy(entry.mIcac, icac.data(), icac.size());
+            ReturnErrorOnFailure(DecodeChipCert(ByteSpan(entry.mIcac, entry.mIcacLength), entry.mIcacData,
+                                                BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
+
+            // Only an ICAC issued by the RCAC is marked as verified: ValidateCert() then skips its signature when its
+            // issuer resolves to the RCAC, which is the only trust anchor of the set.
+            VerifyOrReturnError(entry.mIcacData.mIssuerDN.IsEqual(entry.mRcacData.mSubjectDN) &&
+                                    entry.mIcacData.mAuthKeyId.data_equal(entry.mRcacData.mSubjectKeyId),
+                                CHIP_ERROR_CA_CERT_NOT_FOUND);
+            ReturnErrorOnFailure(VerifyCertSignature(entry.mIcacData, entry.mRcacData));
+            entry.mIcacData.mCertFlags.Set(CertFlags::kSignatureVerified);
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    System::Mutex mMutex;
+    bool mIsInitialized = false;
+    uint32_t mUseCount  = 0;
+    uint32_t mHitCount  = 0;
+    uint32_t mMissCount = 0;
+    Entry mEntries[CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE];
+};
+
+VerifiedCertChainCache sVerifiedCertChainCache;
+
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+
 } // anonymous namespace
 
 CHIP_ERROR FabricInfo::Init(const FabricInfo::InitParams & initParams)
@@ -410,11 +575,34 @@ CHIP_ERROR FabricTable::VerifyCredentials(const ByteSpan & noc, const ByteSpan &
     ChipCertificateSet certificates;
     ReturnErrorOnFailure(certificates.Init(kMaxNumCertsInOpCreds));
 
-    ReturnErrorOnFailure(certificates.LoadCert(rcac, BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor)));
+#if CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+    // Issuers seen before are loaded from the cache: they are not decoded again, and the ICAC signature is not verified again.
+    // The entry stays pinned until this returns, as the certificate set points into its buffers.
+    const VerifiedCertChainCache::Entry * cachedIssuers = sVerifiedCertChainCache.Acquire(rcac, icac);
+    auto releaseCachedIssuers                           = MakeDefer([cachedIssuers]() {
+        if (cachedIssuers != nullptr)
+        {
+            sVerifiedCertChainCache.Release(cachedIssuers);
+        }
+    });
 
-    if (!icac.empty())
+    if (cachedIssuers != nullptr)
     {
-        ReturnErrorOnFailure(certificates.LoadCert(icac, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
+        ReturnErrorOnFailure(certificates.LoadCert(cachedIssuers->mRcacData));
+        if (cachedIssuers->HasIcac())
+        {
+            ReturnErrorOnFailure(certificates.LoadCert(cachedIssuers->mIcacData));
+        }
+    }
+    else
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+    {
+        ReturnErrorOnFailure(certificates.LoadCert(rcac, BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor)));
+
+        if (!icac.empty())
+        {
+            ReturnErrorOnFailure(certificates.LoadCert(icac, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
+        }
     }
 
     ReturnErrorOnFailure(certificates.LoadCert(noc, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
@@ -480,6 +668,18 @@ CHIP_ERROR FabricTable::VerifyCredentials(const ByteSpan & noc, const ByteSpan &
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+uint32_t FabricTable::GetVerifiedCertChainCacheHitCount()
+{
+    return sVerifiedCertChainCache.GetHitCount();
+}
+
+uint32_t FabricTable::GetVerifiedCertChainCacheMissCount()
+{
+    return sVerifiedCertChainCache.GetMissCount();
+}
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+
 const FabricInfo * FabricTable::FindFabric(const Crypto::P256PublicKey & rootPubKey, FabricId fabricId) const
 {
     return FindFabricCommon(rootPubKey, fabricId);
@@ -1097,6 +1297,10 @@ CHIP_ERROR FabricTable::Init(const FabricTable::InitParams & initParams)
     // this condition and can act appropriately.
     mLastKnownGoodTime.Init(mStorage);
 
+#if CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+    ReturnErrorOnFailure(sVerifiedCertChainCache.Init());
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+
     uint8_t buf[IndexInfoTLVMaxSize()];
     uint16_t size  = sizeof(buf);
     CHIP_ERROR err = mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::FabricIndexInfo().KeyName(), buf, size);
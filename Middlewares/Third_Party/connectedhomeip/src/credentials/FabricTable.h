@@ -969,6 +969,13 @@ public:
                                         Credentials::ValidationContext & context, CompressedFabricId & outCompressedFabricId,
                                         FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
                                         Crypto::P256PublicKey * outRootPublicKey = nullptr);
+
+#if CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+    // Number of VerifyCredentials() calls that reused cached issuers, and that decoded and verified issuers to cache them.
+    static uint32_t GetVerifiedCertChainCacheHitCount();
+    static uint32_t GetVerifiedCertChainCacheMissCount();
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+
     /**
      * @brief Enables FabricInfo instances to collide and reference the same logical fabric (i.e Root Public Key + FabricId).
      *
@@ -832,12 +832,14 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    InvalidateGroupSessionCache();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
     mStorage = storage;
+    InvalidateGroupSessionCache();
 }
 
 //
@@ -1349,6 +1351,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1418,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1451,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1528,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1600,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1696,6 +1703,7 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
     FabricData fabric(fabric_index);
+    InvalidateGroupSessionCache();
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
     // However, states has a separate list, and needs to be removed regardless
@@ -1845,6 +1853,15 @@ GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGrou
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (provider.LoadGroupSessionCache())
+    {
+        mUseCache   = true;
+        mCacheIndex = provider.FindCachedGroupSession(session_id);
+        return;
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1860,6 +1877,18 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
     FabricData fabric(mFirstFabric);
     size_t count = 0;
 
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (mUseCache)
+    {
+        for (uint16_t i = mProvider.FindCachedGroupSession(mSessionId);
+             i < mProvider.mGroupSessionCacheCount && mProvider.mGroupSessionCache[i].credentials.hash == mSessionId; ++i)
+        {
+            count++;
+        }
+        return count;
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     for (size_t i = 0; i < mFabricTotal; i++, fabric.fabric_index = fabric.next)
     {
         if (CHIP_NO_ERROR != fabric.Load(mProvider.mStorage))
@@ -1898,6 +1927,26 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (mUseCache)
+    {
+        // The cache may have been invalidated by a change to the group keys since the iterator was created
+        VerifyOrReturnError(GroupSessionCacheState::kLoaded == mProvider.mGroupSessionCacheState, false);
+        VerifyOrReturnError(mCacheIndex < mProvider.mGroupSessionCacheCount, false);
+
+        const CachedGroupSession & cached = mProvider.mGroupSessionCache[mCacheIndex];
+        VerifyOrReturnError(cached.credentials.hash == mSessionId, false);
+        mCacheIndex++;
+
+        mGroupKeyContext.Initialize(cached.credentials.encryption_key, mSessionId, cached.credentials.privacy_key);
+        output.fabric_index    = cached.fabric_index;
+        output.group_id        = cached.group_id;
+        output.security_policy = cached.security_policy;
+        output.keyContext      = &mGroupKeyContext;
+        return true;
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
@@ -1956,6 +2005,118 @@ void GroupDataProviderImpl::GroupSessionIteratorImpl::Release()
     mProvider.mGroupSessionsIterator.ReleaseObject(this);
 }
 
+//
+// Group session cache
+//
+
+void GroupDataProviderImpl::InvalidateGroupSessionCache()
+{
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    for (uint16_t i = 0; i < mGroupSessionCacheCount; ++i)
+    {
+        Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(&mGroupSessionCache[i].credentials),
+                                sizeof(mGroupSessionCache[i].credentials));
+    }
+    mGroupSessionCacheCount = 0;
+    mGroupSessionCacheState = GroupSessionCacheState::kEmpty;
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+}
+
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
+bool GroupDataProviderImpl::LoadGroupSessionCache()
+{
+    if (GroupSessionCacheState::kEmpty != mGroupSessionCacheState)
+    {
+        return GroupSessionCacheState::kLoaded == mGroupSessionCacheState;
+    }
+
+    FabricList fabric_list;
+    CHIP_ERROR err = fabric_list.Load(mStorage);
+    if (CHIP_ERROR_NOT_FOUND == err)
+    {
+        // No fabrics, no group sessions
+        mGroupSessionCacheState = GroupSessionCacheState::kLoaded;
+        return true;
+    }
+    VerifyOrReturnError(CHIP_NO_ERROR == err, false);
+
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        err = fabric.Load(mStorage);
+        SuccessOrExit(err);
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            err = mapping.Load(mStorage);
+            SuccessOrExit(err);
+
+            KeySetData keyset;
+            VerifyOrExit(keyset.Find(mStorage, fabric, mapping.keyset_id), err = CHIP_ERROR_NOT_FOUND);
+
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                if (mGroupSessionCacheCount >= CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE)
+                {
+                    // Keep iterating from storage until the group keys change
+                    InvalidateGroupSessionCache();
+                    mGroupSessionCacheState = GroupSessionCacheState::kOverflow;
+                    return false;
+                }
+
+                // Insert sorted by session id, after any existing entry with the same session id, so that
+                // candidates are returned in the same order as when iterating from storage.
+                uint16_t pos = mGroupSessionCacheCount;
+                while (pos > 0 && mGroupSessionCache[pos - 1].credentials.hash > keyset.operational_keys[k].hash)
+                {
+                    mGroupSessionCache[pos] = mGroupSessionCache[pos - 1];
+                    pos--;
+                }
+
+                CachedGroupSession & cached = mGroupSessionCache[pos];
+                cached.fabric_index         = fabric.fabric_index;
+                cached.group_id             = mapping.group_id;
+                cached.security_policy      = keyset.policy;
+                cached.credentials          = keyset.operational_keys[k];
+                mGroupSessionCacheCount++;
+            }
+        }
+    }
+
+exit:
+    if (CHIP_NO_ERROR != err)
+    {
+        InvalidateGroupSessionCache();
+        return false;
+    }
+    mGroupSessionCacheState = GroupSessionCacheState::kLoaded;
+    return true;
+}
+
+uint16_t GroupDataProviderImpl::FindCachedGroupSession(uint16_t session_id) const
+{
+    // Lower bound: index of the first entry with the given session id, if any
+    uint16_t low  = 0;
+    uint16_t high = mGroupSessionCacheCount;
+    while (low < high)
+    {
+        uint16_t mid = static_cast<uint16_t>(low + (high - low) / 2);
+        if (mGroupSessionCache[mid].credentials.hash < session_id)
+        {
+            low = static_cast<uint16_t>(mid + 1);
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
 namespace {
 
 GroupDataProvider * gGroupsProvider = nullptr;
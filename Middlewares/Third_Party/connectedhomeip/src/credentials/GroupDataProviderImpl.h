@@ -241,10 +241,43 @@ protected:
         uint16_t mKeyIndex       = 0;
         uint16_t mKeyCount       = 0;
         bool mFirstMap           = true;
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+        bool mUseCache       = false;
+        uint16_t mCacheIndex = 0;
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
         GroupKeyContext mGroupKeyContext;
     };
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
+    void InvalidateGroupSessionCache();
+
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    // RAM copy of the group sessions (operational group keys mapped to a group), sorted by session id.
+    // Trial decryption of incoming groupcast messages is served from this cache, so that no persistent
+    // storage reads are needed per message. The cache is loaded lazily and dropped on any change to the
+    // group key map or key sets.
+    struct CachedGroupSession
+    {
+        FabricIndex fabric_index;
+        GroupId group_id;
+        SecurityPolicy security_policy;
+        Crypto::GroupOperationalCredentials credentials;
+    };
+
+    enum class GroupSessionCacheState : uint8_t
+    {
+        kEmpty,    // Not loaded yet, or invalidated
+        kLoaded,   // Holds every group session
+        kOverflow, // Too many group sessions, iterate from storage
+    };
+
+    bool LoadGroupSessionCache();
+    uint16_t FindCachedGroupSession(uint16_t session_id) const;
+
+    CachedGroupSession mGroupSessionCache[CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE];
+    uint16_t mGroupSessionCacheCount               = 0;
+    GroupSessionCacheState mGroupSessionCacheState = GroupSessionCacheState::kEmpty;
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
 
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
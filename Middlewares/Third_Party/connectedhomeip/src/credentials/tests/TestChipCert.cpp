@@ -1340,6 +1340,72 @@ TEST_F(TestChipCert, TestChipCert_LoadDuplicateCerts)
     EXPECT_EQ(certSet.GetCertCount(), 3);
 }
 
+TEST_F(TestChipCert, TestChipCert_LoadSignatureVerifiedCerts)
+{
+    ChipCertificateSet certSet;
+    ValidationContext validContext;
+    ChipCertificateData rootData;
+    ChipCertificateData icaData;
+    ChipCertificateData nodeData;
+    ByteSpan cert;
+
+    // Copies of the ICA and node certificates with a corrupted signature: their subject DN and key id are unchanged.
+    uint8_t badIcaBuf[kMaxCHIPCertLength];
+    uint8_t badNodeBuf[kMaxCHIPCertLength];
+
+    auto corruptSignature = [](const ByteSpan & original, uint8_t (&buf)[kMaxCHIPCertLength]) {
+        MutableByteSpan span{ buf };
+        EXPECT_EQ(CopySpanToMutableSpan(original, span), CHIP_NO_ERROR);
+        // The signature is the last element of the certificate, right before the end of container.
+        buf[span.size() - 2] ^= 0x01;
+        return ByteSpan{ span };
+    };
+
+    auto findValidCert = [&validContext](ChipCertificateSet & set, const ChipCertificateData & subject) {
+        const ChipCertificateData * resultCert = nullptr;
+        validContext.Reset();
+        EXPECT_EQ(SetCurrentTime(validContext, 2021, 1, 1), CHIP_NO_ERROR);
+        return set.FindValidCert(subject.mSubjectDN, subject.mSubjectKeyId, validContext, &resultCert);
+    };
+
+    EXPECT_EQ(GetTestCert(TestCert::kRoot01, sNullLoadFlag, cert), CHIP_NO_ERROR);
+    EXPECT_EQ(DecodeChipCert(cert, rootData, sTrustAnchorFlag), CHIP_NO_ERROR);
+
+    EXPECT_EQ(GetTestCert(TestCert::kICA01, sNullLoadFlag, cert), CHIP_NO_ERROR);
+    EXPECT_EQ(DecodeChipCert(corruptSignature(cert, badIcaBuf), icaData, sGenTBSHashFlag), CHIP_NO_ERROR);
+
+    // Without the flag, the signature of the ICA certificate is verified.
+    EXPECT_EQ(certSet.Init(kStandardCertsCount), CHIP_NO_ERROR);
+    EXPECT_EQ(certSet.LoadCert(rootData), CHIP_NO_ERROR);
+    EXPECT_EQ(certSet.LoadCert(icaData), CHIP_NO_ERROR);
+    EXPECT_NE(findValidCert(certSet, icaData), CHIP_NO_ERROR);
+    certSet.Release();
+
+    // With the flag, the signature is trusted as it was issued by the trust anchor.
+    icaData.mCertFlags.Set(CertFlags::kSignatureVerified);
+    EXPECT_EQ(certSet.Init(kStandardCertsCount), CHIP_NO_ERROR);
+    EXPECT_EQ(certSet.LoadCert(rootData), CHIP_NO_ERROR);
+    EXPECT_EQ(certSet.LoadCert(icaData), CHIP_NO_ERROR);
+    EXPECT_EQ(findValidCert(certSet, icaData), CHIP_NO_ERROR);
+    certSet.Release();
+
+    // The flag is ignored when the issuer is not a trust anchor: the signature of the node certificate is verified
+    // with the ICA public key.
+    EXPECT_EQ(GetTestCert(TestCert::kICA01, sNullLoadFlag, cert), CHIP_NO_ERROR);
+    EXPECT_EQ(DecodeChipCert(cert, icaData, sGenTBSHashFlag), CHIP_NO_ERROR);
+    EXPECT_EQ(GetTestCert(TestCert::kNode01_01, sNullLoadFlag, cert), CHIP_NO_ERROR);
+    EXPECT_EQ(DecodeChipCert(corruptSignature(cert, badNodeBuf), nodeData, sGenTBSHashFlag), CHIP_NO_ERROR);
+    nodeData.mCertFlags.Set(CertFlags::kSignatureVerified);
+
+    EXPECT_EQ(certSet.Init(kStandardCertsCount), CHIP_NO_ERROR);
+    EXPECT_EQ(certSet.LoadCert(rootData), CHIP_NO_ERROR);
+    EXPECT_EQ(certSet.LoadCert(icaData), CHIP_NO_ERROR);
+    EXPECT_EQ(certSet.LoadCert(nodeData), CHIP_NO_ERROR);
+    EXPECT_EQ(findValidCert(certSet, icaData), CHIP_NO_ERROR);
+    EXPECT_NE(findValidCert(certSet, nodeData), CHIP_NO_ERROR);
+    certSet.Release();
+}
+
 TEST_F(TestChipCert, TestChipCert_GenerateRootCert)
 {
     // Generate a new keypair for cert signing
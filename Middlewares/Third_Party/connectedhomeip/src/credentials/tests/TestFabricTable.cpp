@@ -2995,4 +2995,229 @@ TEST_F(TestFabricTable, TestCommitMarker)
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 }
 
+TEST_F(TestFabricTable, TestVerifyCredentialsWithSameIssuers)
+{
+    Credentials::TestOnlyLocalCertificateAuthority fabricCertAuthority;
+    Credentials::TestOnlyLocalCertificateAuthority otherCertAuthority;
+
+    chip::TestPersistentStorageDelegate storage;
+    EXPECT_TRUE(fabricCertAuthority.Init().IsSuccess());
+    EXPECT_TRUE(otherCertAuthority.Init().IsSuccess());
+
+    // Initializing the fabric table sets up the issuers cache, when enabled.
+    ScopedFabricTable fabricTableHolder;
+    EXPECT_EQ(fabricTableHolder.Init(&storage), CHIP_NO_ERROR);
+
+    Crypto::P256Keypair nocKeypair;
+    EXPECT_EQ(nocKeypair.Initialize(Crypto::ECPKeyTarget::ECDSA), CHIP_NO_ERROR);
+
+    constexpr FabricId kFabricId = 1111;
+
+    auto copyCert = [](const ByteSpan & cert, uint8_t (&buf)[kMaxCHIPCertLength]) {
+        MutableByteSpan span{ buf };
+        EXPECT_EQ(CopySpanToMutableSpan(cert, span), CHIP_NO_ERROR);
+        return ByteSpan{ span };
+    };
+
+    // Two NOCs issued by two different ICACs of the same root, and a chain of another root.
+    uint8_t rcacBuf[kMaxCHIPCertLength];
+    uint8_t icac1Buf[kMaxCHIPCertLength];
+    uint8_t noc1Buf[kMaxCHIPCertLength];
+    uint8_t icac2Buf[kMaxCHIPCertLength];
+    uint8_t noc2Buf[kMaxCHIPCertLength];
+    uint8_t otherIcacBuf[kMaxCHIPCertLength];
+    uint8_t otherNocBuf[kMaxCHIPCertLength];
+
+    fabricCertAuthority.SetIncludeIcac(true);
+    EXPECT_EQ(fabricCertAuthority.GenerateNocChain(kFabricId, 55, nocKeypair.Pubkey()).GetStatus(), CHIP_NO_ERROR);
+    ByteSpan rcac  = copyCert(fabricCertAuthority.GetRcac(), rcacBuf);
+    ByteSpan icac1 = copyCert(fabricCertAuthority.GetIcac(), icac1Buf);
+    ByteSpan noc1  = copyCert(fabricCertAuthority.GetNoc(), noc1Buf);
+
+    EXPECT_EQ(fabricCertAuthority.GenerateNocChain(kFabricId, 66, nocKeypair.Pubkey()).GetStatus(), CHIP_NO_ERROR);
+    ByteSpan icac2 = copyCert(fabricCertAuthority.GetIcac(), icac2Buf);
+    ByteSpan noc2  = copyCert(fabricCertAuthority.GetNoc(), noc2Buf);
+
+    otherCertAuthority.SetIncludeIcac(true);
+    EXPECT_EQ(otherCertAuthority.GenerateNocChain(kFabricId, 77, nocKeypair.Pubkey()).GetStatus(), CHIP_NO_ERROR);
+    ByteSpan otherIcac = copyCert(otherCertAuthority.GetIcac(), otherIcacBuf);
+    ByteSpan otherNoc  = copyCert(otherCertAuthority.GetNoc(), otherNocBuf);
+
+    auto verify = [&rcac](const ByteSpan & noc, const ByteSpan & icac, NodeId & outNodeId) {
+        Credentials::ValidationContext validContext;
+        validContext.Reset();
+        validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+        validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+
+        CompressedFabricId compressedFabricId;
+        FabricId fabricId;
+        Crypto::P256PublicKey nocPubkey;
+        return FabricTable::VerifyCredentials(noc, icac, rcac, validContext, compressedFabricId, fabricId, outNodeId, nocPubkey);
+    };
+
+    // The results are the same on the first validation with given issuers as on the next ones, which can reuse them.
+    for (int i = 0; i < 3; i++)
+    {
+        NodeId nodeId = kUndefinedNodeId;
+
+        EXPECT_EQ(verify(noc1, icac1, nodeId), CHIP_NO_ERROR);
+        EXPECT_EQ(nodeId, 55u);
+        EXPECT_EQ(verify(noc2, icac2, nodeId), CHIP_NO_ERROR);
+        EXPECT_EQ(nodeId, 66u);
+
+        // The NOC signature is still verified with known issuers.
+        EXPECT_NE(verify(noc2, icac1, nodeId), CHIP_NO_ERROR);
+        EXPECT_NE(verify(noc1, icac2, nodeId), CHIP_NO_ERROR);
+        EXPECT_NE(verify(noc1, ByteSpan{}, nodeId), CHIP_NO_ERROR);
+
+        // An ICAC that was not issued by the root is never accepted.
+        EXPECT_NE(verify(otherNoc, otherIcac, nodeId), CHIP_NO_ERROR);
+    }
+}
+
+#if CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+TEST_F(TestFabricTable, TestVerifiedCertChainCacheEviction)
+{
+    constexpr size_t kNumIssuers = CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE + 1;
+    constexpr FabricId kFabricId = 1111;
+    constexpr NodeId kNodeIdBase = 100;
+
+    Credentials::TestOnlyLocalCertificateAuthority fabricCertAuthority;
+    chip::TestPersistentStorageDelegate storage;
+    EXPECT_TRUE(fabricCertAuthority.Init().IsSuccess());
+
+    ScopedFabricTable fabricTableHolder;
+    EXPECT_EQ(fabricTableHolder.Init(&storage), CHIP_NO_ERROR);
+
+    Crypto::P256Keypair nocKeypair;
+    EXPECT_EQ(nocKeypair.Initialize(Crypto::ECPKeyTarget::ECDSA), CHIP_NO_ERROR);
+
+    auto copyCert = [](const ByteSpan & cert, uint8_t (&buf)[kMaxCHIPCertLength]) {
+        MutableByteSpan span{ buf };
+        EXPECT_EQ(CopySpanToMutableSpan(cert, span), CHIP_NO_ERROR);
+        return ByteSpan{ span };
+    };
+
+    // One more ICAC of the same root than the cache has entries, each with its own NOC.
+    uint8_t rcacBuf[kMaxCHIPCertLength];
+    uint8_t icacBufs[kNumIssuers][kMaxCHIPCertLength];
+    uint8_t nocBufs[kNumIssuers][kMaxCHIPCertLength];
+    ByteSpan rcac;
+    ByteSpan icacs[kNumIssuers];
+    ByteSpan nocs[kNumIssuers];
+
+    fabricCertAuthority.SetIncludeIcac(true);
+    for (size_t i = 0; i < kNumIssuers; i++)
+    {
+        EXPECT_EQ(fabricCertAuthority.GenerateNocChain(kFabricId, kNodeIdBase + i, nocKeypair.Pubkey()).GetStatus(),
+                  CHIP_NO_ERROR);
+        rcac     = copyCert(fabricCertAuthority.GetRcac(), rcacBuf);
+        icacs[i] = copyCert(fabricCertAuthority.GetIcac(), icacBufs[i]);
+        nocs[i]  = copyCert(fabricCertAuthority.GetNoc(), nocBufs[i]);
+    }
+
+    // Verifies the chain of the given issuer, and returns whether its issuers were found in the cache.
+    auto verifyIsHit = [&](size_t issuer) {
+        Credentials::ValidationContext validContext;
+        validContext.Reset();
+        validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+        validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+
+        CompressedFabricId compressedFabricId;
+        FabricId fabricId;
+        NodeId nodeId = kUndefinedNodeId;
+        Crypto::P256PublicKey nocPubkey;
+
+        uint32_t hitCount  = FabricTable::GetVerifiedCertChainCacheHitCount();
+        uint32_t missCount = FabricTable::GetVerifiedCertChainCacheMissCount();
+        EXPECT_EQ(FabricTable::VerifyCredentials(nocs[issuer], icacs[issuer], rcac, validContext, compressedFabricId, fabricId,
+                                                 nodeId, nocPubkey),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(nodeId, kNodeIdBase + issuer);
+
+        bool isHit = FabricTable::GetVerifiedCertChainCacheHitCount() == hitCount + 1;
+        EXPECT_EQ(FabricTable::GetVerifiedCertChainCacheMissCount(), missCount + (isHit ? 0 : 1));
+        return isHit;
+    };
+
+    // Each new issuer takes an entry. The last one replaces the least recently used entry, the one of the first issuer.
+    for (size_t i = 0; i < kNumIssuers; i++)
+    {
+        EXPECT_FALSE(verifyIsHit(i));
+    }
+
+    // Going back through the cached ones leaves the last issuer as the least recently used: the first one replaces it.
+    for (size_t i = kNumIssuers - 1; i > 0; i--)
+    {
+        EXPECT_TRUE(verifyIsHit(i));
+    }
+    EXPECT_FALSE(verifyIsHit(0));
+
+    for (size_t i = 0; i < kNumIssuers - 1; i++)
+    {
+        EXPECT_TRUE(verifyIsHit(i));
+    }
+    EXPECT_FALSE(verifyIsHit(kNumIssuers - 1));
+}
+
+TEST_F(TestFabricTable, TestVerifiedCertChainCacheTamperedIcac)
+{
+    constexpr FabricId kFabricId = 1111;
+
+    Credentials::TestOnlyLocalCertificateAuthority fabricCertAuthority;
+    chip::TestPersistentStorageDelegate storage;
+    EXPECT_TRUE(fabricCertAuthority.Init().IsSuccess());
+
+    ScopedFabricTable fabricTableHolder;
+    EXPECT_EQ(fabricTableHolder.Init(&storage), CHIP_NO_ERROR);
+
+    Crypto::P256Keypair nocKeypair;
+    EXPECT_EQ(nocKeypair.Initialize(Crypto::ECPKeyTarget::ECDSA), CHIP_NO_ERROR);
+
+    uint8_t rcacBuf[kMaxCHIPCertLength];
+    uint8_t icacBuf[kMaxCHIPCertLength];
+    uint8_t tamperedIcacBuf[kMaxCHIPCertLength];
+    uint8_t nocBuf[kMaxCHIPCertLength];
+    MutableByteSpan rcac{ rcacBuf };
+    MutableByteSpan icac{ icacBuf };
+    MutableByteSpan tamperedIcac{ tamperedIcacBuf };
+    MutableByteSpan noc{ nocBuf };
+
+    fabricCertAuthority.SetIncludeIcac(true);
+    EXPECT_EQ(fabricCertAuthority.GenerateNocChain(kFabricId, 55, nocKeypair.Pubkey()).GetStatus(), CHIP_NO_ERROR);
+    EXPECT_EQ(CopySpanToMutableSpan(fabricCertAuthority.GetRcac(), rcac), CHIP_NO_ERROR);
+    EXPECT_EQ(CopySpanToMutableSpan(fabricCertAuthority.GetIcac(), icac), CHIP_NO_ERROR);
+    EXPECT_EQ(CopySpanToMutableSpan(fabricCertAuthority.GetNoc(), noc), CHIP_NO_ERROR);
+
+    // Same subject DN and key id as the ICAC, which still issued the NOC, but not signed by the root: the signature is
+    // the last element of the certificate, right before the end of container.
+    EXPECT_EQ(CopySpanToMutableSpan(icac, tamperedIcac), CHIP_NO_ERROR);
+    tamperedIcacBuf[tamperedIcac.size() - 2] ^= 0x01;
+
+    auto verify = [&](const ByteSpan & issuer) {
+        Credentials::ValidationContext validContext;
+        validContext.Reset();
+        validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+        validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+
+        CompressedFabricId compressedFabricId;
+        FabricId fabricId;
+        NodeId nodeId;
+        Crypto::P256PublicKey nocPubkey;
+        return FabricTable::VerifyCredentials(noc, issuer, rcac, validContext, compressedFabricId, fabricId, nodeId, nocPubkey);
+    };
+
+    // The tampered ICAC is rejected whether or not the genuine one is cached, and is never cached in its place.
+    EXPECT_NE(verify(tamperedIcac), CHIP_NO_ERROR);
+    EXPECT_EQ(verify(icac), CHIP_NO_ERROR);
+    EXPECT_NE(verify(tamperedIcac), CHIP_NO_ERROR);
+
+    uint32_t hitCount = FabricTable::GetVerifiedCertChainCacheHitCount();
+    EXPECT_NE(verify(tamperedIcac), CHIP_NO_ERROR);
+    EXPECT_EQ(FabricTable::GetVerifiedCertChainCacheHitCount(), hitCount);
+    EXPECT_EQ(verify(icac), CHIP_NO_ERROR);
+    EXPECT_EQ(FabricTable::GetVerifiedCertChainCacheHitCount(), hitCount + 1);
+}
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE > 0
+
 } // namespace
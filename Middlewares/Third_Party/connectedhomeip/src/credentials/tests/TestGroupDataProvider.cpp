@@ -162,6 +162,18 @@ public:
 };
 static TestListener sListener;
 
+class ReadCountingStorageDelegate : public chip::TestPersistentStorageDelegate
+{
+public:
+    size_t read_count = 0;
+
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        read_count++;
+        return TestPersistentStorageDelegate::SyncGetKeyValue(key, buffer, size);
+    }
+};
+
 void ResetProvider(GroupDataProvider * provider)
 {
     provider->RemoveFabric(kFabric1);
@@ -192,7 +204,7 @@ bool CompareKeySets(const KeySet & retrievedKeySet, const KeySet & keyset2)
 struct TestGroupDataProvider : public ::testing::Test
 {
 
-    static chip::TestPersistentStorageDelegate sDelegate;
+    static ReadCountingStorageDelegate sDelegate;
     static chip::Crypto::DefaultSessionKeystore sSessionKeystore;
     static GroupDataProviderImpl sProvider;
 
@@ -244,7 +256,7 @@ struct TestGroupDataProvider : public ::testing::Test
     }
 };
 
-chip::TestPersistentStorageDelegate TestGroupDataProvider::sDelegate;
+ReadCountingStorageDelegate TestGroupDataProvider::sDelegate;
 chip::Crypto::DefaultSessionKeystore TestGroupDataProvider::sSessionKeystore;
 GroupDataProviderImpl TestGroupDataProvider::sProvider(kMaxGroupsPerFabric, kMaxGroupKeysPerFabric);
 
@@ -1222,6 +1234,89 @@ TEST_F(TestGroupDataProvider, TestGroupDecryption)
     it->Release();
 }
 
+TEST_F(TestGroupDataProvider, TestGroupSessionCache)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+    EXPECT_TRUE(provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet3), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+
+    auto countSessions = [provider](uint16_t session_id, FabricIndex fabric_index, GroupId group_id) -> size_t {
+        GroupSession session;
+        size_t count = 0;
+        auto it      = provider->IterateGroupSessions(session_id);
+        VerifyOrReturnValue(it != nullptr, 0);
+        while (it->Next(session))
+        {
+            EXPECT_NE(session.keyContext, nullptr);
+            if (session.fabric_index == fabric_index && session.group_id == group_id)
+            {
+                count++;
+            }
+        }
+        EXPECT_EQ(it->Count(), count);
+        it->Release();
+        return count;
+    };
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric2, kGroup2);
+    ASSERT_NE(nullptr, key_context);
+    uint16_t session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 1u);
+
+    // Once loaded, iterating group sessions must not touch persistent storage, as long as the
+    // three group sessions configured above fit in the cache
+    size_t reads = sDelegate.read_count;
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 1u);
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE >= 3
+    EXPECT_EQ(sDelegate.read_count, reads);
+#else
+    EXPECT_GT(sDelegate.read_count, reads);
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE >= 3
+
+    // Changes to the group key map must be visible on the next iteration, which reloads the cache once
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset3), CHIP_NO_ERROR);
+    reads = sDelegate.read_count;
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 0u);
+    EXPECT_GT(sDelegate.read_count, reads);
+    // Group 2 now maps to the three keys of key set 3: five group sessions in total
+    reads = sDelegate.read_count;
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 0u);
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE >= 5
+    EXPECT_EQ(sDelegate.read_count, reads);
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE >= 5
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 1, kGroup3Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup3), 1u);
+    EXPECT_EQ(provider->RemoveGroupKeyAt(kFabric2, 1), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup3), 0u);
+
+    // Changes to the key sets must be visible on the next iteration
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 1u);
+    KeySet updated_keyset = kKeySet1;
+    memcpy(updated_keyset.epoch_keys, kKeySet2.epoch_keys, sizeof(updated_keyset.epoch_keys));
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, updated_keyset), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 0u);
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 1u);
+    EXPECT_EQ(provider->RemoveKeySet(kFabric2, kKeysetId1), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 0u);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset3), CHIP_NO_ERROR);
+
+    // Removing the fabric drops its group sessions
+    EXPECT_EQ(provider->RemoveFabric(kFabric2), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(session_id, kFabric2, kGroup2), 0u);
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
@@ -91,6 +91,52 @@
 #define CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE 100
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+ *
+ * On FreeRTOS, carry the chip Platform events in two lock-free rings instead of a FreeRTOS queue:
+ * an urgent ring for all the events, and a bulk ring for the work scheduled with ScheduleWork().
+ * The event loop dispatches the urgent events first, and is woken up by a single task notification
+ * for all the events posted while it was busy.
+ *
+ * Events keep their order within a ring, but an urgent event posted after some work can be dispatched
+ * before it.
+ */
+#ifndef CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+#define CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING 0
+#endif
+
+/**
+ * CHIP_DEVICE_CONFIG_URGENT_EVENT_RING_SIZE
+ *
+ * The maximum number of urgent events held by CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING. Must be a power of two.
+ */
+#ifndef CHIP_DEVICE_CONFIG_URGENT_EVENT_RING_SIZE
+#define CHIP_DEVICE_CONFIG_URGENT_EVENT_RING_SIZE 64
+#endif
+
+/**
+ * CHIP_DEVICE_CONFIG_BULK_EVENT_RING_SIZE
+ *
+ * The maximum number of scheduled work items held by CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING. Must be a power of two.
+ */
+#ifndef CHIP_DEVICE_CONFIG_BULK_EVENT_RING_SIZE
+#define CHIP_DEVICE_CONFIG_BULK_EVENT_RING_SIZE 32
+#endif
+
+/**
+ * CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+ *
+ * Count the posted and dropped chip Platform events, the maximum queue depth, and the time between the
+ * posting and the dispatch of the events, for the urgent events and the scheduled work separately.
+ *
+ * Only implemented on FreeRTOS, for both the FreeRTOS queue and CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING,
+ * so that they can be compared. Times are in FreeRTOS ticks.
+ */
+#ifndef CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+#define CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS 0
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
  *
@@ -74,13 +74,19 @@ CHIP_ERROR GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_InitChipStack(void)
         }
     }
 
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    // Start with a clean slate, as the queue below.
+    mUrgentEvents.Reset();
+    mBulkEvents.Reset();
+    mEventLoopWakeupPending.store(false);
+#else
     if (mChipEventQueue == NULL)
     {
 #if defined(CHIP_CONFIG_FREERTOS_USE_STATIC_QUEUE) && CHIP_CONFIG_FREERTOS_USE_STATIC_QUEUE
-        mChipEventQueue = xQueueCreateStatic(CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE, sizeof(ChipDeviceEvent), mEventQueueBuffer,
+        mChipEventQueue = xQueueCreateStatic(CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE, sizeof(EventQueueItem), mEventQueueBuffer,
                                              &mEventQueueStruct);
 #else
-        mChipEventQueue = xQueueCreate(CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE, sizeof(ChipDeviceEvent));
+        mChipEventQueue = xQueueCreate(CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE, sizeof(EventQueueItem));
 #endif
         if (mChipEventQueue == NULL)
         {
@@ -94,6 +100,7 @@ CHIP_ERROR GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_InitChipStack(void)
         // with a clean slate, as if we had just re-created the queue.
         xQueueReset(mChipEventQueue);
     }
+#endif // CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
 
     mShouldRunEventLoop.store(false);
 
@@ -170,24 +177,57 @@ bool GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_IsChipStackLockedByCurrent
 template <class ImplClass>
 CHIP_ERROR GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_PostEvent(const ChipDeviceEvent * event)
 {
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    QueuedEvent queued;
+    queued.mEvent = *event;
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    queued.mPostTicks = xTaskGetTickCount();
+#endif
+    if (!PushEvent(queued))
+    {
+        ChipLogError(DeviceLayer, "Failed to post event to CHIP Platform event queue");
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    // Only the first event posted since the event loop started dispatching notifies it. The flag must be set before
+    // reading the waiter: a loop that starts after the read clears it before looking for events.
+    if (!mEventLoopWakeupPending.exchange(true))
+    {
+        TaskHandle_t waiter = mEventLoopWaiter.load();
+        if (waiter != NULL)
+        {
+            xTaskNotifyGive(waiter);
+        }
+    }
+    return CHIP_NO_ERROR;
+#else
     if (mChipEventQueue == NULL)
     {
         return CHIP_ERROR_INTERNAL;
     }
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    QueuedEvent queued = { *event, xTaskGetTickCount() };
+    BaseType_t status  = xQueueSend(mChipEventQueue, &queued, 1);
+    RecordEventPosted(*event, status == pdTRUE, uxQueueMessagesWaiting(mChipEventQueue));
+#else
     BaseType_t status = xQueueSend(mChipEventQueue, event, 1);
+#endif
     if (status != pdTRUE)
     {
         ChipLogError(DeviceLayer, "Failed to post event to CHIP Platform event queue");
         return CHIP_ERROR(chip::ChipError::Range::kOS, status);
     }
     return CHIP_NO_ERROR;
+#endif // CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
 }
 
 template <class ImplClass>
 void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_RunEventLoop(void)
 {
     CHIP_ERROR err;
-    ChipDeviceEvent event;
+#if !CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    EventQueueItem item;
+#endif
 
     // Lock the CHIP stack.
     StackLock lock;
@@ -199,6 +239,13 @@ void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_RunEventLoop(void)
         return;
     }
 
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    mEventLoopWaiter.store(xTaskGetCurrentTaskHandle());
+
+    // Events posted before the loop started did not notify it.
+    bool moreEvents = true;
+#endif
+
     while (mShouldRunEventLoop.load())
     {
         TickType_t waitTime;
@@ -243,23 +290,139 @@ void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_RunEventLoop(void)
             waitTime = portMAX_DELAY;
         }
 
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+        if (!moreEvents)
+        {
+            // Unlock the CHIP stack, allowing other threads to enter CHIP while
+            // the event loop thread is sleeping.
+            StackUnlock unlock;
+            ulTaskNotifyTake(pdTRUE, waitTime);
+        }
+
+        moreEvents = DispatchQueuedEvents();
+#else
         BaseType_t eventReceived = pdFALSE;
         {
             // Unlock the CHIP stack, allowing other threads to enter CHIP while
             // the event loop thread is sleeping.
             StackUnlock unlock;
-            eventReceived = xQueueReceive(mChipEventQueue, &event, waitTime);
+            eventReceived = xQueueReceive(mChipEventQueue, &item, waitTime);
         }
 
         // If an event was received, dispatch it and continue until the queue is empty.
         while (eventReceived == pdTRUE)
         {
-            Impl()->DispatchEvent(&event);
-            eventReceived = xQueueReceive(mChipEventQueue, &event, 0);
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+            RecordEventDispatched(item);
+            Impl()->DispatchEvent(&item.mEvent);
+#else
+            Impl()->DispatchEvent(&item);
+#endif
+            eventReceived = xQueueReceive(mChipEventQueue, &item, 0);
         }
+#endif // CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
     }
+
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    mEventLoopWaiter.store(NULL);
+#endif
 }
 
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+template <class ImplClass>
+bool GenericPlatformManagerImpl_FreeRTOS<ImplClass>::PushEvent(const QueuedEvent & queued)
+{
+    bool bulk   = (GetEventLane(queued.mEvent) == EventLane::kBulk);
+    bool posted = bulk ? mBulkEvents.Push(queued) : mUrgentEvents.Push(queued);
+
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    RecordEventPosted(queued.mEvent, posted, bulk ? mBulkEvents.Size() : mUrgentEvents.Size());
+#endif
+    return posted;
+}
+
+/**
+ * Dispatches the queued events, the urgent ones first.
+ *
+ * Returns true if it stopped before the rings were empty: at most a ring's worth of events is dispatched at once, so
+ * that a steady flow of events cannot hold back the timers.
+ */
+template <class ImplClass>
+bool GenericPlatformManagerImpl_FreeRTOS<ImplClass>::DispatchQueuedEvents()
+{
+    QueuedEvent queued;
+
+    // The events posted from now on notify the event loop again.
+    mEventLoopWakeupPending.store(false);
+
+    for (size_t i = 0; i < mUrgentEvents.Capacity() + mBulkEvents.Capacity(); i++)
+    {
+        if (!mUrgentEvents.Pop(queued) && !mBulkEvents.Pop(queued))
+        {
+            return false;
+        }
+
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+        RecordEventDispatched(queued);
+#endif
+        Impl()->DispatchEvent(&queued.mEvent);
+    }
+
+    return true;
+}
+#endif // CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+template <class ImplClass>
+void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::RecordEventPosted(const ChipDeviceEvent & event, bool posted, size_t depth)
+{
+    EventQueueMetrics & metrics = mEventQueueMetrics[to_underlying(GetEventLane(event))];
+
+    if (!posted)
+    {
+        metrics.mDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    metrics.mPosted.fetch_add(1, std::memory_order_relaxed);
+
+    // Posted from any task or interrupt.
+    uint32_t maxDepth = metrics.mMaxDepth.load(std::memory_order_relaxed);
+    while (depth > maxDepth &&
+           !metrics.mMaxDepth.compare_exchange_weak(maxDepth, static_cast<uint32_t>(depth), std::memory_order_relaxed))
+    {
+    }
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::RecordEventDispatched(const QueuedEvent & queued)
+{
+    EventQueueMetrics & metrics = mEventQueueMetrics[to_underlying(GetEventLane(queued.mEvent))];
+    TickType_t latency          = xTaskGetTickCount() - queued.mPostTicks;
+
+    metrics.mDispatched++;
+    metrics.mTotalLatencyTicks += latency;
+    if (latency > metrics.mMaxLatencyTicks)
+    {
+        metrics.mMaxLatencyTicks = latency;
+    }
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::ResetEventQueueMetrics()
+{
+    for (EventQueueMetrics & metrics : mEventQueueMetrics)
+    {
+        metrics.mPosted.store(0);
+        metrics.mDropped.store(0);
+        metrics.mMaxDepth.store(0);
+        metrics.mDispatched        = 0;
+        metrics.mMaxLatencyTicks   = 0;
+        metrics.mTotalLatencyTicks = 0;
+    }
+}
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+
 template <class ImplClass>
 CHIP_ERROR GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_StartEventLoopTask(void)
 {
@@ -404,13 +567,42 @@ void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::PostEventFromISR(const Chip
 {
     yieldRequired = pdFALSE;
 
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    QueuedEvent queued;
+    queued.mEvent = *event;
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    queued.mPostTicks = xTaskGetTickCountFromISR();
+#endif
+    if (!PushEvent(queued))
+    {
+        ChipLogError(DeviceLayer, "Failed to post event to CHIP Platform event queue");
+        return;
+    }
+
+    if (!mEventLoopWakeupPending.exchange(true))
+    {
+        TaskHandle_t waiter = mEventLoopWaiter.load();
+        if (waiter != NULL)
+        {
+            vTaskNotifyGiveFromISR(waiter, &yieldRequired);
+        }
+    }
+#else
     if (mChipEventQueue != NULL)
     {
-        if (!xQueueSendFromISR(mChipEventQueue, event, &yieldRequired))
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+        QueuedEvent queued = { *event, xTaskGetTickCountFromISR() };
+        BaseType_t status  = xQueueSendFromISR(mChipEventQueue, &queued, &yieldRequired);
+        RecordEventPosted(*event, status == pdTRUE, uxQueueMessagesWaitingFromISR(mChipEventQueue));
+#else
+        BaseType_t status = xQueueSendFromISR(mChipEventQueue, event, &yieldRequired);
+#endif
+        if (!status)
         {
             ChipLogError(DeviceLayer, "Failed to post event to CHIP Platform event queue");
         }
     }
+#endif // CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
 }
 
 template <class ImplClass>
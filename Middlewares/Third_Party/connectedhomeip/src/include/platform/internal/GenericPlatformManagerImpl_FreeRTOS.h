@@ -39,6 +39,13 @@
 #include "task.h"
 #endif
 
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+#include <lib/support/MpscRing.h>
+#endif
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING || CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+#include <lib/support/TypeTraits.h>
+#endif
+
 #include <atomic>
 
 namespace chip {
@@ -98,6 +105,34 @@ protected:
 
     void PostEventFromISR(const ChipDeviceEvent * event, BaseType_t & yieldRequired);
 
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING || CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    enum class EventLane : uint8_t
+    {
+        kUrgent, ///< All the events but the work scheduled with ScheduleWork().
+        kBulk,   ///< The work scheduled with ScheduleWork().
+        kCount,
+    };
+#endif
+
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    /**
+     * Metrics of the events of a lane. The dispatch metrics are updated by the event loop: read them, and reset the
+     * metrics, with the CHIP stack locked.
+     */
+    struct EventQueueMetrics
+    {
+        std::atomic<uint32_t> mPosted{ 0 };
+        std::atomic<uint32_t> mDropped{ 0 };
+        std::atomic<uint32_t> mMaxDepth{ 0 }; ///< With the FreeRTOS queue, the depth of the queue shared by both lanes.
+        uint32_t mDispatched        = 0;
+        uint32_t mMaxLatencyTicks   = 0;
+        uint64_t mTotalLatencyTicks = 0;
+    };
+
+    const EventQueueMetrics & GetEventQueueMetrics(EventLane lane) const { return mEventQueueMetrics[to_underlying(lane)]; }
+    void ResetEventQueueMetrics();
+#endif
+
 private:
     // ===== Private members for use by this class only.
 
@@ -105,8 +140,50 @@ private:
 
     static void EventLoopTaskMain(void * arg);
 
-#if defined(CHIP_CONFIG_FREERTOS_USE_STATIC_QUEUE) && CHIP_CONFIG_FREERTOS_USE_STATIC_QUEUE
-    uint8_t mEventQueueBuffer[CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE * sizeof(ChipDeviceEvent)];
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING || CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    struct QueuedEvent
+    {
+        ChipDeviceEvent mEvent;
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+        TickType_t mPostTicks;
+#endif
+    };
+#endif
+
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING || CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    static EventLane GetEventLane(const ChipDeviceEvent & event)
+    {
+        return (event.Type == DeviceEventType::kCallWorkFunct) ? EventLane::kBulk : EventLane::kUrgent;
+    }
+#endif
+
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    void RecordEventPosted(const ChipDeviceEvent & event, bool posted, size_t depth);
+    void RecordEventDispatched(const QueuedEvent & queued);
+
+    EventQueueMetrics mEventQueueMetrics[to_underlying(EventLane::kCount)];
+#endif
+
+#if CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    bool PushEvent(const QueuedEvent & queued);
+    bool DispatchQueuedEvents();
+
+    MpscRing<QueuedEvent, CHIP_DEVICE_CONFIG_URGENT_EVENT_RING_SIZE> mUrgentEvents;
+    MpscRing<QueuedEvent, CHIP_DEVICE_CONFIG_BULK_EVENT_RING_SIZE> mBulkEvents;
+
+    // Task running the event loop, to notify when events are posted.
+    std::atomic<TaskHandle_t> mEventLoopWaiter{ nullptr };
+    // Set by the first event posted after the event loop started dispatching: the following ones do not notify it again.
+    std::atomic<bool> mEventLoopWakeupPending{ false };
+#elif CHIP_DEVICE_CONFIG_EVENT_QUEUE_METRICS
+    // The queue carries the time the events were posted.
+    using EventQueueItem = QueuedEvent;
+#else
+    using EventQueueItem = ChipDeviceEvent;
+#endif
+
+#if defined(CHIP_CONFIG_FREERTOS_USE_STATIC_QUEUE) && CHIP_CONFIG_FREERTOS_USE_STATIC_QUEUE && !CHIP_DEVICE_CONFIG_FREERTOS_EVENT_RING
+    uint8_t mEventQueueBuffer[CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE * sizeof(EventQueueItem)];
     StaticQueue_t mEventQueueStruct;
 #endif
 #if defined(CHIP_CONFIG_FREERTOS_USE_STATIC_TASK) && CHIP_CONFIG_FREERTOS_USE_STATIC_TASK
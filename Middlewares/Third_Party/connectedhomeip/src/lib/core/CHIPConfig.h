@@ -747,6 +747,42 @@
 #define CHIP_CONFIG_MAX_FABRICS 16
 #endif // CHIP_CONFIG_MAX_FABRICS
 
+/**
+ * @def CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE
+ *
+ * @brief Number of CASE handshakes the CASEServer can respond to at the same time.
+ *
+ * Each responder holds a CASESession and reserves a SecureSession for its next handshake. A Sigma1 received while all the
+ * responders are in use gets a Busy status report, as does a Sigma1 from a peer address that already has a handshake in
+ * progress.
+ *
+ * Test builds use 2 responders so that the unit tests cover concurrent handshakes.
+ */
+#ifndef CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE
+#if CHIP_CONFIG_TEST
+#define CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE 2
+#else
+#define CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE 1
+#endif // CHIP_CONFIG_TEST
+#endif // CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE
+
+#if CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE < 1
+#error "CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE must be at least 1"
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC
+ *
+ * @brief Number of CASE handshakes that may be verifying a Sigma3 in the background before the CASEServer
+ *        answers new Sigma1 messages with a Busy status report.
+ *
+ * Handling a Sigma1 and verifying a Sigma3 are the ECC-heavy steps of the responder. This bounds how much of that work
+ * is in progress at once when CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE is greater than 1.
+ */
+#ifndef CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC
+#define CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC 1
+#endif // CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC
+
 /**
  * @def CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
  *
@@ -756,7 +792,7 @@
  *
  * This is sized by default to cover the sum of the following:
  *  - At least 3 CASE sessions / fabric (Spec Ref: 4.13.2.8)
- *  - 1 reserved slot for CASEServer as a responder.
+ *  - 1 reserved slot per CASEServer responder (CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE).
  *  - 1 reserved slot for PASE.
  *
  *  NOTE: On heap-based platforms, there is no pre-allocation of the pool.
@@ -766,7 +802,7 @@
  *
  */
 #ifndef CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
-#define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
+#define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE + 1)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
 /**
@@ -854,6 +890,8 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+ *      * #CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES
+ *      * #CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_MAX_SIZE
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
@@ -931,6 +969,27 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES
+ *
+ * @brief Defines the number of encoded attribute values the reporting engine shares between the subscriptions it reports a
+ *        change to.  The cache is emptied every time an attribute is marked dirty.  Set to 0 to encode every attribute for
+ *        every subscription.
+ */
+#ifndef CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES
+#define CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_ENTRIES 8
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_MAX_SIZE
+ *
+ * @brief Defines the largest encoded AttributeReportIB, in bytes, that the reporting engine keeps in its encoded attribute
+ *        cache.  Larger values are encoded for every subscription.
+ */
+#ifndef CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_MAX_SIZE
+#define CHIP_IM_SERVER_ENCODED_ATTRIBUTE_CACHE_MAX_SIZE 64
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1146,6 +1205,34 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_TARGETS_PER_ENTRY 3
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS
+ *
+ * Defines the number of fabrics for which access control keeps a compiled
+ * (pre-decoded) copy of the access control entries, so that checks do not go
+ * through the entry iterator. Fabrics beyond that evict each other. The size
+ * of a compiled copy is derived from the example access control limits
+ * above; larger access control lists fall back to iterating the entries.
+ *
+ * Set to 0 to always iterate the entries.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS
+#define CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ACL_FABRICS 2
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+ *
+ * Defines the number of access control decisions (per endpoint, cluster and
+ * privilege) remembered for the subject of an interaction while an
+ * AccessControl::DecisionCacheScope is alive.
+ *
+ * Set to 0 to disable the decision cache.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE 8
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_ENTRY_STORAGE_POOL_SIZE
  *
@@ -1237,6 +1324,26 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE (3 * CHIP_CONFIG_MAX_FABRICS)
 #endif
 
+/**
+ * @def CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+ *
+ * @brief
+ *   Enable (1) or disable (0) the in-RAM copy of the session resumption index in DefaultSessionResumptionStorage.
+ *
+ *   When enabled, the index and the resumption ID of each of its nodes are read from storage once, then kept up to date
+ *   as they are saved. Save() and Delete() no longer read the index, and FindByResumptionId() finds the node without
+ *   reading the resumption ID link. This costs about 40 bytes of RAM per entry of CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE.
+ *
+ *   Test builds enable it so that the unit tests cover the cache.
+ */
+#ifndef CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+#if CHIP_CONFIG_TEST
+#define CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE 1
+#else
+#define CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE 0
+#endif // CHIP_CONFIG_TEST
+#endif
+
 /**
  * @def CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD
  *
@@ -1257,6 +1364,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES
+ *
+ * @brief
+ *   Number of (event number, offset) entries of the sparse index kept for each event buffer.
+ *
+ * Fetching the events since a given event number for a report starts reading from the closest indexed
+ * event instead of going through every older event of every buffer. The entries are spread out evenly
+ * over the buffer, each one takes 16 bytes.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES 4
+#endif /* CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES */
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1844,6 +1965,69 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS 5
 #endif // CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS
 
+/**
+ * @def CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE
+ *
+ * @brief Maximum number of attributes (across all enabled endpoints) tracked by the ember attribute location index.
+ *
+ * When non-zero, attribute-storage keeps a hash index from <endpoint, cluster, attribute> to the attribute
+ * metadata and storage offset, so that ember attribute reads and writes no longer walk every endpoint, cluster
+ * and attribute. The index uses roughly 20 bytes of RAM per entry. If more attributes are enabled than the index
+ * can hold, lookups fall back to the linear scan.
+ *
+ * Set to 0 to disable the index. Test builds enable it so that the unit tests cover the index.
+ */
+#ifndef CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE
+#if CHIP_CONFIG_TEST
+#define CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE 64
+#else
+#define CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE 0
+#endif // CHIP_CONFIG_TEST
+#endif // CHIP_CONFIG_EMBER_ATTRIBUTE_LOCATION_INDEX_SIZE
+
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+ *
+ * @brief Maximum number of group sessions (operational group keys mapped to a group, across all fabrics)
+ *        kept in RAM by GroupDataProviderImpl.
+ *
+ * When non-zero, GroupDataProviderImpl::IterateGroupSessions() is served from a RAM cache indexed by group
+ * session id instead of reading the fabric, group key map and key set entries from persistent storage for
+ * every incoming groupcast message. The cache is reloaded from storage after any change to the group key
+ * map or key sets, and uses roughly 56 bytes of RAM per entry. If more group sessions exist than the cache
+ * can hold, group sessions are iterated from storage.
+ *
+ * Set to 0 to disable the cache. Test builds enable it so that the unit tests cover the cache.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+#if CHIP_CONFIG_TEST
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE 8
+#else
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE 0
+#endif // CHIP_CONFIG_TEST
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+
+/**
+ * @def CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE
+ *
+ * @brief Number of issuer certificate pairs (RCAC and optional ICAC) kept by FabricTable::VerifyCredentials() after
+ *        validating a chain with them.
+ *
+ * When non-zero, validating another NOC issued by cached issuers (for instance during CASE, where all the peers of a
+ * fabric share them) reuses their decoded data and skips the ICAC signature verification, so only the NOC signature
+ * is verified. Validity times and the certificate validity policy are still checked on every validation. Each entry
+ * uses roughly 1.5 KB of RAM for the copies of the certificates and their decoded data.
+ *
+ * Set to 0 to disable the cache. Test builds enable it so that the unit tests cover the cache.
+ */
+#ifndef CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE
+#if CHIP_CONFIG_TEST
+#define CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE 2
+#else
+#define CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE 0
+#endif // CHIP_CONFIG_TEST
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE
+
 /**
  * @}
  */
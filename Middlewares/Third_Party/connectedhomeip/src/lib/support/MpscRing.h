@@ -0,0 +1,149 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ * A bounded lock-free queue of N items of type T, with any number of producers and a single consumer.
+ *
+ * Push() may be called concurrently from any thread or interrupt handler, Pop() only from the consumer thread. Items are
+ * copied in and out of the ring, and are popped in the order their producers claimed their slot.
+ *
+ * Each slot holds a sequence number telling whether it is free for the producer of a given position, or published for the
+ * consumer. A producer that claimed a slot but did not publish it yet (for instance because an interrupt preempted it)
+ * holds back the items pushed after it: until it is done, Pop() reports the ring as empty.
+ *
+ * N must be a power of two, so that the positions can wrap around.
+ */
+template <typename T, size_t N>
+class MpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "The ring size must be a power of two");
+    static_assert(N <= UINT32_MAX / 2, "The ring positions are 32-bit");
+
+public:
+    MpscRing() { Reset(); }
+
+    MpscRing(const MpscRing &)             = delete;
+    MpscRing & operator=(const MpscRing &) = delete;
+
+    /**
+     * Drops all the items. Must not run concurrently with Push() or Pop().
+     */
+    void Reset()
+    {
+        for (uint32_t i = 0; i < N; i++)
+        {
+            mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+        mPushPosition.store(0, std::memory_order_relaxed);
+        mPopPosition.store(0, std::memory_order_release);
+    }
+
+    /**
+     * Copies an item at the end of the ring.
+     *
+     * @return false if the ring is full.
+     */
+    bool Push(const T & item)
+    {
+        uint32_t position = mPushPosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Slot & slot    = mSlots[position & (N - 1)];
+            int32_t offset = static_cast<int32_t>(slot.mSequence.load(std::memory_order_acquire) - position);
+
+            if (offset == 0)
+            {
+                // The slot is free for this position: claim it.
+                if (mPushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.mItem = item;
+                    slot.mSequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (offset < 0)
+            {
+                // The slot still holds the item pushed N positions earlier.
+                return false;
+            }
+            else
+            {
+                // Another producer claimed this position.
+                position = mPushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Moves the first item of the ring to `item`. Consumer only.
+     *
+     * @return false if the ring is empty, or if its first item is not published yet.
+     */
+    bool Pop(T & item)
+    {
+        uint32_t position = mPopPosition.load(std::memory_order_relaxed);
+        Slot & slot       = mSlots[position & (N - 1)];
+
+        if (slot.mSequence.load(std::memory_order_acquire) != position + 1)
+        {
+            return false;
+        }
+
+        item = slot.mItem;
+        slot.mSequence.store(position + N, std::memory_order_release);
+        mPopPosition.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Number of items claimed and not popped yet. Only a snapshot when producers or the consumer are running.
+     */
+    size_t Size() const
+    {
+        uint32_t popPosition  = mPopPosition.load(std::memory_order_acquire);
+        uint32_t pushPosition = mPushPosition.load(std::memory_order_relaxed);
+        uint32_t size         = pushPosition - popPosition;
+
+        // The positions are read one after the other: items popped and pushed in between can make the difference exceed N.
+        return (size <= N) ? size : N;
+    }
+
+    static constexpr size_t Capacity() { return N; }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint32_t> mSequence;
+        T mItem;
+    };
+
+    Slot mSlots[N];
+    std::atomic<uint32_t> mPushPosition;
+    std::atomic<uint32_t> mPopPosition;
+};
+
+} // namespace chip
@@ -0,0 +1,115 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/support/MpscRing.h>
+
+namespace {
+
+using namespace chip;
+
+struct Item
+{
+    uint32_t mProducer;
+    uint32_t mSequence;
+};
+
+TEST(TestMpscRing, TestPushPop)
+{
+    MpscRing<Item, 4> ring;
+    Item item;
+
+    EXPECT_EQ(ring.Size(), 0u);
+    EXPECT_FALSE(ring.Pop(item));
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(ring.Push(Item{ 0, i }));
+        EXPECT_EQ(ring.Size(), i + 1);
+    }
+    EXPECT_FALSE(ring.Push(Item{ 0, 4 }));
+    EXPECT_EQ(ring.Size(), 4u);
+
+    EXPECT_TRUE(ring.Pop(item));
+    EXPECT_EQ(item.mSequence, 0u);
+    EXPECT_TRUE(ring.Push(Item{ 0, 4 }));
+    EXPECT_FALSE(ring.Push(Item{ 0, 5 }));
+
+    for (uint32_t i = 1; i <= 4; i++)
+    {
+        EXPECT_TRUE(ring.Pop(item));
+        EXPECT_EQ(item.mSequence, i);
+    }
+    EXPECT_FALSE(ring.Pop(item));
+    EXPECT_EQ(ring.Size(), 0u);
+}
+
+TEST(TestMpscRing, TestWrapAround)
+{
+    MpscRing<Item, 8> ring;
+    Item item;
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+
+    // Goes around the ring many times, filling it with 0 to 8 items and trying one more.
+    for (uint32_t round = 0; round < 1000; round++)
+    {
+        uint32_t pushes = round % 10;
+
+        for (uint32_t i = 0; i < pushes; i++)
+        {
+            bool success = ring.Push(Item{ 0, pushed });
+
+            EXPECT_EQ(success, i < 8);
+            pushed += success ? 1 : 0;
+        }
+        EXPECT_EQ(ring.Size(), pushed - popped);
+
+        while (ring.Pop(item))
+        {
+            EXPECT_EQ(item.mSequence, popped);
+            popped++;
+        }
+        EXPECT_EQ(popped, pushed);
+    }
+}
+
+TEST(TestMpscRing, TestReset)
+{
+    MpscRing<Item, 4> ring;
+    Item item;
+
+    EXPECT_TRUE(ring.Push(Item{ 0, 0 }));
+    EXPECT_TRUE(ring.Push(Item{ 0, 1 }));
+    EXPECT_TRUE(ring.Pop(item));
+
+    ring.Reset();
+    EXPECT_EQ(ring.Size(), 0u);
+    EXPECT_FALSE(ring.Pop(item));
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(ring.Push(Item{ 0, i }));
+    }
+    EXPECT_FALSE(ring.Push(Item{ 0, 4 }));
+    EXPECT_TRUE(ring.Pop(item));
+    EXPECT_EQ(item.mSequence, 0u);
+}
+
+} // namespace
@@ -0,0 +1,98 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Multi-threaded unit tests for MpscRing, only built on hosts with std::thread.
+ *
+ */
+
+#include <thread>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/support/MpscRing.h>
+
+namespace {
+
+using namespace chip;
+
+struct Item
+{
+    uint32_t mProducer;
+    uint32_t mSequence;
+};
+
+TEST(TestMpscRingConcurrent, TestConcurrentProducers)
+{
+    constexpr uint32_t kProducers        = 4;
+    constexpr uint32_t kItemsPerProducer = 100000;
+
+    static MpscRing<Item, 16> ring;
+    std::vector<std::thread> producers;
+
+    ring.Reset();
+
+    for (uint32_t producer = 0; producer < kProducers; producer++)
+    {
+        producers.emplace_back([producer] {
+            for (uint32_t i = 0; i < kItemsPerProducer; i++)
+            {
+                // Retry when the consumer fell behind.
+                while (!ring.Push(Item{ producer, i }))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Every item is popped exactly once, in the order each producer pushed them.
+    uint32_t next[kProducers] = {};
+    uint32_t received         = 0;
+    Item item;
+
+    while (received < kProducers * kItemsPerProducer)
+    {
+        if (!ring.Pop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        EXPECT_LT(item.mProducer, kProducers);
+        if (item.mProducer < kProducers)
+        {
+            EXPECT_EQ(item.mSequence, next[item.mProducer]);
+            next[item.mProducer] = item.mSequence + 1;
+        }
+        received++;
+    }
+
+    for (auto & thread : producers)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(received, kProducers * kItemsPerProducer);
+    EXPECT_FALSE(ring.Pop(item));
+    EXPECT_EQ(ring.Size(), 0u);
+}
+
+} // namespace
@@ -41,7 +41,9 @@ using namespace chip::DeviceLayer;
 namespace chip {
 namespace Messaging {
 
-ReliableMessageContext::ReliableMessageContext() : mNextAckTime(0), mPendingPeerAckMessageCounter(0) {}
+ReliableMessageContext::ReliableMessageContext() :
+    mNextAckTime(0), mPendingPeerAckMessageCounter(0), mAckDeadlineIndex(ReliableMessageMgr::kInvalidDeadlineIndex)
+{}
 
 ExchangeContext * ReliableMessageContext::GetExchangeContext()
 {
@@ -170,6 +172,7 @@ CHIP_ERROR ReliableMessageContext::HandleNeedsAckInner(uint32_t messageCounter,
     SetPendingPeerAckMessageCounter(messageCounter);
     using namespace System::Clock::Literals;
     mNextAckTime = System::SystemClock().GetMonotonicTimestamp() + CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT;
+    GetReliableMessageMgr()->ScheduleStandaloneAck(this);
     return CHIP_NO_ERROR;
 }
 
@@ -208,6 +211,7 @@ void ReliableMessageContext::SetPendingPeerAckMessageCounter(uint32_t aPeerAckMe
     mPendingPeerAckMessageCounter = aPeerAckMessageCounter;
     SetAckPending(true);
     mFlags.Set(Flags::kFlagAckMessageCounterIsValid);
+    GetReliableMessageMgr()->ScheduleStandaloneAck(this);
 }
 
 } // namespace Messaging
@@ -216,6 +216,7 @@ private:
 
     System::Clock::Timestamp mNextAckTime; // Next time for triggering Solo Ack
     uint32_t mPendingPeerAckMessageCounter;
+    uint16_t mAckDeadlineIndex; // Position of the Solo Ack in the ReliableMessageMgr deadline queue
 };
 
 inline bool ReliableMessageContext::AutoRequestAck() const
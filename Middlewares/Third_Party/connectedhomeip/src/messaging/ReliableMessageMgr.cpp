@@ -51,7 +51,7 @@ namespace Messaging {
 System::Clock::Timeout ReliableMessageMgr::sAdditionalMRPBackoffTime = CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST;
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
-    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
+    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0), deadlineIndex(kInvalidDeadlineIndex)
 {
     ec->SetWaitingForAck(true);
 }
@@ -76,6 +76,20 @@ void ReliableMessageMgr::Shutdown()
 {
     StopTimer();
 
+    // Clear the deadline queue
+    for (size_t i = 0; i < mDeadlineCount; i++)
+    {
+        if (mDeadlines[i].context != nullptr)
+        {
+            mDeadlines[i].context->mAckDeadlineIndex = kInvalidDeadlineIndex;
+        }
+        else
+        {
+            mDeadlines[i].entry->deadlineIndex = kInvalidDeadlineIndex;
+        }
+    }
+    mDeadlineCount = 0;
+
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         mRetransTable.ReleaseObject(entry);
@@ -109,86 +123,121 @@ void ReliableMessageMgr::ExecuteActions()
     ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions at 0x" ChipLogFormatX64 "ms", ChipLogValueX64(now.count()));
 #endif
 
-    ExecuteForAllContext([&](ReliableMessageContext * rc) {
-        if (rc->IsAckPending())
+    // Only the deadlines that are due are touched.  Each one is popped before it is executed, so that
+    // executing it may freely schedule or cancel other deadlines.
+    while (mDeadlineCount > 0 && mDeadlines[0].time <= now)
+    {
+        Deadline deadline = mDeadlines[0];
+        RemoveDeadline(0);
+#if CHIP_CONFIG_TEST
+        mTestDeadlinesExecuted++;
+#endif // CHIP_CONFIG_TEST
+
+        if (deadline.context != nullptr)
         {
-            if (rc->mNextAckTime <= now)
-            {
+            ExecuteStandaloneAck(deadline.context, now);
+        }
+        else
+        {
+            ExecuteRetransmission(deadline.entry, now);
+        }
+    }
+
+    TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
+}
+
+void ReliableMessageMgr::ExecuteStandaloneAck(ReliableMessageContext * rc, System::Clock::Timestamp now)
+{
+    // The ack may have been piggybacked since it was scheduled.
+    VerifyOrReturn(rc->IsAckPending());
+
+    if (rc->mNextAckTime > now)
+    {
+        ScheduleStandaloneAck(rc);
+        return;
+    }
+
+    // Make sure our exchange stays alive until we are done working with it.
+    ExchangeHandle ec(*rc->GetExchangeContext());
+
 #if defined(RMP_TICKLESS_DEBUG)
-                ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK %p", rc);
+    ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK %p", rc);
 #endif
-                rc->SendStandaloneAckMessage();
-            }
-        }
-    });
+    rc->SendStandaloneAckMessage();
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime > now)
-            return Loop::Continue;
+    // If the ack could not be sent, try again on the next tick.  Retrying at `now` would keep this
+    // loop from ever terminating.
+    if (rc->IsAckPending() && rc->mAckDeadlineIndex == kInvalidDeadlineIndex)
+    {
+        ScheduleDeadline(Deadline{ now + 1_ms, nullptr, rc }, rc->mAckDeadlineIndex);
+    }
+}
+
+void ReliableMessageMgr::ExecuteRetransmission(RetransTableEntry * entry, System::Clock::Timestamp now)
+{
+    if (entry->nextRetransTime > now)
+    {
+        ScheduleDeadline(Deadline{ entry->nextRetransTime, entry, nullptr }, entry->deadlineIndex);
+        return;
+    }
 
-        VerifyOrDie(!entry->retainedBuf.IsNull());
+    VerifyOrDie(!entry->retainedBuf.IsNull());
 
-        // Don't check whether the session in the exchange is valid, because when the session is released, the retrans entry is
-        // cleared inside ExchangeContext::OnSessionReleased, so the session must be valid if the entry exists.
-        auto session      = entry->ec->GetSessionHandle();
-        uint8_t sendCount = entry->sendCount;
+    // Don't check whether the session in the exchange is valid, because when the session is released, the retrans entry is
+    // cleared inside ExchangeContext::OnSessionReleased, so the session must be valid if the entry exists.
+    auto session      = entry->ec->GetSessionHandle();
+    uint8_t sendCount = entry->sendCount;
 #if CHIP_ERROR_LOGGING || CHIP_PROGRESS_LOGGING
-        uint32_t messageCounter = entry->retainedBuf.GetMessageCounter();
-        auto fabricIndex        = session->GetFabricIndex();
-        auto destination        = kUndefinedNodeId;
-        if (session->IsSecureSession())
-        {
-            destination = session->AsSecureSession()->GetPeerNodeId();
-        }
+    uint32_t messageCounter = entry->retainedBuf.GetMessageCounter();
+    auto fabricIndex        = session->GetFabricIndex();
+    auto destination        = kUndefinedNodeId;
+    if (session->IsSecureSession())
+    {
+        destination = session->AsSecureSession()->GetPeerNodeId();
+    }
 #endif // CHIP_ERROR_LOGGING || CHIP_DETAIL_LOGGING
 
-        if (sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
+    if (sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
+    {
+        // Make sure our exchange stays alive until we are done working with it.
+        ExchangeHandle ec(entry->ec);
+
+        ChipLogError(ExchangeManager,
+                     "<<%d [E:" ChipLogFormatExchange " S:%u M:" ChipLogFormatMessageCounter
+                     "] (%s) Msg Retransmission to %u:" ChipLogFormatX64 " failure (max retries:%d)",
+                     sendCount + 1, ChipLogValueExchange(&entry->ec.Get()), session->SessionIdForLogging(), messageCounter,
+                     Transport::GetSessionTypeString(session), fabricIndex, ChipLogValueX64(destination),
+                     CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS);
+
+        // If the exchange is expecting a response, it will handle sending
+        // this notification once it detects that it has not gotten a
+        // response.  Otherwise, we need to do it.
+        if (!ec->IsResponseExpected())
         {
-            // Make sure our exchange stays alive until we are done working with it.
-            ExchangeHandle ec(entry->ec);
-
-            ChipLogError(ExchangeManager,
-                         "<<%d [E:" ChipLogFormatExchange " S:%u M:" ChipLogFormatMessageCounter
-                         "] (%s) Msg Retransmission to %u:" ChipLogFormatX64 " failure (max retries:%d)",
-                         sendCount + 1, ChipLogValueExchange(&entry->ec.Get()), session->SessionIdForLogging(), messageCounter,
-                         Transport::GetSessionTypeString(session), fabricIndex, ChipLogValueX64(destination),
-                         CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS);
-
-            // If the exchange is expecting a response, it will handle sending
-            // this notification once it detects that it has not gotten a
-            // response.  Otherwise, we need to do it.
-            if (!ec->IsResponseExpected())
+            if (session->IsSecureSession() && session->AsSecureSession()->IsCASESession())
             {
-                if (session->IsSecureSession() && session->AsSecureSession()->IsCASESession())
-                {
-                    session->AsSecureSession()->MarkAsDefunct();
-                }
-                session->NotifySessionHang();
+                session->AsSecureSession()->MarkAsDefunct();
             }
-
-            // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
-
-            return Loop::Continue;
+            session->NotifySessionHang();
         }
 
-        entry->sendCount++;
-
-        ChipLogProgress(ExchangeManager,
-                        "<<%d [E:" ChipLogFormatExchange " S:%u M:" ChipLogFormatMessageCounter
-                        "] (%s) Msg Retransmission to %u:" ChipLogFormatX64,
-                        entry->sendCount, ChipLogValueExchange(&entry->ec.Get()), session->SessionIdForLogging(), messageCounter,
-                        Transport::GetSessionTypeString(session), fabricIndex, ChipLogValueX64(destination));
-        MATTER_LOG_METRIC(Tracing::kMetricDeviceRMPRetryCount, entry->sendCount);
+        // Do not StartTimer, we will schedule the timer at the end of the timer handler.
+        // The entry has already been popped from the deadline queue.
+        mRetransTable.ReleaseObject(entry);
+        return;
+    }
 
-        CalculateNextRetransTime(*entry);
-        SendFromRetransTable(entry);
+    entry->sendCount++;
 
-        return Loop::Continue;
-    });
+    ChipLogProgress(ExchangeManager,
+                    "<<%d [E:" ChipLogFormatExchange " S:%u M:" ChipLogFormatMessageCounter
+                    "] (%s) Msg Retransmission to %u:" ChipLogFormatX64,
+                    entry->sendCount, ChipLogValueExchange(&entry->ec.Get()), session->SessionIdForLogging(), messageCounter,
+                    Transport::GetSessionTypeString(session), fabricIndex, ChipLogValueX64(destination));
+    MATTER_LOG_METRIC(Tracing::kMetricDeviceRMPRetryCount, entry->sendCount);
 
-    TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
+    CalculateNextRetransTime(*entry);
+    SendFromRetransTable(entry);
 }
 
 void ReliableMessageMgr::Timeout(System::Layer * aSystemLayer, void * aAppState)
@@ -379,6 +428,10 @@ void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
+    if (entry.deadlineIndex != kInvalidDeadlineIndex)
+    {
+        RemoveDeadline(entry.deadlineIndex);
+    }
     mRetransTable.ReleaseObject(&entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
@@ -386,24 +439,14 @@ void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 
 void ReliableMessageMgr::StartTimer()
 {
-    // When do we need to next wake up to send an ACK?
-    System::Clock::Timestamp nextWakeTime = System::Clock::Timestamp::max();
-
-    ExecuteForAllContext([&](ReliableMessageContext * rc) {
-        if (rc->IsAckPending() && rc->mNextAckTime < nextWakeTime)
-        {
-            nextWakeTime = rc->mNextAckTime;
-        }
-    });
+    // Drop acks that have been piggybacked since they were scheduled, so they don't cause a spurious wakeup.
+    while (mDeadlineCount > 0 && mDeadlines[0].context != nullptr && !mDeadlines[0].context->IsAckPending())
+    {
+        RemoveDeadline(0);
+    }
 
-    // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    // When do we need to next wake up to send an ACK or a retransmission?
+    System::Clock::Timestamp nextWakeTime = (mDeadlineCount > 0) ? mDeadlines[0].time : System::Clock::Timestamp::max();
 
     StopTimer();
 
@@ -493,6 +536,7 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 
     System::Clock::Timeout backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime          = System::SystemClock().GetMonotonicTimestamp() + backoff;
+    ScheduleDeadline(Deadline{ entry.nextRetransTime, &entry, nullptr }, entry.deadlineIndex);
 
 #if CHIP_PROGRESS_LOGGING
     const auto config       = sessionHandle->GetRemoteMRPConfig();
@@ -522,6 +566,95 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 #endif // CHIP_PROGRESS_LOGGING
 }
 
+void ReliableMessageMgr::ScheduleStandaloneAck(ReliableMessageContext * rc)
+{
+    ScheduleDeadline(Deadline{ rc->mNextAckTime, nullptr, rc }, rc->mAckDeadlineIndex);
+}
+
+void ReliableMessageMgr::CancelStandaloneAck(ReliableMessageContext * rc)
+{
+    if (rc->mAckDeadlineIndex != kInvalidDeadlineIndex)
+    {
+        RemoveDeadline(rc->mAckDeadlineIndex);
+    }
+}
+
+void ReliableMessageMgr::ScheduleDeadline(const Deadline & deadline, uint16_t & index)
+{
+    if (index == kInvalidDeadlineIndex)
+    {
+        VerifyOrDie(mDeadlineCount < kMaxDeadlines);
+        index = static_cast<uint16_t>(mDeadlineCount++);
+    }
+    PlaceDeadline(index, deadline);
+    SiftDeadline(index);
+}
+
+void ReliableMessageMgr::RemoveDeadline(uint16_t index)
+{
+    VerifyOrDie(index < mDeadlineCount);
+
+    Deadline & removed = mDeadlines[index];
+    if (removed.context != nullptr)
+    {
+        removed.context->mAckDeadlineIndex = kInvalidDeadlineIndex;
+    }
+    else
+    {
+        removed.entry->deadlineIndex = kInvalidDeadlineIndex;
+    }
+
+    mDeadlineCount--;
+    if (index < mDeadlineCount)
+    {
+        PlaceDeadline(index, mDeadlines[mDeadlineCount]);
+        SiftDeadline(index);
+    }
+}
+
+void ReliableMessageMgr::PlaceDeadline(size_t index, const Deadline & deadline)
+{
+    mDeadlines[index] = deadline;
+    if (deadline.context != nullptr)
+    {
+        deadline.context->mAckDeadlineIndex = static_cast<uint16_t>(index);
+    }
+    else
+    {
+        deadline.entry->deadlineIndex = static_cast<uint16_t>(index);
+    }
+}
+
+void ReliableMessageMgr::SiftDeadline(size_t index)
+{
+    Deadline deadline = mDeadlines[index];
+
+    // Move up while earlier than the parent...
+    while (index > 0 && deadline.time < mDeadlines[(index - 1) / 2].time)
+    {
+        size_t parent = (index - 1) / 2;
+        PlaceDeadline(index, mDeadlines[parent]);
+        index = parent;
+    }
+
+    // ... otherwise move down while later than the earliest child.
+    for (size_t child = 2 * index + 1; child < mDeadlineCount; child = 2 * index + 1)
+    {
+        if (child + 1 < mDeadlineCount && mDeadlines[child + 1].time < mDeadlines[child].time)
+        {
+            child++;
+        }
+        if (!(mDeadlines[child].time < deadline.time))
+        {
+            break;
+        }
+        PlaceDeadline(index, mDeadlines[child]);
+        index = child;
+    }
+
+    PlaceDeadline(index, deadline);
+}
+
 #if CHIP_CONFIG_TEST
 int ReliableMessageMgr::TestGetCountRetransTable()
 {
@@ -66,8 +66,12 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+        uint16_t deadlineIndex;                   /**< Position of the entry in the deadline queue, if scheduled. */
     };
 
+    /// Deadline queue position of entries and contexts that are not scheduled.
+    static constexpr uint16_t kInvalidDeadlineIndex = UINT16_MAX;
+
     ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
     ~ReliableMessageMgr();
 
@@ -75,9 +79,8 @@ public:
     void Shutdown();
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.  If an
-     * action needs to be triggered by ReliableMessageProtocol time facilities,
-     * execute that action.
+     * Pop the pending standalone acks and retransmissions that are due from the
+     * deadline queue and execute them.  Entries that are not due are not touched.
      */
     void ExecuteActions();
 
@@ -161,14 +164,31 @@ public:
     void ClearRetransTable(RetransTableEntry & rEntry);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
-     * Determine how many ReliableMessageProtocol ticks we need to sleep before we
-     * need to physically wake the CPU to perform an action.  Set a timer to go off
-     * when we next need to wake the system.
+     * Determine from the earliest deadline in the deadline queue how many
+     * ReliableMessageProtocol ticks we need to sleep before we need to physically
+     * wake the CPU to perform an action.  Set a timer to go off when we next need
+     * to wake the system.
      *
      */
     void StartTimer();
 
+    /**
+     * Schedule (or move) the standalone ack of the given context at its next ack time.
+     * Must be called whenever the context sets an ack pending or changes its next ack time.
+     * Acks that get piggybacked in the meantime are dropped from the queue lazily.
+     *
+     * @param[in] rc    A pointer to the ReliableMessageContext object.
+     */
+    void ScheduleStandaloneAck(ReliableMessageContext * rc);
+
+    /**
+     * Remove the standalone ack of the given context from the deadline queue, if any.
+     * Must be called before the context is destroyed.
+     *
+     * @param[in] rc    A pointer to the ReliableMessageContext object.
+     */
+    void CancelStandaloneAck(ReliableMessageContext * rc);
+
     /**
      * Stop the timer for retransmistion on current node.
      *
@@ -195,6 +215,10 @@ public:
 #if CHIP_CONFIG_TEST
     // Functions for testing
     int TestGetCountRetransTable();
+    size_t TestGetCountDeadlines() const { return mDeadlineCount; }
+    // Number of deadlines ExecuteActions() has popped since the last reset.
+    size_t TestGetCountDeadlinesExecuted() const { return mTestDeadlinesExecuted; }
+    void TestResetCountDeadlinesExecuted() { mTestDeadlinesExecuted = 0; }
 
     // Enumerate the retransmission table.  Clearing an entry while enumerating
     // that entry is allowed.  F must take a RetransTableEntry as an argument
@@ -230,6 +254,29 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
+    /**
+     * A pending action in the deadline queue: either the standalone ack of `context`
+     * or the retransmission of `entry` (exactly one of them is set).
+     */
+    struct Deadline
+    {
+        System::Clock::Timestamp time;
+        RetransTableEntry * entry;
+        ReliableMessageContext * context;
+    };
+
+    // Every context has at most one pending ack and every retrans table entry at most one pending
+    // retransmission, so the queue can never overflow.
+    static constexpr size_t kMaxDeadlines = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS + CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE;
+    static_assert(kMaxDeadlines < kInvalidDeadlineIndex, "Deadline queue positions are 16-bit");
+
+    void ScheduleDeadline(const Deadline & deadline, uint16_t & index);
+    void RemoveDeadline(uint16_t index);
+    void PlaceDeadline(size_t index, const Deadline & deadline);
+    void SiftDeadline(size_t index);
+    void ExecuteStandaloneAck(ReliableMessageContext * rc, System::Clock::Timestamp now);
+    void ExecuteRetransmission(RetransTableEntry * entry, System::Clock::Timestamp now);
+
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
 
@@ -248,6 +295,14 @@ private:
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+    // Binary min-heap on Deadline::time of every scheduled ack and retransmission.  Scheduled objects
+    // keep their position in the heap so that they can be moved or removed without a search.
+    Deadline mDeadlines[kMaxDeadlines];
+    size_t mDeadlineCount = 0;
+#if CHIP_CONFIG_TEST
+    size_t mTestDeadlinesExecuted = 0;
+#endif // CHIP_CONFIG_TEST
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 
     static System::Clock::Timeout sAdditionalMRPBackoffTime;
@@ -21,6 +21,7 @@
  *      This file implements unit tests for the ReliableMessageProtocol
  *      implementation.
  */
+#include <algorithm>
 #include <errno.h>
 
 #include <pw_unit_test/framework.h>
@@ -363,6 +364,58 @@ TEST_F(TestReliableMessageProtocol, CheckAddClearRetrans)
     exchange->Close();
 }
 
+/**
+ * Checks that MRP timer ticks (ExecuteActions + StartTimer) with 1, half and all of the exchanges having a
+ * retransmission scheduled, none of them due yet, execute no deadline, leave every entry unsent and scheduled,
+ * and that clearing the entries empties both the retransmission table and the deadline queue.
+ */
+TEST_F(TestReliableMessageProtocol, CheckTickSkipsPendingRetransmissions)
+{
+    constexpr size_t kMaxExchanges     = std::min<size_t>(CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE);
+    constexpr size_t kExchangeCounts[] = { 1, kMaxExchanges / 2, kMaxExchanges };
+    constexpr unsigned kTicks          = 100;
+
+    MockAppDelegate mockAppDelegate(*this);
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    for (size_t exchangeCount : kExchangeCounts)
+    {
+        ExchangeContext * exchanges[kMaxExchanges];
+        ReliableMessageMgr::RetransTableEntry * entries[kMaxExchanges];
+
+        for (size_t i = 0; i < exchangeCount; i++)
+        {
+            exchanges[i] = NewExchangeToAlice(&mockAppDelegate);
+            ASSERT_NE(exchanges[i], nullptr);
+            ASSERT_EQ(rm->AddToRetransTable(exchanges[i]->GetReliableMessageContext(), &entries[i]), CHIP_NO_ERROR);
+            rm->StartRetransmision(entries[i]);
+        }
+        EXPECT_EQ(rm->TestGetCountDeadlines(), exchangeCount);
+
+        // None of the retransmissions is due for at least one backoff interval: a tick must not visit any of them,
+        // however many are pending.
+        rm->TestResetCountDeadlinesExecuted();
+        for (unsigned tick = 0; tick < kTicks; tick++)
+        {
+            rm->ExecuteActions();
+            rm->StartTimer();
+        }
+        EXPECT_EQ(rm->TestGetCountDeadlinesExecuted(), 0u);
+
+        EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(exchangeCount));
+        EXPECT_EQ(rm->TestGetCountDeadlines(), exchangeCount);
+        for (size_t i = 0; i < exchangeCount; i++)
+        {
+            EXPECT_EQ(entries[i]->sendCount, 0);
+            rm->ClearRetransTable(*entries[i]);
+            exchanges[i]->Close();
+        }
+        EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+        EXPECT_EQ(rm->TestGetCountDeadlines(), 0u);
+    }
+}
+
 /**
  * Tests MRP retransmission logic with the following scenario:
  *
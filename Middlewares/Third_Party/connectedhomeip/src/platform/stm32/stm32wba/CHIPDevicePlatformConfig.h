@@ -55,7 +55,36 @@
 // These are configuration options that are unique to the platform.
 // These can be overridden by the application as needed.
 
-// ...
+/**
+ * CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES
+ *
+ * Number of entries of the RAM cache in front of the NVM key/value store (see STM32KeyValueCache.h).
+ * Set to 0 to disable the cache and read every value from the NVM.
+ */
+#ifndef CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES
+#define CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES 8
+#endif
+
+/**
+ * CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_MAX_VALUE_SIZE
+ *
+ * Largest value, in bytes, kept by the key/value store cache. Larger values are always read from the NVM.
+ */
+#ifndef CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_MAX_VALUE_SIZE
+#define CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_MAX_VALUE_SIZE 64
+#endif
+
+/**
+ * CHIP_DEVICE_CONFIG_STM32_THREAD_MESSAGE_POOL_PACKETBUFFERS
+ *
+ * Maximum number of PacketBuffers lent to OpenThread to hold its message buffers (see ThreadStackManagerImpl.cpp), so
+ * that the Matter and the Thread stacks share the PacketBuffer memory instead of each keeping its own pool.
+ * Requires the OpenThread library to be built with OPENTHREAD_CONFIG_PLATFORM_MESSAGE_MANAGEMENT enabled.
+ * Set to 0 for OpenThread to use its own message buffer pool.
+ */
+#ifndef CHIP_DEVICE_CONFIG_STM32_THREAD_MESSAGE_POOL_PACKETBUFFERS
+#define CHIP_DEVICE_CONFIG_STM32_THREAD_MESSAGE_POOL_PACKETBUFFERS 0
+#endif
 
 // ========== Platform-specific Configuration Overrides =========
 
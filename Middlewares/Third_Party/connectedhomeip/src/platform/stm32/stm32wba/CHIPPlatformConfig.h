@@ -66,6 +66,23 @@
 #ifndef CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT
 #define CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT 6
 #endif // CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT
+
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE 16
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+
+#ifndef CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE
+#define CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE 2
+#endif // CHIP_CONFIG_VERIFIED_CERT_CHAIN_CACHE_SIZE
+
+#ifndef CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE
+#define CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE 2
+#endif // CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE
+
+#ifndef CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+#define CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE 1
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_FREERTOS_USE_STATIC_QUEUE
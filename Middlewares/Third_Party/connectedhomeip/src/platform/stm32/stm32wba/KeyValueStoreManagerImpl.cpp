@@ -19,13 +19,22 @@
 #include <platform/KeyValueStoreManager.h>
 #include <lib/support/CodeUtils.h>
 #include "flash_wb.h"
+#include "STM32KeyValueCache.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
 namespace chip {
 namespace DeviceLayer {
+namespace Internal {
+/** Singleton instance of the NVM value cache, shared with STM32Config.
+ */
+STM32KeyValueCache STM32KeyValueCache::sInstance;
+} // namespace Internal
+
 namespace PersistedStorage {
+using Internal::STM32KeyValueCache;
+
 /** Singleton instance of the KeyValueStoreManager implementation object.
  */
 KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
@@ -36,8 +45,8 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char *key, void *value,
 
 	if ((key != NULL) && (value != NULL)) {
 		return this->_PrintError(
-				NM_GetKeyValue(value, key, (uint32_t) value_size,
-						read_bytes_size,SECTOR_SECURE));
+				STM32KeyValueCache::Instance().GetKeyValue(value, key,
+						value_size, read_bytes_size, SECTOR_SECURE));
 	} else {
 		err = CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
 	}
@@ -48,7 +57,8 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char *key) {
 
 	ChipLogDetail( DataManagement, "DELETE=> %s",key);
 	if (key != NULL) {
-		return this->_PrintError(NM_DeleteKey(key,SECTOR_SECURE));
+		return this->_PrintError(
+				STM32KeyValueCache::Instance().DeleteKey(key, SECTOR_SECURE));
 
 	}
 	return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
@@ -60,8 +70,8 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char *key, const void *value,
 	if ((value_size != 0) && (key != NULL) && (value != NULL)) {
 
 		return this->_PrintError(
-				NM_SetKeyValue((char*) value, (char*) key,
-						(uint32_t) value_size,SECTOR_SECURE));
+				STM32KeyValueCache::Instance().SetKeyValue(value, key,
+						value_size, SECTOR_SECURE));
 
 	}
 
@@ -18,6 +18,7 @@
 
 #include <platform/internal/CHIPDeviceLayerInternal.h>
 #include <platform/stm32/stm32wba/STM32Config.h>
+#include <platform/stm32/stm32wba/STM32KeyValueCache.h>
 #include "flash_wb.h"
 
 namespace chip {
@@ -35,7 +36,7 @@ CHIP_ERROR STM32Config::ReadConfigValueBin(Key key, uint8_t *buf, size_t bufSize
 
     sprintf((char*) buffer_key, "Config%li", key);
     return PrintError(
-            NM_GetKeyValue(buf, (char*) buffer_key, bufSize,
+            STM32KeyValueCache::Instance().GetKeyValue(buf, (char*) buffer_key, bufSize,
                     &outLen, SECTOR_SECURE));
 }
 
@@ -45,7 +46,7 @@ CHIP_ERROR STM32Config::ReadConfigValue(Key key, bool &val) {
 
     sprintf((char*) buffer_key, "Config%li", key);
     return PrintError(
-            NM_GetKeyValue(reinterpret_cast<uint8_t*>(&val), (char*) buffer_key, sizeof(bool),
+            STM32KeyValueCache::Instance().GetKeyValue(reinterpret_cast<uint8_t*>(&val), (char*) buffer_key, sizeof(bool),
                     &Out_Length, SECTOR_SECURE));
 }
 
@@ -55,7 +56,7 @@ CHIP_ERROR STM32Config::ReadConfigValue(Key key, uint32_t &val) {
 
     sprintf((char*) buffer_key, "Config%li", key);
     return PrintError(
-            NM_GetKeyValue(reinterpret_cast<uint8_t*>(&val), (char*) buffer_key, sizeof(uint32_t),
+            STM32KeyValueCache::Instance().GetKeyValue(reinterpret_cast<uint8_t*>(&val), (char*) buffer_key, sizeof(uint32_t),
                     &Out_Length, SECTOR_SECURE));
 }
 
@@ -65,7 +66,7 @@ CHIP_ERROR STM32Config::ReadConfigValue(Key key, uint64_t &val) {
 
     sprintf((char*) buffer_key, "Config%li", key);
     return PrintError(
-            NM_GetKeyValue(reinterpret_cast<uint8_t*>(&val), (char*) buffer_key, sizeof(uint64_t),
+            STM32KeyValueCache::Instance().GetKeyValue(reinterpret_cast<uint8_t*>(&val), (char*) buffer_key, sizeof(uint64_t),
                     &Out_Length, SECTOR_SECURE));
 }
 
@@ -82,7 +83,7 @@ CHIP_ERROR STM32Config::WriteConfigValue(Key key, uint32_t val) {
     buffer_convert[2] = val >> 16;
     buffer_convert[3] = val >> 24;
     sprintf((char*) buffer_key, "Config%li", key);
-    return PrintError(NM_SetKeyValue((char*)buffer_convert, (char*) buffer_key, sizeof(uint32_t), SECTOR_SECURE));
+    return PrintError(STM32KeyValueCache::Instance().SetKeyValue(buffer_convert, (char*) buffer_key, sizeof(uint32_t), SECTOR_SECURE));
 }
 
 CHIP_ERROR STM32Config::WriteConfigValueStr(Key key, const char *str) {
@@ -97,7 +98,7 @@ CHIP_ERROR STM32Config::WriteConfigValueBin(Key key, const uint8_t *data, size_t
     uint8_t buffer_key[35] = { 0 };
 
     sprintf((char*) buffer_key, "Config%li", key);
-    return PrintError(NM_SetKeyValue((char*) data, (char*) buffer_key, dataLen, SECTOR_SECURE));
+    return PrintError(STM32KeyValueCache::Instance().SetKeyValue(data, (char*) buffer_key, dataLen, SECTOR_SECURE));
 
 
 }
@@ -107,7 +108,7 @@ bool STM32Config::ConfigValueExists(Key key) {
     uint8_t buffer_key[35] = { 0 };
 
     sprintf((char*) buffer_key, "Config%li", key);
-    err = NM_GetKeyExists((char*) buffer_key,SECTOR_SECURE);
+    err = STM32KeyValueCache::Instance().GetKeyExists((char*) buffer_key, SECTOR_SECURE);
     if(err == NVM_OK){
         return true;
     }
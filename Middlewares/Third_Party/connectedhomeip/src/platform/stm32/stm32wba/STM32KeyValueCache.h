@@ -0,0 +1,308 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <platform/CHIPDeviceConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "flash_wb.h"
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * @brief Read-through value cache in front of the NVM key/value API (flash_wb).
+ *
+ * Both KeyValueStoreManagerImpl and STM32Config go through this cache, so that hot keys (fabric table, group
+ * data, session resumption records, counters...) are served from RAM instead of the NVM index and record copy.
+ * Entries hold the value of small records or the fact that a key does not exist, and are replaced in least
+ * recently used order. Every write and delete goes to the NVM first and only updates the cache once the NVM
+ * operation succeeded, so the cache never holds a value the NVM does not.
+ *
+ * All keys of the secure sector must be accessed through the cache, otherwise it may serve stale values. The
+ * cache is not thread safe; callers hold the CHIP stack lock like for the rest of the persistent storage.
+ *
+ * With CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES set to 0 every call goes straight to the NVM API.
+ */
+class STM32KeyValueCache
+{
+public:
+    NVM_StatusTypeDef GetKeyValue(void * value, const char * key, size_t valueSize, size_t * readBytes, NVM_Sector sector)
+    {
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+        if ((value == nullptr) || (key == nullptr))
+        {
+            return NVM_PARAM_ERROR;
+        }
+
+        Entry * entry = Find(key, sector);
+        if (entry != nullptr)
+        {
+            mHitCount++;
+            entry->lastUse = ++mUseCounter;
+            if (!entry->present)
+            {
+                return NVM_KEY_NOT_FOUND;
+            }
+            if (valueSize < entry->valueLength)
+            {
+                return NVM_BUFFER_TOO_SMALL;
+            }
+            memcpy(value, entry->value, entry->valueLength);
+            if (readBytes != nullptr)
+            {
+                *readBytes = entry->valueLength;
+            }
+            return NVM_OK;
+        }
+
+        mMissCount++;
+        size_t readLength        = 0;
+        NVM_StatusTypeDef status = NM_GetKeyValue(value, key, static_cast<uint32_t>(valueSize), &readLength, sector);
+        if (status == NVM_OK)
+        {
+            Store(key, sector, value, readLength);
+            if (readBytes != nullptr)
+            {
+                *readBytes = readLength;
+            }
+        }
+        else if (status == NVM_KEY_NOT_FOUND)
+        {
+            StoreNotFound(key, sector);
+        }
+        return status;
+#else
+        return NM_GetKeyValue(value, key, static_cast<uint32_t>(valueSize), readBytes, sector);
+#endif
+    }
+
+    NVM_StatusTypeDef GetKeyExists(const char * key, NVM_Sector sector)
+    {
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+        Entry * entry = (key != nullptr) ? Find(key, sector) : nullptr;
+        if (entry != nullptr)
+        {
+            mHitCount++;
+            entry->lastUse = ++mUseCounter;
+            return entry->present ? NVM_OK : NVM_KEY_NOT_FOUND;
+        }
+
+        // Only a positive answer is cheap to get without the value, so only a negative one is cached here.
+        mMissCount++;
+        NVM_StatusTypeDef status = NM_GetKeyExists(key, sector);
+        if (status == NVM_KEY_NOT_FOUND)
+        {
+            StoreNotFound(key, sector);
+        }
+        return status;
+#else
+        return NM_GetKeyExists(key, sector);
+#endif
+    }
+
+    NVM_StatusTypeDef SetKeyValue(const void * value, const char * key, size_t valueSize, NVM_Sector sector)
+    {
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+        if ((value != nullptr) && (key != nullptr))
+        {
+            Invalidate(key, sector);
+        }
+#endif
+        NVM_StatusTypeDef status = NM_SetKeyValue(const_cast<char *>(static_cast<const char *>(value)), const_cast<char *>(key),
+                                                  static_cast<uint32_t>(valueSize), sector);
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+        if (status == NVM_OK)
+        {
+            Store(key, sector, value, valueSize);
+        }
+#endif
+        return status;
+    }
+
+    NVM_StatusTypeDef DeleteKey(const char * key, NVM_Sector sector)
+    {
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+        if (key != nullptr)
+        {
+            Invalidate(key, sector);
+        }
+#endif
+        NVM_StatusTypeDef status = NM_DeleteKey(key, sector);
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+        if ((status == NVM_OK) || (status == NVM_KEY_NOT_FOUND))
+        {
+            StoreNotFound(key, sector);
+        }
+#endif
+        return status;
+    }
+
+    /**
+     * @brief Drop all entries, e.g. after the NVM has been erased behind the back of the cache.
+     */
+    void Clear()
+    {
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+        for (auto & entry : mEntries)
+        {
+            entry.keyLength = 0;
+        }
+#endif
+    }
+
+    uint32_t GetHitCount() const { return mHitCount; }
+    uint32_t GetMissCount() const { return mMissCount; }
+
+    static STM32KeyValueCache & Instance() { return sInstance; }
+
+private:
+#if CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+    // Longest key name the NVM accepts, longer keys are never found and are not cached.
+    static constexpr size_t kMaxKeyLength = 32;
+
+    struct Entry
+    {
+        uint32_t hash;
+        uint32_t lastUse;
+        uint16_t valueLength;
+        uint8_t keyLength; // 0 for an unused entry
+        uint8_t sector;
+        bool present;
+        char key[kMaxKeyLength];
+        uint8_t value[CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_MAX_VALUE_SIZE];
+    };
+
+    static uint32_t Hash(const char * key, size_t length)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; i++)
+        {
+            hash = (hash ^ static_cast<uint8_t>(key[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    Entry * Find(const char * key, NVM_Sector sector)
+    {
+        size_t length = strlen(key);
+        if ((length == 0) || (length > kMaxKeyLength))
+        {
+            return nullptr;
+        }
+
+        uint32_t hash = Hash(key, length);
+        for (auto & entry : mEntries)
+        {
+            if ((entry.keyLength == length) && (entry.hash == hash) && (entry.sector == static_cast<uint8_t>(sector)) &&
+                (memcmp(entry.key, key, length) == 0))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void Invalidate(const char * key, NVM_Sector sector)
+    {
+        Entry * entry = Find(key, sector);
+        if (entry != nullptr)
+        {
+            entry->keyLength = 0;
+        }
+    }
+
+    Entry * Allocate(const char * key, NVM_Sector sector)
+    {
+        size_t length = strlen(key);
+        if ((length == 0) || (length > kMaxKeyLength))
+        {
+            return nullptr;
+        }
+
+        Entry * entry = Find(key, sector);
+        if (entry == nullptr)
+        {
+            entry = &mEntries[0];
+            for (auto & candidate : mEntries)
+            {
+                if (candidate.keyLength == 0)
+                {
+                    entry = &candidate;
+                    break;
+                }
+                if (candidate.lastUse < entry->lastUse)
+                {
+                    entry = &candidate;
+                }
+            }
+        }
+
+        entry->hash      = Hash(key, length);
+        entry->lastUse   = ++mUseCounter;
+        entry->keyLength = static_cast<uint8_t>(length);
+        entry->sector    = static_cast<uint8_t>(sector);
+        memcpy(entry->key, key, length);
+        return entry;
+    }
+
+    void Store(const char * key, NVM_Sector sector, const void * value, size_t valueLength)
+    {
+        if (valueLength > CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_MAX_VALUE_SIZE)
+        {
+            return;
+        }
+
+        Entry * entry = Allocate(key, sector);
+        if (entry != nullptr)
+        {
+            entry->present     = true;
+            entry->valueLength = static_cast<uint16_t>(valueLength);
+            memcpy(entry->value, value, valueLength);
+        }
+    }
+
+    void StoreNotFound(const char * key, NVM_Sector sector)
+    {
+        Entry * entry = Allocate(key, sector);
+        if (entry != nullptr)
+        {
+            entry->present     = false;
+            entry->valueLength = 0;
+        }
+    }
+
+    Entry mEntries[CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES] = {};
+    uint32_t mUseCounter                                       = 0;
+#endif // CHIP_DEVICE_CONFIG_STM32_KVS_CACHE_ENTRIES > 0
+
+    uint32_t mHitCount  = 0;
+    uint32_t mMissCount = 0;
+
+    static STM32KeyValueCache sInstance;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,208 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * @brief OpenThread message buffer pool carved out of PacketBuffers.
+ *
+ * A PacketBuffer is borrowed from the Matter pool when the message buffers of the ones already borrowed are all in
+ * use, cut into message buffers, and given back as soon as all of them are free again. The memory of a subscription
+ * burst thus goes to whichever stack holds the packets at the time, instead of both stacks having a pool sized for it.
+ *
+ * ThreadStackManagerImpl implements the otPlatMessagePool* functions with it. The pool is not thread safe: OpenThread
+ * only calls these functions with the Thread stack locked, and the PacketBuffer pool has its own lock.
+ *
+ * @tparam kNumPacketBuffers  Maximum number of PacketBuffers borrowed at the same time.
+ */
+template <size_t kNumPacketBuffers>
+class STM32ThreadMessagePool
+{
+public:
+    /**
+     * Set the size of the message buffers. Must be called before any other method.
+     */
+    void Init(size_t bufferSize)
+    {
+        mBufferSize             = (std::max(bufferSize, sizeof(FreeBuffer)) + kAlignment - 1) & ~(kAlignment - 1);
+        mBuffersPerPacketBuffer = static_cast<uint16_t>(
+            std::min<size_t>((System::PacketBuffer::kMaxSizeWithoutReserve - (kAlignment - 1)) / mBufferSize, UINT16_MAX));
+    }
+
+    /**
+     * Allocate a message buffer, borrowing a PacketBuffer if needed.
+     *
+     * @return  The message buffer, aligned for any type, or nullptr if no PacketBuffer can be borrowed.
+     */
+    void * New()
+    {
+        BorrowedPacketBuffer * unused = nullptr;
+
+        VerifyOrReturnValue(mBuffersPerPacketBuffer > 0, nullptr);
+
+        for (BorrowedPacketBuffer & borrowed : mBorrowed)
+        {
+            if (borrowed.mFreeList != nullptr)
+            {
+                unused = &borrowed;
+                break;
+            }
+
+            if (borrowed.mPacketBuffer == nullptr && unused == nullptr)
+            {
+                unused = &borrowed;
+            }
+        }
+
+        VerifyOrReturnValue(unused != nullptr, nullptr);
+        VerifyOrReturnValue(unused->mPacketBuffer != nullptr || Borrow(*unused), nullptr);
+
+        FreeBuffer * buffer = unused->mFreeList;
+        unused->mFreeList   = buffer->mNext;
+        unused->mNumFree--;
+
+        return buffer;
+    }
+
+    /**
+     * Free a message buffer returned by New(). The PacketBuffer goes back to the Matter pool once all of its message
+     * buffers are free.
+     */
+    void Free(void * buffer)
+    {
+        uint8_t * bytes = static_cast<uint8_t *>(buffer);
+
+        for (BorrowedPacketBuffer & borrowed : mBorrowed)
+        {
+            if (borrowed.mPacketBuffer == nullptr || bytes < borrowed.mStart ||
+                bytes >= borrowed.mStart + mBufferSize * mBuffersPerPacketBuffer)
+            {
+                continue;
+            }
+
+            FreeBuffer * freeBuffer = static_cast<FreeBuffer *>(buffer);
+            freeBuffer->mNext       = borrowed.mFreeList;
+            borrowed.mFreeList      = freeBuffer;
+            borrowed.mNumFree++;
+
+            if (borrowed.mNumFree == mBuffersPerPacketBuffer)
+            {
+                // Releasing the handle gives the PacketBuffer back to the Matter pool.
+                System::PacketBufferHandle handle = System::PacketBufferHandle::Adopt(borrowed.mPacketBuffer);
+
+                borrowed.mPacketBuffer = nullptr;
+                borrowed.mFreeList     = nullptr;
+            }
+
+            return;
+        }
+    }
+
+    /**
+     * Number of message buffers that can still be allocated, counting the PacketBuffers not borrowed yet as if they
+     * were all available.
+     */
+    uint16_t NumFreeBuffers() const
+    {
+        uint32_t numFree = 0;
+
+        for (const BorrowedPacketBuffer & borrowed : mBorrowed)
+        {
+            numFree += (borrowed.mPacketBuffer == nullptr) ? mBuffersPerPacketBuffer : borrowed.mNumFree;
+        }
+
+        return static_cast<uint16_t>(std::min<uint32_t>(numFree, UINT16_MAX));
+    }
+
+    uint16_t BuffersPerPacketBuffer() const { return mBuffersPerPacketBuffer; }
+
+    size_t NumBorrowedPacketBuffers() const
+    {
+        size_t numBorrowed = 0;
+
+        for (const BorrowedPacketBuffer & borrowed : mBorrowed)
+        {
+            numBorrowed += (borrowed.mPacketBuffer != nullptr) ? 1 : 0;
+        }
+
+        return numBorrowed;
+    }
+
+private:
+    static constexpr uintptr_t kAlignment = alignof(std::max_align_t);
+
+    struct FreeBuffer
+    {
+        FreeBuffer * mNext;
+    };
+
+    struct BorrowedPacketBuffer
+    {
+        System::PacketBuffer * mPacketBuffer;
+        uint8_t * mStart;       // First message buffer, aligned.
+        FreeBuffer * mFreeList; // Free message buffers.
+        uint16_t mNumFree;
+    };
+
+    bool Borrow(BorrowedPacketBuffer & borrowed)
+    {
+        System::PacketBufferHandle handle = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        uintptr_t start;
+        uintptr_t end;
+
+        VerifyOrReturnValue(!handle.IsNull(), false);
+
+        start = (reinterpret_cast<uintptr_t>(handle->Start()) + kAlignment - 1) & ~(kAlignment - 1);
+        end   = reinterpret_cast<uintptr_t>(handle->Start()) + handle->AvailableDataLength();
+        VerifyOrReturnValue(end >= start + mBufferSize * mBuffersPerPacketBuffer, false);
+
+        borrowed.mPacketBuffer = std::move(handle).UnsafeRelease();
+        borrowed.mStart        = reinterpret_cast<uint8_t *>(start);
+        borrowed.mFreeList     = nullptr;
+        borrowed.mNumFree      = mBuffersPerPacketBuffer;
+
+        for (uint16_t i = mBuffersPerPacketBuffer; i > 0; i--)
+        {
+            FreeBuffer * buffer = reinterpret_cast<FreeBuffer *>(borrowed.mStart + (i - 1) * mBufferSize);
+
+            buffer->mNext      = borrowed.mFreeList;
+            borrowed.mFreeList = buffer;
+        }
+
+        return true;
+    }
+
+    BorrowedPacketBuffer mBorrowed[kNumPacketBuffers] = {};
+    size_t mBufferSize                                = 0;
+    uint16_t mBuffersPerPacketBuffer                  = 0;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
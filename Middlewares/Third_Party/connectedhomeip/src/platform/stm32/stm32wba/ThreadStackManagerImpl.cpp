@@ -48,6 +48,11 @@
 #include <openthread/thread.h>
 #include "app_thread.h"
 
+#if CHIP_DEVICE_CONFIG_STM32_THREAD_MESSAGE_POOL_PACKETBUFFERS
+#include <openthread/platform/messagepool.h>
+#include "STM32ThreadMessagePool.h"
+#endif
+
 namespace chip {
 namespace DeviceLayer {
 
@@ -169,3 +174,50 @@ void otPlatFree(void * aPtr)
 	CHIPPlatformMemoryFree(aPtr);
 }
 }
+
+#if CHIP_DEVICE_CONFIG_STM32_THREAD_MESSAGE_POOL_PACKETBUFFERS
+
+/*
+ * OpenThread message pool carved out of PacketBuffers (see STM32ThreadMessagePool.h).
+ * These functions are only called by OpenThread, with the Thread stack locked.
+ */
+namespace {
+
+chip::DeviceLayer::Internal::STM32ThreadMessagePool<CHIP_DEVICE_CONFIG_STM32_THREAD_MESSAGE_POOL_PACKETBUFFERS> sMessagePool;
+
+} // namespace
+
+extern "C" void otPlatMessagePoolInit(otInstance * aInstance, uint16_t aMinNumFreeBuffers, size_t aBufferSize)
+{
+    (void) aInstance;
+    (void) aMinNumFreeBuffers;
+
+    sMessagePool.Init(aBufferSize);
+}
+
+extern "C" otMessageBuffer * otPlatMessagePoolNew(otInstance * aInstance)
+{
+    (void) aInstance;
+
+    return static_cast<otMessageBuffer *>(sMessagePool.New());
+}
+
+extern "C" void otPlatMessagePoolFree(otInstance * aInstance, otMessageBuffer * aBuffer)
+{
+    (void) aInstance;
+
+    sMessagePool.Free(aBuffer);
+}
+
+extern "C" uint16_t otPlatMessagePoolNumFreeBuffers(otInstance * aInstance)
+{
+    // PacketBuffers not borrowed yet are counted as available, although the Matter stack may be using them. OpenThread
+    // does not rely on this count to keep buffers for its high priority messages: it evicts lower priority messages when
+    // otPlatMessagePoolNew() fails, whatever the count. The count only feeds otMessageGetBufferInfo(), where the
+    // number of message buffers the pool could still hand out is the relevant figure.
+    (void) aInstance;
+
+    return sMessagePool.NumFreeBuffers();
+}
+
+#endif // CHIP_DEVICE_CONFIG_STM32_THREAD_MESSAGE_POOL_PACKETBUFFERS
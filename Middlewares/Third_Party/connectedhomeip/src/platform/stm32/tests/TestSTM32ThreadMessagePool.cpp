@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Unit tests for the OpenThread message buffer pool carved out of PacketBuffers,
+ *      used by the otPlatMessagePool* functions of the STM32WBA ThreadStackManagerImpl.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <platform/stm32/stm32wba/STM32ThreadMessagePool.h>
+
+namespace {
+
+using chip::DeviceLayer::Internal::STM32ThreadMessagePool;
+
+// Size of an OpenThread message buffer on a 32-bit target.
+constexpr size_t kBufferSize       = 128;
+constexpr size_t kNumPacketBuffers = 4;
+constexpr size_t kMaxBuffersInTest = 64;
+using Pool                         = STM32ThreadMessagePool<kNumPacketBuffers>;
+
+class TestSTM32ThreadMessagePool : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestSTM32ThreadMessagePool, CheckBorrowAndGiveBack)
+{
+    Pool pool;
+    pool.Init(kBufferSize);
+
+    const uint16_t perPacketBuffer = pool.BuffersPerPacketBuffer();
+    ASSERT_GT(perPacketBuffer, 1u);
+    ASSERT_LE(perPacketBuffer * kNumPacketBuffers, kMaxBuffersInTest);
+    EXPECT_EQ(pool.NumFreeBuffers(), perPacketBuffer * kNumPacketBuffers);
+    EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 0u);
+
+    // The first buffer borrows a PacketBuffer, the following ones come from it until it is full.
+    void * buffers[kMaxBuffersInTest];
+    for (uint16_t i = 0; i < perPacketBuffer; i++)
+    {
+        buffers[i] = pool.New();
+        ASSERT_NE(buffers[i], nullptr);
+        EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 1u);
+    }
+    buffers[perPacketBuffer] = pool.New();
+    ASSERT_NE(buffers[perPacketBuffer], nullptr);
+    EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 2u);
+    EXPECT_EQ(pool.NumFreeBuffers(), perPacketBuffer * kNumPacketBuffers - perPacketBuffer - 1);
+
+    // The second PacketBuffer goes back to the Matter pool as soon as its only message buffer is freed.
+    pool.Free(buffers[perPacketBuffer]);
+    EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 1u);
+
+    // The first one once all of its message buffers are freed, in any order.
+    for (uint16_t i = 0; i < perPacketBuffer; i += 2)
+    {
+        pool.Free(buffers[i]);
+    }
+    for (uint16_t i = 1; i < perPacketBuffer; i += 2)
+    {
+        EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 1u);
+        pool.Free(buffers[i]);
+    }
+    EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 0u);
+    EXPECT_EQ(pool.NumFreeBuffers(), perPacketBuffer * kNumPacketBuffers);
+}
+
+TEST_F(TestSTM32ThreadMessagePool, CheckFullPool)
+{
+    Pool pool;
+    pool.Init(kBufferSize);
+
+    const size_t numBuffers = pool.BuffersPerPacketBuffer() * kNumPacketBuffers;
+    ASSERT_LE(numBuffers, kMaxBuffersInTest);
+
+    // Every buffer is aligned and does not overlap any other: fill each one with its own pattern and check them all.
+    void * buffers[kMaxBuffersInTest];
+    for (size_t i = 0; i < numBuffers; i++)
+    {
+        buffers[i] = pool.New();
+        ASSERT_NE(buffers[i], nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(buffers[i]) % alignof(std::max_align_t), 0u);
+        memset(buffers[i], static_cast<int>(i), kBufferSize);
+    }
+    EXPECT_EQ(pool.NumBorrowedPacketBuffers(), kNumPacketBuffers);
+    EXPECT_EQ(pool.NumFreeBuffers(), 0u);
+    EXPECT_EQ(pool.New(), nullptr);
+
+    for (size_t i = 0; i < numBuffers; i++)
+    {
+        const uint8_t * bytes = static_cast<const uint8_t *>(buffers[i]);
+        for (size_t j = 0; j < kBufferSize; j++)
+        {
+            ASSERT_EQ(bytes[j], static_cast<uint8_t>(i));
+        }
+    }
+
+    // A freed buffer is handed out again.
+    pool.Free(buffers[3]);
+    EXPECT_EQ(pool.NumFreeBuffers(), 1u);
+    EXPECT_EQ(pool.New(), buffers[3]);
+
+    for (size_t i = 0; i < numBuffers; i++)
+    {
+        pool.Free(buffers[i]);
+    }
+    EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 0u);
+}
+
+TEST_F(TestSTM32ThreadMessagePool, CheckRandomAllocations)
+{
+    Pool pool;
+    pool.Init(kBufferSize);
+
+    const size_t numBuffers = pool.BuffersPerPacketBuffer() * kNumPacketBuffers;
+    ASSERT_LE(numBuffers, kMaxBuffersInTest);
+
+    void * buffers[kMaxBuffersInTest];
+    size_t numHeld = 0;
+    uint32_t seed  = 1;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        if (((seed >> 16) & 1) && numHeld < numBuffers)
+        {
+            buffers[numHeld] = pool.New();
+            ASSERT_NE(buffers[numHeld], nullptr);
+            for (size_t j = 0; j < numHeld; j++)
+            {
+                ASSERT_NE(buffers[j], buffers[numHeld]);
+            }
+            numHeld++;
+        }
+        else if (numHeld > 0)
+        {
+            size_t index = (seed >> 8) % numHeld;
+            pool.Free(buffers[index]);
+            buffers[index] = buffers[--numHeld];
+        }
+        ASSERT_EQ(pool.NumFreeBuffers(), numBuffers - numHeld);
+    }
+
+    while (numHeld > 0)
+    {
+        pool.Free(buffers[--numHeld]);
+    }
+    EXPECT_EQ(pool.NumBorrowedPacketBuffers(), 0u);
+}
+
+} // namespace
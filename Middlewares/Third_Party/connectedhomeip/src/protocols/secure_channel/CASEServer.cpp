@@ -47,28 +47,86 @@ CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager
     mExchangeManager           = exchangeManager;
     mGroupDataProvider         = responderGroupDataProvider;
 
-    // Set up the group state provider that persists across all handshakes.
-    GetSession().SetGroupDataProvider(mGroupDataProvider);
+    for (auto & responder : mResponders)
+    {
+        // Set up the group state provider that persists across all handshakes.
+        responder.mServer = this;
+        responder.mPairingSession.SetGroupDataProvider(mGroupDataProvider);
+    }
 
     ChipLogProgress(Inet, "CASE Server enabling CASE session setups");
     mExchangeManager->RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1, this);
 
-    PrepareForSessionEstablishment();
+    for (auto & responder : mResponders)
+    {
+        PrepareForSessionEstablishment(responder);
+    }
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASEServer::InitCASEHandshake(Messaging::ExchangeContext * ec)
+CHIP_ERROR CASEServer::InitCASEHandshake(Messaging::ExchangeContext * ec, Responder & responder)
 {
     MATTER_TRACE_SCOPE("InitCASEHandshake", "CASEServer");
     ReturnErrorCodeIf(ec == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
     // Hand over the exchange context to the CASE session.
-    ec->SetDelegate(&GetSession());
+    responder.mPeerAddress = ec->GetSessionHandle()->AsUnauthenticatedSession()->GetPeerAddress();
+    ec->SetDelegate(&responder.mPairingSession);
 
     return CHIP_NO_ERROR;
 }
 
+CASEServer::Responder * CASEServer::AllocateResponder(Messaging::ExchangeContext * ec, Responder *& busyResponder)
+{
+    const Transport::PeerAddress & peerAddress = ec->GetSessionHandle()->AsUnauthenticatedSession()->GetPeerAddress();
+    Responder * idleResponder                  = nullptr;
+    size_t numVerifyingSigma3                  = 0;
+
+    busyResponder = nullptr;
+
+    for (auto & responder : mResponders)
+    {
+        if (responder.IsIdle())
+        {
+            idleResponder = (idleResponder == nullptr) ? &responder : idleResponder;
+            continue;
+        }
+
+        // Invoke watchdog to fix any stuck handshakes
+        if (responder.mPairingSession.InvokeBackgroundWorkWatchdog())
+        {
+            idleResponder = (idleResponder == nullptr) ? &responder : idleResponder;
+            continue;
+        }
+
+        // A peer only gets one handshake at a time: the one in progress continues.
+        if (responder.mPeerAddress == peerAddress)
+        {
+            busyResponder = &responder;
+            return nullptr;
+        }
+
+        if (responder.mPairingSession.GetState() == CASESession::State::kHandleSigma3Pending)
+        {
+            numVerifyingSigma3++;
+        }
+
+        // Report a handshake waiting for Sigma3, if any, so that the busy delay accounts for its Sigma2 timeout.
+        if (busyResponder == nullptr || responder.mPairingSession.GetState() == CASESession::State::kSentSigma2)
+        {
+            busyResponder = &responder;
+        }
+    }
+
+    // A new handshake starts with the ECC operations of Sigma2: wait for the Sigma3 verifications in progress.
+    if (idleResponder != nullptr && numVerifyingSigma3 >= CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC)
+    {
+        return nullptr;
+    }
+    return idleResponder;
+}
+
 CHIP_ERROR CASEServer::OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate)
 {
     // TODO: assign newDelegate to CASESession, let CASESession handle future messages.
@@ -81,67 +139,58 @@ CHIP_ERROR CASEServer::OnMessageReceived(Messaging::ExchangeContext * ec, const
 {
     MATTER_TRACE_SCOPE("OnMessageReceived", "CASEServer");
 
-    bool busy = GetSession().GetState() != CASESession::State::kInitialized;
-    CHIP_FAULT_INJECT(FaultInjection::kFault_CASEServerBusy, busy = true);
-    if (busy)
+    if (!ec->GetSessionHandle()->IsUnauthenticatedSession())
     {
-        // We are in the middle of CASE handshake
+        ChipLogError(Inet, "CASE Server received Sigma1 message %s EC %p", "over encrypted session. Ignoring.", ec);
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
 
-        // Invoke watchdog to fix any stuck handshakes
-        bool watchdogFired = GetSession().InvokeBackgroundWorkWatchdog();
-        if (!watchdogFired)
-        {
-            // Handshake wasn't stuck, send the busy status report and let the existing handshake continue.
+    Responder * busyResponder = nullptr;
+    Responder * responder     = AllocateResponder(ec, busyResponder);
+    CHIP_FAULT_INJECT(FaultInjection::kFault_CASEServerBusy, responder = nullptr);
+    if (responder == nullptr)
+    {
+        // We are in the middle of CASE handshakes: send the busy status report and let the existing handshakes continue.
 
-            // A successful CASE handshake can take several seconds and some may time out (30 seconds or more).
+        // A successful CASE handshake can take several seconds and some may time out (30 seconds or more).
 
-            System::Clock::Milliseconds16 delay = System::Clock::kZero;
-            if (GetSession().GetState() == CASESession::State::kSentSigma2)
+        System::Clock::Milliseconds16 delay = System::Clock::kZero;
+        if (busyResponder != nullptr && busyResponder->mPairingSession.GetState() == CASESession::State::kSentSigma2)
+        {
+            // The delay should be however long we think it will take for
+            // that to time out.
+            auto sigma2Timeout = CASESession::ComputeSigma2ResponseTimeout(busyResponder->mPairingSession.GetRemoteMRPConfig());
+            if (sigma2Timeout < System::Clock::Milliseconds16::max())
             {
-                // The delay should be however long we think it will take for
-                // that to time out.
-                auto sigma2Timeout = CASESession::ComputeSigma2ResponseTimeout(GetSession().GetRemoteMRPConfig());
-                if (sigma2Timeout < System::Clock::Milliseconds16::max())
-                {
-                    delay = std::chrono::duration_cast<System::Clock::Milliseconds16>(sigma2Timeout);
-                }
-                else
-                {
-                    // Avoid overflow issues, just wait for as long as we can to
-                    // get close to our expected Sigma2 timeout.
-                    delay = System::Clock::Milliseconds16::max();
-                }
+                delay = std::chrono::duration_cast<System::Clock::Milliseconds16>(sigma2Timeout);
             }
             else
             {
-                // For now, setting minimum wait time to 5000 milliseconds if we
-                // have no other information.
-                delay = System::Clock::Milliseconds16(5000);
+                // Avoid overflow issues, just wait for as long as we can to
+                // get close to our expected Sigma2 timeout.
+                delay = System::Clock::Milliseconds16::max();
             }
-            CHIP_ERROR err = SendBusyStatusReport(ec, delay);
-            if (err != CHIP_NO_ERROR)
-            {
-                ChipLogError(Inet, "Failed to send the busy status report, err:%" CHIP_ERROR_FORMAT, err.Format());
-            }
-            return err;
         }
-    }
-
-    if (!ec->GetSessionHandle()->IsUnauthenticatedSession())
-    {
-        ChipLogError(Inet, "CASE Server received Sigma1 message %s EC %p", "over encrypted session. Ignoring.", ec);
-        return CHIP_ERROR_INCORRECT_STATE;
+        else
+        {
+            // For now, setting minimum wait time to 5000 milliseconds if we
+            // have no other information.
+            delay = System::Clock::Milliseconds16(5000);
+        }
+        CHIP_ERROR err = SendBusyStatusReport(ec, delay);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Inet, "Failed to send the busy status report, err:%" CHIP_ERROR_FORMAT, err.Format());
+        }
+        return err;
     }
 
     ChipLogProgress(Inet, "CASE Server received Sigma1 message %s EC %p", ". Starting handshake.", ec);
 
-    CHIP_ERROR err = InitCASEHandshake(ec);
+    CHIP_ERROR err = InitCASEHandshake(ec, *responder);
     SuccessOrExit(err);
 
-    // TODO - Enable multiple concurrent CASE session establishment
-    // https://github.com/project-chip/connectedhomeip/issues/8342
-
-    err = GetSession().OnMessageReceived(ec, payloadHeader, std::move(payload));
+    err = responder->mPairingSession.OnMessageReceived(ec, payloadHeader, std::move(payload));
     SuccessOrExit(err);
 
 exit:
@@ -150,9 +199,9 @@ exit:
     return err;
 }
 
-void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyEstablishedPeer)
+void CASEServer::PrepareForSessionEstablishment(Responder & responder, const ScopedNodeId & previouslyEstablishedPeer)
 {
-    GetSession().Clear();
+    responder.mPairingSession.Clear();
 
     //
     // This releases our reference to a previously pinned session. If that was a successfully established session and is now
@@ -163,7 +212,7 @@ void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyE
     // de-allocated since no one else is holding onto this session. This will mean that when we get to allocating a session below,
     // we'll at least have one free session available in the session table, and won't need to evict an arbitrary session.
     //
-    mPinnedSecureSession.ClearValue();
+    responder.mPinnedSecureSession.ClearValue();
 
     //
     // Indicate to the underlying CASE session to prepare for session establishment requests coming its way. This will
@@ -181,9 +230,10 @@ void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyE
     // TODO(#17568): Once session eviction is actually in place, this call should NEVER fail and if so, is a logic bug.
     // Dying here on failure is even more appropriate then.
     //
-    VerifyOrDie(GetSession().PrepareForSessionEstablishment(*mSessionManager, mFabrics, mSessionResumptionStorage,
-                                                            mCertificateValidityPolicy, this, previouslyEstablishedPeer,
-                                                            GetLocalMRPConfig()) == CHIP_NO_ERROR);
+    VerifyOrDie(responder.mPairingSession.PrepareForSessionEstablishment(*mSessionManager, mFabrics, mSessionResumptionStorage,
+                                                                         mCertificateValidityPolicy, &responder,
+                                                                         previouslyEstablishedPeer, GetLocalMRPConfig()) ==
+                CHIP_NO_ERROR);
 
     //
     // PairingSession::mSecureSessionHolder is a weak-reference. If MarkForEviction is called on this session, the session is
@@ -195,30 +245,30 @@ void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyE
     //
     // Let's create a SessionHandle strong-reference to it to keep it resident.
     //
-    mPinnedSecureSession = GetSession().CopySecureSession();
+    responder.mPinnedSecureSession = responder.mPairingSession.CopySecureSession();
 
     //
     // If we've gotten this far, it means we have successfully allocated a SecureSession to back our next attempt. If we haven't,
     // there is a bug somewhere and we should raise attention to it by dying.
     //
-    VerifyOrDie(mPinnedSecureSession.HasValue());
+    VerifyOrDie(responder.mPinnedSecureSession.HasValue());
 }
 
-void CASEServer::OnSessionEstablishmentError(CHIP_ERROR err)
+void CASEServer::Responder::OnSessionEstablishmentError(CHIP_ERROR err)
 {
     MATTER_TRACE_SCOPE("OnSessionEstablishmentError", "CASEServer");
     ChipLogError(Inet, "CASE Session establishment failed: %" CHIP_ERROR_FORMAT, err.Format());
 
     MATTER_TRACE_SCOPE("CASEFail", "CASESession");
-    PrepareForSessionEstablishment();
+    mServer->PrepareForSessionEstablishment(*this);
 }
 
-void CASEServer::OnSessionEstablished(const SessionHandle & session)
+void CASEServer::Responder::OnSessionEstablished(const SessionHandle & session)
 {
     MATTER_TRACE_SCOPE("OnSessionEstablished", "CASEServer");
     ChipLogProgress(Inet, "CASE Session established to peer: " ChipLogFormatScopedNodeId,
                     ChipLogValueScopedNodeId(session->GetPeer()));
-    PrepareForSessionEstablishment(session->GetPeer());
+    mServer->PrepareForSessionEstablishment(*this, session->GetPeer());
 }
 
 CHIP_ERROR CASEServer::SendBusyStatusReport(Messaging::ExchangeContext * ec, System::Clock::Milliseconds16 minimumWaitTime)
@@ -26,18 +26,24 @@
 
 namespace chip {
 
-class CASEServer : public SessionEstablishmentDelegate,
-                   public Messaging::UnsolicitedMessageHandler,
-                   public Messaging::ExchangeDelegate
+/**
+ * Responder side of CASE: handles the Sigma1 messages received by the node.
+ *
+ * The server owns a pool of CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE responder sessions, so that handshakes with several
+ * peers can progress at the same time. A Sigma1 gets a Busy status report when every responder is in use, when the same peer
+ * address already has a handshake in progress, or when CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC handshakes are already
+ * verifying a Sigma3 in the background.
+ */
+class CASEServer : public Messaging::UnsolicitedMessageHandler, public Messaging::ExchangeDelegate
 {
 public:
     CASEServer() {}
     ~CASEServer() override { Shutdown(); }
 
     /*
-     * This method will shutdown this object, releasing the strong reference to the pinned SecureSession object.
-     * It will also unregister the unsolicited handler and clear out the session object (which will release the weak
-     * reference through the underlying SessionHolder).
+     * This method will shutdown this object, releasing the strong references to the pinned SecureSession objects.
+     * It will also unregister the unsolicited handler and clear out the session objects (which will release the weak
+     * references through the underlying SessionHolders).
      *
      */
     void Shutdown()
@@ -48,8 +54,11 @@ public:
             mExchangeManager = nullptr;
         }
 
-        GetSession().Clear();
-        mPinnedSecureSession.ClearValue();
+        for (auto & responder : mResponders)
+        {
+            responder.mPairingSession.Clear();
+            responder.mPinnedSecureSession.ClearValue();
+        }
     }
 
     CHIP_ERROR ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, SessionManager * sessionManager,
@@ -57,10 +66,6 @@ public:
                                              Credentials::CertificateValidityPolicy * policy,
                                              Credentials::GroupDataProvider * responderGroupDataProvider);
 
-    //////////// SessionEstablishmentDelegate Implementation ///////////////
-    void OnSessionEstablishmentError(CHIP_ERROR error) override;
-    void OnSessionEstablished(const SessionHandle & session) override;
-
     //// UnsolicitedMessageHandler Implementation ////
     CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override;
 
@@ -70,44 +75,69 @@ public:
     void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
     Messaging::ExchangeMessageDispatch & GetMessageDispatch() override { return GetSession().GetMessageDispatch(); }
 
-    CASESession & GetSession() { return mPairingSession; }
+    // The first responder session of the pool.
+    CASESession & GetSession() { return mResponders[0].mPairingSession; }
 
 private:
+    class Responder : public SessionEstablishmentDelegate
+    {
+    public:
+        //////////// SessionEstablishmentDelegate Implementation ///////////////
+        void OnSessionEstablishmentError(CHIP_ERROR error) override;
+        void OnSessionEstablished(const SessionHandle & session) override;
+
+        bool IsIdle() { return mPairingSession.GetState() == CASESession::State::kInitialized; }
+
+        CASEServer * mServer = nullptr;
+
+        //
+        // When we're in the process of establishing a session, this is used
+        // to maintain an additional, strong reference to the underlying SecureSession.
+        // This is because the existing reference in PairingSession is a weak one
+        // (i.e a SessionHolder) and can lose its reference if the session is evicted
+        // for any reason.
+        //
+        // This initially points to a session that is not yet active. Upon activation, it
+        // transfers ownership of the session to the SecureSessionManager and this reference
+        // is released before simultaneously acquiring ownership of a new SecureSession.
+        //
+        Optional<SessionHandle> mPinnedSecureSession;
+
+        CASESession mPairingSession;
+
+        // Address of the peer the handshake in progress is with.
+        Transport::PeerAddress mPeerAddress;
+    };
+
     Messaging::ExchangeManager * mExchangeManager                       = nullptr;
     SessionResumptionStorage * mSessionResumptionStorage                = nullptr;
     Credentials::CertificateValidityPolicy * mCertificateValidityPolicy = nullptr;
 
-    //
-    // When we're in the process of establishing a session, this is used
-    // to maintain an additional, strong reference to the underlying SecureSession.
-    // This is because the existing reference in PairingSession is a weak one
-    // (i.e a SessionHolder) and can lose its reference if the session is evicted
-    // for any reason.
-    //
-    // This initially points to a session that is not yet active. Upon activation, it
-    // transfers ownership of the session to the SecureSessionManager and this reference
-    // is released before simultaneously acquiring ownership of a new SecureSession.
-    //
-    Optional<SessionHandle> mPinnedSecureSession;
-
-    CASESession mPairingSession;
+    Responder mResponders[CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE];
     SessionManager * mSessionManager = nullptr;
 
     FabricTable * mFabrics                              = nullptr;
     Credentials::GroupDataProvider * mGroupDataProvider = nullptr;
 
-    CHIP_ERROR InitCASEHandshake(Messaging::ExchangeContext * ec);
+    CHIP_ERROR InitCASEHandshake(Messaging::ExchangeContext * ec, Responder & responder);
+
+    /*
+     * Returns the responder that should handle a Sigma1 received on the given exchange, or nullptr if the Sigma1
+     * should get a Busy status report. In that case, busyResponder is set to the responder whose handshake the
+     * peer should wait for.
+     */
+    Responder * AllocateResponder(Messaging::ExchangeContext * ec, Responder *& busyResponder);
 
     /*
      * This will clean up any state from a previous session establishment
-     * attempt (if any) and setup the machinery to listen for and handle
-     * any session handshakes there-after.
+     * attempt (if any) of the responder and setup the machinery to listen for
+     * and handle any session handshakes there-after.
      *
      * If a session had previously been established successfully, previouslyEstablishedPeer
      * should be set to the scoped node-id of the peer associated with that session.
      *
      */
-    void PrepareForSessionEstablishment(const ScopedNodeId & previouslyEstablishedPeer = ScopedNodeId());
+    void PrepareForSessionEstablishment(Responder & responder, const ScopedNodeId & previouslyEstablishedPeer = ScopedNodeId());
 
     // If we are in the middle of handshake and receive a Sigma1 then respond with Busy status code.
     // @param[in] ec              Exchange Context
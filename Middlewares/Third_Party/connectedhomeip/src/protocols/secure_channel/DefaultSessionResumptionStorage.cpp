@@ -42,6 +42,28 @@ CHIP_ERROR DefaultSessionResumptionStorage::FindByResumptionId(ConstResumptionId
 
 CHIP_ERROR DefaultSessionResumptionStorage::FindNodeByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node)
 {
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    // The link is only read from storage when the resumption ID of some node of the index is not known
+    if (LoadIndexCache() == CHIP_NO_ERROR)
+    {
+        bool allKnown = true;
+        for (size_t i = 0; i < mIndexCache.mSize; ++i)
+        {
+            if (!mResumptionIdKnown[i])
+            {
+                allKnown = false;
+            }
+            else if (std::equal(mResumptionIdCache[i].begin(), mResumptionIdCache[i].end(), resumptionId.begin(),
+                                resumptionId.end()))
+            {
+                node = mIndexCache.mNodes[i];
+                return CHIP_NO_ERROR;
+            }
+        }
+        VerifyOrReturnError(!allKnown, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    }
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+
     ReturnErrorOnFailure(LoadLink(resumptionId, node));
     return CHIP_NO_ERROR;
 }
@@ -50,7 +72,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, Cons
                                                  const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs)
 {
     SessionIndex index;
-    ReturnErrorOnFailure(LoadIndex(index));
+    ReturnErrorOnFailure(LoadCachedIndex(index));
 
     for (size_t i = 0; i < index.mSize; ++i)
     {
@@ -65,7 +87,10 @@ CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, Cons
             // resumption-id-keyed link is best effort.  If we cannot load
             // state to lookup the resumption ID for the key, the entry in
             // the link table will be leaked.
-            err = LoadState(node, oldResumptionId, oldSharedSecret, oldPeerCATs);
+            if (!FindCachedResumptionId(node, oldResumptionId))
+            {
+                err = LoadState(node, oldResumptionId, oldSharedSecret, oldPeerCATs);
+            }
             if (err != CHIP_NO_ERROR)
             {
                 ChipLogError(SecureChannel,
@@ -75,6 +100,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, Cons
             }
             else
             {
+                ForgetResumptionId(node);
                 err = DeleteLink(oldResumptionId);
                 if (err != CHIP_NO_ERROR)
                 {
@@ -86,6 +112,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, Cons
             }
             ReturnErrorOnFailure(SaveState(node, resumptionId, sharedSecret, peerCATs));
             ReturnErrorOnFailure(SaveLink(resumptionId, node));
+            CacheResumptionId(node, resumptionId);
             return CHIP_NO_ERROR;
         }
     }
@@ -94,14 +121,15 @@ CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, Cons
     {
         // TODO: implement LRU for resumption
         ReturnErrorOnFailure(Delete(index.mNodes[0]));
-        ReturnErrorOnFailure(LoadIndex(index));
+        ReturnErrorOnFailure(LoadCachedIndex(index));
     }
 
     ReturnErrorOnFailure(SaveState(node, resumptionId, sharedSecret, peerCATs));
     ReturnErrorOnFailure(SaveLink(resumptionId, node));
 
     index.mNodes[index.mSize++] = node;
-    ReturnErrorOnFailure(SaveIndex(index));
+    ReturnErrorOnFailure(SaveCachedIndex(index));
+    CacheResumptionId(node, resumptionId);
 
     return CHIP_NO_ERROR;
 }
@@ -109,14 +137,19 @@ CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, Cons
 CHIP_ERROR DefaultSessionResumptionStorage::Delete(const ScopedNodeId & node)
 {
     SessionIndex index;
-    ReturnErrorOnFailure(LoadIndex(index));
+    ReturnErrorOnFailure(LoadCachedIndex(index));
 
     ResumptionIdStorage resumptionId;
     Crypto::P256ECDHDerivedSecret sharedSecret;
     CATValues peerCATs;
-    CHIP_ERROR err = LoadState(node, resumptionId, sharedSecret, peerCATs);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (!FindCachedResumptionId(node, resumptionId))
+    {
+        err = LoadState(node, resumptionId, sharedSecret, peerCATs);
+    }
     if (err == CHIP_NO_ERROR)
     {
+        ForgetResumptionId(node);
         err = DeleteLink(resumptionId);
         if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
         {
@@ -165,7 +198,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::Delete(const ScopedNodeId & node)
 
     if (found)
     {
-        err = SaveIndex(index);
+        err = SaveCachedIndex(index);
         if (err != CHIP_NO_ERROR)
         {
             ChipLogError(SecureChannel, "Unable to save session resumption index: %" CHIP_ERROR_FORMAT, err.Format());
@@ -186,7 +219,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
     CHIP_ERROR stickyErr = CHIP_NO_ERROR;
     size_t found         = 0;
     SessionIndex index;
-    ReturnErrorOnFailure(LoadIndex(index));
+    ReturnErrorOnFailure(LoadCachedIndex(index));
     size_t initialSize = index.mSize;
     for (size_t i = 0; i < initialSize; ++i)
     {
@@ -200,7 +233,10 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
         {
             continue;
         }
-        err       = LoadState(index.mNodes[cur], resumptionId, sharedSecret, peerCATs);
+        if (!FindCachedResumptionId(index.mNodes[cur], resumptionId))
+        {
+            err = LoadState(index.mNodes[cur], resumptionId, sharedSecret, peerCATs);
+        }
         stickyErr = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
         if (err != CHIP_NO_ERROR)
         {
@@ -210,6 +246,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
                          fabricIndex, err.Format());
             continue;
         }
+        ForgetResumptionId(index.mNodes[cur]);
         err       = DeleteLink(resumptionId);
         stickyErr = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
         if (err != CHIP_NO_ERROR)
@@ -240,7 +277,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
     if (found)
     {
         index.mSize -= found;
-        CHIP_ERROR err = SaveIndex(index);
+        CHIP_ERROR err = SaveCachedIndex(index);
         stickyErr      = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
         if (err != CHIP_NO_ERROR)
         {
@@ -254,4 +291,132 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
     return stickyErr;
 }
 
+void DefaultSessionResumptionStorage::InvalidateIndexCache()
+{
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    mIndexCacheLoaded = false;
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+}
+
+CHIP_ERROR DefaultSessionResumptionStorage::LoadCachedIndex(SessionIndex & index)
+{
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    ReturnErrorOnFailure(LoadIndexCache());
+    index = mIndexCache;
+    return CHIP_NO_ERROR;
+#else
+    return LoadIndex(index);
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+}
+
+CHIP_ERROR DefaultSessionResumptionStorage::SaveCachedIndex(const SessionIndex & index)
+{
+    CHIP_ERROR err = SaveIndex(index);
+
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    if (err != CHIP_NO_ERROR)
+    {
+        // What the storage holds is unknown: read it again when next needed.
+        mIndexCacheLoaded = false;
+        return err;
+    }
+
+    // Carry the known resumption IDs over to the new positions of their nodes
+    ResumptionIdStorage resumptionIds[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+    bool known[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+    for (size_t i = 0; i < index.mSize; ++i)
+    {
+        size_t cached = FindInIndexCache(index.mNodes[i]);
+        known[i]      = (cached != kNotInIndexCache) && mResumptionIdKnown[cached];
+        if (known[i])
+        {
+            resumptionIds[i] = mResumptionIdCache[cached];
+        }
+    }
+
+    mIndexCache = index;
+    for (size_t i = 0; i < index.mSize; ++i)
+    {
+        mResumptionIdKnown[i] = known[i];
+        if (known[i])
+        {
+            mResumptionIdCache[i] = resumptionIds[i];
+        }
+    }
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+
+    return err;
+}
+
+bool DefaultSessionResumptionStorage::FindCachedResumptionId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId) const
+{
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    size_t i = FindInIndexCache(node);
+    if (i != kNotInIndexCache && mResumptionIdKnown[i])
+    {
+        resumptionId = mResumptionIdCache[i];
+        return true;
+    }
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+
+    return false;
+}
+
+void DefaultSessionResumptionStorage::CacheResumptionId(const ScopedNodeId & node, ConstResumptionIdView resumptionId)
+{
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    size_t i = FindInIndexCache(node);
+    if (i != kNotInIndexCache)
+    {
+        std::copy(resumptionId.begin(), resumptionId.end(), mResumptionIdCache[i].begin());
+        mResumptionIdKnown[i] = true;
+    }
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+}
+
+void DefaultSessionResumptionStorage::ForgetResumptionId(const ScopedNodeId & node)
+{
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    size_t i = FindInIndexCache(node);
+    if (i != kNotInIndexCache)
+    {
+        mResumptionIdKnown[i] = false;
+    }
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+}
+
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+CHIP_ERROR DefaultSessionResumptionStorage::LoadIndexCache()
+{
+    VerifyOrReturnError(!mIndexCacheLoaded, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(LoadIndex(mIndexCache));
+
+    // The resumption IDs that cannot be read now are read from storage each time they are needed
+    for (size_t i = 0; i < mIndexCache.mSize; ++i)
+    {
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        CATValues peerCATs;
+        mResumptionIdKnown[i] = (LoadState(mIndexCache.mNodes[i], mResumptionIdCache[i], sharedSecret, peerCATs) == CHIP_NO_ERROR);
+    }
+
+    mIndexCacheLoaded = true;
+    return CHIP_NO_ERROR;
+}
+
+size_t DefaultSessionResumptionStorage::FindInIndexCache(const ScopedNodeId & node) const
+{
+    // Before the index is loaded, nothing is found
+    size_t size = mIndexCacheLoaded ? mIndexCache.mSize : 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (mIndexCache.mNodes[i] == node)
+        {
+            return i;
+        }
+    }
+
+    return kNotInIndexCache;
+}
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+
 } // namespace chip
@@ -29,6 +29,9 @@ namespace chip {
  *   The implementation saves 2 maps:
  *     * <FabricIndex, PeerNodeId>   => <ResumptionId, ShareSecret, PeerCATs>
  *     * <ResumptionId>              => <FabricIndex, PeerNodeId>
+ *
+ *   With CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE, the list of nodes and their resumption IDs are also kept in RAM, written
+ *   through to storage.
  */
 class DefaultSessionResumptionStorage : public SessionResumptionStorage
 {
@@ -66,6 +69,34 @@ protected:
     CHIP_ERROR virtual LoadState(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)             = 0;
     CHIP_ERROR virtual DeleteState(const ScopedNodeId & node)                                                    = 0;
+
+    /**
+     * Drops the in-RAM copy of the index, for instance when the backend changes. It is read from storage again when next needed.
+     */
+    void InvalidateIndexCache();
+
+private:
+    // Read and write the index through its in-RAM copy when CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE is enabled, directly
+    // otherwise.
+    CHIP_ERROR LoadCachedIndex(SessionIndex & index);
+    CHIP_ERROR SaveCachedIndex(const SessionIndex & index);
+
+    // Resumption IDs of the nodes of the index, as far as they are known. Without the cache, nothing is ever known.
+    bool FindCachedResumptionId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId) const;
+    void CacheResumptionId(const ScopedNodeId & node, ConstResumptionIdView resumptionId);
+    void ForgetResumptionId(const ScopedNodeId & node);
+
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    static constexpr size_t kNotInIndexCache = CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE;
+
+    CHIP_ERROR LoadIndexCache();
+    size_t FindInIndexCache(const ScopedNodeId & node) const;
+
+    SessionIndex mIndexCache;
+    ResumptionIdStorage mResumptionIdCache[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+    bool mResumptionIdKnown[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+    bool mIndexCacheLoaded = false;
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
 };
 
 } // namespace chip
@@ -78,6 +78,18 @@ public:
                                           TestCASESecurePairingDelegate & delegateCommissioner);
 
     void SimulateUpdateNOCInvalidatePendingEstablishment();
+
+    // Creates an exchange to Bob that the server sees as coming from its own peer address for each initiator index.
+    ExchangeContext * NewUnauthenticatedExchangeToBobFromInitiator(size_t initiatorIndex, ExchangeDelegate * delegate);
+
+    // Starts the handshakes of the given initiators with the server at the same time, and starts again those told to
+    // wait until all sessions are established. Returns the number of rounds this took.
+    size_t EstablishConcurrentSessions(size_t numInitiators);
+
+    // Puts the first responder of the server in the given state, as if its handshake had got there.
+    static void SetFirstResponderState(CASESession::State state);
+
+    static constexpr size_t kMaxConcurrentInitiators = 2 * CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE + 1;
 };
 
 void TestCASESession::ServiceEvents()
@@ -593,9 +605,10 @@ TEST_F(TestCASESession, ClientReceivesBusyTest)
 
     ServiceEvents();
 
-    // We should have one full handshake and one Sigma1 + Busy + ack.  If that
-    // ever changes (e.g. because our server starts supporting multiple parallel
-    // handshakes), this test needs to be fixed so that the server is still
+    // We should have one full handshake and one Sigma1 + Busy + ack.  Both
+    // clients use the same peer address, and the server only runs one
+    // handshake per peer address even when it has several responders.  If that
+    // ever changes, this test needs to be fixed so that the server is still
     // responding BUSY to the client.
     EXPECT_EQ(loopback.mSentMessageCount, sTestCaseMessageCount + 3);
     EXPECT_EQ(delegateCommissioner1.mNumPairingComplete, 1u);
@@ -610,6 +623,180 @@ TEST_F(TestCASESession, ClientReceivesBusyTest)
     gPairingServer.Shutdown();
 }
 
+ExchangeContext * TestCASESession::NewUnauthenticatedExchangeToBobFromInitiator(size_t initiatorIndex,
+                                                                              ExchangeDelegate * delegate)
+{
+    // The loopback transport answers from the port of the destination with its lowest bit flipped, so that each
+    // initiator gets its own peer address on the server side.
+    Transport::PeerAddress peerAddress = GetBobAddress();
+    peerAddress.SetPort(static_cast<uint16_t>(peerAddress.GetPort() + 2 * initiatorIndex));
+
+    auto mrpConfig              = GetLocalMRPConfig().ValueOr(GetDefaultMRPConfig());
+    auto unauthenticatedSession = GetSecureSessionManager().CreateUnauthenticatedSession(peerAddress, mrpConfig);
+    VerifyOrReturnValue(unauthenticatedSession.HasValue(), nullptr);
+    return GetExchangeManager().NewContext(unauthenticatedSession.Value(), delegate);
+}
+
+size_t TestCASESession::EstablishConcurrentSessions(size_t numInitiators)
+{
+    TemporarySessionManager sessionManager(*this);
+    TestCASESecurePairingDelegate delegateCommissioners[kMaxConcurrentInitiators];
+    CASESession pairingCommissioners[kMaxConcurrentInitiators];
+
+    VerifyOrReturnValue(numInitiators <= kMaxConcurrentInitiators, 0);
+
+    size_t numRounds      = 0;
+    size_t numEstablished = 0;
+
+    while (numEstablished < numInitiators && numRounds < numInitiators)
+    {
+        numRounds++;
+
+        for (size_t i = 0; i < numInitiators; i++)
+        {
+            if (delegateCommissioners[i].mNumPairingComplete != 0)
+            {
+                continue;
+            }
+
+            ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBobFromInitiator(i, &pairingCommissioners[i]);
+            EXPECT_NE(contextCommissioner, nullptr);
+
+            pairingCommissioners[i].SetGroupDataProvider(&gCommissionerGroupDataProvider);
+            EXPECT_EQ(pairingCommissioners[i].EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                               ScopedNodeId{ Node01_01, gCommissionerFabricIndex },
+                                                               contextCommissioner, nullptr, nullptr, &delegateCommissioners[i],
+                                                               NullOptional),
+                      CHIP_NO_ERROR);
+        }
+
+        ServiceEvents();
+
+        numEstablished = 0;
+        for (size_t i = 0; i < numInitiators; i++)
+        {
+            numEstablished += delegateCommissioners[i].mNumPairingComplete;
+        }
+    }
+
+    EXPECT_EQ(numEstablished, numInitiators);
+    for (size_t i = 0; i < numInitiators; i++)
+    {
+        EXPECT_EQ(delegateCommissioners[i].mNumPairingComplete, 1u);
+        EXPECT_EQ(delegateCommissioners[i].mNumPairingErrors, delegateCommissioners[i].mNumBusyResponses);
+    }
+
+    return numRounds;
+}
+
+TEST_F(TestCASESession, ConcurrentInitiatorsTest)
+{
+    // An initiator that gets a Busy status report starts again in the next round, as OperationalSessionSetup does after
+    // the wait requested by the server. Each round establishes as many sessions as the server has responders, so N
+    // initiators need ceil(N / pool size) rounds.
+    constexpr size_t kPoolSize = CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE;
+
+    EXPECT_EQ(gPairingServer.ListenForSessionEstablishment(&GetExchangeManager(), &GetSecureSessionManager(), &gDeviceFabrics,
+                                                           nullptr, nullptr, &gDeviceGroupDataProvider),
+              CHIP_NO_ERROR);
+
+    for (size_t numInitiators : { size_t(1), kPoolSize, kPoolSize + 1, kMaxConcurrentInitiators })
+    {
+        EXPECT_EQ(EstablishConcurrentSessions(numInitiators), (numInitiators + kPoolSize - 1) / kPoolSize);
+    }
+
+    gPairingServer.Shutdown();
+}
+
+#if CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE > 1
+TEST_F(TestCASESession, SamePeerReceivesBusyTest)
+{
+    TemporarySessionManager sessionManager(*this);
+    TestCASESecurePairingDelegate delegateCommissioners[3];
+    CASESession pairingCommissioners[3];
+
+    EXPECT_EQ(gPairingServer.ListenForSessionEstablishment(&GetExchangeManager(), &GetSecureSessionManager(), &gDeviceFabrics,
+                                                           nullptr, nullptr, &gDeviceGroupDataProvider),
+              CHIP_NO_ERROR);
+
+    // The first two initiators share a peer address, the third one has its own. The second Sigma1 from the shared address
+    // gets Busy although a responder is idle: the Sigma1 of the third initiator, received after it, gets that responder.
+    const size_t peerIndexes[] = { 0, 0, 1 };
+    for (size_t i = 0; i < 3; i++)
+    {
+        ExchangeContext * contextCommissioner =
+            NewUnauthenticatedExchangeToBobFromInitiator(peerIndexes[i], &pairingCommissioners[i]);
+        ASSERT_NE(contextCommissioner, nullptr);
+
+        pairingCommissioners[i].SetGroupDataProvider(&gCommissionerGroupDataProvider);
+        EXPECT_EQ(pairingCommissioners[i].EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                           ScopedNodeId{ Node01_01, gCommissionerFabricIndex }, contextCommissioner,
+                                                           nullptr, nullptr, &delegateCommissioners[i], NullOptional),
+                  CHIP_NO_ERROR);
+    }
+
+    ServiceEvents();
+
+    EXPECT_EQ(delegateCommissioners[0].mNumPairingComplete, 1u);
+    EXPECT_EQ(delegateCommissioners[0].mNumPairingErrors, 0u);
+
+    EXPECT_EQ(delegateCommissioners[1].mNumPairingComplete, 0u);
+    EXPECT_EQ(delegateCommissioners[1].mNumPairingErrors, 1u);
+    EXPECT_EQ(delegateCommissioners[1].mNumBusyResponses, 1u);
+
+    EXPECT_EQ(delegateCommissioners[2].mNumPairingComplete, 1u);
+    EXPECT_EQ(delegateCommissioners[2].mNumPairingErrors, 0u);
+
+    gPairingServer.Shutdown();
+}
+#endif // CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE > 1
+
+void TestCASESession::SetFirstResponderState(CASESession::State state)
+{
+    gPairingServer.GetSession().mState = state;
+}
+
+#if CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE > 1 && CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC == 1
+TEST_F(TestCASESession, Sigma3VerificationReceivesBusyTest)
+{
+    TemporarySessionManager sessionManager(*this);
+    TestCASESecurePairingDelegate delegateCommissioner;
+    CASESession pairingCommissioner;
+
+    EXPECT_EQ(gPairingServer.ListenForSessionEstablishment(&GetExchangeManager(), &GetSecureSessionManager(), &gDeviceFabrics,
+                                                           nullptr, nullptr, &gDeviceGroupDataProvider),
+              CHIP_NO_ERROR);
+
+    auto startHandshake = [&]() {
+        ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBobFromInitiator(1, &pairingCommissioner);
+        EXPECT_NE(contextCommissioner, nullptr);
+
+        pairingCommissioner.SetGroupDataProvider(&gCommissionerGroupDataProvider);
+        EXPECT_EQ(pairingCommissioner.EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                       ScopedNodeId{ Node01_01, gCommissionerFabricIndex }, contextCommissioner,
+                                                       nullptr, nullptr, &delegateCommissioner, NullOptional),
+                  CHIP_NO_ERROR);
+        ServiceEvents();
+    };
+
+    // While the first responder verifies a Sigma3 in the background, a Sigma1 from another peer gets Busy although the
+    // other responders are idle.
+    SetFirstResponderState(CASESession::State::kHandleSigma3Pending);
+    startHandshake();
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 1u);
+    EXPECT_EQ(delegateCommissioner.mNumBusyResponses, 1u);
+
+    // Once the verification is done, the next attempt gets a responder.
+    SetFirstResponderState(CASESession::State::kInitialized);
+    startHandshake();
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 1u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 1u);
+
+    gPairingServer.Shutdown();
+}
+#endif // CHIP_CONFIG_CASE_SERVER_RESPONDER_POOL_SIZE > 1 && CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_ECC == 1
+
 struct Sigma1Params
 {
     // Purposefully not using constants like kSigmaParamRandomNumberSize that
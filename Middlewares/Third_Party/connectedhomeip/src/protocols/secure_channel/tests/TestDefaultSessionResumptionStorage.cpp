@@ -388,3 +388,101 @@ TEST(TestDefaultSessionResumptionStorage, TestDeleteAll)
         }
     }
 }
+
+class CountingPersistentStorageDelegate : public chip::TestPersistentStorageDelegate
+{
+public:
+    size_t mReads = 0;
+
+protected:
+    CHIP_ERROR SyncGetKeyValueInternal(const char * key, void * buffer, uint16_t & size) override
+    {
+        mReads++;
+        return TestPersistentStorageDelegate::SyncGetKeyValueInternal(key, buffer, size);
+    }
+};
+
+TEST(TestDefaultSessionResumptionStorage, TestIndexReads)
+{
+    CountingPersistentStorageDelegate storage;
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    struct
+    {
+        chip::SessionResumptionStorage::ResumptionIdStorage resumptionId;
+        chip::ScopedNodeId node;
+    } vectors[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+
+    // Create a shared secret.  We can use the same one for all entries.
+    sharedSecret.SetLength(sharedSecret.Capacity());
+    EXPECT_EQ(chip::Crypto::DRBG_get_bytes(sharedSecret.Bytes(), sharedSecret.Length()), CHIP_NO_ERROR);
+
+    // Populate test vectors.
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        EXPECT_EQ(chip::Crypto::DRBG_get_bytes(vectors[i].resumptionId.data(), vectors[i].resumptionId.size()), CHIP_NO_ERROR);
+        *vectors[i].resumptionId.data() = static_cast<uint8_t>(i); // set first byte to our index to ensure uniqueness
+        vectors[i].node = chip::ScopedNodeId(static_cast<chip::NodeId>(i + 1), static_cast<chip::FabricIndex>(i + 1));
+    }
+
+    // Fill half of the storage, then use another instance to find what the first one saved, as after a reboot.
+    {
+        chip::SimpleSessionResumptionStorage sessionStorage;
+        sessionStorage.Init(&storage);
+        for (size_t i = 0; i < ArraySize(vectors) / 2; ++i)
+        {
+            EXPECT_EQ(sessionStorage.Save(vectors[i].node, vectors[i].resumptionId, sharedSecret, chip::CATValues{}),
+                      CHIP_NO_ERROR);
+        }
+    }
+
+    chip::SimpleSessionResumptionStorage sessionStorage;
+    sessionStorage.Init(&storage);
+
+    chip::ScopedNodeId outNode;
+    chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+    chip::CATValues outCats;
+    EXPECT_EQ(sessionStorage.FindByResumptionId(vectors[0].resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+    EXPECT_EQ(vectors[0].node, outNode);
+
+    // Fill the other half, and save a new resumption ID for the first node.
+    for (size_t i = ArraySize(vectors) / 2; i < ArraySize(vectors); ++i)
+    {
+        EXPECT_EQ(sessionStorage.Save(vectors[i].node, vectors[i].resumptionId, sharedSecret, chip::CATValues{}), CHIP_NO_ERROR);
+    }
+    chip::SessionResumptionStorage::ResumptionIdStorage oldResumptionId = vectors[0].resumptionId;
+    *vectors[0].resumptionId.data() = static_cast<uint8_t>(ArraySize(vectors));
+    EXPECT_EQ(sessionStorage.Save(vectors[0].node, vectors[0].resumptionId, sharedSecret, chip::CATValues{}), CHIP_NO_ERROR);
+    EXPECT_NE(sessionStorage.FindByResumptionId(oldResumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+
+    // Every node is found by its resumption ID.
+    for (auto & vector : vectors)
+    {
+        storage.mReads = 0;
+        EXPECT_EQ(sessionStorage.FindByResumptionId(vector.resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+        EXPECT_EQ(vector.node, outNode);
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+        // Only the state is read, the node comes from the index in RAM.
+        EXPECT_EQ(storage.mReads, 1u);
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    }
+
+    // Delete the first node, and save it again.
+    storage.mReads = 0;
+    EXPECT_EQ(sessionStorage.Delete(vectors[0].node), CHIP_NO_ERROR);
+    EXPECT_NE(sessionStorage.FindByResumptionId(vectors[0].resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+    EXPECT_EQ(sessionStorage.Save(vectors[0].node, vectors[0].resumptionId, sharedSecret, chip::CATValues{}), CHIP_NO_ERROR);
+#if CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+    // Neither the index nor the states are read.
+    EXPECT_EQ(storage.mReads, 0u);
+#endif // CHIP_CONFIG_SESSION_RESUMPTION_INDEX_CACHE
+
+    // The index in storage matches: every node is found by another instance.
+    chip::SimpleSessionResumptionStorage reloadedSessionStorage;
+    reloadedSessionStorage.Init(&storage);
+    for (auto & vector : vectors)
+    {
+        EXPECT_EQ(reloadedSessionStorage.FindByResumptionId(vector.resumptionId, outNode, outSharedSecret, outCats),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(vector.node, outNode);
+    }
+}
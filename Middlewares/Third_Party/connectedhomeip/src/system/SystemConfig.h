@@ -512,6 +512,19 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_TIMER_HEAP
+ *
+ *  @brief
+ *      Use (1) or do not use (0) a TimerHeap, instead of a TimerList, to hold the active timers of LayerImplFreeRTOS.
+ *
+ *      Starting and cancelling a timer then costs O(log N) rather than O(N) in the number of active timers, for a few more
+ *      bytes per timer and one pointer per 2 timers of CHIP_SYSTEM_CONFIG_NUM_TIMERS.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_TIMER_HEAP
+#define CHIP_SYSTEM_CONFIG_TIMER_HEAP 0
+#endif /* CHIP_SYSTEM_CONFIG_TIMER_HEAP */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
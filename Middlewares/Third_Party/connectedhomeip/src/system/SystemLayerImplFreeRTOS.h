@@ -55,8 +55,14 @@ private:
 
     CHIP_ERROR StartPlatformTimer(System::Clock::Timeout aDelay);
 
-    TimerPool<TimerList::Node> mTimerPool;
-    TimerList mTimerList;
+#if CHIP_SYSTEM_CONFIG_TIMER_HEAP
+    using ActiveTimerList = TimerHeap<>;
+#else
+    using ActiveTimerList = TimerList;
+#endif // CHIP_SYSTEM_CONFIG_TIMER_HEAP
+
+    TimerPool<ActiveTimerList::Node> mTimerPool;
+    ActiveTimerList mTimerList;
     bool mHandlingTimerComplete; // true while handling any timer completion
     ObjectLifeCycle mLayerState;
 };
@@ -271,6 +271,15 @@ size_t PacketBuffer::MaxDataLength() const
     return static_cast<size_t>(AllocSize() - ReservedSize());
 }
 
+bool PacketBuffer::HasInlinePayload() const
+{
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    return (PBUF_STRUCT_DATA_CONTIGUOUS(this)) != 0;
+#else
+    return true;
+#endif
+}
+
 size_t PacketBuffer::AvailableDataLength() const
 {
     return (this->MaxDataLength() - this->DataLength());
@@ -262,6 +262,16 @@ public:
      */
     bool HasChainedBuffer() const { return ChainedBuffer() != nullptr; }
 
+    /**
+     * Determine whether the payload of the current buffer is stored inline, right after the buffer structure.
+     *
+     *  @note This is always the case unless the buffer wraps a LwIP pbuf referencing external memory (e.g. PBUF_REF or
+     *        PBUF_ROM), which may be read-only.
+     *
+     *  @return \c true if the payload is stored inline.
+     */
+    bool HasInlinePayload() const;
+
     /**
      * Add the given packet buffer to the end of the buffer chain, adjusting the total length of each buffer in the chain
      * accordingly.
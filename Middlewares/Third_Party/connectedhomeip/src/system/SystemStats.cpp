@@ -55,6 +55,9 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
     "Exchange contexts",
     "Unsolicited message handlers",
     "Platform events",
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    "Decrypt copy buffers",
+#endif
 };
 
 count_t sResourcesInUse[kNumEntries];
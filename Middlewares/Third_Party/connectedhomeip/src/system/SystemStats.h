@@ -65,6 +65,9 @@ enum
     kExchangeMgr_NumContexts,
     kExchangeMgr_NumUMHandlers,
     kPlatformMgr_NumEvents,
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    kTransport_NumDecryptCopyBufs,
+#endif
     kNumEntries
 };
 
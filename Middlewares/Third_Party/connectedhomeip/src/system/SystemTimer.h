@@ -28,6 +28,7 @@
 #include <system/SystemConfig.h>
 
 // Include dependent headers
+#include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/Pool.h>
 
@@ -189,6 +190,273 @@ private:
     Node * mEarliestTimer;
 };
 
+/**
+ * Timers ordered by expiration time in a binary heap, indexed by callback and app state in a hash table.
+ *
+ * It provides the operations of TimerList used by LayerImplFreeRTOS. Adding a timer and removing the earliest one take
+ * O(log N) instead of O(N), and finding or removing a timer by its callback and app state takes O(1) on average instead of
+ * O(N). As with TimerList, timers with the same expiration time expire in the order they were added.
+ *
+ * @tparam N  Maximum number of timers.
+ */
+template <size_t N = CHIP_SYSTEM_CONFIG_NUM_TIMERS>
+class TimerHeap
+{
+    static_assert(N > 0 && N < UINT16_MAX, "The heap positions are 16-bit");
+    static constexpr uint16_t kNotInHeap = UINT16_MAX;
+
+public:
+    class Node : public TimerData
+    {
+    public:
+        Node(Layer & systemLayer, System::Clock::Timestamp awakenTime, TimerCompleteCallback onComplete, void * appState) :
+            TimerData(systemLayer, awakenTime, onComplete, appState)
+        {}
+
+    private:
+        friend class TimerHeap;
+
+        uint32_t mSequence   = 0;
+        uint16_t mHeapIndex  = kNotInHeap;
+        Node * mNextInBucket = nullptr;
+    };
+
+    TimerHeap() = default;
+
+    TimerHeap(const TimerHeap &)             = delete;
+    TimerHeap & operator=(const TimerHeap &) = delete;
+
+    /**
+     * Add a timer to the heap
+     *
+     * @return  The new earliest timer. If this is the newly added timer, that implies it is earlier than any existing timer.
+     */
+    Node * Add(Node * add)
+    {
+        VerifyOrDie(add->mHeapIndex == kNotInHeap && mSize < N);
+
+        add->mSequence  = mNextSequence++;
+        add->mHeapIndex = static_cast<uint16_t>(mSize);
+        mHeap[mSize++]  = add;
+        SiftUp(add->mHeapIndex);
+
+        Node *& bucket     = mBuckets[Bucket(add->GetCallback().GetOnComplete(), add->GetCallback().GetAppState())];
+        add->mNextInBucket = bucket;
+        bucket             = add;
+
+        return mHeap[0];
+    }
+
+    /**
+     * Remove the given timer from the heap, if present. It is not an error for the timer not to be present.
+     *
+     * @return  The new earliest timer, or nullptr if the heap is empty.
+     */
+    Node * Remove(Node * remove)
+    {
+        if (remove != nullptr && remove->mHeapIndex < mSize && mHeap[remove->mHeapIndex] == remove)
+        {
+            RemoveAt(remove->mHeapIndex);
+        }
+        return Earliest();
+    }
+
+    /**
+     * Remove the earliest timer with the given properties, if present. It is not an error for no such timer to be present.
+     *
+     * @return  The removed timer, or nullptr if the heap contains no matching timer.
+     */
+    Node * Remove(TimerCompleteCallback onComplete, void * appState)
+    {
+        Node * timer = Find(onComplete, appState);
+        return (timer != nullptr) ? RemoveAt(timer->mHeapIndex) : nullptr;
+    }
+
+    /**
+     * Remove and return the earliest timer.
+     *
+     * @return  The earliest timer, or nullptr if the heap is empty.
+     */
+    Node * PopEarliest() { return (mSize > 0) ? RemoveAt(0) : nullptr; }
+
+    /**
+     * Remove and return the earliest timer, provided it expires earlier than the given time @a t.
+     *
+     * @return  The earliest timer expiring before @a t, or nullptr if there is no such timer.
+     */
+    Node * PopIfEarlier(Clock::Timestamp t) { return (mSize > 0 && mHeap[0]->AwakenTime() < t) ? RemoveAt(0) : nullptr; }
+
+    /**
+     * Get the earliest timer.
+     *
+     * @return  The earliest timer, or nullptr if there are no timers.
+     */
+    Node * Earliest() const { return (mSize > 0) ? mHeap[0] : nullptr; }
+
+    /**
+     * Test whether there are any timers.
+     */
+    bool Empty() const { return mSize == 0; }
+
+    /**
+     * Remove all timers.
+     */
+    void Clear()
+    {
+        for (size_t i = 0; i < mSize; i++)
+        {
+            mHeap[i]->mHeapIndex    = kNotInHeap;
+            mHeap[i]->mNextInBucket = nullptr;
+        }
+        for (auto & bucket : mBuckets)
+        {
+            bucket = nullptr;
+        }
+        mSize = 0;
+    }
+
+    /**
+     * Find the timer with the given properties, if present, and return its remaining time
+     *
+     * @return The remaining time on this particular timer or 0 if not found.
+     */
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState) const
+    {
+        Node * timer = Find(aOnComplete, aAppState);
+        if (timer != nullptr)
+        {
+            Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+
+            if (currentTime < timer->AwakenTime())
+            {
+                return Clock::Timeout(timer->AwakenTime() - currentTime);
+            }
+        }
+        return Clock::kZero;
+    }
+
+private:
+    // Power of two with at most 2 timers per bucket when the heap is full
+    static constexpr size_t BucketCount()
+    {
+        size_t count = 1;
+        while (count * 2 < N)
+        {
+            count *= 2;
+        }
+        return count;
+    }
+    static constexpr size_t kBucketCount = BucketCount();
+
+    static size_t Bucket(TimerCompleteCallback onComplete, void * appState)
+    {
+        // The low bits of the pointers are mostly alignment: mix in the higher ones.
+        uintptr_t hash = reinterpret_cast<uintptr_t>(appState) ^ (reinterpret_cast<uintptr_t>(onComplete) << 3);
+        hash ^= hash >> 4;
+        hash ^= hash >> 9;
+        hash ^= hash >> 16;
+        return static_cast<size_t>(hash & (kBucketCount - 1));
+    }
+
+    // Expiration order, with the timers added first expiring first when they have the same expiration time.
+    static bool Earlier(const Node * a, const Node * b)
+    {
+        if (a->AwakenTime() != b->AwakenTime())
+        {
+            return a->AwakenTime() < b->AwakenTime();
+        }
+        return static_cast<int32_t>(a->mSequence - b->mSequence) < 0;
+    }
+
+    Node * Find(TimerCompleteCallback onComplete, void * appState) const
+    {
+        Node * found = nullptr;
+        for (Node * timer = mBuckets[Bucket(onComplete, appState)]; timer != nullptr; timer = timer->mNextInBucket)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState &&
+                (found == nullptr || Earlier(timer, found)))
+            {
+                found = timer;
+            }
+        }
+        return found;
+    }
+
+    Node * RemoveAt(size_t index)
+    {
+        Node * remove = mHeap[index];
+
+        Node ** link = &mBuckets[Bucket(remove->GetCallback().GetOnComplete(), remove->GetCallback().GetAppState())];
+        while (*link != remove)
+        {
+            link = &(*link)->mNextInBucket;
+        }
+        *link = remove->mNextInBucket;
+
+        mSize--;
+        if (index != mSize)
+        {
+            Place(mHeap[mSize], index);
+            if (!SiftUp(index))
+            {
+                SiftDown(index);
+            }
+        }
+
+        remove->mHeapIndex    = kNotInHeap;
+        remove->mNextInBucket = nullptr;
+        return remove;
+    }
+
+    void Place(Node * timer, size_t index)
+    {
+        mHeap[index]      = timer;
+        timer->mHeapIndex = static_cast<uint16_t>(index);
+    }
+
+    bool SiftUp(size_t index)
+    {
+        Node * timer = mHeap[index];
+        size_t start = index;
+        while (index > 0 && Earlier(timer, mHeap[(index - 1) / 2]))
+        {
+            Place(mHeap[(index - 1) / 2], index);
+            index = (index - 1) / 2;
+        }
+        Place(timer, index);
+        return index != start;
+    }
+
+    void SiftDown(size_t index)
+    {
+        Node * timer = mHeap[index];
+        for (;;)
+        {
+            size_t child = 2 * index + 1;
+            if (child >= mSize)
+            {
+                break;
+            }
+            if (child + 1 < mSize && Earlier(mHeap[child + 1], mHeap[child]))
+            {
+                child++;
+            }
+            if (!Earlier(mHeap[child], timer))
+            {
+                break;
+            }
+            Place(mHeap[child], index);
+            index = child;
+        }
+        Place(timer, index);
+    }
+
+    Node * mHeap[N];
+    Node * mBuckets[kBucketCount] = {};
+    size_t mSize                  = 0;
+    uint32_t mNextSequence        = 0;
+};
+
 /**
  * ObjectPool wrapper that keeps System Timer statistics.
  */
@@ -0,0 +1,134 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Compares the cost of starting and cancelling timers held in a TimerList and in a TimerHeap,
+ *      with 8, 64 and 512 active timers. This is a standalone host tool, not a unit test: the
+ *      timers expire in the same order in both, which TestSystemTimer checks.
+ */
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <vector>
+
+#include <system/SystemLayerImpl.h>
+#include <system/SystemTimer.h>
+
+namespace {
+
+using namespace chip::System;
+
+constexpr size_t kMaxTimers     = 512;
+constexpr size_t kTimerCounts[] = { 8, 64, kMaxTimers };
+constexpr size_t kOperations    = 20000;
+
+struct Result
+{
+    double mStartNs;
+    double mCancelNs;
+};
+
+void OnTimer(Layer * layer, void * appState) {}
+
+template <class Timers>
+Result RunOperations(Timers & timers, size_t count, Layer & layer)
+{
+    using Node = typename Timers::Node;
+    struct Storage
+    {
+        alignas(Node) unsigned char mBytes[sizeof(Node)];
+    };
+    using Clock     = std::chrono::steady_clock;
+    using Nanosecs  = std::chrono::duration<double, std::nano>;
+    uint32_t seed   = 1;
+    auto nextRandom = [&seed] {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 8) % 100000;
+    };
+
+    // Each timer is its own app state, and is constructed again in place when it is started again.
+    std::vector<Storage> storage(count);
+    Node * nodes = reinterpret_cast<Node *>(storage.data());
+    for (size_t i = 0; i < count; i++)
+    {
+        timers.Add(new (&nodes[i]) Node(layer, chip::System::Clock::Timestamp(nextRandom()), OnTimer, &nodes[i]));
+    }
+
+    Result result;
+
+    // Start a running timer again, as LayerImplFreeRTOS::StartTimer does: cancel it, then add it with its new expiration time.
+    auto begin = Clock::now();
+    for (size_t op = 0; op < kOperations; op++)
+    {
+        void * appState = &nodes[nextRandom() % count];
+        Node * timer    = timers.Remove(OnTimer, appState);
+        timer->~Node();
+        timers.Add(new (timer) Node(layer, chip::System::Clock::Timestamp(nextRandom()), OnTimer, appState));
+    }
+    result.mStartNs = Nanosecs(Clock::now() - begin).count() / kOperations;
+
+    while (timers.PopEarliest() != nullptr)
+    {
+    }
+
+    // Cancel every timer, in another order than they expire, then add them back for the next round.
+    Nanosecs cancelTime(0);
+    size_t rounds = kOperations / count;
+    for (size_t round = 0; round < rounds; round++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            timers.Add(&nodes[i]);
+        }
+        begin = Clock::now();
+        for (size_t i = 0; i < count; i++)
+        {
+            timers.Remove(OnTimer, &nodes[(i * 7919) % count]);
+        }
+        cancelTime += Clock::now() - begin;
+    }
+    result.mCancelNs = cancelTime.count() / static_cast<double>(rounds * count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        nodes[i].~Node();
+    }
+    return result;
+}
+
+} // namespace
+
+int main()
+{
+    LayerImpl layer;
+
+    for (size_t count : kTimerCounts)
+    {
+        TimerList list;
+        static TimerHeap<kMaxTimers> heap;
+
+        Result listResult = RunOperations(list, count, layer);
+        Result heapResult = RunOperations(heap, count, layer);
+
+        printf("%3u timers: start %7.1f ns with a TimerList, %7.1f ns with a TimerHeap; cancel %7.1f ns, %7.1f ns\n",
+               static_cast<unsigned>(count), listResult.mStartNs, heapResult.mStartNs, listResult.mCancelNs, heapResult.mCancelNs);
+    }
+    return 0;
+}
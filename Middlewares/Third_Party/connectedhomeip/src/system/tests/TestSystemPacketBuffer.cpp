@@ -596,6 +596,22 @@ TEST_F(TestSystemPacketBuffer, CheckHasChainedBuffer)
     }
 }
 
+/**
+ *  Test PacketBuffer::HasInlinePayload() function.
+ *
+ *  Description: Buffers allocated by PacketBufferHandle::New() always store their payload inline, whatever their reserved
+ *               size, so that they can be written in place (e.g. decrypted in place by SecureMessageCodec::Decrypt).
+ */
+TEST_F(TestSystemPacketBuffer, CheckHasInlinePayload)
+{
+    for (auto & config : configurations)
+    {
+        PrepareTestBuffer(&config);
+        EXPECT_TRUE(config.handle->HasInlinePayload());
+        config.handle = nullptr;
+    }
+}
+
 /**
  *  Test PacketBuffer::AddToEnd() function.
  *
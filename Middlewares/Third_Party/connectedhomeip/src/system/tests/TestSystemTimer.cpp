@@ -24,6 +24,7 @@
  */
 
 #include <errno.h>
+#include <new>
 #include <stdint.h>
 #include <string.h>
 
@@ -564,6 +565,165 @@ TEST_F(TestSystemTimer, CheckTimerPool)
     EXPECT_TRUE(SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumTimers, 4));
 }
 
+// Test TimerHeap against the same sequence of operations as TimerList.
+TEST_F(TestSystemTimer, CheckTimerHeap)
+{
+    using Heap  = TimerHeap<8>;
+    using Timer = Heap::Node;
+    struct TestState
+    {
+        static void Increment(Layer * layer, void * state) { ++*static_cast<int *>(state); }
+        static void Reset(Layer * layer, void * state) { *static_cast<int *>(state) = 0; }
+    };
+    int state = 0;
+
+    using namespace Clock::Literals;
+    Timer timer0(mLayer, 111_ms, TestState::Increment, &state);
+    Timer timer1(mLayer, 100_ms, TestState::Increment, nullptr);
+    Timer timer2(mLayer, 202_ms, TestState::Reset, &state);
+    Timer timer3(mLayer, 303_ms, TestState::Increment, this);
+
+    Heap heap;
+    EXPECT_EQ(heap.Remove(nullptr), nullptr);
+    EXPECT_EQ(heap.Remove(nullptr, nullptr), nullptr);
+    EXPECT_EQ(heap.PopEarliest(), nullptr);
+    EXPECT_EQ(heap.PopIfEarlier(500_ms), nullptr);
+    EXPECT_EQ(heap.Earliest(), nullptr);
+    EXPECT_TRUE(heap.Empty());
+
+    EXPECT_EQ(heap.Add(&timer0), &timer0); // heap: () → (0) returns: 0
+    EXPECT_EQ(heap.PopIfEarlier(10_ms), nullptr);
+    EXPECT_EQ(heap.Earliest(), &timer0);
+    EXPECT_FALSE(heap.Empty());
+
+    EXPECT_EQ(heap.Add(&timer1), &timer1); // heap: (0) → (1 0) returns: 1
+    EXPECT_EQ(heap.Add(&timer2), &timer1); // heap: (1 0) → (1 0 2) returns: 1
+    EXPECT_EQ(heap.Add(&timer3), &timer1); // heap: (1 0 2) → (1 0 2 3) returns: 1
+
+    EXPECT_EQ(heap.Remove(&timer1), &timer0);                      // heap: (1 0 2 3) → (0 2 3) returns: 0
+    EXPECT_EQ(heap.Remove(&timer1), &timer0);                      // not present
+    EXPECT_EQ(heap.Remove(TestState::Increment, nullptr), nullptr); // timer1 is no longer present
+    EXPECT_EQ(heap.Remove(TestState::Reset, &state), &timer2);     // heap: (0 2 3) → (0 3) returns: 2
+    EXPECT_EQ(heap.Earliest(), &timer0);
+    EXPECT_EQ(heap.GetRemainingTime(TestState::Reset, &state), Clock::kZero);
+
+    EXPECT_EQ(heap.PopEarliest(), &timer0);        // heap: (0 3) → (3) returns: 0
+    EXPECT_EQ(heap.PopIfEarlier(10_ms), nullptr);  // heap: (3) → (3) returns: nullptr
+    EXPECT_EQ(heap.PopIfEarlier(500_ms), &timer3); // heap: (3) → () returns: 3
+    EXPECT_TRUE(heap.Empty());
+
+    EXPECT_EQ(heap.Add(&timer3), &timer3); // heap: () → (3) returns: 3
+    heap.Clear();                          // heap: (3) → ()
+    EXPECT_TRUE(heap.Empty());
+    EXPECT_EQ(heap.Remove(TestState::Increment, this), nullptr);
+
+    // Timers expiring at the same time expire in the order they were added, and the earliest of the timers with the same
+    // callback and app state is removed first.
+    Timer same[] = {
+        { mLayer, 50_ms, TestState::Increment, &state }, { mLayer, 50_ms, TestState::Reset, &state },
+        { mLayer, 50_ms, TestState::Increment, nullptr }, { mLayer, 40_ms, TestState::Increment, &state },
+        { mLayer, 50_ms, TestState::Increment, this },
+    };
+    for (auto & timer : same)
+    {
+        heap.Add(&timer);
+    }
+    EXPECT_EQ(heap.Remove(TestState::Increment, &state), &same[3]);
+    EXPECT_EQ(heap.PopEarliest(), &same[0]);
+    EXPECT_EQ(heap.PopEarliest(), &same[1]);
+    EXPECT_EQ(heap.PopEarliest(), &same[2]);
+    EXPECT_EQ(heap.PopEarliest(), &same[4]);
+    EXPECT_EQ(heap.PopEarliest(), nullptr);
+
+    // Fill the heap, then remove the timers in another order than they expire.
+    Timer full[] = {
+        { mLayer, 80_ms, TestState::Increment, &full[0] }, { mLayer, 10_ms, TestState::Increment, &full[1] },
+        { mLayer, 70_ms, TestState::Increment, &full[2] }, { mLayer, 20_ms, TestState::Increment, &full[3] },
+        { mLayer, 60_ms, TestState::Increment, &full[4] }, { mLayer, 30_ms, TestState::Increment, &full[5] },
+        { mLayer, 50_ms, TestState::Increment, &full[6] }, { mLayer, 40_ms, TestState::Increment, &full[7] },
+    };
+    for (auto & timer : full)
+    {
+        heap.Add(&timer);
+    }
+    EXPECT_EQ(heap.Remove(TestState::Increment, &full[5]), &full[5]);
+    EXPECT_EQ(heap.Remove(&full[1]), &full[3]);
+    EXPECT_EQ(heap.Remove(TestState::Increment, &full[0]), &full[0]);
+    Timer * expected[] = { &full[3], &full[7], &full[6], &full[4], &full[2] };
+    for (Timer * timer : expected)
+    {
+        EXPECT_EQ(heap.PopEarliest(), timer);
+    }
+    EXPECT_TRUE(heap.Empty());
+}
+
+namespace {
+
+void OnTimerHeapTimer(Layer * layer, void * appState) {}
+
+// Adds kTimerCount timers with pseudo-random expiration times, starts random ones again as LayerImplFreeRTOS::StartTimer
+// does (cancel it, then add it with its new expiration time), and records the order in which they expire.
+template <class Timers, size_t kTimerCount>
+void RunTimerOperations(Layer & layer, Timers & timers, size_t (&expirationOrder)[kTimerCount])
+{
+    using Node = typename Timers::Node;
+    struct Storage
+    {
+        alignas(Node) unsigned char mBytes[sizeof(Node)];
+    };
+    uint32_t seed   = 1;
+    auto nextRandom = [&seed] {
+        seed = seed * 1103515245u + 12345u;
+        return Clock::Timestamp((seed >> 8) % 100000);
+    };
+
+    // Each timer is its own app state, and is constructed again in place when it is started again.
+    Storage storage[kTimerCount];
+    Node * nodes = reinterpret_cast<Node *>(storage);
+    for (size_t i = 0; i < kTimerCount; i++)
+    {
+        timers.Add(new (&nodes[i]) Node(layer, nextRandom(), OnTimerHeapTimer, &nodes[i]));
+    }
+
+    for (size_t op = 0; op < 20 * kTimerCount; op++)
+    {
+        void * appState = &nodes[nextRandom().count() % kTimerCount];
+        Node * timer    = timers.Remove(OnTimerHeapTimer, appState);
+        ASSERT_EQ(timer, appState);
+        timer->~Node();
+        timers.Add(new (timer) Node(layer, nextRandom(), OnTimerHeapTimer, appState));
+    }
+
+    for (size_t i = 0; i < kTimerCount; i++)
+    {
+        Node * timer = timers.PopEarliest();
+        ASSERT_NE(timer, nullptr);
+        expirationOrder[i] = static_cast<size_t>(timer - nodes);
+        timer->~Node();
+    }
+    EXPECT_TRUE(timers.Empty());
+}
+
+} // namespace
+
+// Test that TimerHeap expires timers in the same order as TimerList after the same sequence of operations.
+TEST_F(TestSystemTimer, CheckTimerHeapMatchesTimerList)
+{
+    constexpr size_t kTimerCount = 64;
+    size_t listOrder[kTimerCount];
+    size_t heapOrder[kTimerCount];
+
+    TimerList list;
+    TimerHeap<kTimerCount> heap;
+    RunTimerOperations(mLayer, list, listOrder);
+    RunTimerOperations(mLayer, heap, heapOrder);
+
+    for (size_t i = 0; i < kTimerCount; i++)
+    {
+        EXPECT_EQ(listOrder[i], heapOrder[i]);
+    }
+}
+
 TEST_F(TestSystemTimer, ExtendTimerToTest)
 {
     if (!LayerEvents<LayerImpl>::HasServiceEvents())
@@ -27,6 +27,7 @@
 
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
+#include <system/SystemStats.h>
 #include <transport/SecureMessageCodec.h>
 
 namespace chip {
@@ -58,24 +59,11 @@ CHIP_ERROR Encrypt(const CryptoContext & context, CryptoContext::ConstNonceView
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
-                   const PacketHeader & packetHeader, System::PacketBufferHandle & msg)
-{
-    ReturnErrorCodeIf(msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-
-    uint8_t * data = msg->Start();
-    size_t len     = msg->DataLength();
-
-    PacketBufferHandle origMsg;
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    /* This is a workaround for the case where PacketBuffer payload is not
-        allocated as an inline buffer to PacketBuffer structure */
-    origMsg = std::move(msg);
-    msg     = PacketBufferHandle::New(len);
-    VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
-    msg->SetDataLength(len);
-#endif
+namespace {
 
+CHIP_ERROR DecryptPayload(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
+                          const PacketHeader & packetHeader, const uint8_t * data, size_t len, System::PacketBufferHandle & msg)
+{
     uint16_t footerLen = packetHeader.MICTagLength();
     VerifyOrReturnError(footerLen <= len, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
@@ -94,6 +82,37 @@ CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView
     return CHIP_NO_ERROR;
 }
 
+} // namespace
+
+CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
+                   const PacketHeader & packetHeader, System::PacketBufferHandle & msg)
+{
+    ReturnErrorCodeIf(msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint8_t * data = msg->Start();
+    size_t len           = msg->DataLength();
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    /* The payload of a pbuf may not be allocated inline to the PacketBuffer structure (e.g. PBUF_REF / PBUF_ROM), in
+        which case it may not be writable. Such buffers, and buffers that are shared or chained, are decrypted into a
+        new buffer. Everything else is decrypted in place, so that it does not take a second buffer from the pool. */
+    if (!msg.HasSoleOwnership() || msg->HasChainedBuffer() || !msg->HasInlinePayload())
+    {
+        PacketBufferHandle origMsg = std::move(msg);
+        msg                        = PacketBufferHandle::New(len);
+        VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
+        msg->SetDataLength(len);
+
+        SYSTEM_STATS_INCREMENT(chip::System::Stats::kTransport_NumDecryptCopyBufs);
+        CHIP_ERROR err = DecryptPayload(context, nonce, payloadHeader, packetHeader, data, len, msg);
+        SYSTEM_STATS_DECREMENT(chip::System::Stats::kTransport_NumDecryptCopyBufs);
+        return err;
+    }
+#endif
+
+    return DecryptPayload(context, nonce, payloadHeader, packetHeader, data, len, msg);
+}
+
 } // namespace SecureMessageCodec
 
 } // namespace chip
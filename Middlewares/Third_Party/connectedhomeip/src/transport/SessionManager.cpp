@@ -33,6 +33,7 @@
 #include <app/util/basic-types.h>
 #include <credentials/GroupDataProvider.h>
 #include <inttypes.h>
+#include <lib/core/CHIPEncoding.h>
 #include <lib/core/CHIPKeyIds.h>
 #include <lib/core/Global.h>
 #include <lib/support/CodeUtils.h>
@@ -1055,6 +1056,79 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     }
 }
 
+/**
+ * Helper function to check whether a groupcast message is addressed to the group of the given group session,
+ * without modifying the message buffer.
+ *
+ * Only the leading part of the packet header, up to and including the destination group id, is copied to the
+ * stack and, if applicable, deobfuscated. Since privacy obfuscation is a stream cipher, deobfuscating a prefix of
+ * the privacy header yields the same bytes as deobfuscating the whole header. This allows rejecting candidate group
+ * keys of other groups sharing the same session id without cloning the message.
+ *
+ * @param[in] partialPacketHeader The partial packet header with non-obfuscated message fields (result of calling DecodeFixed).
+ * @param[in] applyPrivacy Whether to apply privacy deobfuscation
+ * @param[in] msg The received message
+ * @param[in] mac The MAC of the message
+ * @param[in] groupContext The group context to use for privacy key material
+ *
+ * @return true if the destination group id of the message matches the group of the group session
+ */
+static bool GroupKeyDestinationMatch(const PacketHeader & partialPacketHeader, bool applyPrivacy,
+                                     const System::PacketBufferHandle & msg, const MessageAuthenticationCode & mac,
+                                     const Credentials::GroupDataProvider::GroupSession & groupContext)
+{
+    uint8_t header[PacketHeader::kHeaderMinLength + sizeof(NodeId) + sizeof(GroupId)];
+    size_t groupIdOffset = PacketHeader::kHeaderMinLength;
+    if (partialPacketHeader.HasSourceNodeId())
+    {
+        groupIdOffset += sizeof(NodeId);
+    }
+    size_t headerLength = groupIdOffset + sizeof(GroupId);
+    VerifyOrReturnValue(msg->DataLength() >= headerLength, false);
+    memcpy(header, msg->Start(), headerLength);
+
+    if (applyPrivacy)
+    {
+        CryptoContext context(groupContext.keyContext);
+        uint8_t * privacyHeader = partialPacketHeader.PrivacyHeader(header);
+        size_t privacyLength    = headerLength - PacketHeader::kPrivacyHeaderOffset;
+        VerifyOrReturnValue(CHIP_NO_ERROR ==
+                                context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac),
+                            false);
+    }
+
+    return Encoding::LittleEndian::Get16(&header[groupIdOffset]) == groupContext.group_id;
+}
+
+/**
+ * Helper function to get a writable copy of a groupcast message for a decryption attempt.
+ *
+ * The message is cloned on the first attempt only. Subsequent attempts (after a failed decryption clobbered the copy)
+ * reuse the buffer of the previous copy, so that trial decryption allocates at most one buffer per message.
+ *
+ * @param[in] msg The received message
+ * @param[in,out] msgCopy The copy of the message, restored to the received message content
+ *
+ * @return true if msgCopy holds a copy of the received message
+ */
+static bool GroupKeyPrepareMessageCopy(const System::PacketBufferHandle & msg, System::PacketBufferHandle & msgCopy)
+{
+    size_t len = msg->DataLength();
+    if (!msgCopy.IsNull() && !msgCopy->HasChainedBuffer())
+    {
+        msgCopy->SetStart(msgCopy->Start() - msgCopy->ReservedSize());
+        if (msgCopy->MaxDataLength() >= len)
+        {
+            memcpy(msgCopy->Start(), msg->Start(), len);
+            msgCopy->SetDataLength(len);
+            return true;
+        }
+    }
+
+    msgCopy = msg.CloneData();
+    return !msgCopy.IsNull();
+}
+
 /**
  * Helper function to implement a single attempt to decrypt a groupcast message
  * using the given group key and privacy setting.
@@ -1158,26 +1232,32 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     VerifyOrReturn(taglen == footerLen);
 
     bool decrypted = false;
+    bool privacy   = partialPacketHeader.HasPrivacyFlag();
     while (!decrypted && iter->Next(groupContext))
     {
-        CryptoContext context(groupContext.keyContext);
-        msgCopy = msg.CloneData();
-        if (msgCopy.IsNull())
+        bool destinationMatch = GroupKeyDestinationMatch(partialPacketHeader, privacy, msg, mac, groupContext);
+#if CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
+        // Try processing the P=1 message again without privacy as a work-around for invalid early-SVE2 nodes.
+        bool destinationMatchWithoutPrivacy =
+            privacy && GroupKeyDestinationMatch(partialPacketHeader, false, msg, mac, groupContext);
+#else
+        bool destinationMatchWithoutPrivacy = false;
+#endif // CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
+
+        if (destinationMatch)
         {
-            ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
-            return;
+            if (!GroupKeyPrepareMessageCopy(msg, msgCopy))
+            {
+                ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
+                return;
+            }
+            decrypted =
+                GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msgCopy, mac, groupContext);
         }
 
-        bool privacy = partialPacketHeader.HasPrivacyFlag();
-        decrypted =
-            GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msgCopy, mac, groupContext);
-
-#if CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
-        if (privacy && !decrypted)
+        if (destinationMatchWithoutPrivacy && !decrypted)
         {
-            // Try processing the P=1 message again without privacy as a work-around for invalid early-SVE2 nodes.
-            msgCopy = msg.CloneData();
-            if (msgCopy.IsNull())
+            if (!GroupKeyPrepareMessageCopy(msg, msgCopy))
             {
                 ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
                 return;
@@ -1185,7 +1265,6 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
             decrypted =
                 GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, false, msgCopy, mac, groupContext);
         }
-#endif // CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
     }
     iter.Release();
 
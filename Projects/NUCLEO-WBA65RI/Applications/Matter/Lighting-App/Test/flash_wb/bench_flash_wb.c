@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    bench_flash_wb.c
+ * @brief   Host benchmark of the flash_wb.c NVM key store
+ ******************************************************************************
+ *
+ * Fills the store with a set of keys, then updates and deletes them in a loop
+ * with a NM_Dump every few updates, as the application does. Reports the time
+ * spent in NM_GetKeyValue, NM_SetKeyValue and NM_DeleteKey, and the amount of
+ * flash programmed and erased per update. For reference, the previous format
+ * erased and programmed the whole 24KB NVM area on every NM_Dump.
+ */
+#include "flash_wb.h"
+#include "flash_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LEGACY_NVM_SIZE (4096 * 6)
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static void key_name(unsigned key, char *name) {
+	snprintf(name, 33, "f/%x/s/%08x", key % 5, key * 2654435761U);
+}
+
+static void bench(unsigned key_count, unsigned value_size, unsigned puts_per_dump, unsigned iterations) {
+	char name[33];
+	uint8_t value[512];
+	uint8_t read[512];
+	size_t size;
+	uint64_t get_ns = 0, put_ns = 0, delete_ns = 0;
+	uint64_t put_max_ns = 0;
+	unsigned gets = 0, puts = 0, deletes = 0, dumps = 0;
+
+	flash_sim_erase_all();
+	NM_Init();
+	for (unsigned key = 0; key < key_count; key++) {
+		key_name(key, name);
+		memset(value, (int) key, value_size);
+		NM_SetKeyValue((char*) value, name, value_size, SECTOR_SECURE);
+	}
+	NM_Dump();
+	flash_sim_process();
+	flash_sim_reset_stats();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		unsigned key = (i * 7919U) % key_count;
+		key_name(key, name);
+
+		uint64_t start = now_ns();
+		NM_GetKeyValue(read, name, sizeof(read), &size, SECTOR_SECURE);
+		get_ns += now_ns() - start;
+		gets++;
+
+		memset(value, (int) i, value_size);
+		start = now_ns();
+		NM_SetKeyValue((char*) value, name, value_size, SECTOR_SECURE);
+		uint64_t elapsed = now_ns() - start;
+		put_ns += elapsed;
+		// the put that compacts the oldest page
+		put_max_ns = (elapsed > put_max_ns) ? elapsed : put_max_ns;
+		puts++;
+
+		if (i % 16 == 15) {
+			start = now_ns();
+			NM_DeleteKey(name, SECTOR_SECURE);
+			delete_ns += now_ns() - start;
+			deletes++;
+			NM_SetKeyValue((char*) value, name, value_size, SECTOR_SECURE);
+			puts++;
+		}
+		if (i % puts_per_dump == puts_per_dump - 1) {
+			NM_Dump();
+			flash_sim_process();
+			dumps++;
+		}
+	}
+	NM_Dump();
+	flash_sim_process();
+	dumps++;
+
+	FlashSim_Stats stats = flash_sim_stats();
+	printf("%5u keys %4u B values, dump every %2u puts: get %6.0f ns  put %6.0f ns (max %6.0f ns)  delete %6.0f ns"
+			"  programmed %7.1f B/put  erased %7.1f B/put (previous format %7.1f B/put)\n", key_count,
+			value_size, puts_per_dump, (double) get_ns / gets, (double) put_ns / puts, (double) put_max_ns, (double) delete_ns / deletes,
+			(double) stats.bytes_programmed / puts, (double) stats.bytes_erased / puts,
+			(double) LEGACY_NVM_SIZE * dumps / puts);
+}
+
+int main(int argc, char **argv) {
+	const char *path = (argc > 1) ? argv[1] : "flash_wb_bench.bin";
+
+	if (flash_sim_open(path) != 0) {
+		return 2;
+	}
+	bench(16, 32, 1, 20000);
+	bench(16, 32, 16, 20000);
+	bench(64, 64, 1, 20000);
+	bench(64, 64, 16, 20000);
+	bench(128, 32, 16, 20000);
+	bench(32, 256, 4, 20000);
+	flash_sim_close();
+	return 0;
+}
@@ -0,0 +1,239 @@
+/**
+ ******************************************************************************
+ * @file    flash_sim.c
+ * @brief   File backed flash simulator, for the flash_wb.c host build
+ ******************************************************************************
+ */
+#define _GNU_SOURCE
+#include "flash_sim.h"
+#include "flash_manager.h"
+#include "cmsis_os2.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define FLASH_SIM_QUADWORD 16U
+
+typedef struct {
+	FM_CallbackNode_t *callback;
+	bool pending;
+} FlashSim_Op;
+
+static int flash_fd = -1;
+static uint8_t *flash_mem;
+static FlashSim_Stats stats;
+static FlashSim_Op pending_op;
+static uint32_t power_fail_count;
+static bool power_fail_armed;
+static bool power_failed;
+static uint32_t op_count;
+
+jmp_buf flash_sim_reset_point;
+
+int flash_sim_open(const char *path) {
+	bool created = (access(path, F_OK) != 0);
+
+	flash_fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (flash_fd < 0) {
+		perror("open");
+		return -1;
+	}
+	if (ftruncate(flash_fd, FLASH_SIM_SIZE) != 0) {
+		perror("ftruncate");
+		return -1;
+	}
+	flash_mem = mmap((void*) FLASH_SIM_BASE, FLASH_SIM_SIZE, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_FIXED_NOREPLACE, flash_fd, 0);
+	if (flash_mem != (uint8_t*) FLASH_SIM_BASE) {
+		perror("mmap");
+		return -1;
+	}
+	if (created) {
+		memset(flash_mem, 0xFF, FLASH_SIM_SIZE);
+	}
+	flash_sim_reset_stats();
+	return 0;
+}
+
+void flash_sim_close(void) {
+	if (flash_mem != NULL) {
+		msync(flash_mem, FLASH_SIM_SIZE, MS_SYNC);
+		munmap(flash_mem, FLASH_SIM_SIZE);
+		flash_mem = NULL;
+	}
+	if (flash_fd >= 0) {
+		close(flash_fd);
+		flash_fd = -1;
+	}
+}
+
+void flash_sim_erase_all(void) {
+	memset(flash_mem, 0xFF, FLASH_SIM_SIZE);
+	pending_op.pending = false;
+	power_failed = false;
+	power_fail_armed = false;
+}
+
+void flash_sim_power_fail_after(uint32_t count) {
+	pending_op.pending = false;
+	power_fail_count = count;
+	power_fail_armed = true;
+	power_failed = false;
+}
+
+void flash_sim_power_restore(void) {
+	power_fail_armed = false;
+	power_failed = false;
+}
+
+bool flash_sim_power_failed(void) {
+	return power_failed;
+}
+
+uint32_t flash_sim_op_count(void) {
+	return op_count;
+}
+
+FlashSim_Stats flash_sim_stats(void) {
+	return stats;
+}
+
+void flash_sim_reset_stats(void) {
+	memset(&stats, 0, sizeof(stats));
+}
+
+uint8_t* flash_sim_memory(void) {
+	return flash_mem;
+}
+
+void flash_sim_system_reset(void) {
+	longjmp(flash_sim_reset_point, 1);
+}
+
+static bool flash_sim_powered(void) {
+	if (power_failed) {
+		return false;
+	}
+	if (power_fail_armed) {
+		if (power_fail_count == 0) {
+			power_failed = true;
+			return false;
+		}
+		power_fail_count--;
+	}
+	return true;
+}
+
+static FM_Cmd_Status_t flash_sim_schedule(FM_CallbackNode_t *CallbackNode) {
+	if (pending_op.pending) {
+		fprintf(stderr, "flash_sim: operation requested while another one is running\n");
+		return FM_ERROR;
+	}
+	pending_op.callback = CallbackNode;
+	pending_op.pending = true;
+	op_count++;
+	return FM_OK;
+}
+
+FM_Cmd_Status_t FM_Write(uint32_t *Src, uint32_t *Dest, int32_t Size, FM_CallbackNode_t *CallbackNode) {
+	uintptr_t dest = (uintptr_t) Dest;
+	size_t size = (size_t) Size * sizeof(uint32_t);
+
+	if ((dest < FLASH_SIM_BASE) || (dest + size > FLASH_SIM_BASE + FLASH_SIM_SIZE)
+			|| (dest % FLASH_SIM_QUADWORD != 0) || ((uintptr_t) Src % sizeof(uint32_t) != 0)) {
+		fprintf(stderr, "flash_sim: invalid write to 0x%lx, %zu bytes\n", (unsigned long) dest, size);
+		stats.program_errors++;
+		return FM_ERROR;
+	}
+	bool was_powered = !power_failed;
+	if (!flash_sim_powered()) {
+		// Power lost during the operation, one time out of two half of the quad-words are programmed
+		size = (was_powered && (op_count & 1)) ? ((size / 2) & ~(size_t) (FLASH_SIM_QUADWORD - 1)) : 0;
+	}
+	if (size > 0) {
+		uint8_t *flash = (uint8_t*) dest;
+		for (size_t offset = 0; offset < size; offset += FLASH_SIM_QUADWORD) {
+			size_t length = (size - offset < FLASH_SIM_QUADWORD) ? size - offset : FLASH_SIM_QUADWORD;
+			for (size_t i = 0; i < FLASH_SIM_QUADWORD; i++) {
+				if (flash[offset + i] != 0xFF) {
+					fprintf(stderr, "flash_sim: quad-word at 0x%lx programmed twice\n",
+							(unsigned long) (dest + offset));
+					stats.program_errors++;
+					break;
+				}
+			}
+			// Partial quad-words are padded with 0xFF by the flash driver
+			memcpy(flash + offset, (const uint8_t*) Src + offset, length);
+		}
+		stats.bytes_programmed += size;
+	}
+	return flash_sim_schedule(CallbackNode);
+}
+
+FM_Cmd_Status_t FM_Erase(uint32_t FirstSect, uint32_t NbrSect, FM_CallbackNode_t *CallbackNode) {
+	uint32_t first = FirstSect;
+
+	if (first + NbrSect > FLASH_SIM_PAGE_COUNT) {
+		fprintf(stderr, "flash_sim: invalid erase of pages %u-%u\n", first, first + NbrSect - 1);
+		return FM_ERROR;
+	}
+	if (flash_sim_powered()) {
+		memset(flash_mem + first * FLASH_SIM_PAGE_SIZE, 0xFF, NbrSect * FLASH_SIM_PAGE_SIZE);
+		stats.bytes_erased += NbrSect * FLASH_SIM_PAGE_SIZE;
+		stats.pages_erased += NbrSect;
+		for (uint32_t page = first; page < first + NbrSect; page++) {
+			stats.page_erase_count[page]++;
+		}
+	}
+	return flash_sim_schedule(CallbackNode);
+}
+
+void flash_sim_process(void) {
+	while (pending_op.pending) {
+		pending_op.pending = false;
+		if (power_failed) {
+			// The device is off, the operation never completes
+			return;
+		}
+		pending_op.callback->Callback(FM_OPERATION_COMPLETE);
+	}
+}
+
+/* Semaphores, the host build is single threaded */
+
+typedef struct {
+	uint32_t count;
+	uint32_t max_count;
+} Semaphore;
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr) {
+	(void) attr;
+	Semaphore *semaphore = malloc(sizeof(Semaphore));
+	semaphore->count = initial_count;
+	semaphore->max_count = max_count;
+	return semaphore;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout) {
+	Semaphore *semaphore = semaphore_id;
+	(void) timeout;
+	if (semaphore->count == 0) {
+		// Nothing else can release it
+		fprintf(stderr, "flash_sim: deadlock on the flash manager semaphore\n");
+		abort();
+	}
+	semaphore->count--;
+	return 0;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id) {
+	Semaphore *semaphore = semaphore_id;
+	if (semaphore->count < semaphore->max_count) {
+		semaphore->count++;
+	}
+	return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file    flash_sim.h
+ * @brief   File backed flash simulator, for the flash_wb.c host build
+ ******************************************************************************
+ *
+ * The simulated flash is mapped at FLASH_SIM_BASE, flash_wb.c is built with
+ * START_NVM_Matter = FLASH_SIM_BASE. It behaves as the STM32WBA flash:
+ * - a page must be erased (all 0xFF) before being programmed,
+ * - programming is done by quad-word, a quad-word is programmed only once.
+ * Flash manager operations complete when flash_sim_process is called, as the
+ * flash manager background process would do.
+ */
+#ifndef FLASH_SIM_H
+#define FLASH_SIM_H
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FLASH_SIM_BASE 0x40000000UL
+#define FLASH_SIM_PAGE_SIZE 8192U
+#define FLASH_SIM_PAGE_COUNT 4U
+#define FLASH_SIM_SIZE (FLASH_SIM_PAGE_SIZE * FLASH_SIM_PAGE_COUNT)
+
+typedef struct {
+	uint64_t bytes_programmed;
+	uint64_t bytes_erased;
+	uint32_t pages_erased;
+	uint32_t page_erase_count[FLASH_SIM_PAGE_COUNT];
+	uint32_t program_errors;
+} FlashSim_Stats;
+
+/* Map the flash image file, created erased if it does not exist */
+int flash_sim_open(const char *path);
+void flash_sim_close(void);
+/* Erase the whole simulated flash */
+void flash_sim_erase_all(void);
+/* Complete the pending flash manager operations */
+void flash_sim_process(void);
+/* Drop every flash operation after the next `count` ones, until flash_sim_power_restore */
+void flash_sim_power_fail_after(uint32_t count);
+void flash_sim_power_restore(void);
+bool flash_sim_power_failed(void);
+/* Number of flash manager operations completed */
+uint32_t flash_sim_op_count(void);
+
+FlashSim_Stats flash_sim_stats(void);
+void flash_sim_reset_stats(void);
+uint8_t *flash_sim_memory(void);
+
+/* NVIC_SystemReset jumps back to flash_sim_reset_point, set with setjmp */
+extern jmp_buf flash_sim_reset_point;
+void flash_sim_system_reset(void) __attribute__((noreturn));
+
+#endif /* FLASH_SIM_H */
@@ -0,0 +1,22 @@
+/**
+ ******************************************************************************
+ * @file    cmsis_os2.h
+ * @brief   Host stub of CMSIS-RTOS2 semaphores, for the flash_wb.c host build
+ ******************************************************************************
+ */
+#ifndef CMSIS_OS2_H
+#define CMSIS_OS2_H
+
+#include <stdint.h>
+
+#define osWaitForever 0xFFFFFFFFU
+
+typedef void * osSemaphoreId_t;
+typedef struct osSemaphoreAttr osSemaphoreAttr_t;
+typedef int32_t osStatus_t;
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t * attr);
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout);
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+
+#endif /* CMSIS_OS2_H */
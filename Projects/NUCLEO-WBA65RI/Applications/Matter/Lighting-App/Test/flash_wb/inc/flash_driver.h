@@ -0,0 +1,10 @@
+/**
+ ******************************************************************************
+ * @file    flash_driver.h
+ * @brief   Host stub of the flash driver, for the flash_wb.c host build
+ ******************************************************************************
+ */
+#ifndef FLASH_DRIVER_H
+#define FLASH_DRIVER_H
+
+#endif /* FLASH_DRIVER_H */
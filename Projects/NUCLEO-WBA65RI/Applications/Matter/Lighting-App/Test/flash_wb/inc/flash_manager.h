@@ -0,0 +1,48 @@
+/**
+ ******************************************************************************
+ * @file    flash_manager.h
+ * @brief   Host stub of the flash manager, for the flash_wb.c host build
+ ******************************************************************************
+ */
+#ifndef FLASH_MANAGER_H
+#define FLASH_MANAGER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _tListNode
+{
+  struct _tListNode * next;
+  struct _tListNode * prev;
+} tListNode;
+
+typedef enum
+{
+  FM_OK,
+  FM_BUSY,
+  FM_ERROR
+} FM_Cmd_Status_t;
+
+typedef enum
+{
+  FM_OPERATION_COMPLETE,
+  FM_OPERATION_AVAILABLE
+} FM_FlashOp_Status_t;
+
+typedef struct FM_CallbackNode
+{
+  tListNode NodeList;
+  void (*Callback)(FM_FlashOp_Status_t Status);
+} FM_CallbackNode_t;
+
+FM_Cmd_Status_t FM_Write(uint32_t *Src, uint32_t *Dest, int32_t Size, FM_CallbackNode_t *CallbackNode);
+FM_Cmd_Status_t FM_Erase(uint32_t FirstSect, uint32_t NbrSect, FM_CallbackNode_t *CallbackNode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLASH_MANAGER_H */
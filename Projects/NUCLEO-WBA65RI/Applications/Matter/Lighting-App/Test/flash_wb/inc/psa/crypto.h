@@ -0,0 +1,15 @@
+/**
+ ******************************************************************************
+ * @file    crypto.h
+ * @brief   Host stub of the PSA crypto API, for the flash_wb.c host build
+ ******************************************************************************
+ */
+#ifndef PSA_CRYPTO_H
+#define PSA_CRYPTO_H
+
+#include <stdint.h>
+
+typedef int32_t psa_status_t;
+typedef uint32_t psa_key_id_t;
+
+#endif /* PSA_CRYPTO_H */
@@ -0,0 +1,12 @@
+/**
+ ******************************************************************************
+ * @file    stm32wbaxx.h
+ * @brief   Host stub of the device header, for the flash_wb.c host build
+ ******************************************************************************
+ */
+#ifndef STM32WBAXX_H
+#define STM32WBAXX_H
+
+#include "stm32wbaxx_hal.h"
+
+#endif /* STM32WBAXX_H */
@@ -0,0 +1,22 @@
+/**
+ ******************************************************************************
+ * @file    stm32wbaxx_hal.h
+ * @brief   Host stub of the HAL, for the flash_wb.c host build
+ ******************************************************************************
+ */
+#ifndef STM32WBAXX_HAL_H
+#define STM32WBAXX_HAL_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "flash_sim.h"
+
+#define FLASH_BASE FLASH_SIM_BASE
+#define FLASH_PAGE_SIZE FLASH_SIM_PAGE_SIZE
+
+#define APP_DBG(...) do { printf(__VA_ARGS__); printf("\n"); } while (0)
+
+#define NVIC_SystemReset() flash_sim_system_reset()
+
+#endif /* STM32WBAXX_HAL_H */
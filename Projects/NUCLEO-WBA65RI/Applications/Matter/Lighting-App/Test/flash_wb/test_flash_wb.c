@@ -0,0 +1,462 @@
+/**
+ ******************************************************************************
+ * @file    test_flash_wb.c
+ * @brief   Host tests of the flash_wb.c NVM key store
+ ******************************************************************************
+ */
+#include "flash_wb.h"
+#include "flash_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef NVM_PAGE_COUNT
+#define NVM_PAGE_COUNT 3
+#endif
+
+#define TEST_KEY_COUNT 64
+#define TEST_VALUE_MAX 96
+#define TEST_HISTORY_MAX 32
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while (0)
+
+static unsigned failures;
+
+/* Model of the expected content of the store */
+typedef struct {
+	bool present;
+	uint8_t size;
+	uint8_t value[TEST_VALUE_MAX];
+} KeyModel;
+
+static KeyModel model[TEST_KEY_COUNT];
+
+static void key_name(unsigned key, char *name) {
+	// Names shaped as the Matter keys "f/1/k/..."
+	snprintf(name, 33, "f/%x/k/%u", key % 5, key);
+}
+
+static void boot(void) {
+	CHECK(NM_Init() == NVM_OK);
+}
+
+static void dump(void) {
+	NM_Dump();
+	flash_sim_process();
+}
+
+static void set_key(unsigned key, uint8_t size, uint8_t seed) {
+	char name[33];
+	key_name(key, name);
+	for (uint8_t i = 0; i < size; i++) {
+		model[key].value[i] = (uint8_t) (seed + i * 7);
+	}
+	model[key].size = size;
+	model[key].present = true;
+	CHECK(NM_SetKeyValue((char*) model[key].value, name, size, SECTOR_SECURE) == NVM_OK);
+}
+
+static void delete_key(unsigned key) {
+	char name[33];
+	key_name(key, name);
+	CHECK(NM_DeleteKey(name, SECTOR_SECURE) == (model[key].present ? NVM_OK : NVM_KEY_NOT_FOUND));
+	model[key].present = false;
+}
+
+static bool key_matches(unsigned key, const KeyModel *expected) {
+	char name[33];
+	uint8_t value[512];
+	size_t size = 0;
+
+	key_name(key, name);
+	NVM_StatusTypeDef status = NM_GetKeyValue(value, name, sizeof(value), &size, SECTOR_SECURE);
+	if (!expected->present) {
+		return (status == NVM_KEY_NOT_FOUND) && (NM_GetKeyExists(name, SECTOR_SECURE) == NVM_KEY_NOT_FOUND);
+	}
+	return (status == NVM_OK) && (size == expected->size) && (memcmp(value, expected->value, size) == 0)
+			&& (NM_GetKeyExists(name, SECTOR_SECURE) == NVM_OK);
+}
+
+static void check_model(void) {
+	for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+		CHECK(key_matches(key, &model[key]));
+	}
+}
+
+static uint8_t* ot_buffer(void) {
+	uint32_t addr = 0;
+	CHECK(NM_GetOtNVMAddr(&addr) == NVM_OK);
+	return (uint8_t*) (uintptr_t) addr;
+}
+
+static void reset_store(void) {
+	flash_sim_erase_all();
+	memset(model, 0, sizeof(model));
+	boot();
+}
+
+static void test_basic(void) {
+	char value[16] = "value";
+	char name[] = "g/fs/c";
+	char read[16];
+	size_t size = 0;
+
+	reset_store();
+	CHECK(NM_GetKeyExists(name, SECTOR_SECURE) == NVM_KEY_NOT_FOUND);
+	CHECK(NM_SetKeyValue(value, name, 6, SECTOR_SECURE) == NVM_OK);
+	CHECK(NM_GetKeyExists(name, SECTOR_SECURE) == NVM_OK);
+	CHECK(NM_GetKeyExists(name, SECTOR_NO_SECURE) == NVM_KEY_NOT_FOUND);
+	CHECK(NM_GetKeyValue(read, name, sizeof(read), &size, SECTOR_SECURE) == NVM_OK);
+	CHECK((size == 6) && (memcmp(read, "value", 6) == 0));
+	CHECK(NM_GetKeyValue(read, name, 5, &size, SECTOR_SECURE) == NVM_BUFFER_TOO_SMALL);
+	CHECK(NM_SetKeyValue(value, name, 513, SECTOR_SECURE) == NVM_BLOCK_SIZE_OVERFLOW);
+	CHECK(NM_SetKeyValue(value, name, 6, SECTOR_DEFAULT) == NVM_WRITE_FAILED);
+
+	// Empty values are valid
+	CHECK(NM_SetKeyValue(value, name, 0, SECTOR_SECURE) == NVM_OK);
+	CHECK(NM_GetKeyValue(read, name, sizeof(read), &size, SECTOR_SECURE) == NVM_OK);
+	CHECK(size == 0);
+	CHECK(NM_DeleteKey(name, SECTOR_SECURE) == NVM_OK);
+	CHECK(NM_DeleteKey(name, SECTOR_SECURE) == NVM_KEY_NOT_FOUND);
+	CHECK(NM_GetKeyExists(name, SECTOR_SECURE) == NVM_KEY_NOT_FOUND);
+
+	// Nothing written in flash before NM_Dump
+	CHECK(flash_sim_stats().bytes_programmed == 0);
+
+	for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+		set_key(key, (uint8_t) (1 + key % TEST_VALUE_MAX), (uint8_t) key);
+	}
+	memset(ot_buffer(), 0x5A, 100);
+	dump();
+	CHECK(flash_sim_stats().bytes_erased == 0);
+	boot();
+	check_model();
+	CHECK(ot_buffer()[0] == 0x5A && ot_buffer()[99] == 0x5A && ot_buffer()[100] == 0xFF);
+}
+
+static void test_dump_programs_new_records(void) {
+	reset_store();
+	for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+		set_key(key, 32, (uint8_t) key);
+	}
+	dump();
+	flash_sim_reset_stats();
+
+	set_key(3, 32, 0x33);
+	dump();
+	FlashSim_Stats stats = flash_sim_stats();
+	CHECK(stats.bytes_erased == 0);
+	CHECK(stats.bytes_programmed <= 64);
+
+	// Same value, nothing to program
+	flash_sim_reset_stats();
+	set_key(3, 32, 0x33);
+	dump();
+	CHECK(flash_sim_stats().bytes_programmed == 0);
+	boot();
+	check_model();
+}
+
+static void test_compaction(void) {
+	reset_store();
+	for (unsigned round = 0; round < 200; round++) {
+		for (unsigned key = 0; key < TEST_KEY_COUNT; key += 1 + round % 3) {
+			set_key(key, (uint8_t) (16 + (key + round) % 80), (uint8_t) (round + key));
+		}
+		if (round % 7 == 3) {
+			delete_key(round % TEST_KEY_COUNT);
+		}
+		if (round % 5 == 0) {
+			dump();
+		}
+		if (round % 50 == 49) {
+			dump();
+			boot();
+		}
+		check_model();
+	}
+	dump();
+	boot();
+	check_model();
+
+	FlashSim_Stats stats = flash_sim_stats();
+	CHECK(stats.program_errors == 0);
+	// Wear is spread over the pages
+	for (unsigned page = 1; page < NVM_PAGE_COUNT; page++) {
+		CHECK(abs((int) stats.page_erase_count[page] - (int) stats.page_erase_count[0]) <= 2);
+	}
+}
+
+static void test_ot_buffer(void) {
+	reset_store();
+	uint8_t *ot = ot_buffer();
+	for (unsigned i = 0; i < OT_NVM_SIZE; i++) {
+		ot[i] = (uint8_t) i;
+	}
+	dump();
+	boot();
+	ot = ot_buffer();
+	for (unsigned i = 0; i < OT_NVM_SIZE; i++) {
+		CHECK(ot[i] == (uint8_t) i);
+	}
+
+	// Only the modified chunk is programmed
+	flash_sim_reset_stats();
+	ot[1000] = 0;
+	dump();
+	CHECK(flash_sim_stats().bytes_programmed <= 544);
+
+	// Erased settings are erased in the store too
+	memset(ot, 0xFF, OT_NVM_SIZE);
+	dump();
+	boot();
+	ot = ot_buffer();
+	for (unsigned i = 0; i < OT_NVM_SIZE; i++) {
+		CHECK(ot[i] == 0xFF);
+	}
+}
+
+static void test_legacy_import(void) {
+	uint8_t *flash = flash_sim_memory();
+	unsigned offset = 0;
+
+	reset_store();
+	// Previous format: name on 32 bytes, value size on 4 bytes, value
+	for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+		char name[33] = { 0 };
+		uint32_t size = 1 + key % TEST_VALUE_MAX;
+		key_name(key, name);
+		memcpy(flash + offset, name, 32);
+		memcpy(flash + offset + 32, &size, sizeof(size));
+		for (uint32_t i = 0; i < size; i++) {
+			model[key].value[i] = flash[offset + 36 + i] = (uint8_t) (key ^ i);
+		}
+		model[key].size = (uint8_t) size;
+		model[key].present = true;
+		offset += 36 + size;
+	}
+	for (unsigned i = 0; i < OT_NVM_SIZE; i += 3) {
+		flash[4096 * 5 + i] = (uint8_t) i;
+	}
+
+	boot();
+	check_model();
+	CHECK(ot_buffer()[0] == 0 && ot_buffer()[1] == 0xFF && ot_buffer()[3] == 3);
+	dump();
+	CHECK(flash_sim_stats().program_errors == 0);
+	boot();
+	check_model();
+	CHECK(ot_buffer()[0] == 0 && ot_buffer()[1] == 0xFF && ot_buffer()[3] == 3);
+}
+
+static void test_legacy_import_too_large(void) {
+	static uint8_t legacy[4096 * 6];
+	uint8_t *flash = flash_sim_memory();
+	unsigned offset = 0;
+	unsigned big = 0;
+	char name[33] = { 0 };
+	uint8_t value[512];
+
+	reset_store();
+	// Previous format holding more than the log can: the keys of the model, then 512-byte values
+	for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+		uint32_t value_size = TEST_VALUE_MAX;
+		memset(name, 0, sizeof(name));
+		key_name(key, name);
+		memcpy(flash + offset, name, 32);
+		memcpy(flash + offset + 32, &value_size, sizeof(value_size));
+		for (uint32_t i = 0; i < value_size; i++) {
+			model[key].value[i] = flash[offset + 36 + i] = (uint8_t) (key + i);
+		}
+		model[key].size = (uint8_t) value_size;
+		model[key].present = true;
+		offset += 36 + value_size;
+	}
+	for (big = 0; offset + 36 + sizeof(value) <= 4096 * 5; big++) {
+		uint32_t value_size = sizeof(value);
+		memset(name, 0, sizeof(name));
+		snprintf(name, sizeof(name), "big/%u", big);
+		memcpy(flash + offset, name, 32);
+		memcpy(flash + offset + 32, &value_size, sizeof(value_size));
+		memset(flash + offset + 36, (int) big, value_size);
+		offset += 36 + value_size;
+	}
+	for (unsigned i = 0; i < OT_NVM_SIZE; i++) {
+		flash[4096 * 5 + i] = (uint8_t) (i / 7);
+	}
+	memcpy(legacy, flash, sizeof(legacy));
+
+	// Nothing is imported, the store starts empty as after a factory reset
+	memset(model, 0, sizeof(model));
+	boot();
+	check_model();
+	snprintf(name, sizeof(name), "big/%u", big - 1);
+	CHECK(NM_GetKeyExists(name, SECTOR_SECURE) == NVM_KEY_NOT_FOUND);
+	for (unsigned i = 0; i < OT_NVM_SIZE; i++) {
+		CHECK(ot_buffer()[i] == 0xFF);
+	}
+
+	// A reboot before the first dump finds the previous format again, and does the same
+	boot();
+	check_model();
+	CHECK(memcmp(flash, legacy, sizeof(legacy)) == 0);
+
+	// The store is writable, the next dump erases the previous format
+	set_key(3, 10, 0x30);
+	set_key(7, 20, 0x70);
+	check_model();
+	dump();
+	CHECK(flash_sim_stats().program_errors == 0);
+	unsigned programmed = 0;
+	for (unsigned i = 0; i < NVM_PAGE_COUNT * FLASH_SIM_PAGE_SIZE; i++) {
+		programmed += (flash[i] != 0xFF) ? 1 : 0;
+	}
+	// only the page header and the two records are left
+	CHECK(programmed <= 16 + 2 * 64);
+	boot();
+	check_model();
+	CHECK(NM_GetKeyExists(name, SECTOR_SECURE) == NVM_KEY_NOT_FOUND);
+	for (unsigned i = 0; i < OT_NVM_SIZE; i++) {
+		CHECK(ot_buffer()[i] == 0xFF);
+	}
+}
+
+static void test_power_fail(void) {
+	static KeyModel history[TEST_KEY_COUNT][TEST_HISTORY_MAX];
+	static unsigned history_count[TEST_KEY_COUNT];
+	unsigned seed = 1;
+
+	for (unsigned run = 0; run < 400; run++) {
+		reset_store();
+		for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+			set_key(key, 24, (uint8_t) key);
+		}
+		dump();
+
+		// Random updates, with a dump interrupted by a power failure
+		for (unsigned step = 0; step < 6; step++) {
+			for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+				history[key][0] = model[key];
+				history_count[key] = 1;
+			}
+			for (unsigned i = 0; i < 20 + run % 60; i++) {
+				seed = seed * 1103515245 + 12345;
+				unsigned key = (seed >> 8) % TEST_KEY_COUNT;
+				if ((seed >> 20) % 8 == 0) {
+					delete_key(key);
+				} else {
+					set_key(key, (uint8_t) (8 + (seed >> 4) % 80), (uint8_t) (seed >> 12));
+				}
+				if (history_count[key] < sizeof(history[key]) / sizeof(history[key][0])) {
+					history[key][history_count[key]++] = model[key];
+				}
+			}
+			if (step < 5) {
+				dump();
+				continue;
+			}
+			uint32_t ops = flash_sim_op_count();
+			flash_sim_power_fail_after(run % 5);
+			NM_Dump();
+			flash_sim_process();
+			bool failed = flash_sim_power_failed();
+			flash_sim_power_restore();
+			boot();
+			CHECK(flash_sim_stats().program_errors == 0);
+			// Each key holds one of the values it had since the last complete dump
+			for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+				bool found = false;
+				for (unsigned h = 0; (h < history_count[key]) && !found; h++) {
+					found = key_matches(key, &history[key][h]);
+				}
+				if (!found) {
+					fprintf(stderr, "run %u: key %u lost (%u flash operations, power failed %d)\n", run, key,
+							flash_sim_op_count() - ops, failed);
+				}
+				CHECK(found);
+			}
+			// The store is usable after the power failure
+			for (unsigned key = 0; key < TEST_KEY_COUNT; key++) {
+				set_key(key, 40, (uint8_t) (run + key));
+			}
+			dump();
+			boot();
+			check_model();
+		}
+	}
+}
+
+static void test_full(void) {
+	char name[33];
+	uint8_t value[512];
+	unsigned key = 0;
+	NVM_StatusTypeDef status = NVM_OK;
+
+	reset_store();
+	memset(value, 0x11, sizeof(value));
+	for (key = 0; key < 100; key++) {
+		snprintf(name, sizeof(name), "big/%u", key);
+		status = NM_SetKeyValue((char*) value, name, sizeof(value), SECTOR_SECURE);
+		if (status != NVM_OK) {
+			break;
+		}
+	}
+	CHECK(status == NVM_SIZE_FULL);
+	CHECK(key > (NVM_PAGE_COUNT - 1) * 12);
+	// Room is available again once keys are deleted
+	snprintf(name, sizeof(name), "big/%u", 0);
+	CHECK(NM_DeleteKey(name, SECTOR_SECURE) == NVM_OK);
+	snprintf(name, sizeof(name), "big/%u", 1);
+	CHECK(NM_DeleteKey(name, SECTOR_SECURE) == NVM_OK);
+	snprintf(name, sizeof(name), "big/%u", key);
+	CHECK(NM_SetKeyValue((char*) value, name, sizeof(value), SECTOR_SECURE) == NVM_OK);
+	dump();
+	CHECK(flash_sim_stats().program_errors == 0);
+	boot();
+	CHECK(NM_GetKeyExists(name, SECTOR_SECURE) == NVM_OK);
+}
+
+static void test_reset_factory(void) {
+	reset_store();
+	set_key(1, 10, 1);
+	dump();
+	volatile bool reset = false;
+	if (setjmp(flash_sim_reset_point) == 0) {
+		NM_ResetFactory();
+		flash_sim_process();
+	} else {
+		reset = true;
+	}
+	CHECK(reset);
+	memset(model, 0, sizeof(model));
+	boot();
+	check_model();
+}
+
+int main(int argc, char **argv) {
+	const char *path = (argc > 1) ? argv[1] : "flash_wb_test.bin";
+
+	if (flash_sim_open(path) != 0) {
+		return 2;
+	}
+	test_basic();
+	test_dump_programs_new_records();
+	test_compaction();
+	test_ot_buffer();
+	test_legacy_import();
+	test_legacy_import_too_large();
+	test_full();
+	test_reset_factory();
+	test_power_fail();
+	flash_sim_close();
+
+	printf("%s: %u failure(s)\n", (failures == 0) ? "PASSED" : "FAILED", failures);
+	return (failures == 0) ? 0 : 1;
+}
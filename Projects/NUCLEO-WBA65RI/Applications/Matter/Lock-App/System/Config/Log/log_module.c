@@ -20,6 +20,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h> /* vsnprintf */
+#include <string.h> /* strlen, memcpy */
 
 #include "app_conf.h"
 #include "log_module.h"
@@ -40,6 +41,13 @@
 /* Definition of 'End Of Line' */
 #define ENDOFLINE_SIZE          0x01u
 #define ENDOFLINE_CHAR          '\n'
+
+/* The logs are formatted on the host when the traces are in deferred mode */
+#if defined(UTIL_ADV_TRACE_CONDITIONNAL) && defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+#define LOG_DEFERRED_FORMATTING 1
+#else
+#define LOG_DEFERRED_FORMATTING 0
+#endif
 /* USER CODE BEGIN PD */
 
 /* USER CODE END PD */
@@ -93,7 +101,7 @@ static uint32_t Get_Region_Mask(Log_Region_t region);
 
 /* Functions Definition ------------------------------------------------------*/
 
-#if ( LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0 )
+#if ( LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0 ) && ( LOG_DEFERRED_FORMATTING == 0 )
 
 /**
  * @brief Add the color (in function of Region) on the start of Log sentence.
@@ -140,8 +148,10 @@ static uint16_t RegionToColor( char * szBuffer, Log_Region_t eRegion )
  */
 void Log_Module_PrintWithArg( Log_Verbose_Level_t eVerboseLevel, Log_Region_t eRegion, const char * pText, va_list args )
 {
+#if ( LOG_DEFERRED_FORMATTING == 0 )
   uint16_t  iTempSize, iBuffSize = 0u;
   char      szFullText[UTIL_ADV_TRACE_TMP_BUF_SIZE];
+#endif /* LOG_DEFERRED_FORMATTING */
 
   /**
    * This user section can be used to insert a guard clauses design pattern
@@ -171,6 +181,19 @@ void Log_Module_PrintWithArg( Log_Verbose_Level_t eVerboseLevel, Log_Region_t eR
     return;
   }
 
+#if ( LOG_DEFERRED_FORMATTING != 0 )
+  /* Post the format address and the arguments, adv_trace_decode.py formats the text on the host.
+   * The time stamp is the raw one registered with UTIL_ADV_TRACE_RegisterRawTimeStampFunction, no color is added. */
+  UTIL_ADV_TRACE_DeferredVSend( ( LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0 ) ? 1u : 0u, pText, args );
+
+#if ( LOG_INSERT_EOL_INSIDE_THE_TRACE != 0 )
+  /* Add End Of Line if the format does not end with one */
+  if ( ( pText[0] == '\0' ) || ( pText[strlen( pText ) - 1u] != ENDOFLINE_CHAR ) )
+  {
+    UTIL_ADV_TRACE_Send( (const uint8_t *)"\n", ENDOFLINE_SIZE );
+  }
+#endif /* LOG_INSERT_EOL_INSIDE_THE_TRACE */
+#else /* LOG_DEFERRED_FORMATTING */
 #if ( LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0 )
   /* Add Color in function of Region */
   iTempSize = RegionToColor( &szFullText[iBuffSize], eRegion );
@@ -204,6 +227,7 @@ void Log_Module_PrintWithArg( Log_Verbose_Level_t eVerboseLevel, Log_Region_t eR
 
   /* Send full_text to ADV Traces */
   UTIL_ADV_TRACE_Send( (const uint8_t *)szFullText, iBuffSize );
+#endif /* LOG_DEFERRED_FORMATTING */
 }
 
 /**
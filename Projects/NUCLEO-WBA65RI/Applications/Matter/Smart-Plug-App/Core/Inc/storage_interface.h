@@ -31,6 +31,10 @@ extern "C" {
 
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+/* PSA ITS area, right after the Matter NVM area (flash_wb.c) */
+#define ITS_LOCATION         0X081EA000 /* ITS start address */
+#define ITS_MAX_SIZE         (8*1024U)  /* 8 KBytes */
+
 #define ITS_ENCRYPTION_SECRET_KEY_ID  ((psa_key_id_t)0x2FFFAAAA)
 /* Device Attestation PSA key ID */
 #define DEVICE_ATTESTATION_PRIVATE_KEY_ID_USER   ((psa_key_id_t)0x1fff0001)
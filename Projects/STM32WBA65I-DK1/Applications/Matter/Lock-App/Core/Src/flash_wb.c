@@ -17,41 +17,133 @@
  ******************************************************************************
  */
 
+/*
+ * The NVM is a log of records spread over NVM_PAGE_COUNT flash pages, used as
+ * a ring. A RAM mirror of the whole area holds the log, keys are located with
+ * a RAM hash index of (sector, key name) to record offset.
+ *
+ * - Set and Delete append a record (a tombstone for Delete) at the head of the
+ *   log, the previous record of the key is left in place and becomes dead.
+ * - When the head page is full, the next page is opened. One free page is
+ *   always kept in reserve: when there is no other free page, the oldest page
+ *   is compacted by copying its live records to the head, and released. The
+ *   Set or Delete that needs the room does it, in the RAM mirror only: at most
+ *   one page of records is copied, flash is only written by NM_Dump.
+ * - NM_Dump only programs the records appended since the previous dump.
+ *   Flash pages are erased only when they have been released by compaction.
+ *
+ * Page layout : NVM_PageHeader, then records, each aligned on a flash
+ * quad-word (16 bytes) so that records are never programmed twice.
+ * Record layout : NVM_RecordHeader, key name, value, padding.
+ *
+ * The OpenThread settings buffer (NM_GetOtNVMAddr) stays a raw RAM buffer,
+ * persisted as NVM_OT_CHUNK_COUNT records of a private sector: only chunks
+ * that changed since the previous dump are appended.
+ *
+ * The previous format (key records packed in the first 20KB of the area, then
+ * the OpenThread buffer) is imported by NM_Init, and replaced in flash by the
+ * next NM_Dump. The log holds less than the previous format did, the area
+ * ending where the PSA ITS starts: if the content does not fit, the store
+ * starts empty as after NM_ResetFactory, and the next NM_Dump erases the area.
+ */
+
 /* Includes ------------------------------------------------------------------*/
 #include "flash_wb.h"
 #include "flash_driver.h"
 #include "flash_manager.h"
 #include "cmsis_os2.h"
+#include "storage_interface.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /* Private defines -----------------------------------------------------------*/
 #define MATTER_KEY_NAME_MAX_LENGTH (16 * 2) // ADD Max key name string size is 32 "keyType...;KeyName..."
 #define NVM_OFFSET_KEY 512
 #define NVM_BLOCK_SIZE NVM_OFFSET_KEY
 #define DEFAULT_VALUE  0xFF
-#define SECTOR_SIZE_SECURE 4096*5
-#define SECTOR_SIZE_NO_SECURE 4096
-#define SECTOR_SIZE 8192
+#ifndef START_NVM_Matter
 #define START_NVM_Matter 0x81E4000
-#define NVM_MATTER_ADDR_INIT_PTR ((void * const) START_NVM_Matter)
-#define NVM_SIZE_FLASH (SECTOR_SIZE_SECURE + SECTOR_SIZE_NO_SECURE)
+#endif
+#define NVM_MATTER_ADDR_INIT_PTR ((const uint8_t *) (uintptr_t) START_NVM_Matter)
+/* Matter NVM area starts at 0x81E4000, the PSA ITS (storage_interface.h) at 0x81EA000 */
+#define NVM_PAGE_SIZE FLASH_PAGE_SIZE
+#ifndef NVM_PAGE_COUNT
+#define NVM_PAGE_COUNT 3
+#endif
+#define NVM_SIZE_FLASH (NVM_PAGE_SIZE * NVM_PAGE_COUNT)
+#if (START_NVM_Matter < ITS_LOCATION + ITS_MAX_SIZE) && (START_NVM_Matter + NVM_SIZE_FLASH > ITS_LOCATION)
+#error "The Matter NVM area overlaps the PSA ITS"
+#endif
 #define START_SECTOR_FLASH_NVM ((START_NVM_Matter - FLASH_BASE)/(FLASH_PAGE_SIZE))
-#define NB_SECTOR_FLASH_NVM (NVM_SIZE_FLASH/SECTOR_SIZE)
-#define NVM_SIZE_32_BITS (NVM_SIZE_FLASH/4)
+#define NB_SECTOR_FLASH_NVM NVM_PAGE_COUNT
+
+/* Flash is programmed by quad-word */
+#define NVM_WRITE_ALIGN 16
+#define NVM_ALIGN(size) (((size) + NVM_WRITE_ALIGN - 1) & ~(NVM_WRITE_ALIGN - 1))
+
+#define NVM_PAGE_MAGIC 0x4C4D564EU /* "NVML" */
+#define NVM_RECORD_MAGIC 0xA5
+#define NVM_RECORD_FLAG_TOMBSTONE 0x01
+#define NVM_RECORD_MAX_SIZE NVM_ALIGN(sizeof(NVM_RecordHeader) + MATTER_KEY_NAME_MAX_LENGTH + NVM_BLOCK_SIZE)
+
+/* Private sector holding the OpenThread settings buffer */
+#define NVM_SECTOR_OT 0x0F
+#define NVM_OT_CHUNK_SIZE 512
+#define NVM_OT_CHUNK_COUNT (OT_NVM_SIZE / NVM_OT_CHUNK_SIZE)
+
+/* Live records must fit in the pages of the log, whatever the padding at the end of the pages,
+ * with room left for one more record, so that compacting every page makes room for an append. */
+#define NVM_LIVE_MAX ((NVM_PAGE_COUNT - 1) * (NVM_PAGE_SIZE - sizeof(NVM_PageHeader) - NVM_RECORD_MAX_SIZE) \
+		- NVM_RECORD_MAX_SIZE)
+
+/* Index of the live records, must be a power of two */
+#define NVM_INDEX_SIZE 1024
+#define NVM_INDEX_MAX_COUNT ((NVM_INDEX_SIZE * 3) / 4)
+#define NVM_INDEX_EMPTY 0xFFFF
+
+/* Previous NVM format */
+#define LEGACY_SECTOR_SIZE_SECURE (4096 * 5)
+#define LEGACY_SIZE_FIELD_LENGTH 4
+#define LEGACY_RECORD_SIZE(value_len) (MATTER_KEY_NAME_MAX_LENGTH + LEGACY_SIZE_FIELD_LENGTH + (value_len))
+
+typedef struct {
+	uint32_t magic;
+	uint32_t seq;
+	uint32_t seq_check; /* ~seq */
+	uint32_t reserved;
+} NVM_PageHeader;
+
+typedef struct {
+	uint8_t magic;
+	uint8_t flags;
+	uint8_t sector;
+	uint8_t name_len;
+	uint16_t value_len;
+	uint16_t reserved;
+	uint32_t crc; /* CRC-32 of the header up to crc, the name and the value */
+} NVM_RecordHeader;
 
 typedef struct {
-	NVM_Sector id_sector;
-	uint8_t *ram_ptr;
-	size_t sector_size;
+	uint32_t seq;        /* Sequence number of the page, 0 if the page is free */
+	uint16_t used;       /* Bytes used in the page, header included */
+	uint16_t flushed;    /* Bytes of the page already programmed in flash */
+	uint32_t flash_seq;  /* Sequence number of the page in flash, 0 if none */
+	bool erase;          /* Flash page holds data and must be erased before being programmed */
+} NVM_PageState;
 
-} NVM_Sector_Struct;
+typedef struct {
+	uint8_t erase;
+	uint8_t page;
+	uint16_t offset;
+	uint16_t size;
+} NVM_FlashOp;
 
 static void FM_EraseCallback(FM_FlashOp_Status_t Status);
-static void FM_EraseBeforeWriteCallback(FM_FlashOp_Status_t Status);
-static void FM_WriteCallback(FM_FlashOp_Status_t Status);
+static void FM_DumpCallback(FM_FlashOp_Status_t Status);
 
 static FM_CallbackNode_t FM_EraseStatusCallback = {
 /* Header for chained list */
@@ -59,53 +151,81 @@ static FM_CallbackNode_t FM_EraseStatusCallback = {
 /* Callback for request status */
 .Callback = FM_EraseCallback };
 
-static FM_CallbackNode_t FM_EraseBeforeWriteStatusCallback = {
-/* Header for chained list */
-.NodeList = { .next = NULL, .prev = NULL },
-/* Callback for request status */
-.Callback = FM_EraseBeforeWriteCallback };
-
-static FM_CallbackNode_t FM_WriteStatusCallback = {
+static FM_CallbackNode_t FM_DumpStatusCallback = {
 /* Header for chained list */
 .NodeList = { .next = NULL, .prev = NULL },
 /* Callback for request status */
-.Callback = FM_WriteCallback };
+.Callback = FM_DumpCallback };
 
 /* Private macros ------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
-uint8_t ram_nvm[SECTOR_SIZE_SECURE + SECTOR_SIZE_NO_SECURE] = { 0 };
+static uint8_t ram_nvm[NVM_SIZE_FLASH] __attribute__((aligned(NVM_WRITE_ALIGN)));
+static uint8_t ram_nvm_ot[OT_NVM_SIZE] __attribute__((aligned(NVM_WRITE_ALIGN)));
 static osSemaphoreId_t FMSemaphore;
 
-const NVM_Sector_Struct sector_no_secure = { .id_sector = SECTOR_NO_SECURE,
-		.ram_ptr = ram_nvm + SECTOR_SIZE_SECURE, .sector_size =
-		SECTOR_SIZE_NO_SECURE };
+static NVM_PageState nvm_pages[NVM_PAGE_COUNT];
+static uint8_t nvm_head;
+static uint32_t nvm_seq;
+static uint16_t nvm_index[NVM_INDEX_SIZE];
+static uint16_t nvm_index_count;
+static uint32_t nvm_live_bytes;
 
-//*SIMULATE TO EXAMPLE*
-const NVM_Sector_Struct sector_secure = { .id_sector = SECTOR_SECURE, .ram_ptr =
-		ram_nvm, .sector_size = SECTOR_SIZE_SECURE };
+static NVM_FlashOp nvm_flash_ops[2 * NVM_PAGE_COUNT];
+static uint8_t nvm_flash_op_count;
+static uint8_t nvm_flash_op_index;
 
 /* Global variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 
-static NVM_StatusTypeDef flash_get(uint8_t *KeyValue, uint8_t *KeyAddr, size_t KeySize,
-		size_t *read_by_size);
-static NVM_StatusTypeDef flash_update(const NVM_Sector_Struct select_sector,
-		uint8_t *KeyName, uint8_t *KeyValue, size_t KeySize);
-static NVM_StatusTypeDef flash_replace(const NVM_Sector_Struct select_sector,
-		uint8_t *PtKeyfind, uint8_t *KeyName, uint8_t *KeyValue, size_t KeySize);
-static NVM_StatusTypeDef flash_write(uint8_t *PtKeyFree, uint8_t *key,
-		uint8_t *value, size_t value_size);
-static uint8_t* SearchKey(uint8_t *PtPage, uint8_t *KeyName, size_t nvm_size);
-static NVM_StatusTypeDef delete_key(const NVM_Sector_Struct select_sector,
-		uint8_t *PtkeyFind);
+static bool select_sector(NVM_Sector sector, uint8_t *log_sector);
+static uint32_t nvm_crc(uint32_t crc, const uint8_t *data, size_t size);
+static bool nvm_is_blank(const uint8_t *data, size_t size);
+static uint32_t nvm_hash(uint8_t sector, const uint8_t *name, uint8_t name_len);
+static NVM_RecordHeader* nvm_record(uint16_t offset);
+static uint16_t nvm_record_size(const NVM_RecordHeader *record);
+static uint16_t* nvm_index_find(uint8_t sector, const uint8_t *name, uint8_t name_len);
+static void nvm_index_remove(uint16_t *slot);
+static bool nvm_index_set(uint16_t offset);
+static uint8_t nvm_free_pages(void);
+static void nvm_open_page(uint8_t page);
+static NVM_StatusTypeDef nvm_reserve(uint16_t size, bool compacting);
+static NVM_StatusTypeDef nvm_compact_oldest(void);
+static NVM_StatusTypeDef nvm_append(uint8_t sector, const uint8_t *name, uint8_t name_len,
+		const uint8_t *value, uint16_t value_len, bool tombstone, bool compacting);
+static NVM_StatusTypeDef nvm_set(uint8_t sector, const uint8_t *name, uint8_t name_len,
+		const uint8_t *value, uint16_t value_len);
+static NVM_StatusTypeDef nvm_delete(uint8_t sector, const uint8_t *name, uint8_t name_len);
+static void nvm_load_page(uint8_t page);
+static void nvm_compact_in_place(void);
+static void nvm_recover(void);
+static void nvm_clear(void);
+static bool nvm_legacy_record(uint32_t offset, uint8_t *name_len, uint16_t *value_len);
+static bool nvm_import_legacy(void);
+static void nvm_load_ot(void);
+static NVM_StatusTypeDef nvm_save_ot(void);
+static bool nvm_flash_before(const NVM_PageState *page, const NVM_PageState *other);
+static void nvm_flash_next_op(void);
 
 void LockFMThread(void);
 void UnLockFMThread(void);
 
-static void FM_WriteCallback(FM_FlashOp_Status_t Status) {
-	/* Update status */
-	UnLockFMThread();
+static void FM_DumpCallback(FM_FlashOp_Status_t Status) {
+	if (Status == FM_OPERATION_COMPLETE) {
+		NVM_FlashOp *op = &nvm_flash_ops[nvm_flash_op_index];
+		NVM_PageState *page = &nvm_pages[op->page];
+		if (op->erase) {
+			page->erase = false;
+			page->flushed = 0;
+			page->flash_seq = 0;
+		} else {
+			page->flushed = op->offset + op->size;
+			page->flash_seq = page->seq;
+		}
+		nvm_flash_op_index++;
+	}
+	// FM_OPERATION_AVAILABLE: the flash manager was busy, retry the operation
+	nvm_flash_next_op();
 }
 
 static void FM_EraseCallback(FM_FlashOp_Status_t Status) {
@@ -116,169 +236,221 @@ static void FM_EraseCallback(FM_FlashOp_Status_t Status) {
 	}
 }
 
-static void FM_EraseBeforeWriteCallback(FM_FlashOp_Status_t Status) {
-	/* Update status */
-	FM_Write((uint32_t*) ram_nvm, NVM_MATTER_ADDR_INIT_PTR,
-	NVM_SIZE_32_BITS, &FM_WriteStatusCallback);
-
-}
-
 /* Public functions ----------------------------------------------------------*/
 
 NVM_StatusTypeDef NM_Init(void) {
-	memset(ram_nvm, DEFAULT_VALUE, sizeof(ram_nvm));
-	memcpy(ram_nvm, NVM_MATTER_ADDR_INIT_PTR, sizeof(ram_nvm));
-		/* Create thread for FM and semaphore to control it*/
-		FMSemaphore = osSemaphoreNew(1, 1, NULL);
+	const uint8_t *flash = NVM_MATTER_ADDR_INIT_PTR;
+	bool log_found = false;
+
+	memcpy(ram_nvm, flash, sizeof(ram_nvm));
+	memset(ram_nvm_ot, DEFAULT_VALUE, sizeof(ram_nvm_ot));
+	memset(nvm_pages, 0, sizeof(nvm_pages));
+	memset(nvm_index, 0xFF, sizeof(nvm_index));
+	nvm_index_count = 0;
+	nvm_live_bytes = 0;
+	nvm_head = 0;
+	nvm_seq = 0;
+
+	for (uint8_t page = 0; page < NVM_PAGE_COUNT; page++) {
+		const NVM_PageHeader *header = (const NVM_PageHeader*) (ram_nvm + page * NVM_PAGE_SIZE);
+		if ((header->magic == NVM_PAGE_MAGIC) && (header->seq == ~header->seq_check) && (header->seq != 0)) {
+			nvm_pages[page].seq = header->seq;
+			nvm_pages[page].flash_seq = header->seq;
+			log_found = true;
+			if (header->seq > nvm_seq) {
+				nvm_seq = header->seq;
+				nvm_head = page;
+			}
+		}
+	}
+	bool blank = nvm_is_blank(ram_nvm, sizeof(ram_nvm));
+
+	if (!log_found && !blank) {
+		if (!nvm_import_legacy()) {
+			APP_DBG("ERROR NVM : previous NVM content does not fit, NVM reset");
+			nvm_clear();
+		}
+	} else {
+		// Replay the pages from the oldest to the newest, so that the last record of a key wins
+		bool page_loaded[NVM_PAGE_COUNT] = { false };
+		for (uint8_t i = 0; i < NVM_PAGE_COUNT; i++) {
+			uint8_t oldest = 0;
+			while (page_loaded[oldest]) {
+				oldest++;
+			}
+			for (uint8_t page = oldest + 1; page < NVM_PAGE_COUNT; page++) {
+				if (!page_loaded[page] && (nvm_pages[page].seq < nvm_pages[oldest].seq)) {
+					oldest = page;
+				}
+			}
+			page_loaded[oldest] = true;
+			nvm_load_page(oldest);
+		}
+		nvm_recover();
+	}
+	nvm_load_ot();
+
+	/* Create thread for FM and semaphore to control it*/
+	FMSemaphore = osSemaphoreNew(1, 1, NULL);
 	if (FMSemaphore == NULL) {
 		APP_DBG( "ERROR FREERTOS : FMSemaphore SEMAPHORE CREATION FAILED" );
 		while (1)
 			;
-		}
+	}
 	return NVM_OK;
 
 }
 
 NVM_StatusTypeDef NM_Dump(void) {
-	// Mutex will be release after the write
+	// Mutex will be release after the last flash operation
 	LockFMThread();
-	FM_Erase(START_SECTOR_FLASH_NVM, NB_SECTOR_FLASH_NVM,
-	         &FM_EraseBeforeWriteStatusCallback);
-	// write when erase is finish in the CallBack
-	return NVM_OK;
+
+	NVM_StatusTypeDef status = nvm_save_ot();
+
+	// Program the pages in the order they were opened, so that the flash always holds a prefix of
+	// the log. A released page is erased only once the pages holding the copies of its records are
+	// programmed: right before it is programmed again, or at the end if it is still free.
+	nvm_flash_op_count = 0;
+	nvm_flash_op_index = 0;
+	bool page_done[NVM_PAGE_COUNT] = { false };
+	for (;;) {
+		int8_t next = -1;
+		for (uint8_t page = 0; page < NVM_PAGE_COUNT; page++) {
+			const NVM_PageState *state = &nvm_pages[page];
+			if (page_done[page] || (!state->erase && (state->used == state->flushed))) {
+				continue;
+			}
+			if ((next < 0) || nvm_flash_before(state, &nvm_pages[next])) {
+				next = page;
+			}
+		}
+		if (next < 0) {
+			break;
+		}
+		NVM_PageState *state = &nvm_pages[next];
+		uint16_t offset = state->erase ? 0 : state->flushed;
+		page_done[next] = true;
+		if (state->erase) {
+			nvm_flash_ops[nvm_flash_op_count++] = (NVM_FlashOp) { .erase = 1, .page = next, .offset = 0,
+					.size = 0 };
+		}
+		if (state->used > offset) {
+			nvm_flash_ops[nvm_flash_op_count++] = (NVM_FlashOp) { .erase = 0, .page = next, .offset = offset,
+					.size = state->used - offset };
+		}
+	}
+
+	// flash operations are chained in the CallBack
+	nvm_flash_next_op();
+	return status;
 }
 
 NVM_StatusTypeDef NM_GetKeyExists(const char *KeyName, NVM_Sector sector) {
 
-	NVM_StatusTypeDef status = NVM_KEY_NOT_FOUND;
-
+	uint8_t log_sector = 0;
 	if (KeyName == NULL) {
 		return NVM_PARAM_ERROR;
 	}
-	NVM_Sector_Struct select_nvm = { 0 };
-	switch (sector) {
-	case SECTOR_NO_SECURE:
-		select_nvm = sector_no_secure;
-		break;
-
-	case SECTOR_SECURE:
-		select_nvm = sector_secure;
-		break;
-
-	default:
+	if (!select_sector(sector, &log_sector)) {
 		return NVM_WRITE_FAILED;
 	}
+	size_t name_len = strlen(KeyName);
+	if (name_len > MATTER_KEY_NAME_MAX_LENGTH) {
+		return NVM_KEY_NOT_FOUND;
+	}
 
-	uint8_t *key_search = SearchKey(select_nvm.ram_ptr, (uint8_t*) KeyName,
-			select_nvm.sector_size);
-	if (key_search != NULL) {
-		status = NVM_OK;
+	if (nvm_index_find(log_sector, (const uint8_t*) KeyName, (uint8_t) name_len) != NULL) {
+		return NVM_OK;
 	}
-	return status;
+	return NVM_KEY_NOT_FOUND;
 }
 
 NVM_StatusTypeDef NM_GetKeyValue(void *KeyValue, const char *KeyName,
 		uint32_t KeySize, size_t *read_by_size, NVM_Sector sector) {
 
-	if (KeyValue == NULL) {
+	uint8_t log_sector = 0;
+	if ((KeyValue == NULL) || (KeyName == NULL)) {
 		return NVM_PARAM_ERROR;
 	}
-	NVM_Sector_Struct select_nvm = { 0 };
-	switch (sector) {
-	case SECTOR_NO_SECURE:
-		select_nvm = sector_no_secure;
-		break;
-
-	case SECTOR_SECURE:
-		select_nvm = sector_secure;
-		break;
-
-	default:
+	if (!select_sector(sector, &log_sector)) {
 		return NVM_WRITE_FAILED;
 	}
+	size_t name_len = strlen(KeyName);
+	if (name_len > MATTER_KEY_NAME_MAX_LENGTH) {
+		return NVM_KEY_NOT_FOUND;
+	}
 
-	uint8_t *key_search = SearchKey(select_nvm.ram_ptr, (uint8_t*) KeyName,
-			select_nvm.sector_size);
-	if (key_search != NULL) {
-		// copy Keyname's value in KeyValue and copy the size of KeyValue in read_by_size
-		return flash_get(KeyValue, key_search, KeySize, read_by_size);
+	uint16_t *slot = nvm_index_find(log_sector, (const uint8_t*) KeyName, (uint8_t) name_len);
+	if (slot == NULL) {
+		return NVM_KEY_NOT_FOUND;
 	}
-	return NVM_KEY_NOT_FOUND;
+	const NVM_RecordHeader *record = nvm_record(*slot);
+	const uint8_t *value = (const uint8_t*) (record + 1) + record->name_len;
+	uint16_t value_len = record->value_len;
+	// copy Keyname's value in KeyValue and copy the size of KeyValue in read_by_size
+	if (KeySize < value_len) {
+		return NVM_BUFFER_TOO_SMALL;
+	}
+	memcpy(KeyValue, value, value_len);
+	if (read_by_size) {
+		*read_by_size = value_len;
+	}
+	return NVM_OK;
 }
 
 NVM_StatusTypeDef NM_GetOtNVMAddr(uint32_t *NVMAddr) {
 	if (NVMAddr == NULL) {
 		return NVM_PARAM_ERROR;
 	}
-	*NVMAddr = (uint32_t) ram_nvm + SECTOR_SIZE_SECURE;
+	*NVMAddr = (uint32_t) (uintptr_t) ram_nvm_ot;
 	return NVM_OK;
 }
 
 NVM_StatusTypeDef NM_SetKeyValue(char *KeyValue, char *KeyName,
 		uint32_t KeySize, NVM_Sector sector) {
 
+	uint8_t log_sector = 0;
 	if ((KeyValue == NULL) || (KeyName == NULL)) {
 		return NVM_PARAM_ERROR;
 	}
-	NVM_Sector_Struct select_nvm = { 0 };
-	void *Ptkey = NULL;
-
-	switch (sector) {
-	case SECTOR_NO_SECURE:
-		select_nvm = sector_no_secure;
-		break;
-
-	case SECTOR_SECURE:
-		select_nvm = sector_secure;
-		break;
-
-	default:
+	if (!select_sector(sector, &log_sector)) {
 		return NVM_WRITE_FAILED;
 	}
-
 	if (KeySize > NVM_BLOCK_SIZE) {
 		return NVM_BLOCK_SIZE_OVERFLOW;
 	}
-	// call function to search the pointer of key if it exist else return  null
-	Ptkey = SearchKey(select_nvm.ram_ptr, (uint8_t*) KeyName,
-			select_nvm.sector_size);
-
-	if (Ptkey == NULL) {
-		return flash_update(select_nvm, (uint8_t*) KeyName, (uint8_t*) KeyValue,
-				KeySize);
-	} else {
-		if (!flash_replace(select_nvm, Ptkey, (uint8_t*) KeyName,
-				(uint8_t*) KeyValue, KeySize)) {
-			return NVM_OK;
-		}
+	size_t name_len = strlen(KeyName);
+	if ((name_len == 0) || (name_len > MATTER_KEY_NAME_MAX_LENGTH)) {
+		return NVM_PARAM_ERROR;
 	}
-	return NVM_WRITE_FAILED;
+
+	// wait for a running NM_Dump, the log must not change while it is programmed
+	LockFMThread();
+	NVM_StatusTypeDef status = nvm_set(log_sector, (const uint8_t*) KeyName, (uint8_t) name_len,
+			(const uint8_t*) KeyValue, (uint16_t) KeySize);
+	UnLockFMThread();
+	return status;
 }
 
 NVM_StatusTypeDef NM_DeleteKey(const char *Keyname, NVM_Sector sector) {
 
+	uint8_t log_sector = 0;
 	if (Keyname == NULL) {
 		return NVM_PARAM_ERROR;
 	}
-	NVM_Sector_Struct select_nvm = { 0 };
-	switch (sector) {
-	case SECTOR_NO_SECURE:
-		select_nvm = sector_no_secure;
-		break;
-
-	case SECTOR_SECURE:
-		select_nvm = sector_secure;
-		break;
-
-	default:
+	if (!select_sector(sector, &log_sector)) {
 		return NVM_WRITE_FAILED;
 	}
-	uint8_t *Ptkey = SearchKey(select_nvm.ram_ptr, (uint8_t*) Keyname,
-			select_nvm.sector_size);
-	if (Ptkey != NULL) {
-		return delete_key(select_nvm, Ptkey);
+	size_t name_len = strlen(Keyname);
+	if (name_len > MATTER_KEY_NAME_MAX_LENGTH) {
+		return NVM_KEY_NOT_FOUND;
 	}
-	return NVM_KEY_NOT_FOUND;
+
+	// wait for a running NM_Dump, the log must not change while it is programmed
+	LockFMThread();
+	NVM_StatusTypeDef status = nvm_delete(log_sector, (const uint8_t*) Keyname, (uint8_t) name_len);
+	UnLockFMThread();
+	return status;
 }
 
 void NM_ResetFactory(void) {
@@ -294,133 +466,527 @@ void NM_ResetFactory(void) {
  *
  *************************************************************/
 
-static uint8_t* SearchKey(uint8_t *PtPage, uint8_t *KeyName, size_t nvm_size) {
+static bool select_sector(NVM_Sector sector, uint8_t *log_sector) {
+	switch (sector) {
+	case SECTOR_NO_SECURE:
+	case SECTOR_SECURE:
+		*log_sector = (uint8_t) sector;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+static uint32_t nvm_crc(uint32_t crc, const uint8_t *data, size_t size) {
+	// CRC-32 (IEEE 802.3), computed 4 bits at a time
+	static const uint32_t crc_table[16] = { 0x00000000, 0x1DB71064, 0x3B6E20C8,
+			0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+			0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0,
+			0x86D3D2D4, 0xA00AE278, 0xBDBDF21C };
+
+	crc = ~crc;
+	for (size_t i = 0; i < size; i++) {
+		crc = crc_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+		crc = crc_table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+	}
+	return ~crc;
+}
+
+static bool nvm_is_blank(const uint8_t *data, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		if (data[i] != DEFAULT_VALUE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static uint32_t nvm_hash(uint8_t sector, const uint8_t *name, uint8_t name_len) {
+	// FNV-1a
+	uint32_t hash = 2166136261U ^ sector;
+	for (uint8_t i = 0; i < name_len; i++) {
+		hash = (hash ^ name[i]) * 16777619U;
+	}
+	return hash;
+}
+
+static NVM_RecordHeader* nvm_record(uint16_t offset) {
+	return (NVM_RecordHeader*) (ram_nvm + offset);
+}
+
+static uint16_t nvm_record_size(const NVM_RecordHeader *record) {
+	return NVM_ALIGN(sizeof(NVM_RecordHeader) + record->name_len + record->value_len);
+}
+
+static uint16_t* nvm_index_find(uint8_t sector, const uint8_t *name, uint8_t name_len) {
+	uint32_t slot = nvm_hash(sector, name, name_len) & (NVM_INDEX_SIZE - 1);
+
+	while (nvm_index[slot] != NVM_INDEX_EMPTY) {
+		const NVM_RecordHeader *record = nvm_record(nvm_index[slot]);
+		if ((record->sector == sector) && (record->name_len == name_len)
+				&& (memcmp(record + 1, name, name_len) == 0)) {
+			return &nvm_index[slot];
+		}
+		slot = (slot + 1) & (NVM_INDEX_SIZE - 1);
+	}
+	return NULL;
+}
+
+static void nvm_index_remove(uint16_t *slot) {
+	// Backward shift deletion, keeps the probe sequences of the following entries intact
+	uint32_t hole = (uint32_t) (slot - nvm_index);
+	uint32_t next = hole;
+	uint16_t removed_size = nvm_record_size(nvm_record(*slot));
+
+	for (;;) {
+		next = (next + 1) & (NVM_INDEX_SIZE - 1);
+		if (nvm_index[next] == NVM_INDEX_EMPTY) {
+			break;
+		}
+		const NVM_RecordHeader *record = nvm_record(nvm_index[next]);
+		uint32_t home = nvm_hash(record->sector, (const uint8_t*) (record + 1), record->name_len)
+				& (NVM_INDEX_SIZE - 1);
+		// move the entry to the hole if its home slot is not in ]hole, next]
+		if (((next - home) & (NVM_INDEX_SIZE - 1)) >= ((next - hole) & (NVM_INDEX_SIZE - 1))) {
+			nvm_index[hole] = nvm_index[next];
+			hole = next;
+		}
+	}
+	nvm_index[hole] = NVM_INDEX_EMPTY;
+	nvm_index_count--;
+	nvm_live_bytes -= removed_size;
+}
+
+static bool nvm_index_set(uint16_t offset) {
+	const NVM_RecordHeader *record = nvm_record(offset);
+	const uint8_t *name = (const uint8_t*) (record + 1);
+	uint16_t *slot = nvm_index_find(record->sector, name, record->name_len);
 
-	uint8_t *i = PtPage;
-	size_t read_by_size = 0;
+	if (slot != NULL) {
+		nvm_live_bytes += nvm_record_size(record);
+		nvm_live_bytes -= nvm_record_size(nvm_record(*slot));
+		*slot = offset;
+		return true;
+	}
+	if (nvm_index_count >= NVM_INDEX_MAX_COUNT) {
+		return false;
+	}
+	uint32_t free_slot = nvm_hash(record->sector, name, record->name_len) & (NVM_INDEX_SIZE - 1);
+	while (nvm_index[free_slot] != NVM_INDEX_EMPTY) {
+		free_slot = (free_slot + 1) & (NVM_INDEX_SIZE - 1);
+	}
+	nvm_index[free_slot] = offset;
+	nvm_index_count++;
+	nvm_live_bytes += nvm_record_size(record);
+	return true;
+}
 
-	while ((i >= PtPage) || (i < (PtPage + nvm_size))) {
-		if (*i != DEFAULT_VALUE) {
-			if (strcmp((const char*)KeyName, (const char*) i) == 0) {
-				return i;
+static uint8_t nvm_free_pages(void) {
+	uint8_t count = 0;
+	for (uint8_t page = 0; page < NVM_PAGE_COUNT; page++) {
+		if (nvm_pages[page].seq == 0) {
+			count++;
+		}
+	}
+	return count;
+}
+
+static void nvm_open_page(uint8_t page) {
+	NVM_PageHeader *header = (NVM_PageHeader*) (ram_nvm + page * NVM_PAGE_SIZE);
+
+	nvm_seq++;
+	header->magic = NVM_PAGE_MAGIC;
+	header->seq = nvm_seq;
+	header->seq_check = ~nvm_seq;
+	header->reserved = 0;
+	nvm_pages[page].seq = nvm_seq;
+	nvm_pages[page].used = sizeof(NVM_PageHeader);
+	nvm_head = page;
+}
+
+static NVM_StatusTypeDef nvm_reserve(uint16_t size, bool compacting) {
+	NVM_PageState *head = &nvm_pages[nvm_head];
+
+	if ((head->seq != 0) && (NVM_PAGE_SIZE - head->used >= size)) {
+		return NVM_OK;
+	}
+	if (!compacting) {
+		// Keep a free page to be able to compact the oldest page
+		for (uint8_t i = 0; (i < NVM_PAGE_COUNT) && (nvm_free_pages() < 2); i++) {
+			if (nvm_compact_oldest() != NVM_OK) {
+				return NVM_SIZE_FULL;
 			}
-			read_by_size =
-					*(size_t*) ((uint8_t*) i + MATTER_KEY_NAME_MAX_LENGTH);
-			// ensure that the size of the data being read does not exceed the remaining size of the buffer
-			if (read_by_size + sizeof(size_t) + MATTER_KEY_NAME_MAX_LENGTH
-					> nvm_size - (i - PtPage)) {
-				return NULL;
+			if (NVM_PAGE_SIZE - nvm_pages[nvm_head].used >= size) {
+				return NVM_OK;
 			}
-			i += read_by_size + sizeof(size_t) + MATTER_KEY_NAME_MAX_LENGTH;
-			//Flash is corrupted
-			if ((i < PtPage) || (i > (PtPage + nvm_size))) {
-				NM_ResetFactory();
+		}
+		if (nvm_free_pages() < 2) {
+			return NVM_SIZE_FULL;
+		}
+	} else if (nvm_free_pages() == 0) {
+		return NVM_SIZE_FULL;
+	}
+
+	// Pages are used as a ring, take the first free page after the head
+	for (uint8_t i = 1; i <= NVM_PAGE_COUNT; i++) {
+		uint8_t page = (nvm_head + i) % NVM_PAGE_COUNT;
+		if (nvm_pages[page].seq == 0) {
+			nvm_open_page(page);
+			break;
+		}
+	}
+	return NVM_OK;
+}
+
+static NVM_StatusTypeDef nvm_compact_oldest(void) {
+	uint8_t oldest = nvm_head;
+	bool keep_tombstones = false;
+
+	for (uint8_t page = 0; page < NVM_PAGE_COUNT; page++) {
+		if ((nvm_pages[page].seq != 0) && (nvm_pages[page].seq < nvm_pages[oldest].seq)) {
+			oldest = page;
+		}
+		keep_tombstones |= nvm_pages[page].erase;
+	}
+	if (oldest == nvm_head) {
+		// Only the head page holds records
+		return NVM_SIZE_FULL;
+	}
+
+	// Copy the live records to the head. Tombstones are dropped, unless a released page is still
+	// in flash: it may hold an older record of the key, that must stay hidden until it is erased.
+	uint16_t page_offset = (uint16_t) (oldest * NVM_PAGE_SIZE);
+	uint16_t offset = sizeof(NVM_PageHeader);
+	while (offset < nvm_pages[oldest].used) {
+		NVM_RecordHeader *record = nvm_record(page_offset + offset);
+		if (record->magic != NVM_RECORD_MAGIC) {
+			break;
+		}
+		const uint8_t *name = (const uint8_t*) (record + 1);
+		uint16_t *slot = nvm_index_find(record->sector, name, record->name_len);
+		bool tombstone = (record->flags & NVM_RECORD_FLAG_TOMBSTONE) != 0;
+		if (tombstone ? (keep_tombstones && (slot == NULL)) : ((slot != NULL) && (*slot == page_offset + offset))) {
+			NVM_StatusTypeDef status = nvm_append(record->sector, name, record->name_len,
+					name + record->name_len, record->value_len, tombstone, true);
+			if (status != NVM_OK) {
+				return status;
 			}
-		} else {
-			return NULL;
 		}
+		offset += nvm_record_size(record);
+	}
 
+	// Release the page, it is erased by the next NM_Dump
+	memset(ram_nvm + page_offset, DEFAULT_VALUE, NVM_PAGE_SIZE);
+	if ((nvm_pages[oldest].flushed > 0) || (nvm_pages[oldest].flash_seq != 0)) {
+		nvm_pages[oldest].erase = true;
 	}
-	return NULL;
+	nvm_pages[oldest].seq = 0;
+	nvm_pages[oldest].used = 0;
+	nvm_pages[oldest].flushed = 0;
+	return NVM_OK;
+}
 
+static NVM_StatusTypeDef nvm_append(uint8_t sector, const uint8_t *name, uint8_t name_len,
+		const uint8_t *value, uint16_t value_len, bool tombstone, bool compacting) {
+
+	uint16_t size = NVM_ALIGN(sizeof(NVM_RecordHeader) + name_len + value_len);
+	NVM_StatusTypeDef status = nvm_reserve(size, compacting);
+	if (status != NVM_OK) {
+		return status;
+	}
+
+	uint16_t offset = (uint16_t) (nvm_head * NVM_PAGE_SIZE + nvm_pages[nvm_head].used);
+	NVM_RecordHeader *record = nvm_record(offset);
+	uint8_t *data = (uint8_t*) (record + 1);
+
+	// name and value may point to a record of the log, being compacted
+	memmove(data, name, name_len);
+	if (value_len > 0) {
+		memmove(data + name_len, value, value_len);
+	}
+	record->magic = NVM_RECORD_MAGIC;
+	record->flags = tombstone ? NVM_RECORD_FLAG_TOMBSTONE : 0;
+	record->sector = sector;
+	record->name_len = name_len;
+	record->value_len = value_len;
+	record->reserved = 0;
+	record->crc = nvm_crc(0, (const uint8_t*) record, offsetof(NVM_RecordHeader, crc));
+	record->crc = nvm_crc(record->crc, data, name_len + value_len);
+	memset(data + name_len + value_len, 0, size - sizeof(NVM_RecordHeader) - name_len - value_len);
+	nvm_pages[nvm_head].used += size;
+
+	if (tombstone) {
+		uint16_t *slot = nvm_index_find(sector, data, name_len);
+		if (slot != NULL) {
+			nvm_index_remove(slot);
+		}
+		return NVM_OK;
+	}
+	return nvm_index_set(offset) ? NVM_OK : NVM_SIZE_FULL;
 }
 
-static NVM_StatusTypeDef flash_get(uint8_t *KeyValue, uint8_t *KeyAddr, size_t KeySize, size_t *read_by_size) {
-    size_t size = *(size_t *) ((uint8_t *) KeyAddr + MATTER_KEY_NAME_MAX_LENGTH);
-    if (KeySize >= size) {
-        memcpy(KeyValue, KeyAddr + MATTER_KEY_NAME_MAX_LENGTH + sizeof(size_t), size);
-	if (read_by_size) {
-            *read_by_size = size;
-        }
-        return NVM_OK;
-    } else {
-        return NVM_BUFFER_TOO_SMALL;
-    }
+static NVM_StatusTypeDef nvm_set(uint8_t sector, const uint8_t *name, uint8_t name_len,
+		const uint8_t *value, uint16_t value_len) {
+
+	uint16_t *slot = nvm_index_find(sector, name, name_len);
+	uint32_t live_bytes = nvm_live_bytes + NVM_ALIGN(sizeof(NVM_RecordHeader) + name_len + value_len);
+	if (slot != NULL) {
+		const NVM_RecordHeader *record = nvm_record(*slot);
+		if ((record->value_len == value_len)
+				&& (memcmp((const uint8_t*) (record + 1) + name_len, value, value_len) == 0)) {
+			// Same value, nothing to write
+			return NVM_OK;
+		}
+		live_bytes -= nvm_record_size(record);
+	} else if (nvm_index_count >= NVM_INDEX_MAX_COUNT) {
+		return NVM_SIZE_FULL;
+	}
+	if (live_bytes > NVM_LIVE_MAX) {
+		return NVM_SIZE_FULL;
+	}
+	return nvm_append(sector, name, name_len, value, value_len, false, false);
+}
 
+static NVM_StatusTypeDef nvm_delete(uint8_t sector, const uint8_t *name, uint8_t name_len) {
+	if (nvm_index_find(sector, name, name_len) == NULL) {
+		return NVM_KEY_NOT_FOUND;
+	}
+	return nvm_append(sector, name, name_len, NULL, 0, true, false);
 }
 
-static NVM_StatusTypeDef flash_update(const NVM_Sector_Struct select_sector,
-		uint8_t *KeyName, uint8_t *KeyValue, size_t KeySize) {
+static void nvm_load_page(uint8_t page) {
+	NVM_PageState *state = &nvm_pages[page];
+	uint16_t page_offset = (uint16_t) (page * NVM_PAGE_SIZE);
+
+	if (state->seq == 0) {
+		// Free page, erase it with the next NM_Dump if it is not blank
+		for (uint16_t i = 0; i < NVM_PAGE_SIZE; i++) {
+			if (ram_nvm[page_offset + i] != DEFAULT_VALUE) {
+				state->erase = true;
+				memset(ram_nvm + page_offset, DEFAULT_VALUE, NVM_PAGE_SIZE);
+				break;
+			}
+		}
+		return;
+	}
 
-	uint8_t *i = select_sector.ram_ptr;
-	size_t read_by_size = 0;
-	while (i < (select_sector.ram_ptr + select_sector.sector_size)) {
-		if (*i == DEFAULT_VALUE) {
-			return flash_write(i, KeyName, KeyValue, KeySize);
+	uint16_t offset = sizeof(NVM_PageHeader);
+	while (offset < NVM_PAGE_SIZE) {
+		const NVM_RecordHeader *record = nvm_record(page_offset + offset);
+		if (record->magic == DEFAULT_VALUE) {
+			break;
 		}
-		read_by_size = *(size_t*) ((uint8_t*) i + MATTER_KEY_NAME_MAX_LENGTH);
-		if (read_by_size > NVM_BLOCK_SIZE) {
-			return NVM_ERROR_BLOCK_ALIGN;
+		uint16_t size = nvm_record_size(record);
+		const uint8_t *data = (const uint8_t*) (record + 1);
+		uint32_t crc = nvm_crc(0, (const uint8_t*) record, offsetof(NVM_RecordHeader, crc));
+		if ((record->magic != NVM_RECORD_MAGIC) || (record->name_len > MATTER_KEY_NAME_MAX_LENGTH)
+				|| (size > NVM_PAGE_SIZE - offset)
+				|| (nvm_crc(crc, data, record->name_len + record->value_len) != record->crc)) {
+			// Interrupted write, the rest of the page can't be programmed anymore
+			memset(ram_nvm + page_offset + offset, DEFAULT_VALUE, NVM_PAGE_SIZE - offset);
+			state->used = NVM_PAGE_SIZE;
+			state->flushed = NVM_PAGE_SIZE;
+			return;
+		}
+		if (record->flags & NVM_RECORD_FLAG_TOMBSTONE) {
+			uint16_t *slot = nvm_index_find(record->sector, data, record->name_len);
+			if (slot != NULL) {
+				nvm_index_remove(slot);
+			}
+		} else {
+			nvm_index_set(page_offset + offset);
+		}
+		offset += size;
+	}
+	state->used = offset;
+	state->flushed = offset;
+}
+
+static void nvm_compact_in_place(void) {
+	uint8_t oldest = nvm_head;
+
+	for (uint8_t page = 0; page < NVM_PAGE_COUNT; page++) {
+		if ((nvm_pages[page].seq != 0) && (nvm_pages[page].seq < nvm_pages[oldest].seq)) {
+			oldest = page;
+		}
+	}
+
+	// Move the live records and the tombstones that still hide a record to the start of the page
+	uint16_t page_offset = (uint16_t) (oldest * NVM_PAGE_SIZE);
+	uint16_t offset = sizeof(NVM_PageHeader);
+	uint16_t end = sizeof(NVM_PageHeader);
+	while (offset < nvm_pages[oldest].used) {
+		NVM_RecordHeader *record = nvm_record(page_offset + offset);
+		if (record->magic != NVM_RECORD_MAGIC) {
+			break;
+		}
+		uint16_t size = nvm_record_size(record);
+		uint16_t *slot = nvm_index_find(record->sector, (const uint8_t*) (record + 1), record->name_len);
+		bool tombstone = (record->flags & NVM_RECORD_FLAG_TOMBSTONE) != 0;
+		if (tombstone ? (slot == NULL) : ((slot != NULL) && (*slot == page_offset + offset))) {
+			memmove(ram_nvm + page_offset + end, record, size);
+			if (slot != NULL) {
+				*slot = page_offset + end;
+			}
+			end += size;
+		}
+		offset += size;
+	}
+	memset(ram_nvm + page_offset + end, DEFAULT_VALUE, NVM_PAGE_SIZE - end);
+
+	// The page becomes the head, it is erased and programmed again by the next NM_Dump
+	nvm_open_page(oldest);
+	nvm_pages[oldest].used = end;
+	nvm_pages[oldest].flushed = 0;
+	nvm_pages[oldest].erase = true;
+}
 
+static void nvm_recover(void) {
+	// A power failure during NM_Dump can leave released pages in flash, so that every page holds
+	// records. Compact the oldest pages to get a free page back.
+	for (uint8_t i = 0; (i < NVM_PAGE_COUNT) && (nvm_free_pages() == 0); i++) {
+		if (nvm_compact_oldest() != NVM_OK) {
+			// No room left in the head page: the page is rewritten in place, its records are lost
+			// if the power fails again between its erase and its programming.
+			nvm_compact_in_place();
 		}
-		i += read_by_size + sizeof(size_t) + MATTER_KEY_NAME_MAX_LENGTH;
 	}
-	return NVM_SIZE_FULL;
 }
 
-static NVM_StatusTypeDef flash_replace(const NVM_Sector_Struct select_sector,
-		uint8_t *PtKeyfind, uint8_t *KeyName, uint8_t *KeyValue, size_t KeySize) {
+static void nvm_clear(void) {
+	// Empty log, the whole area is erased by the next NM_Dump
+	memset(ram_nvm, DEFAULT_VALUE, sizeof(ram_nvm));
+	memset(nvm_pages, 0, sizeof(nvm_pages));
+	memset(nvm_index, 0xFF, sizeof(nvm_index));
+	nvm_index_count = 0;
+	nvm_live_bytes = 0;
+	nvm_head = 0;
+	for (uint8_t page = 0; page < NVM_PAGE_COUNT; page++) {
+		nvm_pages[page].erase = true;
+	}
+}
+
+static bool nvm_legacy_record(uint32_t offset, uint8_t *name_len, uint16_t *value_len) {
+	// Key record of the previous format at offset: name on 32 bytes, value size on 4 bytes, value
+	const uint8_t *flash = NVM_MATTER_ADDR_INIT_PTR;
+	uint32_t size = 0;
 
-	NVM_StatusTypeDef err = NVM_OK;
-	if ((PtKeyfind != NULL) && (KeyName != NULL) && (KeyValue != NULL)) {
-		err = delete_key(select_sector, PtKeyfind);
-		if (err != NVM_OK)
-			return err;
+	if ((LEGACY_RECORD_SIZE(0) > LEGACY_SECTOR_SIZE_SECURE - offset) || (flash[offset] == DEFAULT_VALUE)) {
+		return false;
+	}
+	memcpy(&size, flash + offset + MATTER_KEY_NAME_MAX_LENGTH, sizeof(size));
+	if ((size > NVM_BLOCK_SIZE) || (LEGACY_RECORD_SIZE(size) > LEGACY_SECTOR_SIZE_SECURE - offset)) {
+		return false;
+	}
+	*name_len = 0;
+	while ((*name_len < MATTER_KEY_NAME_MAX_LENGTH) && (flash[offset + *name_len] != 0)) {
+		(*name_len)++;
+	}
+	*value_len = (uint16_t) size;
+	return *name_len != 0;
+}
 
-		err = flash_update(select_sector, KeyName, KeyValue, KeySize);
-		if (err != NVM_OK)
-			return err;
-		return err;
+static bool nvm_import_legacy(void) {
+	const uint8_t *flash = NVM_MATTER_ADDR_INIT_PTR;
+	const uint8_t *ot = flash + LEGACY_SECTOR_SIZE_SECURE;
+	uint32_t live_bytes = 0;
+	uint32_t count = 0;
+	uint8_t name_len = 0;
+	uint16_t value_len = 0;
+
+	// Check that everything fits before importing anything, not to keep only a part of the keys
+	for (uint32_t i = 0; nvm_legacy_record(i, &name_len, &value_len); i += LEGACY_RECORD_SIZE(value_len)) {
+		live_bytes += NVM_ALIGN(sizeof(NVM_RecordHeader) + name_len + value_len);
+		count++;
+	}
+	for (uint8_t chunk = 0; chunk < NVM_OT_CHUNK_COUNT; chunk++) {
+		if (!nvm_is_blank(ot + chunk * NVM_OT_CHUNK_SIZE, NVM_OT_CHUNK_SIZE)) {
+			live_bytes += NVM_ALIGN(sizeof(NVM_RecordHeader) + 1 + NVM_OT_CHUNK_SIZE);
+			count++;
+		}
+	}
+	if ((live_bytes > NVM_LIVE_MAX) || (count > NVM_INDEX_MAX_COUNT)) {
+		return false;
 	}
-	return NVM_WRITE_FAILED;
 
+	// The whole area is rewritten by the next NM_Dump
+	nvm_clear();
+	for (uint32_t i = 0; nvm_legacy_record(i, &name_len, &value_len); i += LEGACY_RECORD_SIZE(value_len)) {
+		if (nvm_set(SECTOR_SECURE, flash + i, name_len, flash + i + LEGACY_RECORD_SIZE(0), value_len) != NVM_OK) {
+			return false;
+		}
+	}
+	for (uint8_t chunk = 0; chunk < NVM_OT_CHUNK_COUNT; chunk++) {
+		const uint8_t *value = ot + chunk * NVM_OT_CHUNK_SIZE;
+		if (!nvm_is_blank(value, NVM_OT_CHUNK_SIZE)
+				&& (nvm_set(NVM_SECTOR_OT, &chunk, 1, value, NVM_OT_CHUNK_SIZE) != NVM_OK)) {
+			return false;
+		}
+	}
+	return true;
 }
 
-static NVM_StatusTypeDef delete_key(const NVM_Sector_Struct select_sector,
-		uint8_t *PtkeyFind) {
-	uint8_t *PtKeyNext = NULL;
-	uint8_t *PtKeyCpy = NULL;
-	size_t size_key = 0;
+static void nvm_load_ot(void) {
+	for (uint8_t chunk = 0; chunk < NVM_OT_CHUNK_COUNT; chunk++) {
+		uint16_t *slot = nvm_index_find(NVM_SECTOR_OT, &chunk, 1);
+		if (slot != NULL) {
+			const NVM_RecordHeader *record = nvm_record(*slot);
+			if (record->value_len == NVM_OT_CHUNK_SIZE) {
+				memcpy(ram_nvm_ot + chunk * NVM_OT_CHUNK_SIZE, (const uint8_t*) (record + 1) + 1,
+						NVM_OT_CHUNK_SIZE);
+			}
+		}
+	}
+}
+
+static NVM_StatusTypeDef nvm_save_ot(void) {
+	NVM_StatusTypeDef status = NVM_OK;
 
-	if (PtkeyFind != NULL) {
-		size_key =
-				*(size_t*) ((uint8_t*) PtkeyFind + MATTER_KEY_NAME_MAX_LENGTH);
-		PtKeyNext = PtkeyFind + size_key + MATTER_KEY_NAME_MAX_LENGTH
-				+ sizeof(size_key);
-		PtKeyCpy = PtkeyFind;
-		while ((*PtKeyNext != 0xFF)
-				&& (PtKeyNext
-						< (select_sector.ram_ptr + select_sector.sector_size))) {
-			size_key = *(size_t*) ((uint8_t*) PtKeyNext
-					+ MATTER_KEY_NAME_MAX_LENGTH);
-			memcpy(PtKeyCpy, PtKeyNext,
-					size_key + sizeof(size_t) + MATTER_KEY_NAME_MAX_LENGTH);
-			PtKeyCpy += size_key + sizeof(size_t) + MATTER_KEY_NAME_MAX_LENGTH;
-			PtKeyNext += size_key + MATTER_KEY_NAME_MAX_LENGTH
-					+ sizeof(size_key);
+	for (uint8_t chunk = 0; (chunk < NVM_OT_CHUNK_COUNT) && (status == NVM_OK); chunk++) {
+		const uint8_t *value = ram_nvm_ot + chunk * NVM_OT_CHUNK_SIZE;
+		if (!nvm_is_blank(value, NVM_OT_CHUNK_SIZE)) {
+			status = nvm_set(NVM_SECTOR_OT, &chunk, 1, value, NVM_OT_CHUNK_SIZE);
+		} else if (nvm_index_find(NVM_SECTOR_OT, &chunk, 1) != NULL) {
+			status = nvm_delete(NVM_SECTOR_OT, &chunk, 1);
 		}
-		memset(PtKeyCpy, DEFAULT_VALUE,
-				(select_sector.ram_ptr + select_sector.sector_size - PtKeyCpy));
-		return NVM_OK;
 	}
-	return NVM_DELETE_FAILED;
+	return status;
 }
 
-static NVM_StatusTypeDef flash_write(uint8_t *PtKeyFree, uint8_t *key,
-		uint8_t *value, size_t value_size) {
+static bool nvm_flash_before(const NVM_PageState *page, const NVM_PageState *other) {
+	// Pages of the log by sequence number, then the free pages to erase, oldest first
+	if ((page->seq == 0) != (other->seq == 0)) {
+		return page->seq != 0;
+	}
+	if (page->seq != 0) {
+		return page->seq < other->seq;
+	}
+	return page->flash_seq < other->flash_seq;
+}
 
-	if ((PtKeyFree != NULL) && (key != NULL) && (value != NULL)) {
+static void nvm_flash_next_op(void) {
+	while (nvm_flash_op_index < nvm_flash_op_count) {
+		NVM_FlashOp *op = &nvm_flash_ops[nvm_flash_op_index];
+		uint32_t offset = op->page * NVM_PAGE_SIZE + op->offset;
+		FM_Cmd_Status_t status;
 
-		memset(PtKeyFree, DEFAULT_VALUE, value_size);
-		memset(PtKeyFree, 0x00, MATTER_KEY_NAME_MAX_LENGTH);
-		memcpy(PtKeyFree, key, strlen((char*) key));
-		memcpy(PtKeyFree + MATTER_KEY_NAME_MAX_LENGTH, &value_size,
-				sizeof(size_t));
-		memcpy(PtKeyFree + MATTER_KEY_NAME_MAX_LENGTH + sizeof(size_t), value,
-				value_size);
-		return NVM_OK;
+		if (op->erase) {
+			status = FM_Erase(START_SECTOR_FLASH_NVM + op->page, 1, &FM_DumpStatusCallback);
+		} else {
+			status = FM_Write((uint32_t*) (ram_nvm + offset), (uint32_t*) (uintptr_t) (START_NVM_Matter + offset),
+					op->size / sizeof(uint32_t), &FM_DumpStatusCallback);
+		}
+		if (status != FM_ERROR) {
+			// FM_OK: done in the CallBack, FM_BUSY: CallBack when the flash manager is available
+			return;
+		}
+		// Stop there, not to erase pages whose records were not programmed elsewhere.
+		// The remaining operations are retried by the next NM_Dump.
+		APP_DBG("ERROR NVM : flash operation failed");
+		break;
 	}
-	return NVM_WRITE_FAILED;
+	UnLockFMThread();
 }
 
 void LockFMThread(void) {
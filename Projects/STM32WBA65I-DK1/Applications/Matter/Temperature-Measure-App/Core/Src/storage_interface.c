@@ -36,8 +36,6 @@
 #define NB_PAGE_SECTOR_PER_ERASE  (1U)  /* Nb page erased per erase */
 
 
-#define ITS_LOCATION         0X081EA000 /* ITS start address */
-#define ITS_MAX_SIZE         (8*1024U)  /* 8 KBytes */
 #define ITS_SLOT_MAX_NUMBER  (16U)
 #define ITS_SLOT_OFFSET      0x00000080 /* 128 words (32 bits)) */
 
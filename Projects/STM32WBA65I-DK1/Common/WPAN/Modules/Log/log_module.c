@@ -20,6 +20,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h> /* vsnprintf */
+#include <string.h> /* strlen, memcpy */
 
 #include "log_module.h"
 #include "stm32_adv_trace.h"
@@ -39,6 +40,13 @@
 /* Definition of 'End Of Line' */
 #define ENDOFLINE_SIZE          (0x01u)
 #define ENDOFLINE_CHAR          '\n'
+
+/* The logs are formatted on the host when the traces are in deferred mode */
+#if defined(UTIL_ADV_TRACE_CONDITIONNAL) && defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+#define LOG_DEFERRED_FORMATTING (1)
+#else
+#define LOG_DEFERRED_FORMATTING (0)
+#endif /* UTIL_ADV_TRACE_CONDITIONNAL && UTIL_ADV_TRACE_DEFERRED_MODE */
 /* USER CODE BEGIN PD */
 
 /* USER CODE END PD */
@@ -88,7 +96,7 @@ CallBack_TimeStamp *            log_timestamp_function;
 /* Private function prototypes -----------------------------------------------*/
 static uint32_t Get_Region_Mask(Log_Region_t Region);
 
-#if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0)
+#if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0) && (LOG_DEFERRED_FORMATTING == 0)
 static uint16_t RegionToColor(char * TextBuffer, uint16_t SizeMax, Log_Region_t Region);
 #endif /* LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0  */
 /* USER CODE BEGIN PFP */
@@ -96,7 +104,7 @@ static uint16_t RegionToColor(char * TextBuffer, uint16_t SizeMax, Log_Region_t
 /* USER CODE END PFP */
 
 /* Functions Definition ------------------------------------------------------*/
-#if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0)
+#if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0) && (LOG_DEFERRED_FORMATTING == 0)
 /**
  * @brief Add the color (in function of Region) on the start of Log sentence.
  *
@@ -143,9 +151,11 @@ static uint16_t RegionToColor(char * TextBuffer, uint16_t SizeMax, Log_Region_t
 
 void Log_Module_PrintWithArg(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args)
 {
+#if (LOG_DEFERRED_FORMATTING == 0)
   uint16_t tmp_size = 0;
   uint16_t buffer_size = 0;
   char full_text[UTIL_ADV_TRACE_TMP_BUF_SIZE + 1u];
+#endif /* LOG_DEFERRED_FORMATTING == 0 */
 
   /* USER CODE BEGIN Log_Module_PrintWithArg_1 */
 
@@ -163,6 +173,19 @@ void Log_Module_PrintWithArg(Log_Verbose_Level_t VerboseLevel, Log_Region_t Regi
     return;
   }
 
+#if (LOG_DEFERRED_FORMATTING != 0)
+  /* Post the format address and the arguments, adv_trace_decode.py formats the text on the host.
+   * The time stamp is the raw one registered with UTIL_ADV_TRACE_RegisterRawTimeStampFunction, no color is added. */
+  UTIL_ADV_TRACE_DeferredVSend(((LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0) ? 1u : 0u), Text, Args);
+
+#if (LOG_INSERT_EOL_INSIDE_THE_TRACE != 0)
+  /* Add End Of Line if the format does not end with one */
+  if ((Text[0] == '\0') || (Text[strlen(Text) - 1u] != ENDOFLINE_CHAR))
+  {
+    UTIL_ADV_TRACE_Send((const uint8_t *)"\n", ENDOFLINE_SIZE);
+  }
+#endif /* LOG_INSERT_EOL_INSIDE_THE_TRACE != 0 */
+#else /* LOG_DEFERRED_FORMATTING != 0 */
 #if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0)
   /* Add to full_text the color matching the region */
   tmp_size = RegionToColor(&full_text[buffer_size], (UTIL_ADV_TRACE_TMP_BUF_SIZE - buffer_size), Region);
@@ -204,6 +227,7 @@ void Log_Module_PrintWithArg(Log_Verbose_Level_t VerboseLevel, Log_Region_t Regi
 
   /* Send full_text to ADV Traces */
   UTIL_ADV_TRACE_Send((const uint8_t *)full_text, buffer_size);
+#endif /* LOG_DEFERRED_FORMATTING != 0 */
 }
 
 void Log_Module_Print(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, ...)
@@ -0,0 +1,126 @@
+/**
+ ******************************************************************************
+ * @file    bench_stm32_timer.c
+ * @brief   Host benchmark of the stm32_timer.c critical sections
+ ******************************************************************************
+ *
+ * Built once per backend (UTIL_TIMER_HEAP_BACKEND 0 and 1). Keeps a given
+ * number of timers running, then stops, restarts and expires them in a loop,
+ * and reports the length of the timer server critical sections taken by
+ * UTIL_TIMER_Start, UTIL_TIMER_Stop and UTIL_TIMER_IRQ_Handler: these are the
+ * intervals the application runs with interrupts disabled. The host may
+ * preempt the benchmark, so the 99.9th percentile is a better estimate of the
+ * worst case than the maximum.
+ */
+#include "stm32_timer.h"
+#include "timer_if_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_MAX_TIMERS 512U
+#define BENCH_ITERATIONS 20000U
+#define BENCH_MAX_SAMPLES (BENCH_ITERATIONS * 4U)
+
+static UTIL_TIMER_Object_t timers[BENCH_MAX_TIMERS];
+static UTIL_TIMER_Object_t *expired[BENCH_MAX_TIMERS];
+static unsigned expired_count;
+static uint32_t rng_state;
+
+static uint32_t start_samples[BENCH_MAX_SAMPLES];
+static uint32_t stop_samples[BENCH_MAX_SAMPLES];
+static uint32_t irq_samples[BENCH_MAX_SAMPLES];
+
+static uint32_t rng(void)
+{
+  rng_state = rng_state * 1664525U + 1013904223U;
+  return rng_state >> 8;
+}
+
+static void on_timer(void *argument)
+{
+  /* restarted by the benchmark loop, so that the restart is not accounted to the IRQ handler */
+  expired[expired_count++] = (UTIL_TIMER_Object_t *)argument;
+}
+
+static int compare_samples(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static void report(const char *operation, unsigned timer_count, timer_sim_critical_log_t *log)
+{
+  uint64_t total = 0;
+
+  if (log->count == 0)
+  {
+    return;
+  }
+  qsort(log->samples, log->count, sizeof(log->samples[0]), compare_samples);
+  for (uint32_t i = 0; i < log->count; i++)
+  {
+    total += log->samples[i];
+  }
+  printf("%-6s %4u timers %7u calls  mean %6.0f ns  p99 %6u ns  p99.9 %6u ns  max %7u ns\n", operation, timer_count,
+         log->count, (double)total / (double)log->count, log->samples[(log->count * 99U) / 100U],
+         log->samples[(log->count * 999U) / 1000U], log->samples[log->count - 1U]);
+}
+
+static void bench(unsigned timer_count)
+{
+  timer_sim_critical_log_t start_log = { start_samples, BENCH_MAX_SAMPLES, 0 };
+  timer_sim_critical_log_t stop_log = { stop_samples, BENCH_MAX_SAMPLES, 0 };
+  timer_sim_critical_log_t irq_log = { irq_samples, BENCH_MAX_SAMPLES, 0 };
+
+  rng_state = 12345U;
+  expired_count = 0;
+  timer_sim_reset(0U, 3U);
+  UTIL_TIMER_Init();
+  for (unsigned i = 0; i < timer_count; i++)
+  {
+    UTIL_TIMER_Create(&timers[i], 100U + (rng() % 10000U), UTIL_TIMER_ONESHOT, on_timer, &timers[i]);
+    UTIL_TIMER_Start(&timers[i]);
+  }
+
+  for (unsigned i = 0; i < BENCH_ITERATIONS; i++)
+  {
+    UTIL_TIMER_Object_t *timer = &timers[rng() % timer_count];
+
+    timer_sim_set_critical_log(&stop_log);
+    UTIL_TIMER_Stop(timer);
+
+    timer_sim_set_critical_log(NULL);
+    UTIL_TIMER_SetPeriod(timer, 100U + (rng() % 10000U));
+    timer_sim_set_critical_log(&start_log);
+    UTIL_TIMER_Start(timer);
+
+    timer_sim_set_critical_log(&irq_log);
+    timer_sim_advance(rng() % 20U);
+
+    /* keep the number of running timers constant */
+    timer_sim_set_critical_log(&start_log);
+    while (expired_count != 0)
+    {
+      UTIL_TIMER_Start(expired[--expired_count]);
+    }
+  }
+  timer_sim_set_critical_log(NULL);
+
+  report("start", timer_count, &start_log);
+  report("stop", timer_count, &stop_log);
+  report("irq", timer_count, &irq_log);
+}
+
+int main(void)
+{
+  static const unsigned timer_counts[] = { 8, 64, 512 };
+
+  printf("stm32_timer %s backend, critical section length\n", (UTIL_TIMER_HEAP_BACKEND == 1) ? "heap" : "list");
+  for (unsigned i = 0; i < sizeof(timer_counts) / sizeof(timer_counts[0]); i++)
+  {
+    bench(timer_counts[i]);
+  }
+  return 0;
+}
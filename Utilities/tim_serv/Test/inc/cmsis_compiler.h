@@ -0,0 +1,10 @@
+/**
+ ******************************************************************************
+ * @file    cmsis_compiler.h
+ * @brief   Host stub of CMSIS, for the stm32_timer.c host build
+ ******************************************************************************
+ */
+#ifndef CMSIS_COMPILER_H
+#define CMSIS_COMPILER_H
+
+#endif /* CMSIS_COMPILER_H */
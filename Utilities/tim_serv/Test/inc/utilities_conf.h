@@ -0,0 +1,18 @@
+/**
+ ******************************************************************************
+ * @file    utilities_conf.h
+ * @brief   Utilities configuration for the stm32_timer.c host build
+ ******************************************************************************
+ *
+ * The timer server critical sections are routed to the simulator, which
+ * measures how long they last.
+ */
+#ifndef UTILITIES_CONF_H
+#define UTILITIES_CONF_H
+
+#include "timer_if_sim.h"
+
+#define UTIL_TIMER_ENTER_CRITICAL_SECTION()   timer_sim_enter_critical()
+#define UTIL_TIMER_EXIT_CRITICAL_SECTION()    timer_sim_exit_critical()
+
+#endif /* UTILITIES_CONF_H */
@@ -0,0 +1,393 @@
+/**
+ ******************************************************************************
+ * @file    test_stm32_timer.c
+ * @brief   Host tests of the stm32_timer.c timer server
+ ******************************************************************************
+ *
+ * Built once per backend (UTIL_TIMER_HEAP_BACKEND 0 and 1). Random sequences
+ * of start, stop and period changes are checked against a model of the
+ * expected deadlines: a timer only fires when it is running, never before
+ * its deadline, never much later, and always as the next timer to expire.
+ */
+#include "stm32_timer.h"
+#include "timer_if_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_TIMER_COUNT 48
+#define TEST_MIN_TIMEOUT 3U
+/* each IRQ handles one timer, the next one is scheduled after the minimum timeout */
+#define TEST_MAX_LATENESS ((uint64_t)TEST_MIN_TIMEOUT * (TEST_TIMER_COUNT + 1U))
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      failures++; \
+    } \
+  } while (0)
+
+static unsigned failures;
+
+/* Model of a timer */
+typedef struct {
+  UTIL_TIMER_Object_t timer;
+  bool running;
+  bool periodic;
+  bool restart_in_callback;
+  uint32_t period;
+  uint64_t deadline;
+  unsigned fired;
+} TestTimer;
+
+static TestTimer timers[TEST_TIMER_COUNT];
+static uint64_t fire_log[TEST_TIMER_COUNT * 4];
+static unsigned fire_log_count;
+
+/* 64-bit view of the simulated counter, the simulated counter wraps */
+static uint64_t model_now;
+static uint32_t model_last;
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+  rng_state = rng_state * 1664525U + 1013904223U;
+  return rng_state >> 8;
+}
+
+static uint64_t now(void)
+{
+  uint32_t sim = timer_sim_now();
+  model_now += (uint32_t)(sim - model_last);
+  model_last = sim;
+  return model_now;
+}
+
+static uint64_t ticks_of(uint32_t period)
+{
+  return (period < TEST_MIN_TIMEOUT) ? TEST_MIN_TIMEOUT : period;
+}
+
+static uint64_t min_deadline(void)
+{
+  uint64_t min = UINT64_MAX;
+  for (unsigned i = 0; i < TEST_TIMER_COUNT; i++)
+  {
+    if (timers[i].running && (timers[i].deadline < min))
+    {
+      min = timers[i].deadline;
+    }
+  }
+  return min;
+}
+
+static void on_timer(void *argument)
+{
+  TestTimer *t = (TestTimer *)argument;
+  uint64_t time = now();
+
+  CHECK(t->running);
+  CHECK(time >= t->deadline);
+  CHECK(time - t->deadline <= TEST_MAX_LATENESS);
+  /* the head may have been pushed by the minimum timeout when it was programmed */
+  CHECK(t->deadline <= min_deadline() + TEST_MIN_TIMEOUT);
+
+  t->fired++;
+  if (fire_log_count < sizeof(fire_log) / sizeof(fire_log[0]))
+  {
+    fire_log[fire_log_count++] = (uint64_t)(t - timers);
+  }
+
+  if (t->periodic)
+  {
+    t->deadline = time + ticks_of(t->period);
+  }
+  else
+  {
+    t->running = false;
+    if (t->restart_in_callback)
+    {
+      CHECK(UTIL_TIMER_Start(&t->timer) == UTIL_TIMER_OK);
+      t->running = true;
+      t->deadline = time + ticks_of(t->period);
+    }
+  }
+}
+
+static void reset(uint32_t start, unsigned count)
+{
+  timer_sim_reset(start, TEST_MIN_TIMEOUT);
+  model_now = 0;
+  model_last = start;
+  fire_log_count = 0;
+  CHECK(UTIL_TIMER_Init() == UTIL_TIMER_OK);
+
+  memset(timers, 0, sizeof(timers));
+  for (unsigned i = 0; i < count; i++)
+  {
+    TestTimer *t = &timers[i];
+    t->periodic = (rng() % 4) == 0;
+    t->restart_in_callback = !t->periodic && ((rng() % 4) == 0);
+    t->period = rng() % 500;
+    CHECK(UTIL_TIMER_Create(&t->timer, t->period, t->periodic ? UTIL_TIMER_PERIODIC : UTIL_TIMER_ONESHOT, on_timer, t) ==
+          UTIL_TIMER_OK);
+  }
+}
+
+static void start(TestTimer *t)
+{
+  UTIL_TIMER_Status_t status = UTIL_TIMER_Start(&t->timer);
+  if (t->running)
+  {
+    CHECK(status == UTIL_TIMER_INVALID_PARAM);
+  }
+  else
+  {
+    CHECK(status == UTIL_TIMER_OK);
+    t->running = true;
+    t->deadline = now() + ticks_of(t->period);
+  }
+}
+
+static void stop(TestTimer *t)
+{
+  CHECK(UTIL_TIMER_Stop(&t->timer) == UTIL_TIMER_OK);
+  t->running = false;
+}
+
+static void advance(uint32_t ticks)
+{
+  timer_sim_advance(ticks);
+  (void)now();
+}
+
+/* Checks the running state and remaining time of every timer */
+static void check_timers(unsigned count)
+{
+  uint64_t time = now();
+  uint32_t first = UINT32_MAX;
+  uint32_t remaining;
+
+  for (unsigned i = 0; i < count; i++)
+  {
+    TestTimer *t = &timers[i];
+    CHECK(UTIL_TIMER_IsRunning(&t->timer) == (t->running ? 1U : 0U));
+    if (!t->running)
+    {
+      CHECK(UTIL_TIMER_GetRemainingTime(&t->timer, &remaining) == UTIL_TIMER_INVALID_PARAM);
+      continue;
+    }
+
+    /* a timer is never overdue by more than the time needed to handle the ones before it */
+    CHECK((t->deadline >= time) || (time - t->deadline <= TEST_MAX_LATENESS));
+
+    uint64_t expected = (t->deadline > time) ? t->deadline - time : 0U;
+    CHECK(UTIL_TIMER_GetRemainingTime(&t->timer, &remaining) == UTIL_TIMER_OK);
+    CHECK(remaining >= expected);
+    CHECK(remaining <= expected + TEST_MIN_TIMEOUT);
+    if (remaining < first)
+    {
+      first = remaining;
+    }
+  }
+
+  uint32_t head_remaining = UTIL_TIMER_GetFirstRemainingTime();
+  if (first == UINT32_MAX)
+  {
+    CHECK(head_remaining == UINT32_MAX);
+    CHECK(UTIL_TIMER_GetTimerList() == NULL);
+  }
+  else
+  {
+    CHECK(head_remaining <= first + TEST_MIN_TIMEOUT);
+  }
+}
+
+static void drain(unsigned count)
+{
+  for (unsigned i = 0; i < count; i++)
+  {
+    if (timers[i].periodic || timers[i].restart_in_callback)
+    {
+      timers[i].restart_in_callback = false;
+      stop(&timers[i]);
+    }
+  }
+  advance(2000U);
+  for (unsigned i = 0; i < count; i++)
+  {
+    CHECK(!timers[i].running);
+  }
+  check_timers(count);
+}
+
+static void test_order(void)
+{
+  static const uint32_t periods[] = { 50, 10, 40, 20, 30 };
+  const unsigned count = sizeof(periods) / sizeof(periods[0]);
+
+  reset(1000U, count);
+  for (unsigned i = 0; i < count; i++)
+  {
+    timers[i].periodic = false;
+    timers[i].restart_in_callback = false;
+    timers[i].period = periods[i];
+    CHECK(UTIL_TIMER_Create(&timers[i].timer, periods[i], UTIL_TIMER_ONESHOT, on_timer, &timers[i]) == UTIL_TIMER_OK);
+    start(&timers[i]);
+  }
+  CHECK(UTIL_TIMER_GetTimerList() == &timers[1].timer);
+  check_timers(count);
+
+  advance(100U);
+  CHECK(fire_log_count == count);
+  CHECK(fire_log[0] == 1 && fire_log[1] == 3 && fire_log[2] == 4 && fire_log[3] == 2 && fire_log[4] == 0);
+  CHECK(timer_sim_irq_count() == count);
+  check_timers(count);
+}
+
+static void test_stop_head(void)
+{
+  uint32_t alarm;
+
+  reset(0U, 3);
+  for (unsigned i = 0; i < 3; i++)
+  {
+    timers[i].periodic = false;
+    timers[i].restart_in_callback = false;
+    timers[i].period = 100U * (i + 1U);
+    CHECK(UTIL_TIMER_Create(&timers[i].timer, timers[i].period, UTIL_TIMER_ONESHOT, on_timer, &timers[i]) == UTIL_TIMER_OK);
+    start(&timers[i]);
+  }
+  CHECK(timer_sim_alarm(&alarm) && alarm == 100U);
+
+  /* stopping the head programs the next timer, stopping another timer does not change the alarm */
+  stop(&timers[0]);
+  CHECK(timer_sim_alarm(&alarm) && alarm == 200U);
+  stop(&timers[2]);
+  CHECK(timer_sim_alarm(&alarm) && alarm == 200U);
+  stop(&timers[1]);
+  CHECK(!timer_sim_alarm(&alarm));
+
+  /* a timer can be stopped twice and restarted */
+  stop(&timers[1]);
+  start(&timers[1]);
+  CHECK(timer_sim_alarm(&alarm) && alarm == 200U);
+  advance(300U);
+  CHECK(timers[0].fired == 0 && timers[1].fired == 1 && timers[2].fired == 0);
+  check_timers(3);
+}
+
+static void test_periodic(void)
+{
+  reset(500U, 1);
+  timers[0].periodic = true;
+  timers[0].restart_in_callback = false;
+  timers[0].period = 10U;
+  CHECK(UTIL_TIMER_Create(&timers[0].timer, 10U, UTIL_TIMER_PERIODIC, on_timer, &timers[0]) == UTIL_TIMER_OK);
+  start(&timers[0]);
+  advance(105U);
+  CHECK(timers[0].fired == 10);
+
+  /* a new period applies from now on */
+  CHECK(UTIL_TIMER_SetPeriod(&timers[0].timer, 20U) == UTIL_TIMER_OK);
+  timers[0].period = 20U;
+  timers[0].deadline = now() + 20U;
+  advance(100U);
+  CHECK(timers[0].fired == 15);
+  check_timers(1);
+  drain(1);
+}
+
+static void test_random(uint32_t start_time, unsigned iterations)
+{
+  reset(start_time, TEST_TIMER_COUNT);
+
+  for (unsigned i = 0; i < iterations; i++)
+  {
+    TestTimer *t = &timers[rng() % TEST_TIMER_COUNT];
+    uint32_t period;
+
+    switch (rng() % 8)
+    {
+    case 0:
+    case 1:
+    case 2:
+      start(t);
+      break;
+    case 3:
+      stop(t);
+      break;
+    case 4:
+      period = rng() % 500;
+      CHECK(UTIL_TIMER_StartWithPeriod(&t->timer, period) == UTIL_TIMER_OK);
+      t->period = period;
+      t->running = true;
+      t->deadline = now() + ticks_of(period);
+      break;
+    case 5:
+      period = rng() % 500;
+      CHECK(UTIL_TIMER_SetPeriod(&t->timer, period) == UTIL_TIMER_OK);
+      t->period = period;
+      if (t->running)
+      {
+        t->deadline = now() + ticks_of(period);
+      }
+      break;
+    default:
+      advance(((rng() % 16) == 0) ? rng() % 2000 : rng() % 50);
+      break;
+    }
+    check_timers(TEST_TIMER_COUNT);
+  }
+  drain(TEST_TIMER_COUNT);
+}
+
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+static void test_heap_full(void)
+{
+  static UTIL_TIMER_Object_t objects[UTIL_TIMER_HEAP_SIZE + 1U];
+  static TestTimer dummy;
+
+  reset(0U, 0);
+  for (unsigned i = 0; i < UTIL_TIMER_HEAP_SIZE + 1U; i++)
+  {
+    CHECK(UTIL_TIMER_Create(&objects[i], 1000U + i, UTIL_TIMER_ONESHOT, on_timer, &dummy) == UTIL_TIMER_OK);
+  }
+  for (unsigned i = 0; i < UTIL_TIMER_HEAP_SIZE; i++)
+  {
+    CHECK(UTIL_TIMER_Start(&objects[i]) == UTIL_TIMER_OK);
+  }
+  CHECK(UTIL_TIMER_Start(&objects[UTIL_TIMER_HEAP_SIZE]) == UTIL_TIMER_UNKNOWN_ERROR);
+  CHECK(UTIL_TIMER_IsRunning(&objects[UTIL_TIMER_HEAP_SIZE]) == 0U);
+
+  CHECK(UTIL_TIMER_Stop(&objects[UTIL_TIMER_HEAP_SIZE / 2U]) == UTIL_TIMER_OK);
+  CHECK(UTIL_TIMER_Start(&objects[UTIL_TIMER_HEAP_SIZE]) == UTIL_TIMER_OK);
+  for (unsigned i = 0; i < UTIL_TIMER_HEAP_SIZE + 1U; i++)
+  {
+    CHECK(UTIL_TIMER_Stop(&objects[i]) == UTIL_TIMER_OK);
+  }
+  CHECK(UTIL_TIMER_GetTimerList() == NULL);
+}
+#endif /* UTIL_TIMER_HEAP_BACKEND */
+
+int main(void)
+{
+  rng_state = 12345U;
+
+  test_order();
+  test_stop_head();
+  test_periodic();
+  test_random(0U, 20000);
+  /* the simulated counter wraps during the test */
+  test_random(UINT32_MAX - 5000U, 20000);
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+  test_heap_full();
+#endif
+
+  printf("%s (%s backend): %u failure(s)\n", (failures == 0) ? "PASSED" : "FAILED",
+         (UTIL_TIMER_HEAP_BACKEND == 1) ? "heap" : "list", failures);
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+/**
+ ******************************************************************************
+ * @file    timer_if_sim.c
+ * @brief   Simulated timer interface, for the stm32_timer.c host build
+ ******************************************************************************
+ */
+#include "timer_if_sim.h"
+#include "stm32_timer.h"
+
+#include <assert.h>
+#include <time.h>
+
+static uint32_t sim_now;
+static uint32_t sim_context;
+static uint32_t sim_min_timeout;
+static uint32_t sim_alarm;
+static bool sim_alarm_armed;
+static uint32_t sim_irq_count;
+
+static unsigned critical_depth;
+static uint64_t critical_start_ns;
+static timer_sim_critical_log_t *critical_log;
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static UTIL_TIMER_Status_t SIM_Init(void)
+{
+  return UTIL_TIMER_OK;
+}
+
+static UTIL_TIMER_Status_t SIM_DeInit(void)
+{
+  return UTIL_TIMER_OK;
+}
+
+static UTIL_TIMER_Status_t SIM_StartTimer(uint32_t timeout)
+{
+  sim_alarm = sim_context + timeout;
+  sim_alarm_armed = true;
+  return UTIL_TIMER_OK;
+}
+
+static UTIL_TIMER_Status_t SIM_StopTimer(void)
+{
+  sim_alarm_armed = false;
+  return UTIL_TIMER_OK;
+}
+
+static uint32_t SIM_SetTimerContext(void)
+{
+  sim_context = sim_now;
+  return sim_context;
+}
+
+static uint32_t SIM_GetTimerContext(void)
+{
+  return sim_context;
+}
+
+static uint32_t SIM_GetTimerElapsedTime(void)
+{
+  return sim_now - sim_context;
+}
+
+static uint32_t SIM_GetTimerValue(void)
+{
+  return sim_now;
+}
+
+static uint32_t SIM_GetMinimumTimeout(void)
+{
+  return sim_min_timeout;
+}
+
+static uint32_t SIM_ms2Tick(uint32_t timeMilliSec)
+{
+  return timeMilliSec;
+}
+
+static uint32_t SIM_Tick2ms(uint32_t tick)
+{
+  return tick;
+}
+
+const UTIL_TIMER_Driver_s UTIL_TimerDriver =
+{
+  SIM_Init,
+  SIM_DeInit,
+
+  SIM_StartTimer,
+  SIM_StopTimer,
+
+  SIM_SetTimerContext,
+  SIM_GetTimerContext,
+
+  SIM_GetTimerElapsedTime,
+  SIM_GetTimerValue,
+  SIM_GetMinimumTimeout,
+
+  SIM_ms2Tick,
+  SIM_Tick2ms,
+};
+
+void timer_sim_reset(uint32_t now, uint32_t min_timeout)
+{
+  sim_now = now;
+  sim_context = now;
+  sim_min_timeout = min_timeout;
+  sim_alarm_armed = false;
+  sim_irq_count = 0;
+}
+
+uint32_t timer_sim_now(void)
+{
+  return sim_now;
+}
+
+void timer_sim_advance(uint32_t ticks)
+{
+  uint32_t target = sim_now + ticks;
+
+  /* the alarm is always programmed at least the minimum timeout ahead of the counter */
+  while (sim_alarm_armed && ((uint32_t)(sim_alarm - sim_now) <= (uint32_t)(target - sim_now)))
+  {
+    sim_now = sim_alarm;
+    sim_alarm_armed = false;
+    sim_irq_count++;
+    UTIL_TIMER_IRQ_Handler();
+  }
+  sim_now = target;
+}
+
+bool timer_sim_alarm(uint32_t *alarm)
+{
+  *alarm = sim_alarm;
+  return sim_alarm_armed;
+}
+
+uint32_t timer_sim_irq_count(void)
+{
+  return sim_irq_count;
+}
+
+void timer_sim_enter_critical(void)
+{
+  if (critical_depth++ == 0)
+  {
+    critical_start_ns = now_ns();
+  }
+}
+
+void timer_sim_exit_critical(void)
+{
+  assert(critical_depth > 0);
+  if (--critical_depth == 0)
+  {
+    uint64_t duration = now_ns() - critical_start_ns;
+    if ((critical_log != NULL) && (critical_log->count < critical_log->capacity))
+    {
+      critical_log->samples[critical_log->count++] = (duration > UINT32_MAX) ? UINT32_MAX : (uint32_t)duration;
+    }
+  }
+}
+
+void timer_sim_set_critical_log(timer_sim_critical_log_t *log)
+{
+  critical_log = log;
+}
@@ -0,0 +1,49 @@
+/**
+ ******************************************************************************
+ * @file    timer_if_sim.h
+ * @brief   Simulated timer interface, for the stm32_timer.c host build
+ ******************************************************************************
+ *
+ * Implements UTIL_TimerDriver as stm32_timer_if_template.c describes it, on
+ * top of a simulated 32-bit up-counting timer: one tick is one millisecond,
+ * the alarm fires when the counter reaches context + timeout, and the
+ * counter only moves when the test calls timer_sim_advance.
+ *
+ * The timer server critical sections are routed to timer_sim_enter_critical
+ * and timer_sim_exit_critical, which measure their length with the host
+ * monotonic clock and record it in a timer_sim_critical_log_t.
+ */
+#ifndef TIMER_IF_SIM_H
+#define TIMER_IF_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  uint32_t *samples;    /* length in ns of each outermost critical section */
+  uint32_t capacity;
+  uint32_t count;       /* samples recorded, at most capacity */
+} timer_sim_critical_log_t;
+
+/* Sets the counter value and the minimum timeout, and disarms the alarm */
+void timer_sim_reset(uint32_t now, uint32_t min_timeout);
+
+/* Current counter value */
+uint32_t timer_sim_now(void);
+
+/* Moves the counter forward, calling UTIL_TIMER_IRQ_Handler at each alarm */
+void timer_sim_advance(uint32_t ticks);
+
+/* Absolute counter value of the armed alarm, false if the alarm is not armed */
+bool timer_sim_alarm(uint32_t *alarm);
+
+/* Number of alarms since the last reset */
+uint32_t timer_sim_irq_count(void);
+
+void timer_sim_enter_critical(void);
+void timer_sim_exit_critical(void);
+
+/* Records the length of the next critical sections in the log, NULL to stop recording */
+void timer_sim_set_critical_log(timer_sim_critical_log_t *log);
+
+#endif /* TIMER_IF_SIM_H */
@@ -83,11 +83,43 @@
  *  @{
  */
 
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+/**
+  * @brief Running timer and its expiry time
+  *
+  */
+typedef struct
+{
+  uint64_t Deadline;            /*!<Expiry time in ticks, on the TimerEpoch time base */
+  UTIL_TIMER_Object_t *Timer;   /*!<Running timer                                     */
+} UTIL_TIMER_HeapEntry_t;
+
+/**
+  * @brief Running timers, binary min-heap ordered by deadline
+  *
+  */
+static UTIL_TIMER_HeapEntry_t TimerHeap[UTIL_TIMER_HEAP_SIZE];
+
+/**
+  * @brief Number of running timers
+  *
+  */
+static uint32_t TimerHeapCount = 0U;
+
+/**
+  * @brief Ticks from the timer server initialization to the current timer context
+  *
+  * @note Deadlines are absolute on this 64-bit time base so that moving the timer
+  *       context does not require to update every running timer.
+  */
+static uint64_t TimerEpoch = 0U;
+#else
 /**
   * @brief Timers list head pointer
   *
   */
 static UTIL_TIMER_Object_t *TimerListHead = NULL;
+#endif /* UTIL_TIMER_HEAP_BACKEND */
 
 /**
   *  @}
@@ -98,8 +130,17 @@ static UTIL_TIMER_Object_t *TimerListHead = NULL;
  *  @{
  */
 
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+static void TimerHeapPlace( uint32_t Index, const UTIL_TIMER_HeapEntry_t *Entry );
+static void TimerHeapFix( uint32_t Index, UTIL_TIMER_HeapEntry_t Entry );
+static void TimerHeapInsert( const UTIL_TIMER_HeapEntry_t *Entry );
+static void TimerHeapRemove( uint32_t Index );
+static uint32_t TimerHeapTimestamp( const UTIL_TIMER_HeapEntry_t *Entry );
+static void TimerUpdateContext( void );
+#else
 void TimerInsertNewHeadTimer( UTIL_TIMER_Object_t *TimerObject );
 void TimerInsertTimer( UTIL_TIMER_Object_t *TimerObject );
+#endif /* UTIL_TIMER_HEAP_BACKEND */
 void TimerSetTimeout( UTIL_TIMER_Object_t *TimerObject );
 bool TimerExists( UTIL_TIMER_Object_t *TimerObject );
 
@@ -116,7 +157,12 @@ bool TimerExists( UTIL_TIMER_Object_t *TimerObject );
 UTIL_TIMER_Status_t UTIL_TIMER_Init(void)
 {
   UTIL_TIMER_INIT_CRITICAL_SECTION();
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+  TimerHeapCount = 0U;
+  TimerEpoch = 0U;
+#else
   TimerListHead = NULL;
+#endif /* UTIL_TIMER_HEAP_BACKEND */
   return UTIL_TimerDriver.InitTimer();
 }
 
@@ -146,6 +192,69 @@ UTIL_TIMER_Status_t UTIL_TIMER_Create( UTIL_TIMER_Object_t *TimerObject, uint32_
   }
 }
 
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+UTIL_TIMER_Status_t UTIL_TIMER_Start( UTIL_TIMER_Object_t *TimerObject)
+{
+  UTIL_TIMER_Status_t  ret = UTIL_TIMER_OK;
+  UTIL_TIMER_HeapEntry_t entry;
+  UTIL_TIMER_Object_t *head = NULL;
+  uint32_t elapsedTime = 0U;
+  uint32_t minValue;
+  uint32_t ticks;
+
+  if(( TimerObject != NULL ) && ( TimerExists( TimerObject ) == false ) && (TimerObject->IsRunning == 0U))
+  {
+    UTIL_TIMER_ENTER_CRITICAL_SECTION();
+    if( TimerHeapCount < UTIL_TIMER_HEAP_SIZE )
+    {
+      ticks = TimerObject->ReloadValue;
+      minValue = UTIL_TimerDriver.GetMinimumTimeout( );
+
+      if( ticks < minValue )
+      {
+        ticks = minValue;
+      }
+
+      TimerObject->IsPending = 0U;
+      TimerObject->IsRunning = 1U;
+      TimerObject->IsReloadStopped = 0U;
+      if( TimerHeapCount == 0U )
+      {
+        TimerUpdateContext( );
+      }
+      else
+      {
+        elapsedTime = UTIL_TimerDriver.GetTimerElapsedTime( );
+        head = TimerHeap[0].Timer;
+      }
+      TimerObject->Timestamp = ticks + elapsedTime;
+      entry.Deadline = TimerEpoch + ticks + elapsedTime;
+      entry.Timer = TimerObject;
+      TimerHeapInsert( &entry );
+
+      /* insert a timeout at now+obj->Timestamp if it expires first */
+      if( TimerHeap[0].Timer == TimerObject )
+      {
+        if( head != NULL )
+        {
+          head->IsPending = 0U;
+        }
+        TimerSetTimeout( TimerObject );
+      }
+    }
+    else
+    {
+      ret = UTIL_TIMER_UNKNOWN_ERROR;
+    }
+    UTIL_TIMER_EXIT_CRITICAL_SECTION();
+  }
+  else
+  {
+    ret =  UTIL_TIMER_INVALID_PARAM;
+  }
+  return ret;
+}
+#else
 UTIL_TIMER_Status_t UTIL_TIMER_Start( UTIL_TIMER_Object_t *TimerObject)
 {
   UTIL_TIMER_Status_t  ret = UTIL_TIMER_OK;
@@ -195,6 +304,7 @@ UTIL_TIMER_Status_t UTIL_TIMER_Start( UTIL_TIMER_Object_t *TimerObject)
   }
   return ret;
 }
+#endif /* UTIL_TIMER_HEAP_BACKEND */
 
 UTIL_TIMER_Status_t UTIL_TIMER_StartWithPeriod( UTIL_TIMER_Object_t *TimerObject, uint32_t PeriodValue)
 {
@@ -216,6 +326,49 @@ UTIL_TIMER_Status_t UTIL_TIMER_StartWithPeriod( UTIL_TIMER_Object_t *TimerObject
   return ret;
 }
 
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+UTIL_TIMER_Status_t UTIL_TIMER_Stop( UTIL_TIMER_Object_t *TimerObject )
+{
+  UTIL_TIMER_Status_t  ret = UTIL_TIMER_OK;
+
+  if (NULL != TimerObject)
+  {
+    UTIL_TIMER_ENTER_CRITICAL_SECTION();
+    TimerObject->IsReloadStopped = 1U;
+
+    /* Heap is empty or the Obj to stop does not exist  */
+    if( TimerHeapCount != 0U )
+    {
+      TimerObject->IsRunning = 0U;
+
+      if( TimerExists( TimerObject ) )
+      {
+        uint32_t index = TimerObject->HeapIndex;
+
+        TimerHeapRemove( index );
+        if( index == 0U ) /* Stop the Head */
+        {
+          TimerObject->IsPending = 0U;
+          if( TimerHeapCount != 0U )
+          {
+            TimerSetTimeout( TimerHeap[0].Timer );
+          }
+          else
+          {
+            UTIL_TimerDriver.StopTimerEvt( );
+          }
+        }
+      }
+    }
+    UTIL_TIMER_EXIT_CRITICAL_SECTION();
+  }
+  else
+  {
+    ret = UTIL_TIMER_INVALID_PARAM;
+  }
+  return ret;
+}
+#else
 UTIL_TIMER_Status_t UTIL_TIMER_Stop( UTIL_TIMER_Object_t *TimerObject )
 {
   UTIL_TIMER_Status_t  ret = UTIL_TIMER_OK;
@@ -281,6 +434,7 @@ UTIL_TIMER_Status_t UTIL_TIMER_Stop( UTIL_TIMER_Object_t *TimerObject )
   }
   return ret;
 }
+#endif /* UTIL_TIMER_HEAP_BACKEND */
 
 UTIL_TIMER_Status_t UTIL_TIMER_SetPeriod(UTIL_TIMER_Object_t *TimerObject, uint32_t NewPeriodValue)
 {
@@ -323,13 +477,18 @@ UTIL_TIMER_Status_t UTIL_TIMER_GetRemainingTime(UTIL_TIMER_Object_t *TimerObject
   if(TimerExists(TimerObject))
   {
     uint32_t time = UTIL_TimerDriver.GetTimerElapsedTime();
-    if (TimerObject->Timestamp < time )
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+    uint32_t timestamp = TimerHeapTimestamp( &TimerHeap[TimerObject->HeapIndex] );
+#else
+    uint32_t timestamp = TimerObject->Timestamp;
+#endif /* UTIL_TIMER_HEAP_BACKEND */
+    if (timestamp < time )
     {
       *ElapsedTime = 0;
     }
     else
     {
-      *ElapsedTime = TimerObject->Timestamp - time;
+      *ElapsedTime = timestamp - time;
     }
   }
   else
@@ -354,14 +513,64 @@ uint32_t UTIL_TIMER_IsRunning( UTIL_TIMER_Object_t *TimerObject )
 uint32_t UTIL_TIMER_GetFirstRemainingTime(void)
 {
 	uint32_t NextTimer = 0xFFFFFFFFU;
+	UTIL_TIMER_Object_t *head = UTIL_TIMER_GetTimerList();
 
-	if(TimerListHead != NULL)
+	if(head != NULL)
 	{
-		(void)UTIL_TIMER_GetRemainingTime(TimerListHead, &NextTimer);
+		(void)UTIL_TIMER_GetRemainingTime(head, &NextTimer);
 	}
 	return NextTimer;
 }
 
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+void UTIL_TIMER_IRQ_Handler( void )
+{
+  UTIL_TIMER_Object_t *cur, *exec = NULL;
+  void ( *FunctionCallback )( void *) = NULL;
+  void *argument = NULL;
+
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
+
+  /* move the time reference, running timers deadlines are absolute and do not need an update */
+  TimerUpdateContext( );
+
+  if ( TimerHeapCount != 0U )
+  {
+    /* only the first expired timer is handled, the next one is scheduled at the minimum timeout */
+    if ( TimerHeap[0].Deadline <= TimerEpoch )
+    {
+      cur = TimerHeap[0].Timer;
+      TimerHeapRemove( 0U );
+      cur->Timestamp = 0;
+      cur->IsPending = 0;
+      cur->IsRunning = 0;
+      /* save for execution when the heap is fully updated */
+      if(( cur->Mode == UTIL_TIMER_PERIODIC) && (cur->IsReloadStopped == 0U))
+      {
+        exec = cur;
+      }
+      argument = cur->argument;
+      FunctionCallback = cur->Callback;
+    }
+
+    if (exec != NULL) (void)UTIL_TIMER_Start(exec);
+
+    /* start the next heap head if it exists and it is not pending*/
+    if(( TimerHeapCount != 0U ) && (TimerHeap[0].Timer->IsPending == 0U))
+    {
+      TimerSetTimeout( TimerHeap[0].Timer );
+    }
+  }
+
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
+
+  // Call user call back
+  if (FunctionCallback != NULL)
+  {
+    FunctionCallback(argument);
+  }
+}
+#else
 void UTIL_TIMER_IRQ_Handler( void )
 {
   UTIL_TIMER_Object_t *cur, *exec = NULL;
@@ -425,6 +634,7 @@ void UTIL_TIMER_IRQ_Handler( void )
     FunctionCallback(argument);
   }
 }
+#endif /* UTIL_TIMER_HEAP_BACKEND */
 
 UTIL_TIMER_Time_t UTIL_TIMER_GetCurrentTime(void)
 {
@@ -442,7 +652,11 @@ UTIL_TIMER_Time_t UTIL_TIMER_GetElapsedTime(UTIL_TIMER_Time_t past )
 
 UTIL_TIMER_Object_t *UTIL_TIMER_GetTimerList(void)
 {
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+  return ( TimerHeapCount != 0U ) ? TimerHeap[0].Timer : NULL;
+#else
   return TimerListHead;
+#endif /* UTIL_TIMER_HEAP_BACKEND */
 }
 
 /**
@@ -456,6 +670,145 @@ UTIL_TIMER_Object_t *UTIL_TIMER_GetTimerList(void)
   *
   *  @{
   */
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+/**
+ * @brief Check if the Object to be added is not already in the heap
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ * @retval 1 (the object is already in the heap) or 0
+ */
+bool TimerExists( UTIL_TIMER_Object_t *TimerObject )
+{
+  return (( TimerObject != NULL ) && ( TimerObject->HeapIndex < TimerHeapCount ) &&
+          ( TimerHeap[TimerObject->HeapIndex].Timer == TimerObject ));
+}
+
+/**
+ * @brief Sets a timeout for the deadline of the heap head timer
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ */
+void TimerSetTimeout( UTIL_TIMER_Object_t *TimerObject )
+{
+  uint32_t minTicks= UTIL_TimerDriver.GetMinimumTimeout( );
+  uint32_t timeout = TimerHeapTimestamp( &TimerHeap[TimerObject->HeapIndex] );
+  TimerObject->IsPending = 1;
+
+  /* In case deadline too soon, the deadline itself is kept so that the heap order is preserved */
+  if( timeout < (UTIL_TimerDriver.GetTimerElapsedTime(  ) + minTicks) )
+  {
+    timeout = UTIL_TimerDriver.GetTimerElapsedTime(  ) + minTicks;
+  }
+  TimerObject->Timestamp = timeout;
+  UTIL_TimerDriver.StartTimerEvt( timeout );
+}
+
+/**
+ * @brief Stores an entry in the heap and records its position in the timer
+ *
+ * @param Index Position in the heap
+ * @param Entry Entry to store
+ */
+static void TimerHeapPlace( uint32_t Index, const UTIL_TIMER_HeapEntry_t *Entry )
+{
+  TimerHeap[Index] = *Entry;
+  Entry->Timer->HeapIndex = (uint16_t)Index;
+}
+
+/**
+ * @brief Stores an entry at a free position of the heap, and moves it up or
+ *        down until the heap order is restored
+ *
+ * @remark An entry with the same deadline as its parent is not moved above it.
+ *
+ * @param Index Free position in the heap
+ * @param Entry Entry to store
+ */
+static void TimerHeapFix( uint32_t Index, UTIL_TIMER_HeapEntry_t Entry )
+{
+  uint32_t parent;
+  uint32_t child;
+
+  while( Index > 0U )
+  {
+    parent = ( Index - 1U ) / 2U;
+    if( TimerHeap[parent].Deadline <= Entry.Deadline )
+    {
+      break;
+    }
+    TimerHeapPlace( Index, &TimerHeap[parent] );
+    Index = parent;
+  }
+
+  while( ( child = ( 2U * Index ) + 1U ) < TimerHeapCount )
+  {
+    if( (( child + 1U ) < TimerHeapCount ) && ( TimerHeap[child + 1U].Deadline < TimerHeap[child].Deadline ) )
+    {
+      child++;
+    }
+    if( Entry.Deadline <= TimerHeap[child].Deadline )
+    {
+      break;
+    }
+    TimerHeapPlace( Index, &TimerHeap[child] );
+    Index = child;
+  }
+
+  TimerHeapPlace( Index, &Entry );
+}
+
+/**
+ * @brief Adds a timer to the heap
+ *
+ * @remark The heap head always contains the next timer to expire.
+ *
+ * @param Entry Timer and its deadline, the heap must not be full
+ */
+static void TimerHeapInsert( const UTIL_TIMER_HeapEntry_t *Entry )
+{
+  TimerHeapCount++;
+  TimerHeapFix( TimerHeapCount - 1U, *Entry );
+}
+
+/**
+ * @brief Removes a timer from the heap
+ *
+ * @param Index Position of the timer in the heap
+ */
+static void TimerHeapRemove( uint32_t Index )
+{
+  TimerHeapCount--;
+  if( Index < TimerHeapCount )
+  {
+    TimerHeapFix( Index, TimerHeap[TimerHeapCount] );
+  }
+}
+
+/**
+ * @brief Returns the expiry time of a running timer in ticks from the timer context
+ *
+ * @param Entry Timer and its deadline
+ * @retval 0 if the deadline is reached, the remaining ticks otherwise
+ */
+static uint32_t TimerHeapTimestamp( const UTIL_TIMER_HeapEntry_t *Entry )
+{
+  if( Entry->Deadline <= TimerEpoch )
+  {
+    return 0U;
+  }
+  return (uint32_t)( Entry->Deadline - TimerEpoch );
+}
+
+/**
+ * @brief Moves the timer context to now and advances the time base of the deadlines
+ */
+static void TimerUpdateContext( void )
+{
+  uint32_t old = UTIL_TimerDriver.GetTimerContext( );
+  uint32_t now = UTIL_TimerDriver.SetTimerContext( );
+  TimerEpoch += (uint32_t)( now - old ); /*intentional wrap around */
+}
+#else
 /**
  * @brief Check if the Object to be added is not already in the list
  *
@@ -548,6 +901,7 @@ void TimerInsertNewHeadTimer( UTIL_TIMER_Object_t *TimerObject )
   TimerListHead = TimerObject;
   TimerSetTimeout( TimerListHead );
 }
+#endif /* UTIL_TIMER_HEAP_BACKEND */
 
 /**
   *  @}
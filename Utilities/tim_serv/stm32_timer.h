@@ -57,7 +57,40 @@
 #include <stddef.h>   
 #include <cmsis_compiler.h>
 #include "utilities_conf.h"
-   
+
+/* Configuration -------------------------------------------------------------*/
+/** @defgroup TIMER_SERVER_Configuration TIMER_SERVER Configuration
+  *  @{
+  */
+
+/**
+  * @brief Running timers storage
+  *
+  * 0: running timers are kept in a list sorted by expiry time. Start, stop
+  *    and the IRQ handler are linear in the number of running timers.
+  * 1: running timers are kept in a binary min-heap of UTIL_TIMER_HEAP_SIZE
+  *    entries. Start, stop and the IRQ handler are logarithmic in the number
+  *    of running timers. Starting more than UTIL_TIMER_HEAP_SIZE timers fails
+  *    with UTIL_TIMER_UNKNOWN_ERROR.
+  */
+#ifndef UTIL_TIMER_HEAP_BACKEND
+#define UTIL_TIMER_HEAP_BACKEND   0
+#endif
+
+/**
+  * @brief Maximum number of running timers with the heap backend
+  */
+#ifndef UTIL_TIMER_HEAP_SIZE
+#define UTIL_TIMER_HEAP_SIZE      32U
+#endif
+#if (UTIL_TIMER_HEAP_BACKEND == 1) && (UTIL_TIMER_HEAP_SIZE > 65535U)
+#error "UTIL_TIMER_HEAP_SIZE must fit the 16-bit HeapIndex of the timer objects"
+#endif
+
+/**
+  *  @}
+  */
+
 /* Exported types ------------------------------------------------------------*/
 /** @defgroup TIMER_SERVER_exported_TypeDef TIMER_SERVER exported Typedef
   *  @{
@@ -96,6 +129,9 @@ typedef struct TimerEvent_s
     void ( *Callback )( void *);  /*!<callback function                               */
     void *argument;               /*!<callback argument                               */
 	struct TimerEvent_s *Next;    /*!<Pointer to the next Timer object.               */
+#if (UTIL_TIMER_HEAP_BACKEND == 1)
+    uint16_t HeapIndex;           /*!<Position in the running timers heap             */
+#endif
 } UTIL_TIMER_Object_t;
 
 /**
@@ -272,6 +308,9 @@ UTIL_TIMER_Time_t UTIL_TIMER_GetElapsedTime(UTIL_TIMER_Time_t past );
   *
   * @retval pointer on @ref UTIL_TIMER_Object_t
   *
+  * @Note : with UTIL_TIMER_HEAP_BACKEND the Next pointers are not maintained, only
+  *         the timer expiring first is returned
+  *
   * @Note : the use of this function is dangerous and must be done with precaution, the risks are:
   *         1 - an update of this data structure may affect the operation of timer server
   *         2 - data structure is moving according the events, so read must be under critical section
@@ -0,0 +1,21 @@
+/**
+ ******************************************************************************
+ * @file    app_conf.h
+ * @brief   Log configuration for the log_module.c host build
+ ******************************************************************************
+ *
+ * The colors are enabled to check that the deferred mode leaves them out.
+ */
+#ifndef APP_CONF_H
+#define APP_CONF_H
+
+#define UNUSED(X) (void)(X)
+
+#define CFG_LOG_SUPPORTED                           (1U)
+#define CFG_LOG_INSERT_COLOR_INSIDE_THE_TRACE       (1U)
+#define CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE  (1U)
+#define CFG_LOG_INSERT_EOL_INSIDE_THE_TRACE         (1U)
+#define CFG_LOG_TRACE_FIFO_SIZE                     (512U)
+#define CFG_LOG_TRACE_BUF_SIZE                      (256U)
+
+#endif /* APP_CONF_H */
@@ -0,0 +1,12 @@
+/**
+ ******************************************************************************
+ * @file    cmsis_compiler.h
+ * @brief   Host stub of CMSIS, for the stm32_adv_trace.c host build
+ ******************************************************************************
+ */
+#ifndef CMSIS_COMPILER_H
+#define CMSIS_COMPILER_H
+
+#define __WEAK __attribute__((weak))
+
+#endif /* CMSIS_COMPILER_H */
@@ -0,0 +1,38 @@
+/**
+ ******************************************************************************
+ * @file    utilities_conf.h
+ * @brief   Utilities configuration for the stm32_adv_trace.c host build
+ ******************************************************************************
+ *
+ * Same trace configuration as the Matter applications, with the deferred mode
+ * enabled. The fifo is kept small so that the records wrap around it.
+ */
+#ifndef UTILITIES_CONF_H
+#define UTILITIES_CONF_H
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cmsis_compiler.h"
+#include "app_conf.h"
+
+#define VLEVEL_OFF    0
+#define VLEVEL_ALWAYS 0
+#define VLEVEL_L      1
+#define VLEVEL_M      2
+#define VLEVEL_H      3
+
+#define UTIL_ADV_TRACE_CONDITIONNAL
+#define UTIL_ADV_TRACE_UNCHUNK_MODE
+#define UTIL_ADV_TRACE_DEFERRED_MODE
+#define UTIL_ADV_TRACE_DEBUG(...)
+#define UTIL_ADV_TRACE_INIT_CRITICAL_SECTION()
+#define UTIL_ADV_TRACE_ENTER_CRITICAL_SECTION()
+#define UTIL_ADV_TRACE_EXIT_CRITICAL_SECTION()
+#define UTIL_ADV_TRACE_TMP_BUF_SIZE                (CFG_LOG_TRACE_BUF_SIZE)
+#define UTIL_ADV_TRACE_TMP_MAX_TIMESTMAP_SIZE      (15U)
+#define UTIL_ADV_TRACE_FIFO_SIZE                   (CFG_LOG_TRACE_FIFO_SIZE)
+#define UTIL_ADV_TRACE_MEMSET8(dest, value, size)  memset((dest), (value), (size))
+#define UTIL_ADV_TRACE_VSNPRINTF(...)              vsnprintf(__VA_ARGS__)
+
+#endif /* UTILITIES_CONF_H */
@@ -0,0 +1,262 @@
+/**
+ ******************************************************************************
+ * @file    test_stm32_adv_trace.c
+ * @brief   Host tests of the deferred mode of stm32_adv_trace.c
+ ******************************************************************************
+ *
+ * Traces are posted with UTIL_ADV_TRACE_COND_FSend and with the log module,
+ * the stub driver captures the records. The program writes the capture and
+ * the text snprintf gives for the same calls: the Makefile decodes the capture
+ * with adv_trace_decode.py and compares both.
+ *
+ * The records of the string arguments are also checked here, to make sure
+ * that nothing is read past the precision.
+ *
+ *   test_stm32_adv_trace capture.bin expected.txt
+ */
+#include "stm32_adv_trace.h"
+#include "log_module.h"
+#include "trace_if_stub.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      failures++; \
+    } \
+  } while (0)
+
+#define TEST_TIMESTAMP 123456U
+
+/* Default UTIL_ADV_TRACE_DEFERRED_STRING_SIZE, null character included */
+#define TEST_STRING_SIZE 32U
+
+/* Deferred record header: marker and size, then the format address */
+#define TEST_RECORD_HEADER_SIZE 6U
+
+static unsigned failures;
+static FILE *expected;
+
+static uint32_t raw_timestamp(void)
+{
+  return TEST_TIMESTAMP;
+}
+
+static void expect(const char *prefix, const char *strFormat, ...)
+{
+  va_list vaArgs;
+
+  fputs(prefix, expected);
+  va_start(vaArgs, strFormat);
+  vfprintf(expected, strFormat, vaArgs);
+  va_end(vaArgs);
+}
+
+/* UTIL_ADV_TRACE_COND_FSend and its text, without and with time stamp */
+#define TRACE(...) \
+  do { \
+    CHECK(UTIL_ADV_TRACE_COND_FSend(VLEVEL_L, 1U, 0U, __VA_ARGS__) == UTIL_ADV_TRACE_OK); \
+    trace_stub_flush(); \
+    expect("", __VA_ARGS__); \
+  } while (0)
+
+#define TRACE_TS(...) \
+  do { \
+    CHECK(UTIL_ADV_TRACE_COND_FSend(VLEVEL_L, 1U, 1U, __VA_ARGS__) == UTIL_ADV_TRACE_OK); \
+    trace_stub_flush(); \
+    expect("[123456] ", __VA_ARGS__); \
+  } while (0)
+
+/* Log_Module_Print: raw time stamp, no color, and an end of line added when the format has none */
+#define LOG(fmt, ...) \
+  do { \
+    LOG_INFO_APP(fmt, ##__VA_ARGS__); \
+    trace_stub_flush(); \
+    expect("[123456] ", fmt, ##__VA_ARGS__); \
+    if ((fmt[0] == '\0') || (fmt[strlen(fmt) - 1U] != '\n')) { \
+      expect("", "\n"); \
+    } \
+  } while (0)
+
+static size_t capture_size(void)
+{
+  size_t size;
+
+  (void)trace_stub_capture(&size);
+  return size;
+}
+
+/* Checks that the capture from start is one record holding the given arguments */
+static void check_record(size_t start, const void *args, size_t size)
+{
+  size_t end;
+  const uint8_t *capture = trace_stub_capture(&end);
+
+  CHECK(end - start == TEST_RECORD_HEADER_SIZE + size);
+  if (end - start != TEST_RECORD_HEADER_SIZE + size) {
+    return;
+  }
+  CHECK(capture[start] == 0x1EU);
+  CHECK(capture[start + 1U] == 4U + size);
+  CHECK(memcmp(&capture[start + TEST_RECORD_HEADER_SIZE], args, size) == 0);
+}
+
+static void test_conversions(void)
+{
+  TRACE("plain text\n");
+  TRACE("%d %i %u %o %x %X %c|%%\n", -42, 7, 42U, 8U, 0xBEEFU, 0xCAFEU, 'z');
+  TRACE("%5d|%-5d|%05d|%+d|% d|%#x|%#o\n", 12, 12, 12, 12, 12, 0x1FU, 8U);
+  TRACE("%*d|%-*d|%.*d\n", 6, 3, 4, 5, 3, 7);
+  TRACE("%hhd %hd %hhu %hu\n", 300, 70000, 300, 70000);
+  TRACE("%ld %lu %lld %llu %llx\n", -100000L, 100000UL, -5000000000LL, 5000000000ULL, 0x123456789ABCULL);
+  TRACE("%zu %jd %td\n", (size_t)1234, (intmax_t)-56, (ptrdiff_t)-78);
+  TRACE("%f %.2f %8.3f %e %E %g %G\n", 3.5, 3.14159, -2.5, 12345.678, 0.000123, 100000.0, 1e-10);
+  TRACE("%s|%10s|%-10s|%.3s|\n", "abc", "right", "left", "truncated");
+  TRACE("%p\n", (void *)&failures);
+  TRACE("%s after %d\n", "string", 99);
+  TRACE_TS("with a time stamp %u\n", 17U);
+}
+
+static void test_string_precision(void)
+{
+  /* not null terminated, followed by other data */
+  static const struct {
+    char text[8];
+    char next[8];
+  } unterminated = { { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h' }, { 'X', 'X', 'X', 'X', 'X', 'X', 'X', '\0' } };
+  static const char long_text[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ";
+  uint8_t args[64];
+  int precision;
+  size_t start;
+
+  start = capture_size();
+  TRACE("[%.4s]\n", unterminated.text);
+  check_record(start, "abcd", 5U);
+
+  start = capture_size();
+  TRACE("[%.8s]\n", unterminated.text);
+  check_record(start, "abcdefgh", 9U);
+
+  start = capture_size();
+  TRACE("[%.0s]\n", unterminated.text);
+  check_record(start, "", 1U);
+
+  start = capture_size();
+  TRACE("[%5.2s]\n", unterminated.text);
+  check_record(start, "ab", 3U);
+
+  /* precision given as an argument */
+  precision = 6;
+  start = capture_size();
+  TRACE("[%.*s]\n", precision, unterminated.text);
+  memcpy(args, &precision, sizeof(precision));
+  memcpy(&args[sizeof(precision)], "abcdef", 7U);
+  check_record(start, args, sizeof(precision) + 7U);
+
+  /* a negative precision is taken as if it were missing */
+  precision = -1;
+  start = capture_size();
+  TRACE("[%.*s]\n", precision, "negative");
+  memcpy(args, &precision, sizeof(precision));
+  memcpy(&args[sizeof(precision)], "negative", 9U);
+  check_record(start, args, sizeof(precision) + 9U);
+
+  /* a precision larger than the string stops at the null character */
+  start = capture_size();
+  TRACE("[%.20s]\n", "short");
+  check_record(start, "short", 6U);
+
+  /* strings are cut at UTIL_ADV_TRACE_DEFERRED_STRING_SIZE, with or without precision */
+  start = capture_size();
+  CHECK(UTIL_ADV_TRACE_COND_FSend(VLEVEL_L, 1U, 0U, "[%s]\n", long_text) == UTIL_ADV_TRACE_OK);
+  trace_stub_flush();
+  expect("", "[%.*s]\n", (int)(TEST_STRING_SIZE - 1U), long_text);
+  memcpy(args, long_text, TEST_STRING_SIZE - 1U);
+  args[TEST_STRING_SIZE - 1U] = 0U;
+  check_record(start, args, TEST_STRING_SIZE);
+
+  start = capture_size();
+  CHECK(UTIL_ADV_TRACE_COND_FSend(VLEVEL_L, 1U, 0U, "[%.40s]\n", long_text) == UTIL_ADV_TRACE_OK);
+  trace_stub_flush();
+  expect("", "[%.*s]\n", (int)(TEST_STRING_SIZE - 1U), long_text);
+  check_record(start, args, TEST_STRING_SIZE);
+}
+
+static void test_log_module(void)
+{
+  Log_Module_t config = { .verbose_level = LOG_VERBOSE_INFO, .region = LOG_REGION_APP };
+  size_t start;
+
+  /* the log module initializes the trace system again */
+  Log_Module_Init(config);
+  UTIL_ADV_TRACE_RegisterRawTimeStampFunction(raw_timestamp);
+
+  LOG("no end of line");
+  LOG("end of line %d\n", 1);
+  LOG("");
+  LOG("%s=%u, %.3s", "key", 42U, "valuable");
+  LOG("%08lx %c%c", 0xABCDUL, 'o', 'k');
+
+  /* filtered out by the log module, nothing is sent */
+  start = capture_size();
+  LOG_DEBUG_APP("debug %d\n", 1);
+  LOG_INFO_BLE("ble %d\n", 2);
+  trace_stub_flush();
+  CHECK(capture_size() == start);
+
+  /* Matter logs: prefix, module, message and end of line are printed separately */
+  Log_Module_Print(LOG_VERBOSE_INFO, LOG_REGION_APP, "[chip]");
+  trace_stub_flush();
+  Log_Module_Print(LOG_VERBOSE_INFO, LOG_REGION_APP, "%s", "DMG");
+  trace_stub_flush();
+  Log_Module_Print(LOG_VERBOSE_INFO, LOG_REGION_APP, "\n");
+  trace_stub_flush();
+  expect("", "[123456] [chip]\n[123456] DMG\n[123456] \n");
+}
+
+int main(int argc, char *argv[])
+{
+  const uint8_t *capture;
+  size_t size;
+  FILE *out;
+
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s capture.bin expected.txt\n", argv[0]);
+    return 2;
+  }
+  expected = fopen(argv[2], "w");
+  if (expected == NULL) {
+    perror(argv[2]);
+    return 2;
+  }
+
+  CHECK(UTIL_ADV_TRACE_Init() == UTIL_ADV_TRACE_OK);
+  UTIL_ADV_TRACE_SetVerboseLevel(VLEVEL_H);
+  UTIL_ADV_TRACE_SetRegion(1U);
+  UTIL_ADV_TRACE_RegisterRawTimeStampFunction(raw_timestamp);
+
+  test_conversions();
+  test_string_precision();
+  test_log_module();
+
+  fclose(expected);
+  capture = trace_stub_capture(&size);
+  out = fopen(argv[1], "wb");
+  if ((out == NULL) || (fwrite(capture, 1U, size, out) != size)) {
+    perror(argv[1]);
+    return 2;
+  }
+  fclose(out);
+
+  if (failures != 0U) {
+    fprintf(stderr, "%u check(s) failed\n", failures);
+    return 1;
+  }
+  printf("%zu bytes captured, checks passed\n", size);
+  return 0;
+}
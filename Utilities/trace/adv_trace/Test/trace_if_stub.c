@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ * @file    trace_if_stub.c
+ * @brief   Trace driver stub for the stm32_adv_trace.c host build
+ ******************************************************************************
+ */
+#include "trace_if_stub.h"
+#include "stm32_adv_trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_STUB_CAPTURE_SIZE 65536U
+
+static void (*tx_cplt_cb)(void *ptr);
+static int transfer_pending;
+static uint8_t capture[TRACE_STUB_CAPTURE_SIZE];
+static size_t capture_size;
+
+static UTIL_ADV_TRACE_Status_t stub_init(void (*cb)(void *ptr))
+{
+  tx_cplt_cb = cb;
+  return UTIL_ADV_TRACE_OK;
+}
+
+static UTIL_ADV_TRACE_Status_t stub_deinit(void)
+{
+  return UTIL_ADV_TRACE_OK;
+}
+
+static UTIL_ADV_TRACE_Status_t stub_start_rx(void (*cb)(uint8_t *pdata, uint16_t size, uint8_t error))
+{
+  (void)cb;
+  return UTIL_ADV_TRACE_OK;
+}
+
+static UTIL_ADV_TRACE_Status_t stub_send(uint8_t *pdata, uint16_t size)
+{
+  if (transfer_pending || capture_size + size > TRACE_STUB_CAPTURE_SIZE) {
+    fprintf(stderr, "trace_if_stub: unexpected send\n");
+    exit(1);
+  }
+  memcpy(&capture[capture_size], pdata, size);
+  capture_size += size;
+  transfer_pending = 1;
+  return UTIL_ADV_TRACE_OK;
+}
+
+const UTIL_ADV_TRACE_Driver_s UTIL_TraceDriver = {
+  stub_init,
+  stub_deinit,
+  stub_start_rx,
+  stub_send,
+};
+
+void trace_stub_flush(void)
+{
+  /* the completion callback sends the next part of the fifo, if any */
+  while (transfer_pending) {
+    transfer_pending = 0;
+    tx_cplt_cb(NULL);
+  }
+}
+
+const uint8_t *trace_stub_capture(size_t *size)
+{
+  *size = capture_size;
+  return capture;
+}
@@ -0,0 +1,22 @@
+/**
+ ******************************************************************************
+ * @file    trace_if_stub.h
+ * @brief   Trace driver stub for the stm32_adv_trace.c host build
+ ******************************************************************************
+ *
+ * The stub driver appends the data sent by the trace system to a capture
+ * buffer. The transfers complete when trace_stub_flush is called.
+ */
+#ifndef TRACE_IF_STUB_H
+#define TRACE_IF_STUB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Completes the transfers until the trace fifo is empty */
+void trace_stub_flush(void);
+
+/* Data sent so far */
+const uint8_t *trace_stub_capture(size_t *size);
+
+#endif /* TRACE_IF_STUB_H */
@@ -20,6 +20,7 @@
 #include "stm32_adv_trace.h"
 #include "stdarg.h"
 #include "stdio.h"
+#include "stddef.h"
 
 /** @addtogroup ADV_TRACE
  * @{
@@ -68,6 +69,36 @@ typedef enum {
   TRACE_UNCHUNK_TRANSFER      /*!<unchunk status an unchunk transfer is ongoing. */
 } TRACE_UNCHUNK_STATUS;
 #endif
+
+#if defined(UTIL_ADV_TRACE_CONDITIONNAL) && defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+/**
+ *  @brief  maximum size of a string argument inside a deferred record, including the terminating null character.
+ *
+ *  @note only valid if UTIL_ADV_TRACE_DEFERRED_MODE has been enabled inside utilities conf
+ */
+#if !defined(UTIL_ADV_TRACE_DEFERRED_STRING_SIZE)
+#define UTIL_ADV_TRACE_DEFERRED_STRING_SIZE (32U)
+#endif
+
+/**
+ *  @brief  deferred record format.
+ *  A deferred record replaces the formatted text of UTIL_ADV_TRACE_COND_FSend inside the fifo:
+ *  - 1 byte : TRACE_DEFERRED_RECORD, or TRACE_DEFERRED_RECORD_TIMESTAMP when a raw time stamp is present
+ *  - 1 byte : size of the rest of the record
+ *  - 4 bytes: address of the format string, to look up in the firmware image
+ *  - 4 bytes: raw time stamp, only with TRACE_DEFERRED_RECORD_TIMESTAMP
+ *  - the arguments, in the order of the format string, with the size they have in the variable argument list and
+ *    in the byte order of the target, strings being copied up to their precision with a null character.
+ *  The records are mixed with the text sent by the other functions, these two first bytes values are not expected
+ *  in text traces.
+ *
+ *  @note only valid if UTIL_ADV_TRACE_DEFERRED_MODE has been enabled inside utilities conf
+ */
+#define TRACE_DEFERRED_RECORD           (0x1EU)
+#define TRACE_DEFERRED_RECORD_TIMESTAMP (0x1FU)
+#define TRACE_DEFERRED_HEADER_SIZE      (2U)
+#define TRACE_DEFERRED_RECORD_MAX_SIZE  (TRACE_DEFERRED_HEADER_SIZE + 255U)
+#endif
 /**
  * @}
  */
@@ -103,6 +134,9 @@ typedef struct {
 #endif
 #if defined(UTIL_ADV_TRACE_CONDITIONNAL)
   cb_timestamp *timestamp_func; /*!<ptr of function used to insert time stamp.        */
+#if defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+  cb_timestamp_raw *timestamp_raw_func; /*!<ptr of function used to insert raw time stamp in deferred records. */
+#endif
   uint8_t  CurrentVerboseLevel; /*!<verbose level used.                                */
   uint32_t RegionMask; /*!<mask of the enabled region.                                */
 #endif
@@ -129,7 +163,7 @@ typedef struct {
 static ADV_TRACE_Context ADV_TRACE_Ctx;
 static UTIL_ADV_TRACE_MEMLOCATION uint8_t ADV_TRACE_Buffer[UTIL_ADV_TRACE_FIFO_SIZE];
 
-#if defined(UTIL_ADV_TRACE_CONDITIONNAL) && defined(UTIL_ADV_TRACE_UNCHUNK_MODE)
+#if defined(UTIL_ADV_TRACE_CONDITIONNAL) && defined(UTIL_ADV_TRACE_UNCHUNK_MODE) && !defined(UTIL_ADV_TRACE_DEFERRED_MODE)
 /**
  * @brief temporary buffer used by UTIL_ADV_TRACE_COND_FSend
  * a temporary buffers variable used to evaluate a formatted string size.
@@ -153,6 +187,11 @@ static void TRACE_Lock(void);
 static void TRACE_UnLock(void);
 static uint32_t TRACE_IsLocked(void);
 
+#if defined(UTIL_ADV_TRACE_CONDITIONNAL) && defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+static uint16_t TRACE_DeferredEncode(uint8_t *pRecord, uint32_t TimeStampState, const char *strFormat, va_list vaArgs);
+static uint8_t TRACE_DeferredPut(uint8_t *pRecord, uint16_t *pPos, const void *pValue, uint16_t Size);
+#endif
+
 /**
  * @}
  */
@@ -202,15 +241,18 @@ UTIL_ADV_TRACE_Status_t UTIL_ADV_TRACE_StartRxProcess(void (*UserCallback)(uint8
 UTIL_ADV_TRACE_Status_t UTIL_ADV_TRACE_COND_FSend(uint32_t VerboseLevel, uint32_t Region, uint32_t TimeStampState, const char *strFormat, ...)
 {
   va_list vaArgs;
-#if defined(UTIL_ADV_TRACE_UNCHUNK_MODE)
+#if defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+  UTIL_ADV_TRACE_Status_t status;
+#elif defined(UTIL_ADV_TRACE_UNCHUNK_MODE)
   uint8_t buf[UTIL_ADV_TRACE_TMP_MAX_TIMESTMAP_SIZE];
   uint16_t timestamp_size = 0u;
   uint16_t writepos;
   uint16_t idx;
+  uint16_t buff_size = 0u;
 #else
   uint8_t buf[UTIL_ADV_TRACE_TMP_BUF_SIZE+UTIL_ADV_TRACE_TMP_MAX_TIMESTMAP_SIZE];
-#endif
   uint16_t buff_size = 0u;
+#endif
 
   /* check verbose level */
   if(!(ADV_TRACE_Ctx.CurrentVerboseLevel >= VerboseLevel))
@@ -223,7 +265,14 @@ UTIL_ADV_TRACE_Status_t UTIL_ADV_TRACE_COND_FSend(uint32_t VerboseLevel, uint32_
     return UTIL_ADV_TRACE_REGIONMASKED;
   }
 
-#if defined(UTIL_ADV_TRACE_UNCHUNK_MODE)
+#if defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+  va_start(vaArgs, strFormat);
+  status = UTIL_ADV_TRACE_DeferredVSend(TimeStampState, strFormat, vaArgs);
+  va_end(vaArgs);
+
+  return status;
+
+#elif defined(UTIL_ADV_TRACE_UNCHUNK_MODE)
   if((ADV_TRACE_Ctx.timestamp_func != NULL) && (TimeStampState != 0u))
   {
     ADV_TRACE_Ctx.timestamp_func(buf,&timestamp_size);
@@ -488,6 +537,24 @@ void UTIL_ADV_TRACE_RegisterTimeStampFunction(cb_timestamp *cb)
   ADV_TRACE_Ctx.timestamp_func = *cb;
 }
 
+#if defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+void UTIL_ADV_TRACE_RegisterRawTimeStampFunction(cb_timestamp_raw *cb)
+{
+  ADV_TRACE_Ctx.timestamp_raw_func = *cb;
+}
+
+UTIL_ADV_TRACE_Status_t UTIL_ADV_TRACE_DeferredVSend(uint32_t TimeStampState, const char *strFormat, va_list vaArgs)
+{
+  uint8_t record[TRACE_DEFERRED_RECORD_MAX_SIZE];
+  uint16_t record_size;
+
+  /* no formatting on the target: post the format address and the raw arguments */
+  record_size = TRACE_DeferredEncode(record, TimeStampState, strFormat, vaArgs);
+
+  return UTIL_ADV_TRACE_Send(record, record_size);
+}
+#endif
+
 void UTIL_ADV_TRACE_SetVerboseLevel(uint8_t Level)
 {
   ADV_TRACE_Ctx.CurrentVerboseLevel = Level;
@@ -818,6 +885,237 @@ static uint32_t TRACE_IsLocked(void)
   return (ADV_TRACE_Ctx.TraceLock == 0u? 0u: 1u);
 }
 
+#if defined(UTIL_ADV_TRACE_CONDITIONNAL) && defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+/**
+ * @brief  encode a deferred record: the format address, the raw time stamp and the arguments.
+ *         The format string is only parsed to pick the arguments from the list, nothing is converted to text.
+ *         The arguments that do not fit in the record are left out, the decoder shows them as missing.
+ * @param  pRecord buffer of TRACE_DEFERRED_RECORD_MAX_SIZE bytes receiving the record
+ * @param  TimeStampState 0 no time stamp, 1 raw time stamp inserted inside the record
+ * @param  strFormat formatted string
+ * @param  vaArgs arguments of the formatted string
+ * @retval size of the record
+ */
+static uint16_t TRACE_DeferredEncode(uint8_t *pRecord, uint32_t TimeStampState, const char *strFormat, va_list vaArgs)
+{
+  const char *ptr = strFormat;
+  uint16_t pos = TRACE_DEFERRED_HEADER_SIZE;
+  uint8_t room = 1u;
+  uint32_t value32 = (uint32_t)(uintptr_t)strFormat;
+
+  pRecord[0] = TRACE_DEFERRED_RECORD;
+  (void)TRACE_DeferredPut(pRecord, &pos, &value32, sizeof(value32));
+
+  if((ADV_TRACE_Ctx.timestamp_raw_func != NULL) && (TimeStampState != 0u))
+  {
+    pRecord[0] = TRACE_DEFERRED_RECORD_TIMESTAMP;
+    value32 = ADV_TRACE_Ctx.timestamp_raw_func();
+    (void)TRACE_DeferredPut(pRecord, &pos, &value32, sizeof(value32));
+  }
+
+  while((*ptr != '\0') && (room != 0u))
+  {
+    char length = '\0';
+    char length2 = '\0';
+    int precision = -1;
+
+    if(*ptr++ != '%')
+    {
+      continue;
+    }
+
+    /* flags */
+    while((*ptr == '-') || (*ptr == '+') || (*ptr == ' ') || (*ptr == '#') || (*ptr == '0'))
+    {
+      ptr++;
+    }
+
+    /* width and precision, given as int arguments with '*', a negative precision is taken as if it were missing */
+    if(*ptr == '*')
+    {
+      int arg = va_arg(vaArgs, int);
+      room = TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+      ptr++;
+    }
+    while((*ptr >= '0') && (*ptr <= '9'))
+    {
+      ptr++;
+    }
+    if(*ptr == '.')
+    {
+      ptr++;
+      precision = 0;
+      if(*ptr == '*')
+      {
+        int arg = va_arg(vaArgs, int);
+        room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        precision = (arg < 0) ? -1 : arg;
+        ptr++;
+      }
+      while((*ptr >= '0') && (*ptr <= '9'))
+      {
+        if(precision < (int)UTIL_ADV_TRACE_DEFERRED_STRING_SIZE)
+        {
+          precision = (precision * 10) + (*ptr - '0');
+        }
+        ptr++;
+      }
+    }
+
+    /* length modifier */
+    if((*ptr == 'h') || (*ptr == 'l') || (*ptr == 'j') || (*ptr == 'z') || (*ptr == 't') || (*ptr == 'L'))
+    {
+      length = *ptr++;
+      if(((length == 'h') || (length == 'l')) && (*ptr == length))
+      {
+        length2 = *ptr++;
+      }
+    }
+
+    switch(*ptr)
+    {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+      case 'c':
+        if((length == 'l') && (length2 == 'l'))
+        {
+          long long arg = va_arg(vaArgs, long long);
+          room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        }
+        else if(length == 'l')
+        {
+          long arg = va_arg(vaArgs, long);
+          room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        }
+        else if(length == 'j')
+        {
+          intmax_t arg = va_arg(vaArgs, intmax_t);
+          room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        }
+        else if(length == 'z')
+        {
+          size_t arg = va_arg(vaArgs, size_t);
+          room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        }
+        else if(length == 't')
+        {
+          ptrdiff_t arg = va_arg(vaArgs, ptrdiff_t);
+          room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        }
+        else
+        {
+          /* char and short are promoted to int */
+          int arg = va_arg(vaArgs, int);
+          room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        }
+        break;
+
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+      {
+        /* long double is sent as double */
+        double arg = (length == 'L') ? (double)va_arg(vaArgs, long double) : va_arg(vaArgs, double);
+        room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        break;
+      }
+
+      case 'p':
+      {
+        uintptr_t arg = (uintptr_t)va_arg(vaArgs, void *);
+        room &= TRACE_DeferredPut(pRecord, &pos, &arg, sizeof(arg));
+        break;
+      }
+
+      case 's':
+      {
+        const char *arg = va_arg(vaArgs, const char *);
+        uint16_t size = 0u;
+        uint16_t size_max = UTIL_ADV_TRACE_DEFERRED_STRING_SIZE - 1u;
+
+        if(arg == NULL)
+        {
+          arg = "(null)";
+        }
+        /* with a precision, the string does not need to be null terminated: nothing is read past it */
+        if((precision >= 0) && ((uint32_t)precision < size_max))
+        {
+          size_max = (uint16_t)precision;
+        }
+        while((size < size_max) && (arg[size] != '\0'))
+        {
+          size++;
+        }
+
+        /* the string is either copied with its null character or left out */
+        if((pos + size + 1u) <= TRACE_DEFERRED_RECORD_MAX_SIZE)
+        {
+          (void)TRACE_DeferredPut(pRecord, &pos, arg, size);
+          pRecord[pos++] = 0u;
+        }
+        else
+        {
+          room = 0u;
+        }
+        break;
+      }
+
+      case 'n':
+        /* nothing is written back */
+        (void)va_arg(vaArgs, void *);
+        break;
+
+      default:
+        /* '%%', or an unsupported conversion */
+        break;
+    }
+
+    if(*ptr != '\0')
+    {
+      ptr++;
+    }
+  }
+
+  pRecord[1] = (uint8_t)(pos - TRACE_DEFERRED_HEADER_SIZE);
+  return pos;
+}
+
+/**
+ * @brief  append a raw value to a deferred record.
+ * @param  pRecord buffer of TRACE_DEFERRED_RECORD_MAX_SIZE bytes receiving the record
+ * @param  pPos write position within the record, updated if the value fits
+ * @param  pValue value to append
+ * @param  Size size of the value
+ * @retval 1 if the value has been appended, 0 if there was no room left for it.
+ */
+static uint8_t TRACE_DeferredPut(uint8_t *pRecord, uint16_t *pPos, const void *pValue, uint16_t Size)
+{
+  uint16_t idx;
+
+  if((*pPos + Size) > TRACE_DEFERRED_RECORD_MAX_SIZE)
+  {
+    return 0u;
+  }
+
+  for (idx = 0u; idx < Size; idx++)
+  {
+    pRecord[*pPos] = ((const uint8_t *)pValue)[idx];
+    *pPos = *pPos + 1u;
+  }
+
+  return 1u;
+}
+#endif
+
 /**
  * @}
  */
@@ -26,6 +26,7 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "stdint.h"
+#include "stdarg.h"
 #include "utilities_conf.h"
 
 /** @defgroup ADV_TRACE advanced tracer
@@ -42,6 +43,13 @@ extern "C" {
  */
 typedef void cb_timestamp(uint8_t *pData, uint16_t *Size);
 
+#if defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+/**
+ *  @brief prototype of the raw time stamp function, used by the deferred mode.
+ */
+typedef uint32_t cb_timestamp_raw(void);
+#endif
+
 /**
  *  @brief prototype of the overrun function.
  */
@@ -179,6 +187,8 @@ void UTIL_ADV_TRACE_RegisterOverRunFunction(cb_overrun *cb);
 
 /**
  * @brief conditional FSend decode the strFormat and post it to the circular queue for printing
+ * @note  with UTIL_ADV_TRACE_DEFERRED_MODE, the format address and the arguments are posted as a binary record
+ *        instead, to be formatted on the host by trace/manager/script/adv_trace_decode.py
  * @param VerboseLevel verbose level of the trace
  * @param Region region of the trace
  * @param TimeStampState 0 no time stamp insertion, 1 time stamp inserted inside the trace data
@@ -223,6 +233,24 @@ UTIL_ADV_TRACE_Status_t UTIL_ADV_TRACE_COND_Send(uint32_t VerboseLevel, uint32_t
  */
 void UTIL_ADV_TRACE_RegisterTimeStampFunction(cb_timestamp *cb);
 
+#if defined(UTIL_ADV_TRACE_DEFERRED_MODE)
+/**
+ * @brief Register a function used to add a raw timestamp inside the deferred records
+ * @param cb pointer of function to return the timestamp value, formatted by the decoder
+ */
+void UTIL_ADV_TRACE_RegisterRawTimeStampFunction(cb_timestamp_raw *cb);
+
+/**
+ * @brief post a deferred record to the circular queue, without checking the verbose level and the region
+ * @note  used by the modules that filter the traces on their own, such as the log module
+ * @param TimeStampState 0 no time stamp insertion, 1 raw time stamp inserted inside the record
+ * @param strFormat formatted string, must stay in the firmware image for the decoder to find it
+ * @param vaArgs arguments of the formatted string
+ * @retval Status based on @ref UTIL_ADV_TRACE_Status_t
+ */
+UTIL_ADV_TRACE_Status_t UTIL_ADV_TRACE_DeferredVSend(uint32_t TimeStampState, const char *strFormat, va_list vaArgs);
+#endif
+
 /**
  * @brief  Set the verbose level
  * @param  Level (0 to 255)
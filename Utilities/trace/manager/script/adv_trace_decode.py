@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+#
+# Decoder of the traces sent by stm32_adv_trace built with UTIL_ADV_TRACE_DEFERRED_MODE.
+#
+# In that mode UTIL_ADV_TRACE_COND_FSend and the log module do not format the text on the target: they send a record
+# holding the address of the format string and the raw arguments. This script looks the format strings up in the ELF file of
+# the firmware and formats the records on the host. Everything else in the capture is text and is copied as is.
+#
+#   python adv_trace_decode.py firmware.elf capture.bin
+#   <serial reader> | python adv_trace_decode.py firmware.elf
+#
+# The ELF file must be the one of the firmware that produced the capture.
+#
+import argparse, re, struct, sys
+
+RECORD           = 0x1E
+RECORD_TIMESTAMP = 0x1F
+HEADER_SIZE      = 2
+
+PT_LOAD = 1
+
+#
+# Minimal ELF reader: maps the addresses of the loaded segments to the file content
+#
+class ElfImage:
+    def __init__(self, filename):
+        with open(filename, "rb") as f:
+            self.data = f.read()
+        if self.data[0:4] != b"\x7fELF":
+            raise ValueError(filename + " is not an ELF file")
+        is64   = (self.data[4] == 2)
+        endian = "<" if self.data[5] == 1 else ">"
+        if is64:
+            phoff, = struct.unpack_from(endian + "Q", self.data, 0x20)
+            phentsize, phnum = struct.unpack_from(endian + "HH", self.data, 0x36)
+        else:
+            phoff, = struct.unpack_from(endian + "I", self.data, 0x1C)
+            phentsize, phnum = struct.unpack_from(endian + "HH", self.data, 0x2A)
+        self.segments = []
+        for i in range(phnum):
+            off = phoff + i * phentsize
+            if is64:
+                p_type, _, p_offset, p_vaddr, _, p_filesz = struct.unpack_from(endian + "IIQQQQ", self.data, off)
+            else:
+                p_type, p_offset, p_vaddr, _, p_filesz = struct.unpack_from(endian + "IIIII", self.data, off)
+            if p_type == PT_LOAD and p_filesz != 0:
+                self.segments.append((p_vaddr, p_filesz, p_offset))
+
+    def read_string(self, address):
+        for vaddr, size, offset in self.segments:
+            # the records only hold the 32 low bits of the address
+            if (vaddr & 0xFFFFFFFF) <= address < (vaddr & 0xFFFFFFFF) + size:
+                start = offset + address - (vaddr & 0xFFFFFFFF)
+                end = self.data.find(b"\0", start, offset + size)
+                if end < 0:
+                    end = offset + size
+                return self.data[start:end].decode("utf-8", "replace")
+        return None
+
+#
+# Same grammar as the parsing done by TRACE_DeferredEncode
+#
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?([diuoxXcfFeEgGaAspn%])")
+
+class Decoder:
+    def __init__(self, image, lp64 = False):
+        self.image = image
+        self.sizes = {
+            "":   4, "hh": 4, "h": 4,
+            "l":  8 if lp64 else 4,
+            "ll": 8, "j":  8,
+            "z":  8 if lp64 else 4,
+            "t":  8 if lp64 else 4,
+        }
+        self.pointer_size = 8 if lp64 else 4
+        self.pending = b""
+
+    def feed(self, data):
+        """Returns the text decoded from data, keeping an incomplete record for the next call."""
+        data = self.pending + data
+        out = []
+        text = bytearray()
+        pos = 0
+        while pos < len(data):
+            byte = data[pos]
+            if byte not in (RECORD, RECORD_TIMESTAMP):
+                text.append(byte)
+                pos += 1
+                continue
+            if pos + HEADER_SIZE > len(data) or pos + HEADER_SIZE + data[pos + 1] > len(data):
+                break
+            out.append(text.decode("utf-8", "replace"))
+            text = bytearray()
+            size = data[pos + 1]
+            out.append(self.decode_record(byte, data[pos + HEADER_SIZE:pos + HEADER_SIZE + size]))
+            pos += HEADER_SIZE + size
+        out.append(text.decode("utf-8", "replace"))
+        self.pending = data[pos:]
+        return "".join(out)
+
+    def decode_record(self, marker, payload):
+        if len(payload) < 4:
+            return "<truncated record>"
+        address, = struct.unpack_from("<I", payload, 0)
+        self.payload = payload
+        self.pos = 4
+        prefix = ""
+        if marker == RECORD_TIMESTAMP:
+            timestamp = self.take(4, False)
+            prefix = "[%s] " % ("?" if timestamp is None else timestamp)
+        fmt = self.image.read_string(address)
+        if fmt is None:
+            return prefix + "<unknown format 0x%08x>\n" % address
+        return prefix + CONVERSION.sub(self.convert, fmt)
+
+    def take(self, size, signed):
+        if self.pos + size > len(self.payload):
+            self.pos = len(self.payload)
+            return None
+        value = int.from_bytes(self.payload[self.pos:self.pos + size], "little", signed = signed)
+        self.pos += size
+        return value
+
+    def take_string(self):
+        if self.pos >= len(self.payload):
+            return None
+        end = self.payload.find(b"\0", self.pos)
+        if end < 0:
+            end = len(self.payload)
+        value = self.payload[self.pos:end].decode("utf-8", "replace")
+        self.pos = end + 1
+        return value
+
+    def convert(self, match):
+        flags, width, precision, length, conversion = match.groups()
+        length = length or ""
+        if conversion == "%":
+            return "%"
+        if width == "*":
+            width = self.take(4, True)
+            if width is None:
+                return "<?>"
+            if width < 0:
+                flags, width = flags + "-", -width
+        if precision == "*":
+            precision = self.take(4, True)
+            if precision is None:
+                return "<?>"
+            if precision < 0:
+                precision = None
+        spec = "%" + flags + (str(width) if width is not None else "")
+        if precision is not None:
+            spec += "." + str(precision)
+
+        if conversion in "diuoxXc":
+            size = self.sizes[length]
+            value = self.take(size, conversion in "di")
+            if value is None:
+                return "<?>"
+            if length == "hh":
+                value = (value & 0xFF) - (0x100 if conversion in "di" and value & 0x80 else 0)
+            elif length == "h":
+                value = (value & 0xFFFF) - (0x10000 if conversion in "di" and value & 0x8000 else 0)
+            if conversion == "c":
+                return (spec + "c") % chr(value & 0xFF)
+            text = (spec + ("d" if conversion in "iu" else conversion)) % value
+            # python writes the alternate octal form as 0o17
+            return text.replace("0o", "0", 1) if conversion == "o" else text
+        if conversion in "fFeEgGaA":
+            if self.pos + 8 > len(self.payload):
+                self.pos = len(self.payload)
+                return "<?>"
+            value, = struct.unpack_from("<d", self.payload, self.pos)
+            self.pos += 8
+            if conversion in "aA":
+                text = float.hex(value)
+                return (spec.split(".")[0] + "s") % (text.upper() if conversion == "A" else text)
+            return (spec + conversion) % value
+        if conversion == "p":
+            value = self.take(self.pointer_size, False)
+            if value is None:
+                return "<?>"
+            return (spec.split(".")[0] + "s") % ("0x%x" % value)
+        if conversion == "s":
+            value = self.take_string()
+            if value is None:
+                return "<?>"
+            return (spec + "s") % value
+        # %n: nothing is sent
+        return ""
+
+def main():
+    parser = argparse.ArgumentParser(description = "Decode the deferred records of stm32_adv_trace")
+    parser.add_argument("elf", help = "ELF file of the firmware that sent the traces")
+    parser.add_argument("capture", nargs = "?", help = "binary capture of the trace output, stdin if omitted")
+    parser.add_argument("--lp64", action = "store_true", help = "long, size_t and pointers on 64 bits (host builds)")
+    args = parser.parse_args()
+
+    decoder = Decoder(ElfImage(args.elf), args.lp64)
+    stream = open(args.capture, "rb") if args.capture else sys.stdin.buffer
+    while True:
+        data = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+        if not data:
+            break
+        sys.stdout.write(decoder.feed(data))
+        sys.stdout.flush()
+    if decoder.pending:
+        sys.stdout.write("<truncated record>\n")
+
+if __name__ == "__main__":
+    main()